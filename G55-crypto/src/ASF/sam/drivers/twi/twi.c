@@ -381,6 +381,114 @@ uint32_t twi_master_write(Twi *p_twi, twi_packet_t *p_packet)
 	return TWI_SUCCESS;
 }
 
+/**
+ * \brief Start writing multiple bytes to a TWI compatible slave device using the PDC.
+ *
+ * \note This function returns as soon as the transfer has been started. The PDC
+ * transmits all bytes but the last one and then sets TWI_SR_ENDTX. The caller
+ * finishes the transfer: disable the PDC with twi_master_pdc_disable(), wait for
+ * TWI_SR_TXRDY, send a STOP and write the last byte to TWI_THR, then wait for
+ * TWI_SR_TXCOMP.
+ *
+ * \param p_twi Pointer to a TWI instance.
+ * \param p_packet Packet information and data (see \ref twi_packet_t).
+ *
+ * \return TWI_SUCCESS if the transfer was started, error code otherwise.
+ */
+uint32_t twi_master_pdc_write_start(Twi *p_twi, twi_packet_t *p_packet)
+{
+	uint32_t cnt = p_packet->length;
+
+	/* Check argument */
+	if (cnt == 0) {
+		return TWI_INVALID_ARGUMENT;
+	}
+
+	twi_master_pdc_disable(p_twi);
+
+	/* Set write mode, slave address and 3 internal address byte lengths */
+	p_twi->TWI_MMR = 0;
+	p_twi->TWI_MMR = TWI_MMR_DADR(p_packet->chip) |
+			((p_packet->addr_length << TWI_MMR_IADRSZ_Pos) &
+			TWI_MMR_IADRSZ_Msk);
+
+	/* Set internal address for remote chip */
+	p_twi->TWI_IADR = 0;
+	p_twi->TWI_IADR = twi_mk_addr(p_packet->addr, p_packet->addr_length);
+
+	/* The PDC sends all bytes but the last, writing TWI_THR starts the transfer */
+	p_twi->TWI_TPR = (uint32_t)p_packet->buffer;
+	p_twi->TWI_TCR = cnt - 1;
+	if (cnt > 1) {
+		p_twi->TWI_PTCR = TWI_PTCR_TXTEN;
+	}
+
+	return TWI_SUCCESS;
+}
+
+/**
+ * \brief Start reading multiple bytes from a TWI compatible slave device using the PDC.
+ *
+ * \note This function returns as soon as the transfer has been started. The PDC
+ * receives all bytes but the last two and then sets TWI_SR_ENDRX. The caller
+ * finishes the transfer: disable the PDC with twi_master_pdc_disable(), wait for
+ * TWI_SR_RXRDY, send a STOP and read the penultimate byte from TWI_RHR, wait for
+ * TWI_SR_RXRDY again and read the last byte, then wait for TWI_SR_TXCOMP. With a
+ * single byte to read the STOP is sent along with the START.
+ *
+ * \param p_twi Pointer to a TWI instance.
+ * \param p_packet Packet information and data (see \ref twi_packet_t).
+ *
+ * \return TWI_SUCCESS if the transfer was started, error code otherwise.
+ */
+uint32_t twi_master_pdc_read_start(Twi *p_twi, twi_packet_t *p_packet)
+{
+	uint32_t cnt = p_packet->length;
+
+	/* Check argument */
+	if (cnt == 0) {
+		return TWI_INVALID_ARGUMENT;
+	}
+
+	twi_master_pdc_disable(p_twi);
+
+	/* Set read mode, slave address and 3 internal address byte lengths */
+	p_twi->TWI_MMR = 0;
+	p_twi->TWI_MMR = TWI_MMR_MREAD | TWI_MMR_DADR(p_packet->chip) |
+			((p_packet->addr_length << TWI_MMR_IADRSZ_Pos) &
+			TWI_MMR_IADRSZ_Msk);
+
+	/* Set internal address for remote chip */
+	p_twi->TWI_IADR = 0;
+	p_twi->TWI_IADR = twi_mk_addr(p_packet->addr, p_packet->addr_length);
+
+	/* The PDC receives all bytes but the last two */
+	if (cnt > 2) {
+		p_twi->TWI_RPR = (uint32_t)p_packet->buffer;
+		p_twi->TWI_RCR = cnt - 2;
+		p_twi->TWI_PTCR = TWI_PTCR_RXTEN;
+	}
+
+	/* Send a START condition */
+	if (cnt == 1) {
+		p_twi->TWI_CR = TWI_CR_START | TWI_CR_STOP;
+	} else {
+		p_twi->TWI_CR = TWI_CR_START;
+	}
+
+	return TWI_SUCCESS;
+}
+
+/**
+ * \brief Disable the PDC transfers of a TWI instance.
+ *
+ * \param p_twi Pointer to a TWI instance.
+ */
+void twi_master_pdc_disable(Twi *p_twi)
+{
+	p_twi->TWI_PTCR = TWI_PTCR_RXTDIS | TWI_PTCR_TXTDIS;
+}
+
 /**
  * \brief Enable TWI interrupts.
  *
@@ -122,6 +122,9 @@ uint32_t twi_set_speed(Twi *p_twi, uint32_t ul_speed, uint32_t ul_mck);
 uint32_t twi_probe(Twi *p_twi, uint8_t uc_slave_addr);
 uint32_t twi_master_read(Twi *p_twi, twi_packet_t *p_packet);
 uint32_t twi_master_write(Twi *p_twi, twi_packet_t *p_packet);
+uint32_t twi_master_pdc_write_start(Twi *p_twi, twi_packet_t *p_packet);
+uint32_t twi_master_pdc_read_start(Twi *p_twi, twi_packet_t *p_packet);
+void twi_master_pdc_disable(Twi *p_twi);
 void twi_enable_interrupt(Twi *p_twi, uint32_t ul_sources);
 void twi_disable_interrupt(Twi *p_twi, uint32_t ul_sources);
 uint32_t twi_get_interrupt_status(Twi *p_twi);
@@ -0,0 +1,131 @@
+/** \brief benchmark of challenge generation, atcacert_gen_challenge_sw() drawing from the software generator
+ *  against atcacert_gen_challenge_hw() on the device, and the software generator on several threads at
+ *  once.  Runs against the in-process emulator with real execution times.
+ *  Host only, build and run with "make bench".
+ *
+ * Copyright (c) 2015 Atmel Corporation. All rights reserved.
+ *
+ * \asf_license_start
+ *
+ * \page License
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. The name of Atmel may not be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * 4. This software may only be redistributed and used in connection with an
+ *    Atmel microcontroller product.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ATMEL "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT ARE
+ * EXPRESSLY AND SPECIFICALLY DISCLAIMED. IN NO EVENT SHALL ATMEL BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * \asf_license_stop
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <pthread.h>
+#include "cryptoauthlib.h"
+#include "atcacert/atcacert_host_hw.h"
+#include "atcacert/atcacert_host_sw.h"
+
+#define BENCH_DEVICE_CHALLENGES (16)
+#define BENCH_SW_CHALLENGES     (200000)    // per thread
+#define BENCH_THREADS           (4)
+
+static double now_s(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+/** \brief generates challenges, and keeps the last one to check threads don't repeat each other */
+static void *gen_challenges(void *last)
+{
+	uint8_t challenge[32];
+	int i;
+
+	for (i = 0; i < BENCH_SW_CHALLENGES; i++)
+	{
+		if ( atcacert_gen_challenge_sw(challenge) != ATCACERT_E_SUCCESS )
+			return NULL;
+	}
+	memcpy(last, challenge, sizeof(challenge));
+	return last;
+}
+
+int main(void)
+{
+	static uint8_t last[BENCH_THREADS][32];
+	uint8_t challenge[32];
+	pthread_t threads[BENCH_THREADS];
+	void *ret[BENCH_THREADS];
+	ATCAIfaceCfg cfg = cfg_ateccx08a_emu_default;
+	double start, device_s, sw_s, threads_s;
+	int i;
+
+	if ( atcab_init(&cfg) != ATCA_SUCCESS )
+		return 1;
+
+	start = now_s();
+	for (i = 0; i < BENCH_DEVICE_CHALLENGES; i++)
+	{
+		if ( atcacert_gen_challenge_hw(challenge) != ATCACERT_E_SUCCESS )
+		{
+			printf("device challenge failed\n");
+			return 1;
+		}
+	}
+	device_s = (now_s() - start) / BENCH_DEVICE_CHALLENGES;
+
+	start = now_s();
+	if ( gen_challenges(last[0]) == NULL )
+	{
+		printf("software challenge failed\n");
+		return 1;
+	}
+	sw_s = (now_s() - start) / BENCH_SW_CHALLENGES;
+
+	start = now_s();
+	for (i = 0; i < BENCH_THREADS; i++)
+		pthread_create(&threads[i], NULL, gen_challenges, last[i]);
+	for (i = 0; i < BENCH_THREADS; i++)
+		pthread_join(threads[i], &ret[i]);
+	threads_s = (now_s() - start) / ((double)BENCH_SW_CHALLENGES * BENCH_THREADS);
+
+	for (i = 0; i < BENCH_THREADS; i++)
+	{
+		if ( ret[i] == NULL || (i > 0 && memcmp(last[i], last[i - 1], sizeof(last[i])) == 0) )
+		{
+			printf("thread %d: challenge failed or repeated\n", i);
+			return 1;
+		}
+	}
+
+	printf("challenge: device %8.3f ms  software %6.0f ns  %d threads %6.0f ns per challenge  %.0fx\n",
+	       device_s * 1000, sw_s * 1e9, BENCH_THREADS, threads_s * 1e9, device_s / sw_s);
+
+	atcab_release();
+	return 0;
+}
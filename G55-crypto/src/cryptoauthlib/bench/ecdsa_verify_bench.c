@@ -0,0 +1,191 @@
+/** \brief benchmark of ECDSA P-256 verify, atcac_sw_ecdsa_verify_p256() in software against the device's
+ *  Verify command through atcab_verify_extern(), and a cross-check that both agree on valid and corrupted
+ *  signatures.  Also times verifies against a public key with a pinned comb table.  Runs against the in-process emulator with real execution times.
+ *  Host only, build and run with "make bench".
+ *
+ * Copyright (c) 2015 Atmel Corporation. All rights reserved.
+ *
+ * \asf_license_start
+ *
+ * \page License
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. The name of Atmel may not be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * 4. This software may only be redistributed and used in connection with an
+ *    Atmel microcontroller product.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ATMEL "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT ARE
+ * EXPRESSLY AND SPECIFICALLY DISCLAIMED. IN NO EVENT SHALL ATMEL BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * \asf_license_stop
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include "cryptoauthlib.h"
+#include "crypto/atca_crypto_sw_ecdsa.h"
+#include "crypto/ecc/p256_routines.h"
+
+#define BENCH_DEVICE_VERIFIES   (16)    // each takes the device's Verify execution time
+#define BENCH_SW_VERIFIES       (500)
+#define BENCH_BATCH             (64)    // signatures under distinct keys for the batch verify
+
+static double now_s(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+/** \brief make up a key, digest and signature for test i, every fourth signature corrupted */
+static void make_signature(int i, uint8_t *digest, uint8_t *signature, uint8_t *pubkey)
+{
+	uint8_t private_key[P256_FIELD_SIZE], k[P256_FIELD_SIZE];
+	int j;
+
+	for (j = 0; j < P256_FIELD_SIZE; j++)
+	{
+		private_key[j] = (uint8_t)(i * 13 + j * 7 + 1);
+		k[j] = (uint8_t)(i * 29 + j * 3 + 5);
+		digest[j] = (uint8_t)(i * 17 + j * 11);
+	}
+	private_key[0] &= 0x7F;     // keep both below n
+	k[0] &= 0x7F;
+	sw_p256_public_key(private_key, pubkey);
+	sw_p256_sign(private_key, digest, k, signature);
+	if (i % 4 == 3)
+		signature[i % P256_SIGNATURE_SIZE] ^= 0x01;
+}
+
+int main(void)
+{
+	uint8_t digest[P256_FIELD_SIZE], signature[P256_SIGNATURE_SIZE], pubkey[P256_PUBLIC_KEY_SIZE];
+	static uint8_t digests[BENCH_BATCH][P256_FIELD_SIZE], signatures[BENCH_BATCH][P256_SIGNATURE_SIZE], pubkeys[BENCH_BATCH][P256_PUBLIC_KEY_SIZE];
+	const uint8_t *digest_list[BENCH_BATCH], *signature_list[BENCH_BATCH], *pubkey_list[BENCH_BATCH];
+	int results[BENCH_BATCH], single[BENCH_BATCH];
+	static sw_p256_comb comb;
+	const sw_p256_comb *pinned[1] = { &comb };
+	ATCAIfaceCfg cfg = cfg_ateccx08a_emu_default;
+	double start, device_s = 0, sw_s = 0, single_s, batch_s, build_s, comb_s;
+	bool verified;
+	int i, ret;
+
+	if ( atcab_init(&cfg) != ATCA_SUCCESS )
+		return 1;
+
+	for (i = 0; i < BENCH_DEVICE_VERIFIES; i++)
+	{
+		make_signature(i, digest, signature, pubkey);
+
+		start = now_s();
+		if ( atcab_verify_extern(digest, signature, pubkey, &verified) != ATCA_SUCCESS )
+		{
+			printf("device verify failed\n");
+			return 1;
+		}
+		device_s += now_s() - start;
+
+		start = now_s();
+		ret = atcac_sw_ecdsa_verify_p256(digest, signature, pubkey);
+		sw_s += now_s() - start;
+
+		if ( (ret == ATCA_SUCCESS) != verified || (ret != ATCA_SUCCESS && ret != ATCA_CHECKMAC_VERIFY_FAILED) )
+		{
+			printf("signature %d: device %s, software %02x\n", i, verified ? "valid" : "invalid", ret);
+			return 1;
+		}
+	}
+
+	// the same key over and over would get a cached comb table, clearing the cache keeps to the plain verify
+	make_signature(0, digest, signature, pubkey);
+	start = now_s();
+	for (i = 0; i < BENCH_SW_VERIFIES; i++)
+	{
+		sw_p256_comb_cache_clear();
+		if ( atcac_sw_ecdsa_verify_p256(digest, signature, pubkey) != ATCA_SUCCESS )
+		{
+			printf("software verify failed\n");
+			return 1;
+		}
+	}
+	sw_s = (now_s() - start) / BENCH_SW_VERIFIES;
+	device_s /= BENCH_DEVICE_VERIFIES;
+
+	printf("verify (%d-bit limbs): device %6.2f ms  software %6.3f ms  %5.1fx\n",
+	       P256_LIMB_BITS, device_s * 1000, sw_s * 1000, device_s / sw_s);
+
+	start = now_s();
+	if ( sw_p256_comb_build(pubkey, &comb) != P256_SUCCESS )
+	{
+		printf("comb table build failed\n");
+		return 1;
+	}
+	build_s = now_s() - start;
+	sw_p256_comb_pin(pinned, 1);
+
+	start = now_s();
+	for (i = 0; i < BENCH_SW_VERIFIES; i++)
+	{
+		if ( atcac_sw_ecdsa_verify_p256(digest, signature, pubkey) != ATCA_SUCCESS )
+		{
+			printf("software verify with a comb table failed\n");
+			return 1;
+		}
+	}
+	comb_s = (now_s() - start) / BENCH_SW_VERIFIES;
+	sw_p256_comb_pin(NULL, 0);
+
+	printf("pinned key: plain %6.3f ms  comb table %6.3f ms  %4.2fx  (table built in %6.3f ms)\n",
+	       sw_s * 1000, comb_s * 1000, sw_s / comb_s, build_s * 1000);
+
+	sw_p256_comb_cache_clear();
+	for (i = 0; i < BENCH_BATCH; i++)
+	{
+		make_signature(i, digests[i], signatures[i], pubkeys[i]);
+		digest_list[i] = digests[i];
+		signature_list[i] = signatures[i];
+		pubkey_list[i] = pubkeys[i];
+	}
+
+	start = now_s();
+	for (i = 0; i < BENCH_BATCH; i++)
+		single[i] = atcac_sw_ecdsa_verify_p256(digests[i], signatures[i], pubkeys[i]);
+	single_s = (now_s() - start) / BENCH_BATCH;
+
+	start = now_s();
+	atcac_sw_ecdsa_verify_p256_batch(digest_list, signature_list, pubkey_list, results, BENCH_BATCH);
+	batch_s = (now_s() - start) / BENCH_BATCH;
+
+	if ( memcmp(results, single, sizeof(results)) != 0 )
+	{
+		printf("batch verify disagrees with single verifies\n");
+		return 1;
+	}
+	printf("%d signatures: one by one %6.3f ms  batch %6.3f ms per signature  %4.2fx\n",
+	       BENCH_BATCH, single_s * 1000, batch_s * 1000, single_s / batch_s);
+
+	atcab_release();
+	return 0;
+}
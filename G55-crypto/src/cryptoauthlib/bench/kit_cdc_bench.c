@@ -0,0 +1,347 @@
+/** \brief benchmark of the kit CDC HAL, commands one by one against hal_kit_cdc_pipeline().  Runs against
+ *  a stand-in kit on a pty that answers at the pace of a 115200 baud line and a device that takes
+ *  KIT_EXEC_S per command.  Also checks that replies to requests abandoned by a wake are dropped and
+ *  that a malformed reply in a pipeline doesn't shift the replies after it.
+ *  Host only, build and run with "make bench".
+ *
+ *
+ * Copyright (c) 2015 Atmel Corporation. All rights reserved.
+ *
+ * \asf_license_start
+ *
+ * \page License
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. The name of Atmel may not be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * 4. This software may only be redistributed and used in connection with an
+ *    Atmel microcontroller product.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ATMEL "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT ARE
+ * EXPRESSLY AND SPECIFICALLY DISCLAIMED. IN NO EVENT SHALL ATMEL BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * \asf_license_stop
+ */
+
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <poll.h>
+#include <pthread.h>
+#include <pty.h>
+#include <unistd.h>
+#include "cryptoauthlib.h"
+#include "hal/hal_kit_cdc.h"
+
+#define KIT_CHAR_S          (10.0 / 115200)     // start, 8 data and stop bit at 115200 baud
+#define KIT_EXEC_S          (0.002)             // execution time of a command on the device
+#define KIT_RESPONSE_SIZE   (35)                // responses as long as a Random response
+#define KIT_PARAM_BAD       (0xEE)              // param1 of a command the stand-in answers with a malformed reply
+#define KIT_REPLIES         (64)                // replies the stand-in holds until they are due
+#define BENCH_COMMANDS      (32)
+
+/** \brief a reply line of the stand-in kit, written once its last character would be on the wire */
+typedef struct {
+	double due;
+	char   line[2 * KIT_RESPONSE_SIZE + 8];
+	int    length;
+} fake_reply_t;
+
+/** \brief the stand-in kit, on the master side of the pty */
+typedef struct {
+	int          fd;
+	volatile int stop;
+	char         line[1024];
+	int          line_len;
+	double       rx_free;       // when the host to kit direction of the line is free
+	double       dev_free;      // when the device is done with its last command
+	double       tx_free;       // when the kit to host direction of the line is free
+	fake_reply_t replies[KIT_REPLIES];
+	int          head, count;
+} fake_kit_t;
+
+static double now_s(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static double max_s(double a, double b)
+{
+	return a > b ? a : b;
+}
+
+static int hex_value(char c)
+{
+	if (c >= '0' && c <= '9')
+		return c - '0';
+	if (c >= 'A' && c <= 'F')
+		return c - 'A' + 10;
+	return -1;
+}
+
+/** \brief answer a request line, the reply is queued with the time it is due */
+static void fake_kit_answer(fake_kit_t *kit, const char *line, int length, double arrived)
+{
+	static const char hex[] = "0123456789ABCDEF";
+	uint8_t data[256], response[KIT_RESPONSE_SIZE];
+	fake_reply_t *reply;
+	double rx_done, exec_s = 0, start;
+	int i, count = 0;
+	bool ok = length >= 5 && line[1] == ':' && line[3] == '(' && line[length - 1] == ')' && (length - 5) % 2 == 0;
+
+	for (i = 4; ok && i < length - 1; i += 2)
+	{
+		ok = hex_value(line[i]) >= 0 && hex_value(line[i + 1]) >= 0;
+		data[count++] = (uint8_t)(hex_value(line[i]) << 4 | hex_value(line[i + 1]));
+	}
+
+	if (kit->count == KIT_REPLIES)
+		return;
+	reply = &kit->replies[(kit->head + kit->count++) % KIT_REPLIES];
+
+	if (!ok)
+		reply->length = sprintf(reply->line, "F0()\n");
+	else if (line[2] == 'w')
+		reply->length = sprintf(reply->line, "00(04113343)\n");
+	else if (line[2] == 't' && count >= 3 && data[2] == KIT_PARAM_BAD)
+	{
+		reply->length = sprintf(reply->line, "00(zz)\n");
+		exec_s = KIT_EXEC_S;
+	}
+	else if (line[2] == 't' && count >= 3)
+	{
+		// count, the command's param1 to tell the replies apart, filler and the CRC
+		response[0] = KIT_RESPONSE_SIZE;
+		response[1] = data[2];
+		for (i = 2; i < KIT_RESPONSE_SIZE - ATCA_CRC_SIZE; i++)
+			response[i] = (uint8_t)i;
+		atCRC(KIT_RESPONSE_SIZE - ATCA_CRC_SIZE, response, &response[KIT_RESPONSE_SIZE - ATCA_CRC_SIZE]);
+
+		reply->length = sprintf(reply->line, "00(");
+		for (i = 0; i < KIT_RESPONSE_SIZE; i++)
+		{
+			reply->line[reply->length++] = hex[response[i] >> 4];
+			reply->line[reply->length++] = hex[response[i] & 0x0F];
+		}
+		reply->length += sprintf(&reply->line[reply->length], ")\n");
+		exec_s = KIT_EXEC_S;
+	}
+	else
+		reply->length = sprintf(reply->line, "00()\n");
+
+	// the request comes in over the line, waits for the device, then its reply goes out over the line
+	rx_done = max_s(arrived, kit->rx_free) + (length + 1) * KIT_CHAR_S;
+	kit->rx_free = rx_done;
+	start = max_s(rx_done, kit->dev_free);
+	kit->dev_free = start + exec_s;
+	reply->due = max_s(kit->dev_free, kit->tx_free) + reply->length * KIT_CHAR_S;
+	kit->tx_free = reply->due;
+}
+
+/** \brief the stand-in kit: reads request lines, writes their replies when they are due */
+static void *fake_kit_run(void *arg)
+{
+	fake_kit_t *kit = arg;
+	struct pollfd pfd = { .fd = kit->fd, .events = POLLIN };
+	struct timespec timeout;
+	char chunk[512], *eol;
+	double wait_s;
+	ssize_t n;
+	int start;
+
+	while (!kit->stop)
+	{
+		wait_s = kit->count ? max_s(kit->replies[kit->head].due - now_s(), 0) : 0.01;
+		timeout.tv_sec = (time_t)wait_s;
+		timeout.tv_nsec = (long)((wait_s - (double)timeout.tv_sec) * 1e9);
+
+		if (ppoll(&pfd, 1, &timeout, NULL) > 0 && (pfd.revents & POLLIN) && (n = read(kit->fd, chunk, sizeof(chunk))) > 0)
+		{
+			for (start = 0; start < n; start = (int)(eol - chunk) + 1)
+			{
+				if ((eol = memchr(&chunk[start], '\n', (size_t)(n - start))) == NULL)
+					eol = &chunk[n];
+				if (kit->line_len + (eol - &chunk[start]) <= (int)sizeof(kit->line))
+				{
+					memcpy(&kit->line[kit->line_len], &chunk[start], (size_t)(eol - &chunk[start]));
+					kit->line_len += (int)(eol - &chunk[start]);
+				}
+				if (eol == &chunk[n])
+					break;
+				fake_kit_answer(kit, kit->line, kit->line_len, now_s());
+				kit->line_len = 0;
+			}
+		}
+
+		while (kit->count > 0 && kit->replies[kit->head].due <= now_s())
+		{
+			if (write(kit->fd, kit->replies[kit->head].line, (size_t)kit->replies[kit->head].length) < 0)
+				return NULL;
+			kit->head = (kit->head + 1) % KIT_REPLIES;
+			kit->count--;
+		}
+	}
+
+	return NULL;
+}
+
+/** \brief a Random command packet, laid out as hal_kit_cdc_send() takes it, with param1 as its tag */
+static void make_packet(uint8_t packet[8], uint8_t tag)
+{
+	packet[0] = 0x00;   // word address value slot, not sent
+	packet[1] = ATCA_CMD_SIZE_MIN;
+	packet[2] = ATCA_RANDOM;
+	packet[3] = tag;
+	packet[4] = 0x00;
+	packet[5] = 0x00;
+	atCRC(ATCA_CMD_SIZE_MIN - ATCA_CRC_SIZE, &packet[1], &packet[6]);
+}
+
+/** \brief send a command and receive its response, check the response is the one to this command */
+static ATCA_STATUS one_command(ATCAIface iface, uint8_t tag)
+{
+	uint8_t packet[8], response[KIT_RESPONSE_SIZE];
+	uint16_t length = sizeof(response);
+	ATCA_STATUS status;
+
+	make_packet(packet, tag);
+	if ((status = atsend(iface, packet, ATCA_CMD_SIZE_MIN)) != ATCA_SUCCESS)
+		return status;
+	if ((status = atreceive(iface, response, &length)) != ATCA_SUCCESS)
+		return status;
+	return (length == KIT_RESPONSE_SIZE && response[1] == tag) ? ATCA_SUCCESS : ATCA_RX_FAIL;
+}
+
+/** \brief pipeline count commands tagged first, first + 1, ..., check every response is the one to its command
+ *  except for the one tagged KIT_PARAM_BAD, which must fail
+ */
+static ATCA_STATUS pipeline_commands(ATCAIface iface, uint8_t first, int count)
+{
+	static uint8_t packets[BENCH_COMMANDS][8], responses[BENCH_COMMANDS][KIT_RESPONSE_SIZE];
+	uint8_t *tx[BENCH_COMMANDS], *rx[BENCH_COMMANDS];
+	int txlength[BENCH_COMMANDS];
+	uint16_t rxlength[BENCH_COMMANDS];
+	ATCA_STATUS status;
+	int i;
+
+	for (i = 0; i < count; i++)
+	{
+		make_packet(packets[i], (uint8_t)(first + i));
+		tx[i] = packets[i];
+		txlength[i] = ATCA_CMD_SIZE_MIN;
+		rx[i] = responses[i];
+		rxlength[i] = KIT_RESPONSE_SIZE;
+		responses[i][1] = 0;
+	}
+
+	status = hal_kit_cdc_pipeline(iface, tx, txlength, rx, rxlength, count);
+	for (i = 0; i < count; i++)
+	{
+		if ((uint8_t)(first + i) != KIT_PARAM_BAD && (rxlength[i] != KIT_RESPONSE_SIZE || responses[i][1] != (uint8_t)(first + i)))
+			return ATCA_RX_FAIL;
+	}
+
+	return status;
+}
+
+int main(void)
+{
+	static fake_kit_t kit;
+	ATCAIfaceCfg cfg = cfg_ecc508_kitcdc_default;
+	ATCAIface iface;
+	pthread_t thread;
+	uint8_t packet[8];
+	char name[64];
+	double start, one_s, pipelined_s;
+	int slave, i;
+
+	if (openpty(&kit.fd, &slave, name, NULL, NULL) != 0)
+	{
+		printf("no pty\n");
+		return 1;
+	}
+	cfg.atcauart.device = name;
+	if ((iface = newATCAIface(&cfg)) == NULL)
+	{
+		printf("kit CDC init failed\n");
+		return 1;
+	}
+	pthread_create(&thread, NULL, fake_kit_run, &kit);
+
+	if (atwake(iface) != ATCA_SUCCESS)
+	{
+		printf("wake failed\n");
+		return 1;
+	}
+
+	// a wake abandons the two commands still in flight, their replies come in behind it and are dropped
+	for (i = 1; i <= 2; i++)
+	{
+		make_packet(packet, (uint8_t)i);
+		atsend(iface, packet, ATCA_CMD_SIZE_MIN);
+	}
+	if (atwake(iface) != ATCA_SUCCESS || one_command(iface, 3) != ATCA_SUCCESS)
+	{
+		printf("stale replies weren't dropped\n");
+		return 1;
+	}
+
+	// a malformed reply fails its own command only
+	if (pipeline_commands(iface, KIT_PARAM_BAD - 5, 12) != ATCA_COMM_FAIL || one_command(iface, 4) != ATCA_SUCCESS)
+	{
+		printf("a malformed reply shifted the replies after it\n");
+		return 1;
+	}
+
+	start = now_s();
+	for (i = 0; i < BENCH_COMMANDS; i++)
+	{
+		if (one_command(iface, (uint8_t)i) != ATCA_SUCCESS)
+		{
+			printf("one by one: command %d failed\n", i);
+			return 1;
+		}
+	}
+	one_s = (now_s() - start) / BENCH_COMMANDS;
+
+	start = now_s();
+	if (pipeline_commands(iface, 0, BENCH_COMMANDS) != ATCA_SUCCESS)
+	{
+		printf("pipelined: commands failed\n");
+		return 1;
+	}
+	pipelined_s = (now_s() - start) / BENCH_COMMANDS;
+
+	printf("kit CDC, %d commands: one by one %6.2f ms  pipelined %6.2f ms per command (depth %d)  %4.2fx\n",
+	       BENCH_COMMANDS, one_s * 1000, pipelined_s * 1000, ATCA_KIT_PIPELINE_DEPTH, one_s / pipelined_s);
+
+	kit.stop = 1;
+	pthread_join(thread, NULL);
+	deleteATCAIface(&iface);
+	close(slave);
+	close(kit.fd);
+	return 0;
+}
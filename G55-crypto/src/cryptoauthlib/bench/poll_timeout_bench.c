@@ -0,0 +1,131 @@
+/** \brief host check of background operations on a device that stops answering.  A random number is
+ *  started with atcab_random_start() on the in-process emulator in ATCA_EXEC_DELAY mode, then the
+ *  device NACKs every read as one stuck busy.  atcab_poll() has to end the operation with an error
+ *  once the execution time and the rx_retries poll intervals after it have passed, not poll forever.
+ *  Host only, build and run with "make bench".
+ *
+ * Copyright (c) 2015 Atmel Corporation. All rights reserved.
+ *
+ * \asf_license_start
+ *
+ * \page License
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. The name of Atmel may not be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * 4. This software may only be redistributed and used in connection with an
+ *    Atmel microcontroller product.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ATMEL "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT ARE
+ * EXPRESSLY AND SPECIFICALLY DISCLAIMED. IN NO EVENT SHALL ATMEL BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * \asf_license_stop
+ */
+
+#include <stdio.h>
+#include <time.h>
+#include "cryptoauthlib.h"
+#include "hal/hal_emu_x08a.h"
+
+#define BENCH_GIVE_UP_S     (5.0)   // a background operation still running after this never ends
+
+static double now_s(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+/** \brief completion callback, keeps the final status */
+static void op_done(ATCA_STATUS status, void *context)
+{
+	*(ATCA_STATUS *)context = status;
+}
+
+/** \brief runs a random number in the background, the device hanging after the command went out if hang is set
+ *  \return final status of the operation, ATCA_RX_NO_RESPONSE if it was still running after BENCH_GIVE_UP_S
+ */
+static ATCA_STATUS random_in_background(bool hang, double *took_s)
+{
+	uint8_t rand_out[32];
+	ATCA_STATUS status, done = ATCA_RX_NO_RESPONSE;
+	double start = now_s();
+
+	if ( (status = atcab_random_start(rand_out, op_done, &done)) != ATCA_SUCCESS )
+		return status;
+	hal_emu_hang(atGetIFace(atcab_getDevice()), hang);
+
+	while ( (status = atcab_poll()) == ATCA_RX_NO_RESPONSE && now_s() - start < BENCH_GIVE_UP_S )
+		atca_delay_us(100);
+	*took_s = now_s() - start;
+
+	hal_emu_hang(atGetIFace(atcab_getDevice()), false);
+	if ( status != ATCA_RX_NO_RESPONSE && status != done )
+		return ATCA_GEN_FAIL;	// the callback has to see the status atcab_poll() ends with
+	return status;
+}
+
+int main(void)
+{
+	ATCAIfaceCfg cfg = cfg_ateccx08a_emu_default;
+	ATCA_STATUS status, hung;
+	double ok_s, hung_s, limit_s;
+
+	cfg.exec_mode = ATCA_EXEC_DELAY;
+	cfg.atcaemu.timing = ATCA_EMU_TIMING_ZERO;
+	if ( atcab_init(&cfg) != ATCA_SUCCESS )
+		return 1;
+
+	if ( (status = random_in_background(false, &ok_s)) != ATCA_SUCCESS )
+	{
+		printf("random on an answering device failed %02x\n", status);
+		return 1;
+	}
+
+	hung = random_in_background(true, &hung_s);
+	if ( hung == ATCA_RX_NO_RESPONSE || hung == ATCA_SUCCESS )
+	{
+		printf("random on a hung device %s after %.1f s\n", hung == ATCA_SUCCESS ? "succeeded" : "still running", hung_s);
+		return 1;
+	}
+
+	limit_s = (atGetExecTime(atGetCommands(atcab_getDevice()), CMD_RANDOM) * 1000.0 + cfg.rx_retries * (double)cfg.poll_interval_us) / 1e6;
+	if ( hung_s < limit_s )
+	{
+		printf("random on a hung device gave up after %.1f ms, before %.1f ms\n", hung_s * 1000, limit_s * 1000);
+		return 1;
+	}
+
+	// the device answers again, and the next operation runs as usual
+	if ( (status = random_in_background(false, &ok_s)) != ATCA_SUCCESS )
+	{
+		printf("random after the device recovered failed %02x\n", status);
+		return 1;
+	}
+
+	printf("poll timeout: random %6.1f ms, on a hung device ends with %02x after %6.1f ms (limit %.1f ms)\n",
+	       ok_s * 1000, hung, hung_s * 1000, limit_s * 1000);
+
+	atcab_release();
+	return 0;
+}
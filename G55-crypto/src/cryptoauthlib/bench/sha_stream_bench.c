@@ -0,0 +1,117 @@
+/** \brief benchmark of SHA-256 on the device, atcab_sha_stream() against start, update per 64 bytes and
+ *  end each in their own wake.  Runs against the in-process emulator with real execution times.
+ *  Host only, build and run with "make bench".
+ *
+ * Copyright (c) 2015 Atmel Corporation. All rights reserved.
+ *
+ * \asf_license_start
+ *
+ * \page License
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. The name of Atmel may not be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * 4. This software may only be redistributed and used in connection with an
+ *    Atmel microcontroller product.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ATMEL "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT ARE
+ * EXPRESSLY AND SPECIFICALLY DISCLAIMED. IN NO EVENT SHALL ATMEL BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * \asf_license_stop
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include "cryptoauthlib.h"
+#include "crypto/hashes/sha2_routines.h"
+
+#define BENCH_MESSAGE_SIZE  (4096)
+
+static double now_s(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+/** \brief hash the message the way atcab_sha had to be used for long messages before the stream API */
+static ATCA_STATUS sha_per_command(const uint8_t *message, size_t length, uint8_t *digest)
+{
+	ATCA_STATUS status;
+	uint8_t block[SHA_DATA_MAX];
+	size_t done;
+
+	if ( (status = atcab_sha_start()) != ATCA_SUCCESS )
+		return status;
+
+	for (done = 0; done + SHA_DATA_MAX <= length; done += SHA_DATA_MAX)
+	{
+		memcpy(block, &message[done], SHA_DATA_MAX);
+		if ( (status = atcab_sha_update(SHA_DATA_MAX, block)) != ATCA_SUCCESS )
+			return status;
+	}
+	if ( done < length && (status = atcab_sha_update((uint16_t)(length - done), &message[done])) != ATCA_SUCCESS )
+		return status;
+
+	return atcab_sha_end(digest);
+}
+
+int main(void)
+{
+	static uint8_t message[BENCH_MESSAGE_SIZE];
+	uint8_t expected[SHA_DIGEST_SIZE], digest[SHA_DIGEST_SIZE];
+	ATCAIfaceCfg cfg = cfg_ateccx08a_emu_default;
+	uint32_t stream_bps;
+	double start, old_s, new_s;
+	int i;
+
+	for (i = 0; i < BENCH_MESSAGE_SIZE; i++)
+		message[i] = (uint8_t)(i * 31 + 7);
+	sw_sha256(message, BENCH_MESSAGE_SIZE, expected);
+
+	if ( atcab_init(&cfg) != ATCA_SUCCESS )
+		return 1;
+
+	start = now_s();
+	if ( sha_per_command(message, BENCH_MESSAGE_SIZE, digest) != ATCA_SUCCESS || memcmp(digest, expected, sizeof(digest)) != 0 )
+	{
+		printf("per command: wrong digest\n");
+		return 1;
+	}
+	old_s = now_s() - start;
+
+	start = now_s();
+	if ( atcab_sha_stream(message, BENCH_MESSAGE_SIZE, digest, &stream_bps) != ATCA_SUCCESS || memcmp(digest, expected, sizeof(digest)) != 0 )
+	{
+		printf("stream: wrong digest\n");
+		return 1;
+	}
+	new_s = now_s() - start;
+
+	printf("%u bytes: per command %8.0f bytes/s  stream %8.0f bytes/s (reported %u)  %4.2fx\n",
+	       BENCH_MESSAGE_SIZE, BENCH_MESSAGE_SIZE / old_s, BENCH_MESSAGE_SIZE / new_s, stream_bps, old_s / new_s);
+
+	atcab_release();
+	return 0;
+}
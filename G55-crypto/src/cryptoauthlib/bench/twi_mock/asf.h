@@ -0,0 +1,179 @@
+/**
+ * \file
+ * \brief host stand-in for the parts of ASF the SAM I2C HAL (lib/hal/hal_sam4s_i2c_asf.c) uses, so the HAL
+ *  builds on a host against the register-level TWI and PDC model in bench/twi_pdc_bench.c.  Register and
+ *  bit names are those of the SAMG55 TWI, the few registers the HAL touches directly are plain fields.
+ *
+ * Copyright (c) 2015 Atmel Corporation. All rights reserved.
+ *
+ * \asf_license_start
+ *
+ * \page License
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. The name of Atmel may not be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * 4. This software may only be redistributed and used in connection with an
+ *    Atmel microcontroller product.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ATMEL "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT ARE
+ * EXPRESSLY AND SPECIFICALLY DISCLAIMED. IN NO EVENT SHALL ATMEL BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * \asf_license_stop
+ */
+
+#ifndef TWI_MOCK_ASF_H_
+#define TWI_MOCK_ASF_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+/** \brief TWI registers.  The PDC pointer registers are as wide as a host pointer.  Reading TWI_RHR and
+ *  writing TWI_THR have side effects on TWI_SR, so they are reached through mock_twi_rhr_read() and
+ *  mock_twi_thr_write(), which apply them to the TWI whose interrupt is being handled.
+ */
+typedef struct {
+	volatile uint32_t  TWI_CR;      // write only, the model takes START and STOP out at its next step
+	volatile uint32_t  TWI_MMR;
+	volatile uint32_t  TWI_IADR;
+	volatile uint32_t  TWI_CWGR;
+	volatile uint32_t  TWI_SR;
+	volatile uint32_t  TWI_IMR;
+	volatile uint32_t  TWI_RHR_[1];
+	volatile uint32_t  TWI_THR_[1];
+	volatile uintptr_t TWI_RPR;
+	volatile uint32_t  TWI_RCR;
+	volatile uintptr_t TWI_TPR;
+	volatile uint32_t  TWI_TCR;
+	volatile uint32_t  TWI_PTSR;
+} Twi;
+
+int mock_twi_rhr_read(void);
+int mock_twi_thr_write(void);
+#define TWI_RHR     TWI_RHR_[mock_twi_rhr_read()]
+#define TWI_THR     TWI_THR_[mock_twi_thr_write()]
+
+extern Twi mock_twi[2];
+#define TWI4        (&mock_twi[0])
+#define TWI1        (&mock_twi[1])
+
+#define TWI_CR_START            (0x1u << 0)
+#define TWI_CR_STOP             (0x1u << 1)
+#define TWI_MMR_IADRSZ_Pos      8
+#define TWI_MMR_IADRSZ_Msk      (0x3u << TWI_MMR_IADRSZ_Pos)
+#define TWI_MMR_MREAD           (0x1u << 12)
+#define TWI_MMR_DADR_Pos        16
+#define TWI_MMR_DADR_Msk        (0x7fu << TWI_MMR_DADR_Pos)
+#define TWI_MMR_DADR(value)     ((TWI_MMR_DADR_Msk & ((value) << TWI_MMR_DADR_Pos)))
+#define TWI_CWGR_CLDIV_Pos      0
+#define TWI_CWGR_CLDIV_Msk      (0xffu << TWI_CWGR_CLDIV_Pos)
+#define TWI_CWGR_CLDIV(value)   ((TWI_CWGR_CLDIV_Msk & ((value) << TWI_CWGR_CLDIV_Pos)))
+#define TWI_CWGR_CHDIV_Pos      8
+#define TWI_CWGR_CHDIV_Msk      (0xffu << TWI_CWGR_CHDIV_Pos)
+#define TWI_CWGR_CHDIV(value)   ((TWI_CWGR_CHDIV_Msk & ((value) << TWI_CWGR_CHDIV_Pos)))
+#define TWI_CWGR_CKDIV_Pos      16
+#define TWI_CWGR_CKDIV_Msk      (0x7u << TWI_CWGR_CKDIV_Pos)
+#define TWI_CWGR_CKDIV(value)   ((TWI_CWGR_CKDIV_Msk & ((value) << TWI_CWGR_CKDIV_Pos)))
+#define TWI_SR_TXCOMP           (0x1u << 0)
+#define TWI_SR_RXRDY            (0x1u << 1)
+#define TWI_SR_TXRDY            (0x1u << 2)
+#define TWI_SR_NACK             (0x1u << 8)
+#define TWI_SR_ENDRX            (0x1u << 12)
+#define TWI_SR_ENDTX            (0x1u << 13)
+#define TWI_IER_TXCOMP          TWI_SR_TXCOMP
+#define TWI_IER_RXRDY           TWI_SR_RXRDY
+#define TWI_IER_TXRDY           TWI_SR_TXRDY
+#define TWI_IER_NACK            TWI_SR_NACK
+#define TWI_IER_ENDRX           TWI_SR_ENDRX
+#define TWI_IER_ENDTX           TWI_SR_ENDTX
+#define TWI_IDR_TXCOMP          TWI_SR_TXCOMP
+#define TWI_IDR_RXRDY           TWI_SR_RXRDY
+#define TWI_IDR_TXRDY           TWI_SR_TXRDY
+#define TWI_IDR_NACK            TWI_SR_NACK
+#define TWI_IDR_ENDRX           TWI_SR_ENDRX
+#define TWI_IDR_ENDTX           TWI_SR_ENDTX
+#define TWI_PTCR_RXTEN          (0x1u << 0)
+#define TWI_PTCR_RXTDIS         (0x1u << 1)
+#define TWI_PTCR_TXTEN          (0x1u << 8)
+#define TWI_PTCR_TXTDIS         (0x1u << 9)
+
+// twi.h
+#define TWI_SUCCESS             0
+#define TWI_INVALID_ARGUMENT    1
+#define TWI_RECEIVE_NACK        5
+#define TWI_ERROR_TIMEOUT       9
+
+typedef struct twi_options {
+	uint32_t master_clk;
+	uint32_t speed;
+	uint8_t  chip;
+	uint8_t  smbus;
+} twi_options_t;
+
+typedef struct twi_packet {
+	uint8_t  addr[3];
+	uint32_t addr_length;
+	void    *buffer;
+	uint32_t length;
+	uint8_t  chip;
+} twi_packet_t;
+
+uint32_t twi_master_init(Twi *p_twi, const twi_options_t *p_opt);
+uint32_t twi_master_read(Twi *p_twi, twi_packet_t *p_packet);
+uint32_t twi_master_write(Twi *p_twi, twi_packet_t *p_packet);
+uint32_t twi_master_pdc_write_start(Twi *p_twi, twi_packet_t *p_packet);
+uint32_t twi_master_pdc_read_start(Twi *p_twi, twi_packet_t *p_packet);
+void twi_master_pdc_disable(Twi *p_twi);
+void twi_enable_interrupt(Twi *p_twi, uint32_t ul_sources);
+void twi_disable_interrupt(Twi *p_twi, uint32_t ul_sources);
+uint32_t twi_get_interrupt_status(Twi *p_twi);
+void twi_reset(Twi *p_twi);
+
+// flexcom, sysclk, ioport
+typedef int Flexcom;
+enum flexcom_opmode { FLEXCOM_NONE, FLEXCOM_USART, FLEXCOM_SPI, FLEXCOM_TWI };
+extern Flexcom mock_flexcom[2];
+#define FLEXCOM4                (&mock_flexcom[0])
+#define FLEXCOM0                (&mock_flexcom[1])
+void flexcom_enable(Flexcom *p_flexcom);
+void flexcom_set_opmode(Flexcom *p_flexcom, enum flexcom_opmode opmode);
+uint32_t sysclk_get_cpu_hz(void);
+
+typedef uint32_t ioport_pin_t;
+enum ioport_value { IOPORT_PIN_LEVEL_LOW, IOPORT_PIN_LEVEL_HIGH };
+enum ioport_direction { IOPORT_DIR_INPUT, IOPORT_DIR_OUTPUT };
+#define TWI4_DATA_GPIO          (4)
+#define TWI1_DATA_GPIO          (1)
+void ioport_set_pin_level(ioport_pin_t pin, bool level);
+void ioport_set_pin_dir(ioport_pin_t pin, enum ioport_direction dir);
+void ioport_enable_pin(ioport_pin_t pin);
+void ioport_disable_pin(ioport_pin_t pin);
+
+// CMSIS, an interrupt is handled at the next step of the model, which __WFI() waits for
+typedef enum { TWI4_IRQn = 19, TWI1_IRQn = 20 } IRQn_Type;
+void NVIC_EnableIRQ(IRQn_Type irq);
+void NVIC_DisableIRQ(IRQn_Type irq);
+void NVIC_ClearPendingIRQ(IRQn_Type irq);
+void __WFI(void);
+
+#endif /* TWI_MOCK_ASF_H_ */
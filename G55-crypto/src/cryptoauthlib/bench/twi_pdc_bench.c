@@ -0,0 +1,492 @@
+/** \brief check of the PDC and interrupt driven transfers of the SAM I2C HAL (ATCA_I2C_PDC) against a
+ *  register-level model of the TWI and its PDC with a device on the bus.  The model runs at the clock
+ *  programmed into TWI_CWGR, so transfers take their time on the wire and the HAL's timeouts are real.
+ *  The HAL is built against the ASF stand-in in bench/twi_mock.  Host only, build and run with "make bench".
+ *
+ *
+ * Copyright (c) 2015 Atmel Corporation. All rights reserved.
+ *
+ * \asf_license_start
+ *
+ * \page License
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. The name of Atmel may not be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * 4. This software may only be redistributed and used in connection with an
+ *    Atmel microcontroller product.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ATMEL "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT ARE
+ * EXPRESSLY AND SPECIFICALLY DISCLAIMED. IN NO EVENT SHALL ATMEL BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * \asf_license_stop
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#define ATCA_I2C_PDC
+#include "../lib/hal/hal_sam4s_i2c_asf.c"
+
+#define MOCK_MCK_HZ         (120000000)
+#define MOCK_SLAVE_ADDRESS  (0xC0)
+
+/** \brief what the bus behind a TWI is doing */
+typedef enum {
+	MOCK_IDLE,
+	MOCK_WRITE,
+	MOCK_READ,
+	MOCK_HELD               // the device holds SCL low, nothing moves until a STOP
+} mock_phase_t;
+
+/** \brief the bus behind a TWI and the device on it */
+typedef struct {
+	mock_phase_t phase;
+	int      thr_full;      // TWI_THR holds a byte not shifted out yet
+	int      stop;          // STOP requested, sent after the byte in progress
+	int      irq_enabled;
+	double   next_s;        // when the byte in progress is done on the wire
+
+	int      nacks;         // addresses the device still NACKs, as it does while it executes a command
+	int      hold;          // the device holds SCL low after the next address
+	uint8_t  written[256];
+	int      written_len;
+	uint8_t  response[256];
+	int      read_len;
+} mock_bus_t;
+
+Twi mock_twi[2];
+Flexcom mock_flexcom[2];
+static mock_bus_t mock_bus[2];
+static int mock_current = -1;   // bus whose interrupt handler runs
+
+static double now_s(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+/** \brief time a byte and its ACK take at the clock in TWI_CWGR, SCL low and high each last
+ *  (CLDIV * 2^CKDIV + 4) periods of the master clock
+ */
+static double mock_byte_s(const Twi *twi)
+{
+	uint32_t cldiv = (twi->TWI_CWGR & TWI_CWGR_CLDIV_Msk) >> TWI_CWGR_CLDIV_Pos;
+	uint32_t ckdiv = (twi->TWI_CWGR & TWI_CWGR_CKDIV_Msk) >> TWI_CWGR_CKDIV_Pos;
+
+	return 9 * 2.0 * ((cldiv << ckdiv) + 4) / MOCK_MCK_HZ;
+}
+
+/** \brief ENDTX and ENDRX follow the PDC counters */
+static void mock_twi_flags(Twi *twi)
+{
+	twi->TWI_SR &= ~(TWI_SR_ENDTX | TWI_SR_ENDRX);
+	if (twi->TWI_TCR == 0)
+		twi->TWI_SR |= TWI_SR_ENDTX;
+	if (twi->TWI_RCR == 0)
+		twi->TWI_SR |= TWI_SR_ENDRX;
+}
+
+int mock_twi_rhr_read(void)
+{
+	if (mock_current >= 0)
+		mock_twi[mock_current].TWI_SR &= ~TWI_SR_RXRDY;
+	return 0;
+}
+
+int mock_twi_thr_write(void)
+{
+	if (mock_current >= 0)
+	{
+		mock_twi[mock_current].TWI_SR &= ~TWI_SR_TXRDY;
+		mock_bus[mock_current].thr_full = 1;
+	}
+	return 0;
+}
+
+/** \brief START and the address byte, the device ACKs it unless it is busy */
+static void mock_twi_start(int b, mock_phase_t phase)
+{
+	Twi *twi = &mock_twi[b];
+	mock_bus_t *bus = &mock_bus[b];
+
+	if (bus->nacks > 0)
+	{
+		bus->nacks--;
+		bus->thr_full = 0;
+		bus->stop = 0;
+		twi->TWI_SR |= TWI_SR_NACK | TWI_SR_TXCOMP | TWI_SR_TXRDY;
+		return;
+	}
+
+	twi->TWI_SR &= ~TWI_SR_TXCOMP;
+	bus->written_len = 0;
+	bus->read_len = 0;
+	bus->phase = bus->hold ? MOCK_HELD : phase;
+}
+
+/** \brief one step of the TWI, its PDC and the bus
+ * \return 1 if a byte went over the bus
+ */
+static int mock_twi_step(int b)
+{
+	Twi *twi = &mock_twi[b];
+	mock_bus_t *bus = &mock_bus[b];
+	uint32_t cr = twi->TWI_CR;
+	int reading = (twi->TWI_MMR & TWI_MMR_MREAD) != 0;
+	int moved = 0;
+
+	twi->TWI_CR = 0;
+	if (cr & TWI_CR_STOP)
+		bus->stop = 1;
+
+	// the PDC keeps TWI_THR full and TWI_RHR empty while it has bytes
+	if (!reading && (twi->TWI_PTSR & TWI_PTCR_TXTEN) && twi->TWI_TCR > 0 && !bus->thr_full)
+	{
+		twi->TWI_THR_[0] = *(uint8_t *)twi->TWI_TPR++;
+		twi->TWI_TCR--;
+		twi->TWI_SR &= ~TWI_SR_TXRDY;
+		bus->thr_full = 1;
+	}
+	if (reading && (twi->TWI_PTSR & TWI_PTCR_RXTEN) && twi->TWI_RCR > 0 && (twi->TWI_SR & TWI_SR_RXRDY))
+	{
+		*(uint8_t *)twi->TWI_RPR++ = (uint8_t)twi->TWI_RHR_[0];
+		twi->TWI_RCR--;
+		twi->TWI_SR &= ~TWI_SR_RXRDY;
+	}
+
+	switch (bus->phase)
+	{
+		case MOCK_IDLE:
+			if (reading ? (cr & TWI_CR_START) != 0 : bus->thr_full)
+			{
+				mock_twi_start(b, reading ? MOCK_READ : MOCK_WRITE);
+				moved = 1;
+			}
+			break;
+
+		case MOCK_WRITE:
+			if (bus->thr_full)
+			{
+				bus->written[bus->written_len++] = (uint8_t)twi->TWI_THR_[0];
+				bus->thr_full = 0;
+				twi->TWI_SR |= TWI_SR_TXRDY;
+				moved = 1;
+			}
+			else if (bus->stop)
+			{
+				bus->stop = 0;
+				bus->phase = MOCK_IDLE;
+				twi->TWI_SR |= TWI_SR_TXCOMP;
+			}
+			break;
+
+		case MOCK_READ:
+			// SCL is stretched while TWI_RHR is full, a STOP requested before a byte starts ends after it
+			if (!(twi->TWI_SR & TWI_SR_RXRDY))
+			{
+				twi->TWI_RHR_[0] = bus->response[bus->read_len++];
+				twi->TWI_SR |= TWI_SR_RXRDY;
+				moved = 1;
+				if (bus->stop)
+				{
+					bus->stop = 0;
+					bus->phase = MOCK_IDLE;
+					twi->TWI_SR |= TWI_SR_TXCOMP;
+				}
+			}
+			break;
+
+		case MOCK_HELD:
+			if (bus->stop)
+			{
+				bus->stop = 0;
+				bus->hold = 0;
+				bus->phase = MOCK_IDLE;
+				twi->TWI_SR |= TWI_SR_TXCOMP | TWI_SR_TXRDY;
+			}
+			break;
+	}
+
+	mock_twi_flags(twi);
+	return moved;
+}
+
+/** \brief waits for the next event: every bus takes a step, at the pace of its clock when a byte moves,
+ *  then the interrupts that are enabled and pending are handled
+ */
+void __WFI(void)
+{
+	int b;
+
+	for (b = 0; b < 2; b++)
+	{
+		mock_bus_t *bus = &mock_bus[b];
+		double now = now_s();
+
+		if (mock_twi_step(b))
+		{
+			if (bus->next_s < now)
+				bus->next_s = now;
+			bus->next_s += mock_byte_s(&mock_twi[b]);
+			while (now_s() < bus->next_s)
+				;
+		}
+
+		if (bus->irq_enabled && (mock_twi[b].TWI_SR & mock_twi[b].TWI_IMR))
+		{
+			mock_current = b;
+			if (b == 0)
+				TWI4_Handler();
+			else
+				TWI1_Handler();
+			mock_current = -1;
+		}
+	}
+}
+
+uint32_t twi_master_init(Twi *p_twi, const twi_options_t *p_opt)
+{
+	uint32_t ckdiv = 0, c_lh_div;
+
+	memset(p_twi, 0, sizeof(*p_twi));
+	p_twi->TWI_SR = TWI_SR_TXCOMP | TWI_SR_TXRDY;
+	mock_twi_flags(p_twi);
+
+	// twi_set_speed()
+	c_lh_div = p_opt->master_clk / (p_opt->speed * 2) - 4;
+	while (c_lh_div > 0xFF && ckdiv < 7)
+	{
+		ckdiv++;
+		c_lh_div /= 2;
+	}
+	p_twi->TWI_CWGR = TWI_CWGR_CLDIV(c_lh_div) | TWI_CWGR_CHDIV(c_lh_div) | TWI_CWGR_CKDIV(ckdiv);
+
+	return TWI_SUCCESS;
+}
+
+uint32_t twi_master_pdc_write_start(Twi *p_twi, twi_packet_t *p_packet)
+{
+	if (p_packet->length == 0)
+		return TWI_INVALID_ARGUMENT;
+
+	twi_master_pdc_disable(p_twi);
+	mock_bus[p_twi == TWI4 ? 0 : 1].thr_full = 0;
+	p_twi->TWI_MMR = TWI_MMR_DADR(p_packet->chip);
+	p_twi->TWI_TPR = (uintptr_t)p_packet->buffer;
+	p_twi->TWI_TCR = p_packet->length - 1;
+	if (p_packet->length > 1)
+		p_twi->TWI_PTSR |= TWI_PTCR_TXTEN;
+	mock_twi_flags(p_twi);
+
+	return TWI_SUCCESS;
+}
+
+uint32_t twi_master_pdc_read_start(Twi *p_twi, twi_packet_t *p_packet)
+{
+	if (p_packet->length == 0)
+		return TWI_INVALID_ARGUMENT;
+
+	twi_master_pdc_disable(p_twi);
+	p_twi->TWI_MMR = TWI_MMR_MREAD | TWI_MMR_DADR(p_packet->chip);
+	if (p_packet->length > 2)
+	{
+		p_twi->TWI_RPR = (uintptr_t)p_packet->buffer;
+		p_twi->TWI_RCR = p_packet->length - 2;
+		p_twi->TWI_PTSR |= TWI_PTCR_RXTEN;
+	}
+	p_twi->TWI_CR = p_packet->length == 1 ? TWI_CR_START | TWI_CR_STOP : TWI_CR_START;
+	mock_twi_flags(p_twi);
+
+	return TWI_SUCCESS;
+}
+
+void twi_master_pdc_disable(Twi *p_twi)
+{
+	p_twi->TWI_PTSR = 0;
+}
+
+void twi_enable_interrupt(Twi *p_twi, uint32_t ul_sources)
+{
+	p_twi->TWI_IMR |= ul_sources;
+}
+
+void twi_disable_interrupt(Twi *p_twi, uint32_t ul_sources)
+{
+	p_twi->TWI_IMR &= ~ul_sources;
+}
+
+uint32_t twi_get_interrupt_status(Twi *p_twi)
+{
+	uint32_t status = p_twi->TWI_SR;
+
+	p_twi->TWI_SR &= ~TWI_SR_NACK;  // clear on read
+	return status;
+}
+
+void twi_reset(Twi *p_twi)
+{
+	memset(p_twi, 0, sizeof(*p_twi));
+}
+
+void flexcom_enable(Flexcom *p_flexcom)
+{
+}
+
+void flexcom_set_opmode(Flexcom *p_flexcom, enum flexcom_opmode opmode)
+{
+	*p_flexcom = opmode;
+}
+
+uint32_t sysclk_get_cpu_hz(void)
+{
+	return MOCK_MCK_HZ;
+}
+
+void ioport_set_pin_level(ioport_pin_t pin, bool level)
+{
+}
+
+void ioport_set_pin_dir(ioport_pin_t pin, enum ioport_direction dir)
+{
+}
+
+void ioport_enable_pin(ioport_pin_t pin)
+{
+}
+
+void ioport_disable_pin(ioport_pin_t pin)
+{
+}
+
+void NVIC_EnableIRQ(IRQn_Type irq)
+{
+	mock_bus[irq == TWI4_IRQn ? 0 : 1].irq_enabled = 1;
+}
+
+void NVIC_DisableIRQ(IRQn_Type irq)
+{
+	mock_bus[irq == TWI4_IRQn ? 0 : 1].irq_enabled = 0;
+}
+
+void NVIC_ClearPendingIRQ(IRQn_Type irq)
+{
+}
+
+/** \brief write and read length bytes on bus 0, check the device got and returned exactly them */
+static int check_transfers(uint32_t length, double *read_s)
+{
+	mock_bus_t *bus = &mock_bus[0];
+	uint8_t data[256];
+	twi_packet_t packet = { .chip = MOCK_SLAVE_ADDRESS >> 1, .addr_length = 0, .buffer = data, .length = length };
+	double start;
+	uint32_t i;
+
+	for (i = 0; i < length; i++)
+	{
+		data[i] = (uint8_t)(i * 7 + length);
+		bus->response[i] = (uint8_t)(i * 13 + length);
+	}
+
+	if (hal_i2c_write(0, &packet) != TWI_SUCCESS || bus->written_len != (int)length || memcmp(bus->written, data, length) != 0)
+		return 0;
+
+	memset(data, 0, sizeof(data));
+	start = now_s();
+	if (hal_i2c_read(0, &packet) != TWI_SUCCESS || bus->read_len != (int)length || memcmp(bus->response, data, length) != 0)
+		return 0;
+	*read_s = now_s() - start;
+
+	return 1;
+}
+
+int main(void)
+{
+	static const uint32_t speeds[] = { 100000, 400000, 1000000 };
+	static const uint32_t lengths[] = { 1, 2, 3, 4, 35, 71, 156, 160 };
+	ATCAIfaceCfg cfg = {
+		.iface_type            = ATCA_I2C_IFACE,
+		.devtype               = ATECC508A,
+		.atcai2c.slave_address = MOCK_SLAVE_ADDRESS,
+		.atcai2c.bus           = 0,
+		.atcai2c.baud          = 100000,
+		.rx_retries            = 1,
+	};
+	ATCAHAL_t hal;
+	uint8_t data[4];
+	twi_packet_t packet = { .chip = MOCK_SLAVE_ADDRESS >> 1, .addr_length = 0, .buffer = data, .length = sizeof(data) };
+	double read_s, long_read_s = 0;
+	uint32_t long_timeout_ms = 0, status;
+	size_t s, l;
+	int transfers = 0;
+
+	if (hal_i2c_init(&hal, &cfg) != ATCA_SUCCESS)
+	{
+		printf("init failed\n");
+		return 1;
+	}
+
+	for (s = 0; s < sizeof(speeds) / sizeof(speeds[0]); s++)
+	{
+		hal_i2c_set_speed(0, speeds[s]);
+		for (l = 0; l < sizeof(lengths) / sizeof(lengths[0]); l++)
+		{
+			if (!check_transfers(lengths[l], &read_s))
+			{
+				printf("%u bytes at %u Hz: transfer failed or wrong\n", (unsigned)lengths[l], (unsigned)speeds[s]);
+				return 1;
+			}
+			transfers += 2;
+		}
+		if (speeds[s] == 100000)
+		{
+			// the longest read, at standard speed
+			long_read_s = read_s;
+			long_timeout_ms = ((160 + 1) * i2c_xfer[0].byte_us + 999) / 1000 + I2C_XFER_MARGIN_MS;
+		}
+	}
+
+	// a busy device NACKs its address, in either direction
+	mock_bus[0].nacks = 2;
+	if (hal_i2c_read(0, &packet) != TWI_RECEIVE_NACK || hal_i2c_write(0, &packet) != TWI_RECEIVE_NACK || !check_transfers(4, &read_s))
+	{
+		printf("NACK not reported\n");
+		return 1;
+	}
+
+	// a transfer that never completes times out, and leaves the bus usable
+	mock_bus[0].hold = 1;
+	if ((status = hal_i2c_read(0, &packet)) != TWI_ERROR_TIMEOUT || !check_transfers(4, &read_s))
+	{
+		printf("stuck transfer: status %u, not timed out or bus not usable after\n", (unsigned)status);
+		return 1;
+	}
+
+	printf("TWI PDC: %d transfers of 1 to 160 bytes at 100 kHz to 1 MHz ok, 160 byte read at 100 kHz %5.2f ms (times out after %u ms)\n",
+	       transfers, long_read_s * 1000, (unsigned)long_timeout_ms);
+
+	hal_i2c_release(hal.hal_data);
+	return 0;
+}
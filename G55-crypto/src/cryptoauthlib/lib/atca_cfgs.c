@@ -99,6 +99,7 @@ ATCAIfaceCfg cfg_ecc508_kitcdc_default = {
 	.atcauart.wordsize = 8,
 	.atcauart.parity = 2,
 	.atcauart.stopbits = 1,
+	.atcauart.device = NULL,
 	.rx_retries = 1,
 };
 
@@ -113,6 +114,30 @@ ATCAIfaceCfg cfg_ecc508_kithid_default = {
 	.atcahid.guid = { 0x4d, 0x1e, 0x55, 0xb2, 0xf1, 0x6f, 0x11, 0xcf, 0x88, 0xcb, 0x00, 0x11, 0x11, 0x00, 0x00, 0x30 },
 };
 
+/** \brief default configuration for an ECCx08A device served by a local process over a Unix domain socket */
+ATCAIfaceCfg cfg_ateccx08a_socket_default = {
+	.iface_type = ATCA_SOCKET_IFACE,
+	.devtype = ATECC508A,
+	.atcasocket.path = "/tmp/atecc508a.sock",
+	.wake_delay = 800,
+	.rx_retries = 20
+};
+
+/** \brief default configuration for an emulated ECCx08A device running in-process, see hal_emu_x08a.c */
+ATCAIfaceCfg cfg_ateccx08a_emu_default = {
+	.iface_type = ATCA_EMU_IFACE,
+	.devtype = ATECC508A,
+	.atcaemu.timing = ATCA_EMU_TIMING_REAL,
+	.atcaemu.time_scale = 100,
+	.atcaemu.seed = 0,
+	.atcaemu.config = NULL,
+	.wake_delay = 800,
+	.rx_retries = 20,
+	.exec_mode = ATCA_EXEC_POLL,
+	.poll_min_ms = 0,
+	.poll_interval_us = 100
+};
+
 /** \brief example of a default configuration for AES132 SPI */
 ATCAIfaceCfg cfg_ataes132_spi_default = {
 	.iface_type = ATCA_SPI_IFACE,
@@ -70,6 +70,12 @@ extern ATCAIfaceCfg cfg_ecc508_kitcdc_default;
 /** \brief default configuration for Kit protocol over a HID interface */
 extern ATCAIfaceCfg cfg_ecc508_kithid_default;
 
+/** \brief default configuration for an ECCx08A device served by a local process over a Unix domain socket */
+extern ATCAIfaceCfg cfg_ateccx08a_socket_default;
+
+/** \brief default configuration for an emulated ECCx08A device running in-process */
+extern ATCAIfaceCfg cfg_ateccx08a_emu_default;
+
 /** \brief example of a default configuration for AES132 SPI */
 extern ATCAIfaceCfg cfg_ataes132_spi_default;
 
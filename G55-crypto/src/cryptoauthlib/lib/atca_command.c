@@ -59,7 +59,8 @@
  */
 struct atca_command {
 	ATCADeviceType dt;
-	uint16_t *execution_times;
+	const uint16_t *execution_times;
+	ATCAExecModel exec_model[CMD_LASTCOMMAND];	// execution times learned from this device
 };
 
 
@@ -72,6 +73,7 @@ ATCACommand newATCACommand( ATCADeviceType device_type )  // constructor
 	ATCACommand cacmd = (ATCACommand)malloc(sizeof(struct atca_command));
 	cacmd->dt = device_type;
 	atInitExecTimes(cacmd, device_type);  // setup typical execution times for this device type
+	atResetExecModel(cacmd);
 	return cacmd;
 }
 
@@ -401,8 +403,9 @@ ATCA_STATUS atSHA( ATCACommand cacmd, ATCAPacket *packet )
 		packet->txsize = SHA_COUNT_LONG + SHA_DATA_MAX;
 		break;
 	case 0x02:
+		// the end command may carry the last partial block of the message, param2 bytes of it
 		packet->rxsize = SHA_RSP_SIZE_LONG;
-		packet->txsize = SHA_COUNT_LONG;
+		packet->txsize = SHA_COUNT_LONG + packet->param2;
 		break;
 	}
 	
@@ -540,9 +543,14 @@ void deleteATCACommand( ATCACommand *cacmd )  // destructor
 }
 
 
+#define ATCA_EXEC_EWMA_SHIFT	(3)	// EWMA weight of a new sample, 1/8
+#define ATCA_EXEC_PROBE_SHIFT	(4)	// on-time responses probe the average down by 1/16
+#define ATCA_EXEC_DECAY_SHIFT	(4)	// on-time responses shrink the guard by 1/16
+#define ATCA_EXEC_GUARD_SHIFT	(3)	// initial guard is 1/8 of the first observation
+
 /** \brief execution times for x08a family, these are based on the typical value from the datasheet
  */
-uint16_t exectimes_x08a[] = {  // in milleseconds
+const uint16_t exectimes_x08a[] = {  // in milleseconds
 	1,   // WAKE_TWHI
 	13,   // CMD_CHECKMAC
 	20,   // CMD_COUNTER
@@ -569,7 +577,7 @@ uint16_t exectimes_x08a[] = {  // in milleseconds
 	
 /** \brief execution times for 204a, these are based on the typical value from the datasheet
  */
-uint16_t exectimes_204a[] = {
+const uint16_t exectimes_204a[] = {
 	3,	// WAKE_TWHI
 	38,	// CMD_CHECKMAC
 	0,	
@@ -630,6 +638,309 @@ uint16_t atGetExecTime( ATCACommand cacmd, ATCA_CmdMap cmd )
 	return cacmd->execution_times[cmd];
 }
 
+/** \brief return the time after which the device is expected to have completed the given command,
+ *  based on what has been learned from this device so far.  This never exceeds the execution time
+ *  from the device type table.
+ *
+ * \param[in] cacmd the command object for which the execution times are associated
+ * \param[in] cmd - the specific command for which to lookup the execution time
+ * \return learned execution time in microseconds, 0 if nothing has been learned for this command yet
+ */
+
+uint32_t atGetLearnedExecTime( ATCACommand cacmd, ATCA_CmdMap cmd )
+{
+	ATCAExecModel *model = &cacmd->exec_model[cmd];
+	uint32_t max_us = (uint32_t)cacmd->execution_times[cmd] * 1000;
+	uint32_t learned_us = model->avg_us + model->guard_us;
+
+	if ( model->samples == 0 )
+		return 0;
+
+	return learned_us < max_us ? learned_us : max_us;
+}
+
+/** \brief feed an observed completion time into the execution time model of a command.
+ *
+ *  The model is an EWMA of the completion time plus a tail guard.  When the device responded to the
+ *  first poll (early == false) the completion time is only an upper bound, so the average is probed
+ *  slightly downwards and the guard decays.  When the first poll was too early the completion time is
+ *  accurate to within one poll interval; it goes into the average and the guard is widened by the miss.
+ *
+ * \param[in] cacmd the command object for which the execution times are associated
+ * \param[in] cmd - the command that completed
+ * \param[in] completion_us - time from sending the command until the response was received
+ * \param[in] early - true if the device was still busy when first polled
+ */
+
+void atUpdateExecTime( ATCACommand cacmd, ATCA_CmdMap cmd, uint32_t completion_us, bool early )
+{
+	ATCAExecModel *model = &cacmd->exec_model[cmd];
+	uint32_t predicted_us = model->avg_us + model->guard_us;
+	uint32_t sample_us;
+
+	if ( model->samples == 0 )
+	{
+		model->avg_us = completion_us;
+		model->guard_us = completion_us >> ATCA_EXEC_GUARD_SHIFT;
+	}
+	else
+	{
+		if ( early )
+		{
+			sample_us = completion_us;
+			if ( completion_us > predicted_us )
+				model->guard_us += completion_us - predicted_us;
+		}
+		else
+		{
+			sample_us = model->avg_us - (model->avg_us >> ATCA_EXEC_PROBE_SHIFT);
+			model->guard_us -= model->guard_us >> ATCA_EXEC_DECAY_SHIFT;
+		}
+
+		if ( sample_us > model->avg_us )
+			model->avg_us += (sample_us - model->avg_us) >> ATCA_EXEC_EWMA_SHIFT;
+		else
+			model->avg_us -= (model->avg_us - sample_us) >> ATCA_EXEC_EWMA_SHIFT;
+	}
+
+	// never plan past the worst case, the guard would only grow without bound on a stuck device
+	if ( model->guard_us > (uint32_t)cacmd->execution_times[cmd] * 1000 )
+		model->guard_us = (uint32_t)cacmd->execution_times[cmd] * 1000;
+
+	if ( model->samples < 0xFFFF )
+		model->samples++;
+}
+
+/** \brief read the learned execution time model of a command, e.g. to save it across resets
+ *
+ * \param[in] cacmd the command object for which the execution times are associated
+ * \param[in] cmd - the specific command to get the model for
+ * \param[out] model - receives the learned model
+ * \return ATCA_STATUS
+ */
+
+ATCA_STATUS atGetExecModel( ATCACommand cacmd, ATCA_CmdMap cmd, ATCAExecModel *model )
+{
+	if ( cmd >= CMD_LASTCOMMAND || model == NULL )
+		return ATCA_BAD_PARAM;
+
+	*model = cacmd->exec_model[cmd];
+	return ATCA_SUCCESS;
+}
+
+/** \brief load a previously saved execution time model for a command
+ *
+ * \param[in] cacmd the command object for which the execution times are associated
+ * \param[in] cmd - the specific command to set the model for
+ * \param[in] model - model to load
+ * \return ATCA_STATUS
+ */
+
+ATCA_STATUS atSetExecModel( ATCACommand cacmd, ATCA_CmdMap cmd, const ATCAExecModel *model )
+{
+	if ( cmd >= CMD_LASTCOMMAND || model == NULL )
+		return ATCA_BAD_PARAM;
+
+	cacmd->exec_model[cmd] = *model;
+	return ATCA_SUCCESS;
+}
+
+/** \brief forget everything learned about the execution times of the device
+ *
+ * \param[in] cacmd the command object for which the execution times are associated
+ */
+
+void atResetExecModel( ATCACommand cacmd )
+{
+	memset( cacmd->exec_model, 0, sizeof(cacmd->exec_model) );
+}
+
+
+/** \brief CRC-16 lookup tables.  The device CRC (polynomial 0x8005, data bits taken LSB first) is the
+ *  bit reversed CRC-16 with the reflected polynomial 0xA001, so the tables are built for the reflected
+ *  form and the register is reversed once on the way in and out.  atca_crc16_table[0] is the byte-wise
+ *  table, atca_crc16_table[k] advances a byte followed by k zero bytes for the slice-by-4 loop.  The
+ *  tables are const so they stay in flash on target, define ATCA_CRC_BYTEWISE to only link the first.
+ */
+#ifdef ATCA_CRC_BYTEWISE
+static const uint16_t atca_crc16_table[1][256] = {
+#else
+static const uint16_t atca_crc16_table[4][256] = {
+#endif
+	{
+		0x0000, 0xC0C1, 0xC181, 0x0140, 0xC301, 0x03C0, 0x0280, 0xC241,
+		0xC601, 0x06C0, 0x0780, 0xC741, 0x0500, 0xC5C1, 0xC481, 0x0440,
+		0xCC01, 0x0CC0, 0x0D80, 0xCD41, 0x0F00, 0xCFC1, 0xCE81, 0x0E40,
+		0x0A00, 0xCAC1, 0xCB81, 0x0B40, 0xC901, 0x09C0, 0x0880, 0xC841,
+		0xD801, 0x18C0, 0x1980, 0xD941, 0x1B00, 0xDBC1, 0xDA81, 0x1A40,
+		0x1E00, 0xDEC1, 0xDF81, 0x1F40, 0xDD01, 0x1DC0, 0x1C80, 0xDC41,
+		0x1400, 0xD4C1, 0xD581, 0x1540, 0xD701, 0x17C0, 0x1680, 0xD641,
+		0xD201, 0x12C0, 0x1380, 0xD341, 0x1100, 0xD1C1, 0xD081, 0x1040,
+		0xF001, 0x30C0, 0x3180, 0xF141, 0x3300, 0xF3C1, 0xF281, 0x3240,
+		0x3600, 0xF6C1, 0xF781, 0x3740, 0xF501, 0x35C0, 0x3480, 0xF441,
+		0x3C00, 0xFCC1, 0xFD81, 0x3D40, 0xFF01, 0x3FC0, 0x3E80, 0xFE41,
+		0xFA01, 0x3AC0, 0x3B80, 0xFB41, 0x3900, 0xF9C1, 0xF881, 0x3840,
+		0x2800, 0xE8C1, 0xE981, 0x2940, 0xEB01, 0x2BC0, 0x2A80, 0xEA41,
+		0xEE01, 0x2EC0, 0x2F80, 0xEF41, 0x2D00, 0xEDC1, 0xEC81, 0x2C40,
+		0xE401, 0x24C0, 0x2580, 0xE541, 0x2700, 0xE7C1, 0xE681, 0x2640,
+		0x2200, 0xE2C1, 0xE381, 0x2340, 0xE101, 0x21C0, 0x2080, 0xE041,
+		0xA001, 0x60C0, 0x6180, 0xA141, 0x6300, 0xA3C1, 0xA281, 0x6240,
+		0x6600, 0xA6C1, 0xA781, 0x6740, 0xA501, 0x65C0, 0x6480, 0xA441,
+		0x6C00, 0xACC1, 0xAD81, 0x6D40, 0xAF01, 0x6FC0, 0x6E80, 0xAE41,
+		0xAA01, 0x6AC0, 0x6B80, 0xAB41, 0x6900, 0xA9C1, 0xA881, 0x6840,
+		0x7800, 0xB8C1, 0xB981, 0x7940, 0xBB01, 0x7BC0, 0x7A80, 0xBA41,
+		0xBE01, 0x7EC0, 0x7F80, 0xBF41, 0x7D00, 0xBDC1, 0xBC81, 0x7C40,
+		0xB401, 0x74C0, 0x7580, 0xB541, 0x7700, 0xB7C1, 0xB681, 0x7640,
+		0x7200, 0xB2C1, 0xB381, 0x7340, 0xB101, 0x71C0, 0x7080, 0xB041,
+		0x5000, 0x90C1, 0x9181, 0x5140, 0x9301, 0x53C0, 0x5280, 0x9241,
+		0x9601, 0x56C0, 0x5780, 0x9741, 0x5500, 0x95C1, 0x9481, 0x5440,
+		0x9C01, 0x5CC0, 0x5D80, 0x9D41, 0x5F00, 0x9FC1, 0x9E81, 0x5E40,
+		0x5A00, 0x9AC1, 0x9B81, 0x5B40, 0x9901, 0x59C0, 0x5880, 0x9841,
+		0x8801, 0x48C0, 0x4980, 0x8941, 0x4B00, 0x8BC1, 0x8A81, 0x4A40,
+		0x4E00, 0x8EC1, 0x8F81, 0x4F40, 0x8D01, 0x4DC0, 0x4C80, 0x8C41,
+		0x4400, 0x84C1, 0x8581, 0x4540, 0x8701, 0x47C0, 0x4680, 0x8641,
+		0x8201, 0x42C0, 0x4380, 0x8341, 0x4100, 0x81C1, 0x8081, 0x4040,
+	},
+#ifndef ATCA_CRC_BYTEWISE
+	{
+		0x0000, 0x9001, 0x6001, 0xF000, 0xC002, 0x5003, 0xA003, 0x3002,
+		0xC007, 0x5006, 0xA006, 0x3007, 0x0005, 0x9004, 0x6004, 0xF005,
+		0xC00D, 0x500C, 0xA00C, 0x300D, 0x000F, 0x900E, 0x600E, 0xF00F,
+		0x000A, 0x900B, 0x600B, 0xF00A, 0xC008, 0x5009, 0xA009, 0x3008,
+		0xC019, 0x5018, 0xA018, 0x3019, 0x001B, 0x901A, 0x601A, 0xF01B,
+		0x001E, 0x901F, 0x601F, 0xF01E, 0xC01C, 0x501D, 0xA01D, 0x301C,
+		0x0014, 0x9015, 0x6015, 0xF014, 0xC016, 0x5017, 0xA017, 0x3016,
+		0xC013, 0x5012, 0xA012, 0x3013, 0x0011, 0x9010, 0x6010, 0xF011,
+		0xC031, 0x5030, 0xA030, 0x3031, 0x0033, 0x9032, 0x6032, 0xF033,
+		0x0036, 0x9037, 0x6037, 0xF036, 0xC034, 0x5035, 0xA035, 0x3034,
+		0x003C, 0x903D, 0x603D, 0xF03C, 0xC03E, 0x503F, 0xA03F, 0x303E,
+		0xC03B, 0x503A, 0xA03A, 0x303B, 0x0039, 0x9038, 0x6038, 0xF039,
+		0x0028, 0x9029, 0x6029, 0xF028, 0xC02A, 0x502B, 0xA02B, 0x302A,
+		0xC02F, 0x502E, 0xA02E, 0x302F, 0x002D, 0x902C, 0x602C, 0xF02D,
+		0xC025, 0x5024, 0xA024, 0x3025, 0x0027, 0x9026, 0x6026, 0xF027,
+		0x0022, 0x9023, 0x6023, 0xF022, 0xC020, 0x5021, 0xA021, 0x3020,
+		0xC061, 0x5060, 0xA060, 0x3061, 0x0063, 0x9062, 0x6062, 0xF063,
+		0x0066, 0x9067, 0x6067, 0xF066, 0xC064, 0x5065, 0xA065, 0x3064,
+		0x006C, 0x906D, 0x606D, 0xF06C, 0xC06E, 0x506F, 0xA06F, 0x306E,
+		0xC06B, 0x506A, 0xA06A, 0x306B, 0x0069, 0x9068, 0x6068, 0xF069,
+		0x0078, 0x9079, 0x6079, 0xF078, 0xC07A, 0x507B, 0xA07B, 0x307A,
+		0xC07F, 0x507E, 0xA07E, 0x307F, 0x007D, 0x907C, 0x607C, 0xF07D,
+		0xC075, 0x5074, 0xA074, 0x3075, 0x0077, 0x9076, 0x6076, 0xF077,
+		0x0072, 0x9073, 0x6073, 0xF072, 0xC070, 0x5071, 0xA071, 0x3070,
+		0x0050, 0x9051, 0x6051, 0xF050, 0xC052, 0x5053, 0xA053, 0x3052,
+		0xC057, 0x5056, 0xA056, 0x3057, 0x0055, 0x9054, 0x6054, 0xF055,
+		0xC05D, 0x505C, 0xA05C, 0x305D, 0x005F, 0x905E, 0x605E, 0xF05F,
+		0x005A, 0x905B, 0x605B, 0xF05A, 0xC058, 0x5059, 0xA059, 0x3058,
+		0xC049, 0x5048, 0xA048, 0x3049, 0x004B, 0x904A, 0x604A, 0xF04B,
+		0x004E, 0x904F, 0x604F, 0xF04E, 0xC04C, 0x504D, 0xA04D, 0x304C,
+		0x0044, 0x9045, 0x6045, 0xF044, 0xC046, 0x5047, 0xA047, 0x3046,
+		0xC043, 0x5042, 0xA042, 0x3043, 0x0041, 0x9040, 0x6040, 0xF041,
+	},
+	{
+		0x0000, 0xC051, 0xC0A1, 0x00F0, 0xC141, 0x0110, 0x01E0, 0xC1B1,
+		0xC281, 0x02D0, 0x0220, 0xC271, 0x03C0, 0xC391, 0xC361, 0x0330,
+		0xC501, 0x0550, 0x05A0, 0xC5F1, 0x0440, 0xC411, 0xC4E1, 0x04B0,
+		0x0780, 0xC7D1, 0xC721, 0x0770, 0xC6C1, 0x0690, 0x0660, 0xC631,
+		0xCA01, 0x0A50, 0x0AA0, 0xCAF1, 0x0B40, 0xCB11, 0xCBE1, 0x0BB0,
+		0x0880, 0xC8D1, 0xC821, 0x0870, 0xC9C1, 0x0990, 0x0960, 0xC931,
+		0x0F00, 0xCF51, 0xCFA1, 0x0FF0, 0xCE41, 0x0E10, 0x0EE0, 0xCEB1,
+		0xCD81, 0x0DD0, 0x0D20, 0xCD71, 0x0CC0, 0xCC91, 0xCC61, 0x0C30,
+		0xD401, 0x1450, 0x14A0, 0xD4F1, 0x1540, 0xD511, 0xD5E1, 0x15B0,
+		0x1680, 0xD6D1, 0xD621, 0x1670, 0xD7C1, 0x1790, 0x1760, 0xD731,
+		0x1100, 0xD151, 0xD1A1, 0x11F0, 0xD041, 0x1010, 0x10E0, 0xD0B1,
+		0xD381, 0x13D0, 0x1320, 0xD371, 0x12C0, 0xD291, 0xD261, 0x1230,
+		0x1E00, 0xDE51, 0xDEA1, 0x1EF0, 0xDF41, 0x1F10, 0x1FE0, 0xDFB1,
+		0xDC81, 0x1CD0, 0x1C20, 0xDC71, 0x1DC0, 0xDD91, 0xDD61, 0x1D30,
+		0xDB01, 0x1B50, 0x1BA0, 0xDBF1, 0x1A40, 0xDA11, 0xDAE1, 0x1AB0,
+		0x1980, 0xD9D1, 0xD921, 0x1970, 0xD8C1, 0x1890, 0x1860, 0xD831,
+		0xE801, 0x2850, 0x28A0, 0xE8F1, 0x2940, 0xE911, 0xE9E1, 0x29B0,
+		0x2A80, 0xEAD1, 0xEA21, 0x2A70, 0xEBC1, 0x2B90, 0x2B60, 0xEB31,
+		0x2D00, 0xED51, 0xEDA1, 0x2DF0, 0xEC41, 0x2C10, 0x2CE0, 0xECB1,
+		0xEF81, 0x2FD0, 0x2F20, 0xEF71, 0x2EC0, 0xEE91, 0xEE61, 0x2E30,
+		0x2200, 0xE251, 0xE2A1, 0x22F0, 0xE341, 0x2310, 0x23E0, 0xE3B1,
+		0xE081, 0x20D0, 0x2020, 0xE071, 0x21C0, 0xE191, 0xE161, 0x2130,
+		0xE701, 0x2750, 0x27A0, 0xE7F1, 0x2640, 0xE611, 0xE6E1, 0x26B0,
+		0x2580, 0xE5D1, 0xE521, 0x2570, 0xE4C1, 0x2490, 0x2460, 0xE431,
+		0x3C00, 0xFC51, 0xFCA1, 0x3CF0, 0xFD41, 0x3D10, 0x3DE0, 0xFDB1,
+		0xFE81, 0x3ED0, 0x3E20, 0xFE71, 0x3FC0, 0xFF91, 0xFF61, 0x3F30,
+		0xF901, 0x3950, 0x39A0, 0xF9F1, 0x3840, 0xF811, 0xF8E1, 0x38B0,
+		0x3B80, 0xFBD1, 0xFB21, 0x3B70, 0xFAC1, 0x3A90, 0x3A60, 0xFA31,
+		0xF601, 0x3650, 0x36A0, 0xF6F1, 0x3740, 0xF711, 0xF7E1, 0x37B0,
+		0x3480, 0xF4D1, 0xF421, 0x3470, 0xF5C1, 0x3590, 0x3560, 0xF531,
+		0x3300, 0xF351, 0xF3A1, 0x33F0, 0xF241, 0x3210, 0x32E0, 0xF2B1,
+		0xF181, 0x31D0, 0x3120, 0xF171, 0x30C0, 0xF091, 0xF061, 0x3030,
+	},
+	{
+		0x0000, 0xFC01, 0xB801, 0x4400, 0x3001, 0xCC00, 0x8800, 0x7401,
+		0x6002, 0x9C03, 0xD803, 0x2402, 0x5003, 0xAC02, 0xE802, 0x1403,
+		0xC004, 0x3C05, 0x7805, 0x8404, 0xF005, 0x0C04, 0x4804, 0xB405,
+		0xA006, 0x5C07, 0x1807, 0xE406, 0x9007, 0x6C06, 0x2806, 0xD407,
+		0xC00B, 0x3C0A, 0x780A, 0x840B, 0xF00A, 0x0C0B, 0x480B, 0xB40A,
+		0xA009, 0x5C08, 0x1808, 0xE409, 0x9008, 0x6C09, 0x2809, 0xD408,
+		0x000F, 0xFC0E, 0xB80E, 0x440F, 0x300E, 0xCC0F, 0x880F, 0x740E,
+		0x600D, 0x9C0C, 0xD80C, 0x240D, 0x500C, 0xAC0D, 0xE80D, 0x140C,
+		0xC015, 0x3C14, 0x7814, 0x8415, 0xF014, 0x0C15, 0x4815, 0xB414,
+		0xA017, 0x5C16, 0x1816, 0xE417, 0x9016, 0x6C17, 0x2817, 0xD416,
+		0x0011, 0xFC10, 0xB810, 0x4411, 0x3010, 0xCC11, 0x8811, 0x7410,
+		0x6013, 0x9C12, 0xD812, 0x2413, 0x5012, 0xAC13, 0xE813, 0x1412,
+		0x001E, 0xFC1F, 0xB81F, 0x441E, 0x301F, 0xCC1E, 0x881E, 0x741F,
+		0x601C, 0x9C1D, 0xD81D, 0x241C, 0x501D, 0xAC1C, 0xE81C, 0x141D,
+		0xC01A, 0x3C1B, 0x781B, 0x841A, 0xF01B, 0x0C1A, 0x481A, 0xB41B,
+		0xA018, 0x5C19, 0x1819, 0xE418, 0x9019, 0x6C18, 0x2818, 0xD419,
+		0xC029, 0x3C28, 0x7828, 0x8429, 0xF028, 0x0C29, 0x4829, 0xB428,
+		0xA02B, 0x5C2A, 0x182A, 0xE42B, 0x902A, 0x6C2B, 0x282B, 0xD42A,
+		0x002D, 0xFC2C, 0xB82C, 0x442D, 0x302C, 0xCC2D, 0x882D, 0x742C,
+		0x602F, 0x9C2E, 0xD82E, 0x242F, 0x502E, 0xAC2F, 0xE82F, 0x142E,
+		0x0022, 0xFC23, 0xB823, 0x4422, 0x3023, 0xCC22, 0x8822, 0x7423,
+		0x6020, 0x9C21, 0xD821, 0x2420, 0x5021, 0xAC20, 0xE820, 0x1421,
+		0xC026, 0x3C27, 0x7827, 0x8426, 0xF027, 0x0C26, 0x4826, 0xB427,
+		0xA024, 0x5C25, 0x1825, 0xE424, 0x9025, 0x6C24, 0x2824, 0xD425,
+		0x003C, 0xFC3D, 0xB83D, 0x443C, 0x303D, 0xCC3C, 0x883C, 0x743D,
+		0x603E, 0x9C3F, 0xD83F, 0x243E, 0x503F, 0xAC3E, 0xE83E, 0x143F,
+		0xC038, 0x3C39, 0x7839, 0x8438, 0xF039, 0x0C38, 0x4838, 0xB439,
+		0xA03A, 0x5C3B, 0x183B, 0xE43A, 0x903B, 0x6C3A, 0x283A, 0xD43B,
+		0xC037, 0x3C36, 0x7836, 0x8437, 0xF036, 0x0C37, 0x4837, 0xB436,
+		0xA035, 0x5C34, 0x1834, 0xE435, 0x9034, 0x6C35, 0x2835, 0xD434,
+		0x0033, 0xFC32, 0xB832, 0x4433, 0x3032, 0xCC33, 0x8833, 0x7432,
+		0x6031, 0x9C30, 0xD830, 0x2431, 0x5030, 0xAC31, 0xE831, 0x1430,
+	},
+#endif
+};
+
+/** \brief reverse the bits of the CRC register, between the device form and the reflected form the tables use */
+static uint16_t atCRCReflect(uint16_t crc)
+{
+	crc = ((crc >> 1) & 0x5555) | ((crc & 0x5555) << 1);
+	crc = ((crc >> 2) & 0x3333) | ((crc & 0x3333) << 2);
+	crc = ((crc >> 4) & 0x0F0F) | ((crc & 0x0F0F) << 4);
+	return (uint16_t)((crc >> 8) | (crc << 8));
+}
+
+/** \brief continue a CRC over more data.  Start from 0, feeding data in pieces gives the same CRC as
+ *  feeding it at once.  The result is the CRC register, the low byte goes on the wire first.
+ * \param[in] crc - CRC of the data before this piece, 0 to start
+ * \param[in] data - pointer to the data
+ * \param[in] length - number of bytes
+ * \return CRC of all the data so far
+ */
+uint16_t atCRCUpdate( uint16_t crc, const uint8_t *data, size_t length )
+{
+	uint16_t reg = atCRCReflect(crc);
+
+#ifndef ATCA_CRC_BYTEWISE
+	// slice-by-4: one lookup per byte, but the four lookups of a word don't depend on each other
+	for (; length >= 4; length -= 4, data += 4)
+	{
+		reg ^= (uint16_t)(data[0] | (data[1] << 8));
+		reg = atca_crc16_table[3][reg & 0xFF] ^ atca_crc16_table[2][reg >> 8]
+		    ^ atca_crc16_table[1][data[2]] ^ atca_crc16_table[0][data[3]];
+	}
+#endif
+	while (length-- > 0)
+		reg = (reg >> 8) ^ atca_crc16_table[0][(reg ^ *data++) & 0xFF];
+
+	return atCRCReflect(reg);
+}
 
 /** \brief This function calculates CRC given raw data, puts the CRC to given pointer
  *
@@ -640,25 +951,62 @@ uint16_t atGetExecTime( ATCACommand cacmd, ATCA_CmdMap cmd )
 
 void atCRC(	uint8_t length, uint8_t *data, uint8_t *crc)
 {
-	uint8_t counter;
-	uint16_t crc_register = 0;
-	uint16_t polynom = 0x8005;
-	uint8_t shift_register;
-	uint8_t data_bit, crc_bit;
-
-	for (counter = 0; counter < length; counter++) {
-		for (shift_register = 0x01; shift_register > 0x00; shift_register <<= 1) {
-			data_bit = (data[counter] & shift_register) ? 1 : 0;
-			crc_bit = crc_register >> 15;
-			crc_register <<= 1;
-			if (data_bit != crc_bit)
-			crc_register ^= polynom;
-		}
-	}
+	uint16_t crc_register = atCRCUpdate(0, data, length);
+
 	crc[0] = (uint8_t) (crc_register & 0x00FF);
 	crc[1] = (uint8_t) (crc_register >> 8);
 }
 
+/** \brief start checking the CRC of a response that is received in pieces
+ * \param[out] stream - check state
+ */
+void atCRCStreamStart( ATCACrcStream *stream )
+{
+	memset(stream, 0, sizeof(ATCACrcStream));
+}
+
+/** \brief feed the next received bytes of a response to a CRC check started with atCRCStreamStart().
+ *  The count byte tells where the response ends, bytes fed past it are ignored.
+ * \param[inout] stream - check state
+ * \param[in] data - bytes received
+ * \param[in] length - number of bytes
+ * \return ATCA_RX_NO_RESPONSE while the response is incomplete, then ATCA_SUCCESS or ATCA_BAD_CRC.
+ *         ATCA_INVALID_SIZE if the count byte is too small for a response.
+ */
+ATCA_STATUS atCRCStreamFeed( ATCACrcStream *stream, const uint8_t *data, size_t length )
+{
+	size_t run;
+
+	if (stream->received == 0 && length > 0)
+	{
+		stream->count = data[ATCA_COUNT_IDX];
+		if (stream->count < ATCA_RSP_SIZE_MIN)
+			return ATCA_INVALID_SIZE;
+	}
+	if (stream->count == 0)
+		return ATCA_RX_NO_RESPONSE;
+
+	// everything up to the CRC field goes into the CRC
+	if (stream->received < stream->count - ATCA_CRC_SIZE)
+	{
+		run = stream->count - ATCA_CRC_SIZE - stream->received;
+		if (run > length)
+			run = length;
+		stream->crc = atCRCUpdate(stream->crc, data, run);
+		stream->received += (uint8_t)run;
+		data += run;
+		length -= run;
+	}
+
+	for (; length > 0 && stream->received < stream->count; length--, stream->received++)
+		stream->rx_crc[stream->received - (stream->count - ATCA_CRC_SIZE)] = *data++;
+
+	if (stream->received < stream->count)
+		return ATCA_RX_NO_RESPONSE;
+
+	return (stream->rx_crc[0] == (uint8_t)(stream->crc & 0xFF) && stream->rx_crc[1] == (uint8_t)(stream->crc >> 8)) ? ATCA_SUCCESS : ATCA_BAD_CRC;
+}
+
 
 /** \brief This function calculates CRC and adds it to the correct offset in the packet data
  * \param[in] ATCAPacket * 
@@ -666,14 +1014,14 @@ void atCRC(	uint8_t length, uint8_t *data, uint8_t *crc)
 
 void atCalcCrc( ATCAPacket *packet )
 {
-	uint8_t length, *crc;
+	uint8_t length, *frame;
 
 	length = packet->txsize - ATCA_CRC_SIZE;
-	// computer pointer to CRC in the packet
-	crc = &(packet->txsize) + length;  
+	// the frame starts at txsize, address it from the packet base rather than off the one byte member
+	frame = (uint8_t*)packet + offsetof(ATCAPacket, txsize);
 	
 	// stuff CRC into packet
-	atCRC(length, &(packet->txsize), crc);
+	atCRC(length, frame, frame + length);
 }
 
 
@@ -684,13 +1032,10 @@ void atCalcCrc( ATCAPacket *packet )
 
 uint8_t atCheckCrc(uint8_t *response)
 {
-	uint8_t crc[ATCA_CRC_SIZE];
-	uint8_t count = response[ATCA_COUNT_IDX];
+	ATCACrcStream stream;
 
-	count -= ATCA_CRC_SIZE;
-	atCRC(count, response, crc);
-
-	return (crc[0] == response[count] && crc[1] == response[count + 1]) ? ATCA_SUCCESS : ATCA_BAD_CRC;
+	atCRCStreamStart(&stream);
+	return atCRCStreamFeed(&stream, response, response[ATCA_COUNT_IDX]) == ATCA_SUCCESS ? ATCA_SUCCESS : ATCA_BAD_CRC;
 }
 
 
@@ -757,6 +1102,9 @@ ATCA_STATUS isATCAError( uint8_t *data )
 		case 0x11: // chip was successfully woken up
 			return ATCA_WAKE_SUCCESS;
 			break;
+		case 0xee: // watchdog is about to expire, the command wasn't executed
+			return ATCA_STATUS_WATCHDOG;
+			break;
 		case 0xff: // bad crc found or other comm error
 			return ATCA_STATUS_CRC;
 			break;	
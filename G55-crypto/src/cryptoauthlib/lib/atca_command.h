@@ -46,6 +46,7 @@
 #ifndef ATCA_COMMAND_H
 #define ATCA_COMMAND_H
 
+#include <stddef.h>
 #include "atca_compiler.h"
 #include "atca_status.h"
 #include "atca_devtypes.h"
@@ -162,14 +163,41 @@ typedef enum {
 	CMD_LASTCOMMAND  // placeholder
 } ATCA_CmdMap;
 
+extern const uint16_t exectimes_x08a[];	// milliseconds, indexed by ATCA_CmdMap
+
+/** \brief execution time learned for one command on one device.  The device is first polled for its
+ *  response after avg_us + guard_us, see atUpdateExecTime() for how these are maintained.
+ */
+typedef struct {
+	uint32_t avg_us;	// exponentially weighted moving average of the observed completion time
+	uint32_t guard_us;	// tail guard on top of the average, widened whenever a poll comes too early
+	uint16_t samples;	// number of observations, 0 if nothing has been learned yet
+} ATCAExecModel;
+
 ATCA_STATUS atInitExecTimes(ATCACommand cacmd, ATCADeviceType device_type);
 uint16_t atGetExecTime( ATCACommand cacmd, ATCA_CmdMap cmd );
+uint32_t atGetLearnedExecTime( ATCACommand cacmd, ATCA_CmdMap cmd );
+void atUpdateExecTime( ATCACommand cacmd, ATCA_CmdMap cmd, uint32_t completion_us, bool early );
+ATCA_STATUS atGetExecModel( ATCACommand cacmd, ATCA_CmdMap cmd, ATCAExecModel *model );
+ATCA_STATUS atSetExecModel( ATCACommand cacmd, ATCA_CmdMap cmd, const ATCAExecModel *model );
+void atResetExecModel( ATCACommand cacmd );
 
 void deleteATCACommand( ATCACommand * );      // destructor
 /*---- end of ATCACommand ----*/
 
+/** \brief state of a response CRC check fed as the response arrives, see atCRCStreamFeed() */
+typedef struct {
+	uint16_t crc;			// CRC of the bytes received before the CRC field
+	uint8_t  count;			// count byte of the response, 0 until it was received
+	uint8_t  received;		// number of bytes of the response received so far
+	uint8_t  rx_crc[2];		// CRC field as received
+} ATCACrcStream;
+
 // command helpers
 void atCRC(	uint8_t length, uint8_t *data, uint8_t *crc);
+uint16_t atCRCUpdate( uint16_t crc, const uint8_t *data, size_t length );
+void atCRCStreamStart( ATCACrcStream *stream );
+ATCA_STATUS atCRCStreamFeed( ATCACrcStream *stream, const uint8_t *data, size_t length );
 void atCalcCrc( ATCAPacket *pkt);
 uint8_t atCheckCrc(uint8_t *response);
 
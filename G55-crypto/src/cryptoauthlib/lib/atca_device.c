@@ -51,6 +51,8 @@
 struct atca_device {
     ATCACommand mCommands; // has-a command set to support a given CryptoAuth device
 	ATCAIface   mIface;    // has-a physical interface
+	void       *mBasicData; // per-device state of the Basic API, owned by the device
+	void      (*mBasicRelease)(void *data);	// gives mBasicData back when the device is deleted
 };
 
 /** \brief constructor for an Atmel CryptoAuth device
@@ -63,6 +65,8 @@ ATCADevice newATCADevice(ATCAIfaceCfg *cfg )
 	ATCADevice cadev = (ATCADevice)malloc(sizeof(struct atca_device));
 	cadev->mCommands = (ATCACommand)newATCACommand(cfg->devtype);
 	cadev->mIface    = (ATCAIface)newATCAIface(cfg);
+	cadev->mBasicData = NULL;
+	cadev->mBasicRelease = NULL;
 
     if (cadev->mCommands == NULL || cadev->mIface == NULL)
     {
@@ -92,6 +96,26 @@ ATCAIface atGetIFace( ATCADevice dev )
 	return dev->mIface;
 }
 
+/** \brief returns the Basic API state attached to the device
+ * \param[in] reference to a device
+ * \return Basic API state, NULL if none was attached yet
+ */
+void *atGetBasicData( ATCADevice dev )
+{
+	return dev->mBasicData;
+}
+
+/** \brief attaches Basic API state to the device, the device gives it back when it's deleted
+ * \param[in] reference to a device
+ * \param[in] Basic API state
+ * \param[in] release - called with the state when the device is deleted, free for a malloc'd state
+ */
+void atSetBasicData( ATCADevice dev, void *data, void (*release)(void *data) )
+{
+	dev->mBasicData = data;
+	dev->mBasicRelease = release;
+}
+
 /** \brief destructor for a device NULLs reference after object is freed
  * \param[in] pointer to a reference to a device
  * 
@@ -104,6 +128,8 @@ void deleteATCADevice( ATCADevice *cadev ) // destructor
 	if ( *cadev ) {
 		deleteATCACommand( (ATCACommand *)&(dev->mCommands));
 		deleteATCAIface((ATCAIface *)&(dev->mIface));
+		if ( dev->mBasicData && dev->mBasicRelease )
+			dev->mBasicRelease(dev->mBasicData);
 		free((void*)*cadev);
 	}
 		
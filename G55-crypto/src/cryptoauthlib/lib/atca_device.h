@@ -59,6 +59,8 @@ ATCADevice newATCADevice(ATCAIfaceCfg *cfg );  // constructor
 /* member functions here */
 ATCACommand atGetCommands( ATCADevice dev );
 ATCAIface atGetIFace( ATCADevice dev );
+void *atGetBasicData( ATCADevice dev );
+void atSetBasicData( ATCADevice dev, void *data, void (*release)(void *data) );
 
 void deleteATCADevice( ATCADevice *dev );      // destructor
 /*---- end of OATCADevice ----*/
@@ -42,6 +42,7 @@
  */
 
 #include <stdlib.h>
+#include <string.h>
 #include "atca_iface.h"
 #include "hal/atca_hal.h"
 
@@ -66,6 +67,22 @@ struct atca_iface {
 	ATCA_STATUS (*atwake)(ATCAIface hal);
 	ATCA_STATUS (*atidle)(ATCAIface hal);
 	ATCA_STATUS (*atsleep)(ATCAIface hal);
+	ATCA_STATUS (*atresync)(ATCAIface hal);
+	
+	// wake state, tracked across commands so a session can keep the device awake
+	int      session_ct;	// nesting depth of atsessionbegin() calls
+	bool     awake;			// device has been woken and not idled or put to sleep since
+	uint32_t awake_us;		// command time charged against the device watchdog since the last wake
+	uint32_t wake_ticks;	// atca_ticks_ms() of the last wake, the watchdog also runs while the host does other things
+	uint16_t wake_delay;	// tWHI the HAL waits after the wake pulse, starts at the configured wake_delay
+	
+	uint32_t bus_us;		// estimated time transfers to and from the device occupied the bus, wraps
+	
+	// retries, see atexecute()
+	ATCARetryStats retry_stats;
+	uint8_t  retry_data[sizeof(((ATCAPacket *)0)->data)];	// data and CRC of the last command sent, which the
+															// response overwrites in the packet
+	bool     cmd_sent;		// the last command reached the device, which may have run it
 	
 	// treat as private
 	void *hal_data;  // generic pointer used by HAL to point to architecture specific structure
@@ -84,6 +101,14 @@ ATCAIface newATCAIface(ATCAIfaceCfg *cfg)  // constructor
 	ATCAIface caiface = (ATCAIface)malloc(sizeof(struct atca_iface));
 	caiface->mType = cfg->iface_type;
 	caiface->mIfaceCFG = cfg;
+	caiface->session_ct = 0;
+	caiface->awake = false;
+	caiface->awake_us = 0;
+	caiface->wake_ticks = 0;
+	caiface->wake_delay = cfg->wake_delay;
+	caiface->bus_us = 0;
+	memset(&caiface->retry_stats, 0, sizeof(caiface->retry_stats));
+	caiface->cmd_sent = false;
 
     if (atinit(caiface) != ATCA_SUCCESS)
     {
@@ -115,33 +140,480 @@ ATCA_STATUS atinit(ATCAIface caiface)
 	return status;
 }
 
+/** \brief estimated time a transfer occupies the bus
+ * \param[in] cfg - interface configuration
+ * \param[in] bytes - number of data bytes transferred
+ * \return time in microseconds, 0 for interfaces that don't share a bus between devices
+ */
+static uint32_t _atbustime(ATCAIfaceCfg *cfg, int bytes)
+{
+	switch ( cfg->iface_type )
+	{
+		case ATCA_I2C_IFACE:
+			// address and data bytes with their ACK bits, plus START and STOP
+			if ( cfg->atcai2c.baud == 0 )
+				return 0;
+			return (uint32_t)(((uint64_t)(bytes + 1) * 9 + 2) * 1000000 / cfg->atcai2c.baud);
+			
+		case ATCA_SWI_IFACE:
+			// a token byte, then every bit is sent as a 10 bit UART frame at 230400 baud
+			return (uint32_t)(bytes + 1) * 8 * 10 * 1000000 / 230400;
+			
+		default:
+			return 0;
+	}
+}
+
+/** \brief send a command packet to the device
+ * \param[in] caiface - interface of the device
+ * \param[in] txdata - packet to send, starting with the byte reserved for the HAL
+ * \param[in] txlength - number of packet bytes after the reserved byte
+ * \return ATCA_STATUS, ATCA_TX_FAIL if the device didn't take the packet
+ */
 ATCA_STATUS atsend(ATCAIface caiface, uint8_t *txdata, int txlength)
 {
-	return caiface->atsend(caiface, txdata, txlength);
+	ATCA_STATUS status;
+	
+	caiface->bus_us += _atbustime(caiface->mIfaceCFG, txlength);
+	status = caiface->atsend(caiface, txdata, txlength);
+	
+	// a device that is awake always takes a command, so most likely it fell asleep
+	return status == ATCA_COMM_FAIL ? ATCA_TX_FAIL : status;
 }
 
+/** \brief receive a response from the device and check its CRC
+ * \param[in] caiface - interface of the device
+ * \param[out] rxdata - receives the response
+ * \param[inout] rxlength - expected number of response bytes
+ * \return ATCA_STATUS, ATCA_BAD_CRC if the response was corrupted, ATCA_RX_FAIL if it was cut short
+ */
 ATCA_STATUS atreceive( ATCAIface caiface, uint8_t *rxdata, uint16_t *rxlength)
 {
-	return caiface->atreceive(caiface, rxdata, rxlength);
+	ATCA_STATUS status = caiface->atreceive(caiface, rxdata, rxlength);
+	ATCACrcStream crc;
+	
+	// a device that is still busy only takes the address byte
+	caiface->bus_us += _atbustime(caiface->mIfaceCFG, status == ATCA_SUCCESS ? *rxlength : 0);
+	if ( status != ATCA_SUCCESS )
+		return status;
+	
+	atCRCStreamStart(&crc);
+	status = atCRCStreamFeed(&crc, rxdata, *rxlength);
+	if ( status == ATCA_RX_NO_RESPONSE || status == ATCA_INVALID_SIZE )
+		return ATCA_RX_FAIL;
+	if ( status != ATCA_SUCCESS )
+		return status;
+	
+	// the device didn't execute the command, it received it corrupted or its watchdog was about to expire
+	if ( rxdata[0] == 4 && (rxdata[1] == 0xFF || rxdata[1] == 0xEE) )
+		return isATCAError(rxdata);
+	return ATCA_SUCCESS;
+}
+
+/** \brief wait for a command that was just sent to complete and receive its response.
+ *  In ATCA_EXEC_DELAY mode this waits the full execution time given.  In ATCA_EXEC_POLL mode it waits
+ *  *wait_us (but at least poll_min_ms) and then polls the device every poll_interval_us, so the
+ *  response is received as soon as the device has it ready.  Polling continues for rx_retries polls
+ *  past the execution time.
+ * \param[in] caiface - interface the command was sent on
+ * \param[in] execution_time - worst case execution time of the command in milliseconds
+ * \param[inout] wait_us - in: expected completion time in microseconds, 0 if unknown.
+ *                         out: time at which the response was received, 0 if completion isn't observed
+ * \param[out] rxdata - receives the response
+ * \param[inout] rxlength - expected number of response bytes
+ * \return ATCA_STATUS, ATCA_TIMEOUT if the device never responded
+ */
+ATCA_STATUS atwaitreceive(ATCAIface caiface, uint16_t execution_time, uint32_t *wait_us, uint8_t *rxdata, uint16_t *rxlength)
+{
+	ATCAIfaceCfg *cfg = caiface->mIfaceCFG;
+	ATCA_STATUS status;
+	uint32_t interval_us, elapsed_us, limit_us;
+	int retries;
+	
+	interval_us = cfg->poll_interval_us ? cfg->poll_interval_us : ATCA_POLL_INTERVAL_US;
+	
+	if ( cfg->exec_mode != ATCA_EXEC_POLL )
+	{
+		atca_delay_ms(execution_time);
+		caiface->awake_us += (uint32_t)execution_time * 1000;
+		*wait_us = 0;
+		
+		// HALs that read only once a call NACK while a slow device is still busy, give it rx_retries more intervals
+		for ( retries = cfg->rx_retries; (status = atreceive(caiface, rxdata, rxlength)) == ATCA_RX_NO_RESPONSE && retries > 0; retries-- )
+		{
+			atca_delay_us(interval_us);
+			caiface->awake_us += interval_us;
+		}
+		return status == ATCA_RX_NO_RESPONSE ? ATCA_TIMEOUT : status;
+	}
+	
+	limit_us = (uint32_t)execution_time * 1000;
+	retries = cfg->rx_retries;
+	
+	// nothing to gain by polling before the device could possibly be done
+	elapsed_us = (uint32_t)cfg->poll_min_ms * 1000;
+	if ( *wait_us > elapsed_us )
+		elapsed_us = *wait_us;
+	if ( elapsed_us > limit_us )
+		elapsed_us = limit_us;
+	atca_delay_us(elapsed_us);
+	
+	// the HAL makes a single read attempt per call in this mode and returns ATCA_RX_NO_RESPONSE while the device NACKs
+	while ( (status = atreceive(caiface, rxdata, rxlength)) == ATCA_RX_NO_RESPONSE )
+	{
+		if ( elapsed_us >= limit_us && retries-- <= 0 )
+			break;
+		
+		atca_delay_us(interval_us);
+		elapsed_us += interval_us;
+	}
+	
+	caiface->awake_us += elapsed_us;
+	if ( status == ATCA_RX_NO_RESPONSE )
+		return ATCA_TIMEOUT;
+	
+	*wait_us = elapsed_us;
+	return status;
 }
 
+/** \brief non-blocking counterpart of atwaitreceive().  Receives the response of a command that was
+ *  sent elapsed_us ago if the device should have it ready by now.  In ATCA_EXEC_DELAY mode that is
+ *  once the execution time has passed, in ATCA_EXEC_POLL mode the device is asked for it once per call.
+ *  In both modes a device that still NACKs gets rx_retries poll intervals past the execution time, as
+ *  atwaitreceive() gives it, and then the command times out.
+ * \param[in] caiface - interface the command was sent on
+ * \param[in] execution_time - worst case execution time of the command in milliseconds
+ * \param[in] elapsed_us - time since the command was sent
+ * \param[out] rxdata - receives the response
+ * \param[inout] rxlength - expected number of response bytes
+ * \return ATCA_RX_NO_RESPONSE while the command is still executing, ATCA_TIMEOUT if the device never
+ *         responded, otherwise the status of receiving the response
+ */
+ATCA_STATUS atpollreceive(ATCAIface caiface, uint16_t execution_time, uint32_t elapsed_us, uint8_t *rxdata, uint16_t *rxlength)
+{
+	ATCAIfaceCfg *cfg = caiface->mIfaceCFG;
+	ATCA_STATUS status;
+	uint32_t interval_us, limit_us = (uint32_t)execution_time * 1000;
+	
+	if ( elapsed_us < (cfg->exec_mode != ATCA_EXEC_POLL ? limit_us : (uint32_t)cfg->poll_min_ms * 1000) )
+		return ATCA_RX_NO_RESPONSE;
+	
+	status = atreceive(caiface, rxdata, rxlength);
+	if ( status == ATCA_RX_NO_RESPONSE )
+	{
+		interval_us = cfg->poll_interval_us ? cfg->poll_interval_us : ATCA_POLL_INTERVAL_US;
+		if ( elapsed_us < limit_us + (uint32_t)cfg->rx_retries * interval_us )
+			return ATCA_RX_NO_RESPONSE;
+		
+		status = ATCA_TIMEOUT;
+	}
+	
+	caiface->awake_us += elapsed_us;
+	return status;
+}
+
+/** \brief wake the device
+ * \param[in] caiface - interface of the device
+ * \return ATCA_STATUS, ATCA_WAKE_FAILED if the device didn't answer with the wake token
+ */
 ATCA_STATUS atwake(ATCAIface caiface)
 {
-	return caiface->atwake(caiface);
+	ATCA_STATUS status = caiface->atwake(caiface);
+	
+	caiface->awake = (status == ATCA_SUCCESS);
+	caiface->awake_us = caiface->wake_delay;
+	caiface->wake_ticks = atca_ticks_ms();
+	caiface->bus_us += caiface->wake_delay + _atbustime(caiface->mIfaceCFG, 4);
+	
+	return status == ATCA_COMM_FAIL ? ATCA_WAKE_FAILED : status;
 }
 
 ATCA_STATUS atidle(ATCAIface caiface)
 {
 	atca_delay_ms(1);
+	caiface->awake = false;
+	caiface->bus_us += _atbustime(caiface->mIfaceCFG, 1);
 	return caiface->atidle(caiface);
 }
 
 ATCA_STATUS atsleep(ATCAIface caiface)
 {
 	atca_delay_ms(1);
+	caiface->awake = false;
+	caiface->bus_us += _atbustime(caiface->mIfaceCFG, 1);
 	return caiface->atsleep(caiface);
 }
 
+/** \brief begin a session which keeps the device awake across commands.  Sessions nest, the device is
+ *  woken by the first command of the session and idled when the outermost session ends.
+ * \param[in] caiface - interface of the device
+ * \return ATCA_STATUS
+ */
+ATCA_STATUS atsessionbegin(ATCAIface caiface)
+{
+	caiface->session_ct++;
+	return ATCA_SUCCESS;
+}
+
+/** \brief end a session started with atsessionbegin(), idling the device if this was the outermost one
+ * \param[in] caiface - interface of the device
+ * \return ATCA_STATUS
+ */
+ATCA_STATUS atsessionend(ATCAIface caiface)
+{
+	if ( caiface->session_ct <= 0 )
+		return ATCA_BAD_PARAM;
+	
+	if ( --caiface->session_ct > 0 || !caiface->awake )
+		return ATCA_SUCCESS;
+	
+	return atidle(caiface);
+}
+
+/** \brief make sure the device is awake for a command that takes up to execution_time milliseconds.
+ *  The device is only woken if it isn't known to be awake, or idled and woken again if the command could
+ *  otherwise run into the watchdog.  The time since the wake is the larger of the command time charged to it
+ *  and the tick count, so time the host spent between commands counts too.
+ *  Idle keeps TempKey and the RNG seed, so restarting the watchdog doesn't break up a command sequence.
+ * \param[in] caiface - interface of the device
+ * \param[in] execution_time - worst case execution time of the next command in milliseconds
+ * \return ATCA_STATUS
+ */
+ATCA_STATUS atsessionwake(ATCAIface caiface, uint16_t execution_time)
+{
+	uint32_t awake_us;
+	
+	if ( caiface->awake )
+	{
+		// the tick may have advanced right after the wake, so up to one more tick has passed
+		awake_us = (atca_ticks_ms() - caiface->wake_ticks + 1) * 1000;
+		if ( awake_us < caiface->awake_us )
+			awake_us = caiface->awake_us;
+		
+		if ( awake_us + (uint32_t)execution_time * 1000 + ATCA_WATCHDOG_MARGIN_US <= ATCA_WATCHDOG_US )
+			return ATCA_SUCCESS;
+		
+		atidle(caiface);
+	}
+	
+	return atwake(caiface);
+}
+
+/** \brief sort an error from waking the device, sending it a command or receiving the response into the
+ *  class of error it is, which decides whether atretry() sends the command again
+ * \param[in] status - error to classify
+ * \return class of the error, ATCA_ERR_FATAL for errors sending the command again can't fix
+ */
+ATCAErrClass atclassify(ATCA_STATUS status)
+{
+	switch ( status )
+	{
+		case ATCA_RX_NO_RESPONSE:
+		case ATCA_TIMEOUT:
+		case ATCA_RX_TIMEOUT:
+		case ATCA_COMM_FAIL:
+			return ATCA_ERR_BUSY;
+			
+		case ATCA_BAD_CRC:
+		case ATCA_RX_FAIL:
+		case ATCA_PARITY_ERROR:
+		case ATCA_STATUS_CRC:
+			return ATCA_ERR_CRC;
+			
+		case ATCA_TX_FAIL:
+		case ATCA_TX_TIMEOUT:
+		case ATCA_STATUS_WATCHDOG:
+			return ATCA_ERR_WATCHDOG;
+			
+		case ATCA_WAKE_FAILED:
+			return ATCA_ERR_WAKE;
+			
+		default:
+			return ATCA_ERR_FATAL;
+	}
+}
+
+/** \brief wake the device if needed and send it a command, keeping what atretry() needs to send it again
+ * \param[in] caiface - interface of the device
+ * \param[in] packet - command to send
+ * \param[in] execution_time - worst case execution time of the command in milliseconds
+ * \return ATCA_STATUS
+ */
+ATCA_STATUS atsendcmd(ATCAIface caiface, ATCAPacket *packet, uint16_t execution_time)
+{
+	ATCA_STATUS status;
+	int length = packet->txsize - (ATCA_CMD_SIZE_MIN - ATCA_CRC_SIZE);
+	
+	if ( length > 0 && length <= (int)sizeof(caiface->retry_data) )
+		memcpy( caiface->retry_data, packet->data, length );
+	
+	caiface->cmd_sent = false;
+	if ( (status = atsessionwake( caiface, execution_time )) != ATCA_SUCCESS )
+		return status;
+	
+	status = atsend( caiface, (uint8_t *)packet, packet->txsize );
+	caiface->cmd_sent = (status == ATCA_SUCCESS);
+	return status;
+}
+
+/** \brief make the device return its response again from the first byte, without idling it, which would
+ *  discard the output buffer
+ * \param[in] caiface - interface of the device
+ * \return ATCA_STATUS, ATCA_UNIMPLEMENTED if the HAL can't read a response again
+ */
+ATCA_STATUS atresync(ATCAIface caiface)
+{
+	if ( caiface->atresync == NULL )
+		return ATCA_UNIMPLEMENTED;
+	
+	caiface->bus_us += _atbustime(caiface->mIfaceCFG, 1);
+	return caiface->atresync(caiface);
+}
+
+/** \brief decide how a command sent with atsendcmd() ended.  If it failed with an error a retry can fix and
+ *  has retries left, wait a backoff that doubles with every retry, then:
+ *  - if the device may have run the command, that is it took the command and didn't answer with status
+ *    0xFF or 0xEE, only read the response again.  The address of the output buffer is reset, the device
+ *    isn't idled.  Running Counter, GenKey, Nonce or an encrypted Write twice would change the device.
+ *  - if the device provably didn't run it (the send or the wake failed, or it answered 0xFF or 0xEE), idle
+ *    and wake the device so the command starts on a fresh watchdog, and send the command again.  Idle keeps
+ *    TempKey, so commands that depend on earlier ones can be repeated.
+ * \param[in] caiface - interface the command was sent on
+ * \param[inout] packet - the command, its data are restored from the copy atsendcmd() kept
+ * \param[in] status - status the command ended with so far
+ * \param[inout] attempt - retries made for the command, 0 after atsendcmd()
+ * \return ATCA_RX_NO_RESPONSE if the response is to be received again, after the command was sent again
+ *         or the device was made to return its response again, otherwise the final status of the command
+ */
+ATCA_STATUS atretry(ATCAIface caiface, ATCAPacket *packet, ATCA_STATUS status, int *attempt)
+{
+	ATCAErrClass err = atclassify( status );
+	int length = packet->txsize - (ATCA_CMD_SIZE_MIN - ATCA_CRC_SIZE);
+	uint32_t backoff_us;
+	
+	if ( status == ATCA_SUCCESS )
+	{
+		if ( *attempt > 0 )
+			caiface->retry_stats.recovered++;
+		return status;
+	}
+	
+	while ( err != ATCA_ERR_FATAL && *attempt < ATCA_RETRY_MAX && length > 0 && length <= (int)sizeof(caiface->retry_data) )
+	{
+		caiface->retry_stats.retries[err]++;
+		backoff_us = (uint32_t)ATCA_RETRY_BACKOFF_US << (*attempt)++;
+		if ( backoff_us > ATCA_RETRY_BACKOFF_MAX_US )
+			backoff_us = ATCA_RETRY_BACKOFF_MAX_US;
+		
+		if ( caiface->cmd_sent && status != ATCA_STATUS_CRC && status != ATCA_STATUS_WATCHDOG )
+		{
+			// a response lost on the bus, or a device still busy, read it again
+			atca_delay_us( backoff_us );
+			if ( (status = atresync( caiface )) == ATCA_SUCCESS )
+				return ATCA_RX_NO_RESPONSE;
+		}
+		else
+		{
+			// a device that is asleep ignores the idle, one that is awake otherwise answers the wake with its output buffer
+			atidle( caiface );
+			atca_delay_us( backoff_us );
+			
+			caiface->cmd_sent = false;
+			if ( (status = atwake( caiface )) == ATCA_SUCCESS )
+			{
+				memcpy( packet->data, caiface->retry_data, length );
+				if ( (status = atsend( caiface, (uint8_t *)packet, packet->txsize )) == ATCA_SUCCESS )
+				{
+					caiface->cmd_sent = true;
+					return ATCA_RX_NO_RESPONSE;
+				}
+			}
+		}
+		err = atclassify( status );
+	}
+	
+	if ( *attempt > 0 || err != ATCA_ERR_FATAL )
+		caiface->retry_stats.failed++;
+	return status;
+}
+
+/** \brief execute a command: wake the device if needed, send the command, wait for it to complete and
+ *  receive the response back into the packet.  Transient errors are retried, see atretry().
+ * \param[in] caiface - interface of the device
+ * \param[inout] packet - command to send, packet->data receives the response
+ * \param[in] execution_time - worst case execution time of the command in milliseconds
+ * \param[inout] wait_us - as for atwaitreceive(), for the last time the command was sent
+ * \return ATCA_STATUS
+ */
+ATCA_STATUS atexecute(ATCAIface caiface, ATCAPacket *packet, uint16_t execution_time, uint32_t *wait_us)
+{
+	ATCA_STATUS status;
+	uint32_t predicted_us = *wait_us;
+	uint16_t rxsize = packet->rxsize;
+	int attempt = 0;
+	
+	status = atsendcmd( caiface, packet, execution_time );
+	for (;;)
+	{
+		if ( status == ATCA_SUCCESS )
+		{
+			*wait_us = predicted_us;
+			packet->rxsize = rxsize;
+			status = atwaitreceive( caiface, execution_time, wait_us, packet->data, &packet->rxsize );
+		}
+		
+		if ( (status = atretry( caiface, packet, status, &attempt )) != ATCA_RX_NO_RESPONSE )
+			return status;
+		status = ATCA_SUCCESS;
+	}
+}
+
+/** \brief retry counters of an interface, to tell how often its bus or device misbehaved
+ * \param[in] caiface - interface of the device
+ * \param[out] stats - receives the counters
+ */
+void atgetretrystats(ATCAIface caiface, ATCARetryStats *stats)
+{
+	*stats = caiface->retry_stats;
+}
+
+/** \brief reset the retry counters of an interface
+ * \param[in] caiface - interface of the device
+ */
+void atclearretrystats(ATCAIface caiface)
+{
+	memset(&caiface->retry_stats, 0, sizeof(caiface->retry_stats));
+}
+
+/** \brief time the HAL waits after the wake pulse before it reads the wake token.  Starts at the configured
+ *  wake_delay, HALs that can tell how long the device actually took calibrate it with atsetwakedelay().
+ * \param[in] caiface - interface of the device
+ * \return delay in microseconds
+ */
+uint16_t atgetwakedelay(ATCAIface caiface)
+{
+	return caiface->wake_delay;
+}
+
+/** \brief set the calibrated wake delay of a device, see atgetwakedelay()
+ * \param[in] caiface - interface of the device
+ * \param[in] wake_delay - delay in microseconds
+ */
+void atsetwakedelay(ATCAIface caiface, uint16_t wake_delay)
+{
+	caiface->wake_delay = wake_delay;
+}
+
+bool atinsession(ATCAIface caiface)
+{
+	return caiface->session_ct > 0;
+}
+
+bool atisawake(ATCAIface caiface)
+{
+	return caiface->awake;
+}
+
 ATCAIfaceCfg * atgetifacecfg(ATCAIface caiface)
 {
 	return caiface->mIfaceCFG;
@@ -152,6 +624,16 @@ void* atgetifacehaldat(ATCAIface caiface)
 	return caiface->hal_data;
 }
 
+/** \brief estimated time transfers to and from the device have occupied its bus so far.  The count wraps,
+ *  so use the difference between two readings.
+ * \param[in] caiface - interface of the device
+ * \return time in microseconds
+ */
+uint32_t atgetbustime(ATCAIface caiface)
+{
+	return caiface->bus_us;
+}
+
 void deleteATCAIface(ATCAIface *caiface) // destructor
 {
 	if ( *caiface ) {
@@ -173,6 +655,7 @@ ATCA_STATUS _atinit(ATCAIface caiface, ATCAHAL_t *hal)
 	caiface->atwake     = hal->halwake;
 	caiface->atsleep    = hal->halsleep;
 	caiface->atidle     = hal->halidle;
+	caiface->atresync   = hal->halresync;
 	caiface->hal_data   = hal->hal_data;
 	
 	return ATCA_SUCCESS;
@@ -61,10 +61,25 @@ typedef enum {
 	ATCA_SWI_IFACE,
 	ATCA_UART_IFACE,
 	ATCA_SPI_IFACE,
-	ATCA_HID_IFACE
+	ATCA_HID_IFACE,
+	ATCA_SOCKET_IFACE,
+	ATCA_EMU_IFACE
 	// additional physical interface types here
 } ATCAIfaceType;
 
+/** \brief how the interface waits for a command to complete before receiving its response */
+typedef enum {
+	ATCA_EXEC_DELAY,	// wait the worst case execution time of the command, then receive
+	ATCA_EXEC_POLL		// wait poll_min_ms, then poll the device until it responds
+} ATCAExecMode;
+
+/** \brief how an emulated device paces command execution */
+typedef enum {
+	ATCA_EMU_TIMING_REAL,	// busy for the execution time of each command, as the real device
+	ATCA_EMU_TIMING_SCALED,	// busy for the execution time scaled by time_scale percent
+	ATCA_EMU_TIMING_ZERO	// responses are ready as soon as the command is sent
+} ATCAEmuTiming;
+
 /* ATCAIfaceCfg is a mediator object between a completely abstract notion of a physical interface and an actual physical interface.
 
 	The main purpose of it is to keep hardware specifics from bleeding into the higher levels - hardware specifics could include
@@ -81,7 +96,7 @@ typedef struct {
 		struct ATCAI2C {
 			uint8_t  slave_address;	// 8-bit slave address
 			uint8_t  bus;			// logical i2c bus number, 0-based - HAL will map this to a pin pair for SDA SCL
-			uint32_t baud;			// typically 400000
+			uint32_t baud;			// typically 400000, up to 1000000 (Fast-mode Plus) where the HAL supports it
 		} atcai2c;
 		
 		struct ATCASWI {
@@ -94,6 +109,7 @@ typedef struct {
 			uint8_t  wordsize;	// usually 8
 			uint8_t  parity;	// 0 == even, 1 == odd, 2 == none
 			uint8_t  stopbits;	// 0,1,2
+			const char *device;	// host tty to open, NULL for the port's default device (/dev/ttyACM<port>)
 		} atcauart;
 
 		struct ATCAHID {
@@ -108,11 +124,55 @@ typedef struct {
 			uint8_t  bus;		// logical bus number, will imply all the rest by the HAL implementation
 			uint32_t baud;
 		} atcaspi;
+		
+		struct ATCASOCKET {
+			const char *path;	// Unix domain socket the device process listens on
+		} atcasocket;
+		
+		struct ATCAEMU {
+			ATCAEmuTiming timing;	// execution time model of the emulated device
+			uint16_t time_scale;	// ATCA_EMU_TIMING_SCALED: percent of the real execution times
+			uint32_t seed;			// seeds the serial number and random numbers, 0 for a different device every init
+			const uint8_t *config;	// initial 128 byte config zone image, NULL for the built-in factory image
+		} atcaemu;
 	};
 	
 	uint16_t wake_delay;   // microseconds of tWHI + tWLO which varies based on chip type
 	int      rx_retries;   // the number of retries to attempt for receiving bytes
+	
+	ATCAExecMode exec_mode;	// completion mode, ATCA_EXEC_DELAY unless the HAL supports polling for a response
+	uint16_t poll_min_ms;		// ATCA_EXEC_POLL: milliseconds to wait before the first poll
+	uint16_t poll_interval_us;	// ATCA_EXEC_POLL: microseconds between polls, 0 selects ATCA_POLL_INTERVAL_US
 } ATCAIfaceCfg;
+
+#define ATCA_POLL_INTERVAL_US	(500)	// default time between polls in ATCA_EXEC_POLL mode
+
+#define ATCA_WATCHDOG_US		(1300000)	// device watchdog puts the device to sleep this long after a wake (tWATCHDOG)
+#define ATCA_WATCHDOG_MARGIN_US	(300000)	// part of the watchdog a session keeps in reserve for bus and host time
+
+/** \brief classes of transient errors atretry() recovers from by re-waking the device and resending the command */
+typedef enum {
+	ATCA_ERR_BUSY,		// device didn't respond in time, or NACKed the read of its response
+	ATCA_ERR_CRC,		// response was corrupted or cut short, or the device received a corrupted command
+	ATCA_ERR_WATCHDOG,	// device fell asleep, or refused the command because its watchdog was about to expire
+	ATCA_ERR_WAKE,		// device didn't answer a wake
+	ATCA_ERR_CLASSES,
+	ATCA_ERR_FATAL = ATCA_ERR_CLASSES	// not retried
+} ATCAErrClass;
+
+/** \brief retry counters of an interface, see atgetretrystats() */
+typedef struct {
+	uint32_t retries[ATCA_ERR_CLASSES];	// retries made for each class of error
+	uint32_t recovered;		// commands that succeeded after one or more retries
+	uint32_t failed;		// commands that still failed when the retries ran out
+} ATCARetryStats;
+
+#ifndef ATCA_RETRY_MAX
+#define ATCA_RETRY_MAX				(3)		// retries per command before an error is passed up
+#endif
+#define ATCA_RETRY_BACKOFF_US		(500)	// wait before the first retry, doubled for each further one
+#define ATCA_RETRY_BACKOFF_MAX_US	(20000)	// longest wait between retries
+
 	
 typedef struct atca_iface * ATCAIface;
 ATCAIface newATCAIface(ATCAIfaceCfg *cfg);  // constructor
@@ -121,13 +181,32 @@ ATCA_STATUS atinit(ATCAIface caiface);
 ATCA_STATUS atpostinit(ATCAIface caiface);
 ATCA_STATUS atsend(ATCAIface caiface, uint8_t *txdata, int txlength);
 ATCA_STATUS atreceive(ATCAIface caiface, uint8_t *rxdata, uint16_t *rxlength);
+ATCA_STATUS atwaitreceive(ATCAIface caiface, uint16_t execution_time, uint32_t *wait_us, uint8_t *rxdata, uint16_t *rxlength);
+ATCA_STATUS atpollreceive(ATCAIface caiface, uint16_t execution_time, uint32_t elapsed_us, uint8_t *rxdata, uint16_t *rxlength);
 ATCA_STATUS atwake(ATCAIface caiface);
 ATCA_STATUS atidle(ATCAIface caiface);
 ATCA_STATUS atsleep(ATCAIface caiface);
+ATCA_STATUS atsessionbegin(ATCAIface caiface);
+ATCA_STATUS atsessionend(ATCAIface caiface);
+ATCA_STATUS atsessionwake(ATCAIface caiface, uint16_t execution_time);
+ATCA_STATUS atresync(ATCAIface caiface);
+bool atinsession(ATCAIface caiface);
+bool atisawake(ATCAIface caiface);
+
+// command transport with retries
+ATCA_STATUS atexecute(ATCAIface caiface, ATCAPacket *packet, uint16_t execution_time, uint32_t *wait_us);
+ATCA_STATUS atsendcmd(ATCAIface caiface, ATCAPacket *packet, uint16_t execution_time);
+ATCA_STATUS atretry(ATCAIface caiface, ATCAPacket *packet, ATCA_STATUS status, int *attempt);
+ATCAErrClass atclassify(ATCA_STATUS status);
+void atgetretrystats(ATCAIface caiface, ATCARetryStats *stats);
+void atclearretrystats(ATCAIface caiface);
 
 // accessors
 ATCAIfaceCfg * atgetifacecfg(ATCAIface caiface);
 void* atgetifacehaldat(ATCAIface caiface);
+uint32_t atgetbustime(ATCAIface caiface);
+uint16_t atgetwakedelay(ATCAIface caiface);
+void atsetwakedelay(ATCAIface caiface, uint16_t wake_delay);
 
 void deleteATCAIface( ATCAIface *dev );      // destructor
 /*---- end of OATCAIface ----*/
@@ -57,13 +57,14 @@ typedef enum {
 	ATCA_SUCCESS                = 0x00, //!< Function succeeded.
 	ATCA_CONFIG_ZONE_LOCKED	    = 0x01,
 	ATCA_DATA_ZONE_LOCKED	    = 0x02,
-	ATCA_WAKE_FAILED		    = 0xD0, //!< response status byte indicates CheckMac failure (status byte = 0x01)
+	ATCA_WAKE_FAILED		    = 0xD0, //!< device didn't answer a wake with the wake token
 	ATCA_CHECKMAC_VERIFY_FAILED	= 0xD1, //!< response status byte indicates CheckMac failure (status byte = 0x01)
 	ATCA_PARSE_ERROR            = 0xD2, //!< response status byte indicates parsing error (status byte = 0x03)
 	ATCA_CMD_FAIL               = 0xD3, //!< response status byte indicates command execution error (status byte = 0x0F)
 	ATCA_STATUS_CRC             = 0xD4, //!< response status byte indicates CRC error (status byte = 0xFF)
 	ATCA_STATUS_UNKNOWN         = 0xD5, //!< response status byte is unknown
 	ATCA_STATUS_ECC             = 0xD6, //!< response status byte is ECC fault (status byte = 0x05)
+	ATCA_STATUS_WATCHDOG        = 0xD7, //!< response status byte indicates the watchdog is about to expire (status byte = 0xEE)
 	ATCA_FUNC_FAIL              = 0xE0, //!< Function could not execute due to incorrect condition / state.
 	ATCA_GEN_FAIL               = 0xE1, //!< unspecified error
 	ATCA_BAD_PARAM              = 0xE2, //!< bad argument (out of range, null pointer, etc.)
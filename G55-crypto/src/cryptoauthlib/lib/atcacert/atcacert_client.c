@@ -71,16 +71,16 @@ int atcacert_read_cert( const atcacert_def_t* cert_def,
     if (ret != ATCACERT_E_SUCCESS)
         return ret;
 
+    // read all the device locations while the device stays awake
+    atcab_session_begin();
     for (i = 0; i < device_locs_count; i++)
     {
         uint8_t data[416];
         if (device_locs[i].zone == DEVZONE_DATA && device_locs[i].is_genkey)
         {
-            atcab_wakeup();
             ret = atcab_get_pubkey(device_locs[i].slot, data);
-            atcab_idle();
 			if (ret != ATCA_SUCCESS)
-				return ret;
+				break;
         }
         else
         {
@@ -91,14 +91,19 @@ int atcacert_read_cert( const atcacert_def_t* cert_def,
 			{
 				ret = atcab_read_zone(device_locs[i].zone, device_locs[i].slot, block, 0, &data[block*32 - device_locs[i].offset], 32);
 				if (ret != ATCA_SUCCESS)
-					return ret;
+					break;
 			}
+			if (ret != ATCA_SUCCESS)
+				break;
 		}
 		
         ret = atcacert_cert_build_process(&build_state, &device_locs[i], data);
         if (ret != ATCACERT_E_SUCCESS)
-            return ret;
+            break;
     }
+    atcab_session_end();
+    if (ret != ATCACERT_E_SUCCESS)
+        return ret;
 
     ret = atcacert_cert_build_finish(&build_state);
     if (ret != ATCACERT_E_SUCCESS)
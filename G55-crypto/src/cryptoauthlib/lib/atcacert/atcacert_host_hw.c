@@ -74,7 +74,7 @@ int atcacert_gen_challenge_hw( uint8_t challenge[32] )
     if (challenge == NULL)
         return ATCACERT_E_BAD_PARAMS;
     
-    return atcab_random(challenge);
+    return atcab_random_bytes(challenge, 32);
 }
 
 int atcacert_verify_response_hw( const uint8_t device_public_key[64],
@@ -42,6 +42,8 @@
 #include "crypto/atca_crypto_sw_ecdsa.h"
 #include "crypto/atca_crypto_sw_rand.h"
 
+#define ATCACERT_VERIFY_BATCH   (8)     // certificates whose digests and signatures are extracted at a time
+
 int atcacert_verify_cert_sw( const atcacert_def_t* cert_def,
                              const uint8_t*        cert,
                              size_t                cert_size,
@@ -63,7 +65,9 @@ int atcacert_verify_cert_sw( const atcacert_def_t* cert_def,
         return ret;
     
     ret = atcac_sw_ecdsa_verify_p256(tbs_digest, signature, ca_public_key);
-    if (ret != ATCACERT_E_SUCCESS)
+    if (ret == ATCA_CHECKMAC_VERIFY_FAILED)
+        return ATCACERT_E_VERIFY_FAILED;
+    if (ret != ATCA_SUCCESS)
         return ret;
     
     return ATCACERT_E_SUCCESS;
@@ -81,8 +85,93 @@ int atcacert_verify_response_sw( const uint8_t device_public_key[64],
                                  const uint8_t challenge[32],
                                  const uint8_t response[64])
 {
+    int ret = 0;
+
     if (device_public_key == NULL || challenge == NULL || response == NULL)
         return ATCACERT_E_BAD_PARAMS;
     
-    return atcac_sw_ecdsa_verify_p256(challenge, response, device_public_key);
-}
\ No newline at end of file
+    ret = atcac_sw_ecdsa_verify_p256(challenge, response, device_public_key);
+    if (ret == ATCA_CHECKMAC_VERIFY_FAILED)
+        return ATCACERT_E_VERIFY_FAILED;
+
+    return ret;
+}
+
+int atcacert_verify_cert_sw_batch( const atcacert_def_t* cert_def,
+                                   const uint8_t* const  certs[],
+                                   const size_t          cert_sizes[],
+                                   size_t                count,
+                                   const uint8_t         ca_public_key[64],
+                                   int                   results[])
+{
+    int ret = ATCACERT_E_SUCCESS;
+    uint8_t tbs_digests[ATCACERT_VERIFY_BATCH][32];
+    uint8_t signatures[ATCACERT_VERIFY_BATCH][64];
+    const uint8_t* msg_list[ATCACERT_VERIFY_BATCH];
+    const uint8_t* sig_list[ATCACERT_VERIFY_BATCH];
+    const uint8_t* key_list[ATCACERT_VERIFY_BATCH];
+    int verified[ATCACERT_VERIFY_BATCH];
+    size_t index[ATCACERT_VERIFY_BATCH];
+    size_t done, chunk, i, batch;
+
+    if (cert_def == NULL || ca_public_key == NULL || ((certs == NULL || cert_sizes == NULL || results == NULL) && count > 0))
+        return ATCACERT_E_BAD_PARAMS;
+
+    for (done = 0; done < count; done += chunk)
+    {
+        chunk = (count - done < ATCACERT_VERIFY_BATCH) ? count - done : ATCACERT_VERIFY_BATCH;
+
+        // certificates that can't be parsed get their error, the rest are verified together
+        batch = 0;
+        for (i = done; i < done + chunk; i++)
+        {
+            if (certs[i] == NULL)
+                results[i] = ATCACERT_E_BAD_PARAMS;
+            else if ((results[i] = atcacert_get_tbs_digest(cert_def, certs[i], cert_sizes[i], tbs_digests[batch])) == ATCACERT_E_SUCCESS)
+                results[i] = atcacert_get_signature(cert_def, certs[i], cert_sizes[i], signatures[batch]);
+            if (results[i] != ATCACERT_E_SUCCESS)
+            {
+                ret = ATCACERT_E_VERIFY_FAILED;
+                continue;
+            }
+            msg_list[batch] = tbs_digests[batch];
+            sig_list[batch] = signatures[batch];
+            key_list[batch] = ca_public_key;
+            index[batch++] = i;
+        }
+
+        atcac_sw_ecdsa_verify_p256_batch(msg_list, sig_list, key_list, verified, batch);
+        for (i = 0; i < batch; i++)
+        {
+            if (verified[i] != ATCA_SUCCESS)
+            {
+                results[index[i]] = ATCACERT_E_VERIFY_FAILED;
+                ret = ATCACERT_E_VERIFY_FAILED;
+            }
+        }
+    }
+
+    return ret;
+}
+
+int atcacert_verify_response_sw_batch( const uint8_t* const device_public_keys[],
+                                       const uint8_t* const challenges[],
+                                       const uint8_t* const responses[],
+                                       size_t               count,
+                                       int                  results[])
+{
+    int ret = 0;
+    size_t i;
+
+    if ((device_public_keys == NULL || challenges == NULL || responses == NULL || results == NULL) && count > 0)
+        return ATCACERT_E_BAD_PARAMS;
+
+    ret = atcac_sw_ecdsa_verify_p256_batch(challenges, responses, device_public_keys, results, count);
+    if (ret == ATCA_BAD_PARAM)
+        return ATCACERT_E_BAD_PARAMS;
+
+    for (i = 0; i < count; i++)
+        results[i] = (results[i] == ATCA_SUCCESS) ? ATCACERT_E_SUCCESS : ATCACERT_E_VERIFY_FAILED;
+
+    return (ret == ATCA_SUCCESS) ? ATCACERT_E_SUCCESS : ATCACERT_E_VERIFY_FAILED;
+}
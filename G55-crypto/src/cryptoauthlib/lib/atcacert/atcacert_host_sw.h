@@ -104,6 +104,47 @@ int atcacert_verify_response_sw( const uint8_t device_public_key[64],
                                  const uint8_t challenge[32],
                                  const uint8_t response[64]);
 
+/**
+ * \brief Verify a batch of certificates against the public key of the certificate authority that
+ *        signed them all, using software crypto functions.  Costs less per certificate than calling
+ *        atcacert_verify_cert_sw() for each.
+ *
+ * \param[in]  cert_def       Certificate definition describing how to extract the TBS and signature
+ *                            components from the certificates.
+ * \param[in]  certs          Certificates to verify.
+ * \param[in]  cert_sizes     Size of each certificate in bytes.
+ * \param[in]  count          Number of certificates.
+ * \param[in]  ca_public_key  The ECC P256 public key of the certificate authority. 64 bytes.
+ * \param[out] results        For each certificate, 0 if it verifies, ATCACERT_E_VERIFY_FAILED if it
+ *                            doesn't, or the error that prevented the check.
+ *
+ * \return 0 if all certificates verify, ATCACERT_E_VERIFY_FAILED if any doesn't.
+ */
+int atcacert_verify_cert_sw_batch( const atcacert_def_t* cert_def,
+                                   const uint8_t* const  certs[],
+                                   const size_t          cert_sizes[],
+                                   size_t                count,
+                                   const uint8_t         ca_public_key[64],
+                                   int                   results[]);
+
+/**
+ * \brief Verify a batch of clients' responses to their challenges using software crypto functions.
+ *        Costs less per response than calling atcacert_verify_response_sw() for each.
+ *
+ * \param[in]  device_public_keys  Public key of each device. 64 bytes each.
+ * \param[in]  challenges          Challenge sent to each client. 32 bytes each.
+ * \param[in]  responses           Response returned from each client. 64 bytes each.
+ * \param[in]  count               Number of responses.
+ * \param[out] results             For each response, 0 if it verifies, ATCACERT_E_VERIFY_FAILED if not.
+ *
+ * \return 0 if all responses verify, ATCACERT_E_VERIFY_FAILED if any doesn't.
+ */
+int atcacert_verify_response_sw_batch( const uint8_t* const device_public_keys[],
+                                       const uint8_t* const challenges[],
+                                       const uint8_t* const responses[],
+                                       size_t               count,
+                                       int                  results[]);
+
 /** @} */
 #ifdef __cplusplus
 }
@@ -46,13 +46,17 @@
  */ 
 
 
+#include <stdlib.h>
 #include "atca_basic.h"
 #include "host/atca_host.h"
+#include "crypto/atca_crypto_sw_drbg.h"
 
 /** \brief basic API methods are all prefixed with atcab_  (Atmel CryptoAuth Basic)
  *  the fundamental premise of the basic API is it is based on a single interface
  *  instance and that instance is global, so all basic API commands assume that 
  *  one global device is the one to operate on.
+ *  Each atcab_ method has an atcab_ctx_ counterpart taking the device to operate on
+ *  explicitly; the global device is the default context the atcab_ methods pass to it.
  */
 
 ATCADevice  _gDevice = NULL;
@@ -135,214 +139,1199 @@ ATCADevice atcab_getDevice(void)
 
 
 /** \brief wakeup the CryptoAuth device
+ *  \param[in] device - device to operate on
  *  \return ATCA_STATUS
  */
-ATCA_STATUS atcab_wakeup(void)
+ATCA_STATUS atcab_ctx_wakeup(ATCADevice device)
 {
-	if ( _gDevice == NULL )
+	if ( device == NULL )
 		return ATCA_GEN_FAIL;
 		
-	return atwake(_gIface);	
+	return atwake(atGetIFace(device));	
+}
+
+/** \brief atcab_ctx_wakeup() on the default device */
+ATCA_STATUS atcab_wakeup(void)
+{
+	return atcab_ctx_wakeup(_gDevice);
 }
 
 /** \brief idle the CryptoAuth device
+ *  \param[in] device - device to operate on
  *  \return ATCA_STATUS
  */
-ATCA_STATUS atcab_idle(void)
+ATCA_STATUS atcab_ctx_idle(ATCADevice device)
 {
-	if ( _gDevice == NULL )
+	if ( device == NULL )
 		return ATCA_GEN_FAIL;
 
-	return atidle(_gIface);
+	return atidle(atGetIFace(device));
+}
+
+/** \brief atcab_ctx_idle() on the default device */
+ATCA_STATUS atcab_idle(void)
+{
+	return atcab_ctx_idle(_gDevice);
 }
 
 /** \brief invoke sleep on the CryptoAuth device
+ *  \param[in] device - device to operate on
  *  \return ATCA_STATUS
  */
-ATCA_STATUS atcab_sleep(void)
+ATCA_STATUS atcab_ctx_sleep(ATCADevice device)
 {
-	if ( _gDevice == NULL )
+	if ( device == NULL )
 		return ATCA_GEN_FAIL;
 	
-	return atsleep(_gIface);
+	return atsleep(atGetIFace(device));
+}
+
+/** \brief atcab_ctx_sleep() on the default device */
+ATCA_STATUS atcab_sleep(void)
+{
+	return atcab_ctx_sleep(_gDevice);
+}
+
+
+/** \brief begin a wake session.  Until the matching atcab_session_end() the device is kept awake
+ *  between commands instead of being woken and idled for each one.  The session tracks the time spent
+ *  against the device watchdog and idles and wakes the device again before the watchdog would expire.
+ *  Sessions nest, only the outermost atcab_session_end() idles the device.
+ *  \param[in] device - device to operate on
+ *  \return ATCA_STATUS
+ */
+ATCA_STATUS atcab_ctx_session_begin(ATCADevice device)
+{
+	if ( device == NULL )
+		return ATCA_GEN_FAIL;
+
+	return atsessionbegin(atGetIFace(device));
+}
+
+/** \brief atcab_ctx_session_begin() on the default device */
+ATCA_STATUS atcab_session_begin(void)
+{
+	return atcab_ctx_session_begin(_gDevice);
+}
+
+/** \brief end a wake session started with atcab_session_begin()
+ *  \param[in] device - device to operate on
+ *  \return ATCA_STATUS
+ */
+ATCA_STATUS atcab_ctx_session_end(ATCADevice device)
+{
+	if ( device == NULL )
+		return ATCA_GEN_FAIL;
+
+	return atsessionend(atGetIFace(device));
+}
+
+/** \brief atcab_ctx_session_end() on the default device */
+ATCA_STATUS atcab_session_end(void)
+{
+	return atcab_ctx_session_end(_gDevice);
+}
+
+/** \brief common cleanup code which idles the device after any operation, unless the operation is
+ *  part of a session
+ *  \param[in] device - device the operation ran on
+ *  \return ATCA_STATUS
+ */
+static ATCA_STATUS _atcab_exit(ATCADevice device)
+{
+	if ( device != NULL && atinsession(atGetIFace(device)) )
+		return ATCA_SUCCESS;
+
+	return atcab_ctx_idle(device);
+}
+
+/** \brief state of a basic API operation, which is a sequence of one or more commands.  The same
+ *  operation runs either blocking through _atcab_run() or in the background through atcab_ctx_poll().
+ */
+typedef struct atcab_op {
+	ATCADevice  device;		// device the operation runs on
+	ATCAPacket  packet;		// command being executed, receives its response
+	ATCA_CmdMap command;	// command in packet, CMD_LASTCOMMAND when the operation is done
+	int         step;		// number of commands of the operation completed so far
+	ATCA_STATUS (*next)(struct atcab_op *op);	// checks the last response and builds the next command
+
+	// operation parameters
+	uint16_t       key_id;
+	const uint8_t *message;
+	const uint8_t *signature;
+	const uint8_t *pubkey;
+	uint8_t       *out;
+	bool          *verified;
+	const uint8_t * const *messages;	// batch operations, a message and an output per item
+	uint8_t      **outs;
+	uint16_t       count;
+
+	// background execution
+	bool           busy;
+	uint32_t       sent_ticks;		// atca_ticks_ms() when the current command was sent
+	uint32_t       polled_ticks;	// atca_ticks_ms() of the last poll of the device
+	uint32_t       first_poll_us;	// learned execution time of the current command
+	int            attempt;			// retries made for the current command, see atretry()
+	atcab_callback callback;
+	void          *context;
+} atcab_op_t;
+
+#ifndef ATCAB_RANDOM_POOL_SIZE
+#define ATCAB_RANDOM_POOL_SIZE		(128)	// random bytes kept ahead per device, see atcab_ctx_random_bytes()
+#endif
+#ifndef ATCAB_DRBG_RESEED_INTERVAL
+#define ATCAB_DRBG_RESEED_INTERVAL	(64)	// DRBG requests between reseeds from the random pool
+#endif
+#ifndef ATCAB_PACKET_POOL_SIZE
+#define ATCAB_PACKET_POOL_SIZE		(4)		// packets preallocated per device for single commands, see _atcab_packet_get()
+#endif
+#ifndef ATCAB_PUBKEY_CACHE_SIZE
+#define ATCAB_PUBKEY_CACHE_SIZE		(8)		// public keys kept per device by the pubkey cache
+#endif
+
+/** \brief public key of a slot kept in the pubkey cache, either calculated from the private key in the
+ *  slot by GenKey or read from the slot
+ */
+typedef struct {
+	uint8_t serial[ATCA_SERIAL_NUM_SIZE];	// serial number of the device
+	uint8_t slot;
+	bool    stored;		// read from the slot, see atcab_ctx_read_pubkey()
+	bool    valid;
+	uint8_t pubkey[ATCA_PUB_KEY_SIZE];
+} atcab_pubkey_t;
+
+/** \brief basic API state kept for each device, attached to the device with atSetBasicData() */
+typedef struct {
+	atcab_op_t op;			// operation of the device, blocking or running in the background.  Its packet
+							// holds the last response, which the atcab_ctx_*_view() calls hand out
+
+	// copies of the config and OTP zones, see _atcab_shadow_read()
+	uint8_t config[ATCA_CONFIG_SIZE];
+	uint8_t otp[ATCA_OTP_SIZE];
+	bool    config_valid;
+	bool    otp_valid;
+
+	// random byte pool, a ring buffer topped up by atcab_ctx_random_idle()
+	uint8_t  rand_pool[ATCAB_RANDOM_POOL_SIZE];
+	uint16_t rand_head;			// oldest byte in the pool
+	uint16_t rand_count;		// bytes in the pool
+	uint8_t  rand_fill[RANDOM_NUM_SIZE];	// receives the random number of a refill running in the background
+	bool     rand_refill;		// the background operation is a refill
+	bool     rand_drbg;			// random bytes come from drbg, which the pool seeds
+	atcac_hmac_drbg_ctx drbg;
+
+	// command packets for single commands, see _atcab_packet_get()
+	ATCAPacket packets[ATCAB_PACKET_POOL_SIZE];
+	uint32_t   packets_used;	// bit n is set while packets[n] is in use
+
+	// public keys of the slots, see _atcab_pubkey_find().  Entries are keyed by serial number as well, so
+	// they never answer for another device put behind the same ATCADevice
+	atcab_pubkey_t pubkeys[ATCAB_PUBKEY_CACHE_SIZE];
+	uint8_t        pubkey_victim;	// entry replaced when the cache is full
+} atcab_state_t;
+
+#ifdef ATCAB_STATIC_STATES
+// states of up to ATCAB_STATIC_STATES devices, for targets that keep the basic API off the heap
+static atcab_state_t _atcab_states[ATCAB_STATIC_STATES];
+static uint8_t       _atcab_states_used[ATCAB_STATIC_STATES];
+
+/** \brief take a free state from _atcab_states.  Devices used from different threads may take theirs
+ *  at the same time, so a slot is claimed with an atomic exchange.
+ *  \return the state, NULL if all are taken
+ */
+static atcab_state_t *_atcab_state_alloc(void)
+{
+	int i;
+
+	for ( i = 0; i < ATCAB_STATIC_STATES; i++ )
+	{
+		if ( __atomic_exchange_n( &_atcab_states_used[i], 1, __ATOMIC_ACQUIRE ) == 0 )
+			return &_atcab_states[i];
+	}
+
+	return NULL;
 }
 
+/** \brief give a state taken with _atcab_state_alloc() back, called when its device is deleted */
+static void _atcab_state_release(void *state)
+{
+	__atomic_store_n( &_atcab_states_used[(atcab_state_t *)state - _atcab_states], 0, __ATOMIC_RELEASE );
+}
+#endif
+
+/** \brief get the basic API state of a device.  The state is about 1.9 KB per device with the default
+ *  pool and cache sizes above, the packets and the pubkey cache take most of it.  It comes from the
+ *  heap, or from a static array of ATCAB_STATIC_STATES states if that is defined.
+ *  \param[in] device - device to get the state of
+ *  \param[in] create - allocate the state if the device doesn't have one yet
+ *  \return the state, NULL if the device has none
+ */
+static atcab_state_t *_atcab_state(ATCADevice device, bool create)
+{
+	atcab_state_t *state = (atcab_state_t *)atGetBasicData( device );
+
+	if ( state == NULL && create )
+	{
+#ifdef ATCAB_STATIC_STATES
+		if ( (state = _atcab_state_alloc()) == NULL )
+			return NULL;
+
+		memset( state, 0, sizeof(atcab_state_t) );
+		atSetBasicData( device, state, _atcab_state_release );
+#else
+		if ( (state = (atcab_state_t *)malloc( sizeof(atcab_state_t) )) == NULL )
+			return NULL;
+
+		memset( state, 0, sizeof(atcab_state_t) );
+		atSetBasicData( device, state, free );
+#endif
+	}
+
+	return state;
+}
+
+/** \brief take a command packet from the device's preallocated packets, so the functions issuing single
+ *  commands don't each put a packet on the stack.  Some of them call others (priv_write calls gendig_host),
+ *  so each device has a few.  The packets belong to the device like the rest of its state, so commands on
+ *  different devices never share one.  Should they run out the packet comes from the heap, unless the
+ *  states are static (ATCAB_STATIC_STATES), then the command fails.
+ *  \param[in] device - device the command is for
+ *  \return packet, NULL if none could be had.  Give it back with _atcab_packet_put().
+ */
+static ATCAPacket *_atcab_packet_get(ATCADevice device)
+{
+	atcab_state_t *state = device ? _atcab_state( device, true ) : NULL;
+	int i;
+
+	for ( i = 0; state && i < ATCAB_PACKET_POOL_SIZE; i++ )
+	{
+		if ( !(state->packets_used & (1u << i)) )
+		{
+			state->packets_used |= 1u << i;
+			return &state->packets[i];
+		}
+	}
+
+#ifdef ATCAB_STATIC_STATES
+	return NULL;
+#else
+	return (ATCAPacket *)malloc( sizeof(ATCAPacket) );
+#endif
+}
+
+/** \brief give back a packet taken with _atcab_packet_get()
+ *  \param[in] device - device the packet was taken for
+ *  \param[in] packet - packet to give back, may be NULL
+ */
+static void _atcab_packet_put(ATCADevice device, ATCAPacket *packet)
+{
+	atcab_state_t *state = device ? _atcab_state( device, false ) : NULL;
+
+	if ( packet == NULL )
+		return;
+
+	if ( state && packet >= state->packets && packet < state->packets + ATCAB_PACKET_POOL_SIZE )
+		state->packets_used &= ~(1u << (packet - state->packets));
+	else
+		free( packet );
+}
+
+/** \brief common command execution which wakes the device, sends a command packet built by one of the
+ *  ATCACommand methods, waits for the device to complete it and receives the response back into the packet.
+ *  Transient errors are retried by the interface, see atexecute().
+ *  When the interface observes when the device completes, the execution time model of the device is updated.
+ *  \param[in] device - device to execute the command on
+ *  \param[inout] packet - command packet to send, packet->data receives the response
+ *  \param[in] command - command being executed, used to look up its execution time
+ *  \return ATCA_STATUS
+ */
+static ATCA_STATUS _atcab_execute(ATCADevice device, ATCAPacket *packet, ATCA_CmdMap command)
+{
+	ATCA_STATUS status;
+	ATCACommand commands = atGetCommands( device );
+	ATCAIface iface = atGetIFace( device );
+	atcab_state_t *state = _atcab_state( device, false );
+	uint16_t execution_time = atGetExecTime( commands, command );
+	uint32_t predicted_us = atGetLearnedExecTime( commands, command );
+	uint32_t completion_us = predicted_us;
+
+	// the device is busy with an operation running in the background
+	if ( state != NULL && state->op.busy )
+		return ATCA_FUNC_FAIL;
+
+	if ( (status = atexecute( iface, packet, execution_time, &completion_us )) != ATCA_SUCCESS )
+		return status;
+
+	if ( completion_us != 0 )
+		atUpdateExecTime( commands, command, completion_us, completion_us > predicted_us );
+
+	return status;
+}
+
+/** \brief run an operation to completion, keeping the device awake for all of its commands
+ *  \param[inout] op - operation to run, with device, next and its parameters set up
+ *  \return ATCA_STATUS
+ */
+static ATCA_STATUS _atcab_run(atcab_op_t *op)
+{
+	ATCA_STATUS status;
+
+	if ( !op->device )
+		return ATCA_GEN_FAIL;
+
+	atcab_ctx_session_begin(op->device);
+
+	for ( op->step = 0; ; op->step++ )
+	{
+		op->command = CMD_LASTCOMMAND;
+		if ( (status = op->next(op)) != ATCA_SUCCESS || op->command == CMD_LASTCOMMAND )
+			break;
+
+		if ( (status = _atcab_execute( op->device, &op->packet, op->command )) != ATCA_SUCCESS )
+			break;
+	}
 
-/** \brief common cleanup code which idles the device after any operation
+	atcab_ctx_session_end(op->device);
+	return status;
+}
+
+/** \brief send the current command of a background operation and note when it was sent
+ *  \param[inout] op - background operation
  *  \return ATCA_STATUS
  */
-static ATCA_STATUS _atcab_exit(void)
+static ATCA_STATUS _atcab_async_send(atcab_op_t *op)
+{
+	ATCA_STATUS status;
+	ATCACommand commands = atGetCommands( op->device );
+	ATCAIface iface = atGetIFace( op->device );
+	uint16_t execution_time = atGetExecTime( commands, op->command );
+
+	op->attempt = 0;
+	status = atsendcmd( iface, &op->packet, execution_time );
+	if ( (status = atretry( iface, &op->packet, status, &op->attempt )) == ATCA_RX_NO_RESPONSE )
+		status = ATCA_SUCCESS;	// sent on a retry
+	if ( status != ATCA_SUCCESS )
+		return status;
+
+	op->sent_ticks = atca_ticks_ms();
+	op->polled_ticks = op->sent_ticks;
+
+	// without polling the response can only be read once the full execution time has passed
+	if ( atgetifacecfg( iface )->exec_mode == ATCA_EXEC_POLL )
+		op->first_poll_us = atGetLearnedExecTime( commands, op->command );
+	else
+		op->first_poll_us = (uint32_t)execution_time * 1000;
+	return ATCA_SUCCESS;
+}
+
+/** \brief start a background operation set up by one of the atcab_ctx_*_start() calls
+ *  \param[inout] op - background operation of the device, from _atcab_op_get()
+ *  \param[in] callback - called from atcab_ctx_poll() when done
+ *  \param[in] context - passed to the callback
+ *  \return ATCA_STATUS, the callback is only called if the operation started successfully
+ */
+static ATCA_STATUS _atcab_async_start(atcab_op_t *op, atcab_callback callback, void *context)
+{
+	ATCA_STATUS status;
+
+	op->callback = callback;
+	op->context = context;
+	op->step = 0;
+	op->command = CMD_LASTCOMMAND;
+
+	atcab_ctx_session_begin(op->device);
+	do {
+		if ( (status = op->next(op)) != ATCA_SUCCESS )
+			break;
+
+		// served without the device, e.g. from the pubkey cache, the next atcab_ctx_poll() completes it
+		if ( op->command == CMD_LASTCOMMAND )
+		{
+			op->sent_ticks = atca_ticks_ms();
+			op->polled_ticks = op->sent_ticks;
+			op->first_poll_us = 0;
+		}
+		else if ( (status = _atcab_async_send(op)) != ATCA_SUCCESS )
+			break;
+
+		op->busy = true;
+		return ATCA_SUCCESS;
+	} while(0);
+
+	atcab_ctx_session_end(op->device);
+	return status;
+}
+
+/** \brief get the operation of a device to set up a new operation in, blocking or in the background.
+ *  Running it in the device state rather than on the stack keeps its packet, and with it the response,
+ *  around after the operation returns.
+ *  \param[in] device - device to start the operation on
+ *  \param[out] op - cleared operation of the device
+ *  \return ATCA_STATUS, ATCA_FUNC_FAIL while a background operation is still running
+ */
+static ATCA_STATUS _atcab_op_get(ATCADevice device, atcab_op_t **op)
+{
+	atcab_state_t *state;
+
+	if ( !device )
+		return ATCA_GEN_FAIL;
+
+	if ( (state = _atcab_state( device, true )) == NULL )
+		return ATCA_GEN_FAIL;
+
+	if ( state->op.busy )
+		return ATCA_FUNC_FAIL;
+
+	memset( &state->op, 0, sizeof(state->op) );
+	state->op.device = device;
+	*op = &state->op;
+	return ATCA_SUCCESS;
+}
+
+/** \brief end a background operation and call its callback
+ *  \param[inout] op - background operation of the device
+ *  \param[in] status - final status of the operation
+ *  \return status
+ */
+static ATCA_STATUS _atcab_async_done(atcab_op_t *op, ATCA_STATUS status)
+{
+	op->busy = false;
+	atcab_ctx_session_end(op->device);
+
+	if ( op->callback )
+		op->callback( status, op->context );
+
+	return status;
+}
+
+/** \brief advance the background operation started on a device by one of the atcab_ctx_*_start()
+ *  calls.  Call this from the application main loop.  It never blocks for the execution time of a
+ *  command, it only reads the response once the device should have it ready according to the
+ *  atca_ticks_ms() tick counter, and then sends the next command of the operation.  When the
+ *  operation completes, the callback given to the start call is invoked with the final status.
+ *  \param[in] device - device to operate on
+ *  \return ATCA_RX_NO_RESPONSE while the operation is running, otherwise its final status.
+ *          ATCA_SUCCESS if no operation is running.
+ */
+ATCA_STATUS atcab_ctx_poll(ATCADevice device)
 {
-	return atcab_idle();
+	atcab_state_t *state;
+	atcab_op_t *op;
+	ATCA_STATUS status;
+	uint32_t now = atca_ticks_ms();
+	uint32_t elapsed_us;
+
+	if ( !device || (state = _atcab_state( device, false )) == NULL || !state->op.busy )
+		return ATCA_SUCCESS;
+	op = &state->op;
+
+	// an operation served without the device has no command in flight
+	if ( op->command == CMD_LASTCOMMAND )
+		return _atcab_async_done(op, ATCA_SUCCESS);
+
+	// poll the device at most once per tick, and only once the command could be done
+	if ( now == op->polled_ticks )
+		return ATCA_RX_NO_RESPONSE;
+	op->polled_ticks = now;
+
+	// the send may have happened late in a tick, so one tick less is what has elapsed for sure
+	elapsed_us = (now - op->sent_ticks - 1) * 1000;
+	if ( elapsed_us < op->first_poll_us )
+		return ATCA_RX_NO_RESPONSE;
+
+	status = atpollreceive( atGetIFace(device), atGetExecTime( atGetCommands(device), op->command ), elapsed_us, op->packet.data, &op->packet.rxsize );
+	if ( status == ATCA_RX_NO_RESPONSE )
+		return status;
+
+	// on a transient error the response is read again, or the command sent again if the device never ran it
+	if ( (status = atretry( atGetIFace(device), &op->packet, status, &op->attempt )) == ATCA_RX_NO_RESPONSE )
+	{
+		op->sent_ticks = atca_ticks_ms();
+		op->polled_ticks = op->sent_ticks;
+		return status;
+	}
+
+	if ( status == ATCA_SUCCESS )
+	{
+		op->step++;
+		op->command = CMD_LASTCOMMAND;
+		status = op->next(op);
+		if ( status == ATCA_SUCCESS && op->command != CMD_LASTCOMMAND )
+		{
+			if ( (status = _atcab_async_send(op)) == ATCA_SUCCESS )
+				return ATCA_RX_NO_RESPONSE;
+		}
+	}
+
+	return _atcab_async_done(op, status);
+}
+
+/** \brief atcab_ctx_poll() on the default device */
+ATCA_STATUS atcab_poll(void)
+{
+	return atcab_ctx_poll(_gDevice);
+}
+
+/** \brief whether an operation started on a device with one of the atcab_ctx_*_start() calls is still running
+ *  \param[in] device - device to operate on
+ *  \return true while atcab_ctx_poll() needs to be called
+ */
+bool atcab_ctx_busy(ATCADevice device)
+{
+	atcab_state_t *state;
+
+	if ( !device || (state = _atcab_state( device, false )) == NULL )
+		return false;
+
+	return state->op.busy;
+}
+
+/** \brief when the response to the command a background operation is executing on a device is due.
+ *  atcab_ctx_poll() doesn't touch the bus before then.
+ *  \param[in] device - device to operate on
+ *  \param[out] due_ticks - atca_ticks_ms() value from which on the response can be read
+ *  \return true if an operation is running on the device
+ */
+bool atcab_ctx_due(ATCADevice device, uint32_t *due_ticks)
+{
+	atcab_state_t *state;
+	atcab_op_t *op;
+
+	if ( !atcab_ctx_busy(device) )
+		return false;
+
+	state = _atcab_state( device, false );
+	op = &state->op;
+
+	// same rounding as atcab_ctx_poll(), which counts one tick less than has passed since the send
+	*due_ticks = op->sent_ticks + 1 + (op->first_poll_us + 999) / 1000;
+
+	// a device that was already polled and still busy is polled again on the next tick
+	if ( (int32_t)(*due_ticks - op->polled_ticks) <= 0 )
+		*due_ticks = op->polled_ticks + 1;
+	return true;
+}
+
+/** \brief atcab_ctx_busy() on the default device */
+bool atcab_busy(void)
+{
+	return atcab_ctx_busy(_gDevice);
 }
 
 
 /** \brief get the device revision information
+ *  \param[in] device - device to operate on
  *  \param[out] revision - 4-byte storage for receiving the revision number from the device
  *  \return ATCA_STATUS
  */
 
-ATCA_STATUS atcab_info( uint8_t *revision )
+ATCA_STATUS atcab_ctx_info(ATCADevice device, uint8_t *revision)
 {
-	ATCAPacket packet;
+	ATCAPacket *packet = NULL;
 	ATCA_STATUS status = ATCA_GEN_FAIL;
-	uint32_t execution_time;
 	
-	if ( !_gDevice )
+	if ( !device )
+		return ATCA_GEN_FAIL;
+
+	if ( (packet = _atcab_packet_get(device)) == NULL )
 		return ATCA_GEN_FAIL;
 
 	// build an info command
-	packet.param1 = INFO_MODE_REVISION;  
-	packet.param2 = 0;
+	packet->param1 = INFO_MODE_REVISION;  
+	packet->param2 = 0;
 
 	do {
-		if ( (status = atInfo( _gCommandObj, &packet )) != ATCA_SUCCESS )
-			break;
-
-		execution_time = atGetExecTime( _gCommandObj, CMD_INFO);
-
-		if ( (status = atcab_wakeup()) != ATCA_SUCCESS )
-			break;
-		
-		// send the command
-		if ( (status = atsend( _gIface, (uint8_t *)&packet, packet.txsize )) != ATCA_SUCCESS )
+		if ( (status = atInfo( atGetCommands(device), packet )) != ATCA_SUCCESS )
 			break;
-			
-		// delay the appropriate amount of time for command to execute
-		atca_delay_ms(execution_time);
 
-		// receive the response
-		if ( (status = atreceive( _gIface, &(packet.data[0]), &(packet.rxsize) )) != ATCA_SUCCESS )
+		if ( (status = _atcab_execute( device, packet, CMD_INFO )) != ATCA_SUCCESS )
 			break;
             
-        if ( (status = isATCAError(packet.data)) != ATCA_SUCCESS )
+        if ( (status = isATCAError(packet->data)) != ATCA_SUCCESS )
             break;
         
-		memcpy( revision, &packet.data[1], 4 );  // don't include the receive length, only payload
+		memcpy( revision, &packet->data[1], 4 );  // don't include the receive length, only payload
 	} while(0);
 	
-	_atcab_exit();
+	_atcab_exit(device);
 	
+	_atcab_packet_put(device, packet);
 	return status;		
 }
 
+/** \brief atcab_ctx_info() on the default device */
+ATCA_STATUS atcab_info(uint8_t *revision)
+{
+	return atcab_ctx_info(_gDevice, revision);
+}
+
+/** \brief step function of the random operation, see atcab_op_t */
+static ATCA_STATUS _atcab_random_next(atcab_op_t *op)
+{
+	ATCA_STATUS status;
+
+	if ( op->step == 0 )
+	{
+		// build an random command
+		op->packet.param1 = RANDOM_SEED_UPDATE;
+		op->packet.param2 = 0x0000;
+		op->command = CMD_RANDOM;
+		return atRandom( atGetCommands(op->device), &op->packet );
+	}
+
+	if ( (status = isATCAError(op->packet.data)) != ATCA_SUCCESS )
+		return status;
+
+	if ( op->out )
+		memcpy( op->out, &op->packet.data[1], 32 );  // data[0] is the length byte of the response
+	return ATCA_SUCCESS;
+}
+
+/** \brief run the operation set up in op and hand out a view of the data of its response
+ *  \param[inout] op - operation of the device, from _atcab_op_get()
+ *  \param[out] view - receives a pointer to the response data in the device's packet, NULL on failure
+ *  \return ATCA_STATUS
+ */
+static ATCA_STATUS _atcab_run_view(atcab_op_t *op, const uint8_t **view)
+{
+	ATCA_STATUS status = _atcab_run(op);
+
+	*view = (status == ATCA_SUCCESS) ? &op->packet.data[ATCA_RSP_DATA_IDX] : NULL;
+	return status;
+}
+
 /** \brief Get a 32 byte random number from the CryptoAuth device
+ *	\param[in] device - device to operate on
  *	\param[out] rand_out ptr to 32 bytes of storage for random number
  *	\return status of the operation
  */
+ATCA_STATUS atcab_ctx_random(ATCADevice device, uint8_t *rand_out)
+{
+	ATCA_STATUS status;
+	const uint8_t *random;
+
+	if ( (status = atcab_ctx_random_view(device, &random)) == ATCA_SUCCESS )
+		memcpy( rand_out, random, 32 );
+	return status;
+}
+
+/** \brief Get a 32 byte random number from the CryptoAuth device without copying it out of the response
+ *	\param[in] device - device to operate on
+ *	\param[out] rand_out receives a pointer to the 32 random bytes in the response, which stays valid until
+ *	                     the next command on the device
+ *	\return status of the operation
+ */
+ATCA_STATUS atcab_ctx_random_view(ATCADevice device, const uint8_t **rand_out)
+{
+	ATCA_STATUS status;
+	atcab_op_t *op;
+
+	if ( (status = _atcab_op_get(device, &op)) != ATCA_SUCCESS )
+		return status;
+
+	op->next = _atcab_random_next;
+	return _atcab_run_view(op, rand_out);
+}
+
+/** \brief atcab_ctx_random() on the default device */
 ATCA_STATUS atcab_random(uint8_t *rand_out)
 {
-	ATCA_STATUS status = ATCA_GEN_FAIL;
-	ATCAPacket packet;
-	uint16_t execution_time = 0;
-	
-	if ( !_gDevice )
+	return atcab_ctx_random(_gDevice, rand_out);
+}
+
+/** \brief atcab_ctx_random_view() on the default device */
+ATCA_STATUS atcab_random_view(const uint8_t **rand_out)
+{
+	return atcab_ctx_random_view(_gDevice, rand_out);
+}
+
+/** \brief start getting a 32 byte random number from the CryptoAuth device in the background
+ *	\param[in] device - device to operate on
+ *	\param[out] rand_out ptr to 32 bytes of storage for random number, must stay valid until the callback
+ *	\param[in] callback called from atcab_ctx_poll() when done, may be NULL
+ *	\param[in] context passed to the callback
+ *	\return status of starting the operation
+ */
+ATCA_STATUS atcab_ctx_random_start(ATCADevice device, uint8_t *rand_out, atcab_callback callback, void *context)
+{
+	ATCA_STATUS status;
+	atcab_op_t *op;
+
+	if ( (status = _atcab_op_get(device, &op)) != ATCA_SUCCESS )
+		return status;
+
+	op->next = _atcab_random_next;
+	op->out = rand_out;
+	return _atcab_async_start(op, callback, context);
+}
+
+/** \brief atcab_ctx_random_start() on the default device */
+ATCA_STATUS atcab_random_start(uint8_t *rand_out, atcab_callback callback, void *context)
+{
+	return atcab_ctx_random_start(_gDevice, rand_out, callback, context);
+}
+
+/** \brief add random bytes to the pool of a device, there has to be room for them */
+static void _atcab_random_push(atcab_state_t *state, const uint8_t *data, uint16_t len)
+{
+	uint16_t i, tail = (state->rand_head + state->rand_count) % ATCAB_RANDOM_POOL_SIZE;
+
+	for ( i = 0; i < len; i++ )
+		state->rand_pool[(tail + i) % ATCAB_RANDOM_POOL_SIZE] = data[i];
+	state->rand_count += len;
+}
+
+/** \brief take random bytes out of the pool of a device, wiping them from the pool
+ *  \return number of bytes taken, less than len when the pool runs out
+ */
+static uint16_t _atcab_random_take(atcab_state_t *state, uint8_t *out, size_t len)
+{
+	uint16_t i, count = (len < state->rand_count) ? (uint16_t)len : state->rand_count;
+
+	for ( i = 0; i < count; i++ )
+	{
+		out[i] = state->rand_pool[state->rand_head];
+		state->rand_pool[state->rand_head] = 0;
+		state->rand_head = (state->rand_head + 1) % ATCAB_RANDOM_POOL_SIZE;
+	}
+	state->rand_count -= count;
+	return count;
+}
+
+/** \brief completion callback of a background refill of the random pool */
+static void _atcab_random_refilled(ATCA_STATUS status, void *context)
+{
+	atcab_state_t *state = _atcab_state( (ATCADevice)context, false );
+
+	if ( state == NULL )
+		return;
+
+	state->rand_refill = false;
+	if ( status == ATCA_SUCCESS && ATCAB_RANDOM_POOL_SIZE - state->rand_count >= RANDOM_NUM_SIZE )
+		_atcab_random_push( state, state->rand_fill, RANDOM_NUM_SIZE );
+	memset( state->rand_fill, 0, sizeof(state->rand_fill) );
+}
+
+/** \brief top up the random pool of a device, call this from the application's idle loop.  Each call
+ *  either starts a Random command in the background, while the pool has room for its output, or polls the
+ *  one running.  It never waits for the device.  Nothing is done while another background operation runs.
+ *  \param[in] device - device to operate on
+ *  \return ATCA_STATUS
+ */
+ATCA_STATUS atcab_ctx_random_idle(ATCADevice device)
+{
+	ATCA_STATUS status;
+	atcab_state_t *state;
+
+	if ( device == NULL || (state = _atcab_state( device, true )) == NULL )
 		return ATCA_GEN_FAIL;
 
-	// build an random command
-	packet.param1 = RANDOM_SEED_UPDATE;
-	packet.param2 = 0x0000;
-	status = atRandom( _gCommandObj, &packet );
-	execution_time = atGetExecTime( _gCommandObj, CMD_RANDOM);
+	if ( state->op.busy )
+	{
+		if ( !state->rand_refill )
+			return ATCA_SUCCESS;
+		status = atcab_ctx_poll(device);
+		return (status == ATCA_RX_NO_RESPONSE) ? ATCA_SUCCESS : status;
+	}
 
-	do {
-		if ( (status = atcab_wakeup()) != ATCA_SUCCESS )
-			break;
-		
-		// send the command
-		if ( (status = atsend( _gIface, (uint8_t *)&packet, packet.txsize )) != ATCA_SUCCESS) 
+	if ( ATCAB_RANDOM_POOL_SIZE - state->rand_count < RANDOM_NUM_SIZE )
+		return ATCA_SUCCESS;
+
+	state->rand_refill = true;
+	if ( (status = atcab_ctx_random_start(device, state->rand_fill, _atcab_random_refilled, device)) != ATCA_SUCCESS )
+		state->rand_refill = false;
+	return status;
+}
+
+/** \brief atcab_ctx_random_idle() on the default device */
+ATCA_STATUS atcab_random_idle(void)
+{
+	return atcab_ctx_random_idle(_gDevice);
+}
+
+/** \brief random bytes from the device, from the pool as far as it goes and from Random commands for the
+ *  rest.  The bytes of the last command not needed are kept in the pool.
+ *  \param[in] device - device to operate on
+ *  \param[inout] state - basic API state of the device
+ *  \param[out] out - receives the random bytes
+ *  \param[in] len - number of bytes
+ *  \return ATCA_STATUS
+ */
+static ATCA_STATUS _atcab_random_fetch(ATCADevice device, atcab_state_t *state, uint8_t *out, size_t len)
+{
+	ATCA_STATUS status = ATCA_SUCCESS;
+	uint8_t number[RANDOM_NUM_SIZE];
+	size_t done;
+
+	// a refill about to complete is worth waiting for rather than starting another command
+	while ( len > state->rand_count && state->op.busy && state->rand_refill )
+	{
+		if ( (status = atcab_ctx_poll(device)) == ATCA_RX_NO_RESPONSE )
+			atca_delay_us(ATCA_POLL_INTERVAL_US);
+	}
+
+	done = _atcab_random_take(state, out, len);
+	if ( done == len )
+		return ATCA_SUCCESS;
+
+	atcab_ctx_session_begin(device);
+	while ( done < len )
+	{
+		if ( (status = atcab_ctx_random(device, number)) != ATCA_SUCCESS )
 			break;
 
-		// delay the appropriate amount of time for command to execute
-		atca_delay_ms(execution_time);
+		if ( len - done >= RANDOM_NUM_SIZE )
+		{
+			memcpy( &out[done], number, RANDOM_NUM_SIZE );
+			done += RANDOM_NUM_SIZE;
+		}
+		else
+		{
+			memcpy( &out[done], number, len - done );
+			_atcab_random_push( state, &number[len - done], (uint16_t)(RANDOM_NUM_SIZE - (len - done)) );
+			done = len;
+		}
+	}
+	atcab_ctx_session_end(device);
 
-		// receive the response
-		if ( (status = atreceive( _gIface, packet.data, &packet.rxsize)) != ATCA_SUCCESS)
+	memset( number, 0, sizeof(number) );
+	return status;
+}
+
+/** \brief get any number of random bytes.  They are taken from the random pool of the device, so with the
+ *  pool kept topped up by atcab_ctx_random_idle() they cost a copy rather than a Random command.  After
+ *  atcab_ctx_random_drbg() they come from an HMAC-DRBG instead, reseeded from the pool.
+ *  \param[in] device - device to operate on
+ *  \param[out] out - receives the random bytes
+ *  \param[in] len - number of bytes
+ *  \return ATCA_STATUS
+ */
+ATCA_STATUS atcab_ctx_random_bytes(ATCADevice device, uint8_t *out, size_t len)
+{
+	ATCA_STATUS status = ATCA_SUCCESS;
+	atcab_state_t *state;
+	uint8_t seed[ATCAC_DRBG_SEED_SIZE];
+	size_t count;
+
+	if ( out == NULL && len > 0 )
+		return ATCA_BAD_PARAM;
+	if ( device == NULL || (state = _atcab_state( device, true )) == NULL )
+		return ATCA_GEN_FAIL;
+
+	if ( !state->rand_drbg )
+		return _atcab_random_fetch(device, state, out, len);
+
+	while ( len > 0 && status == ATCA_SUCCESS )
+	{
+		if ( state->drbg.reseed_counter > ATCAB_DRBG_RESEED_INTERVAL )
+		{
+			if ( (status = _atcab_random_fetch(device, state, seed, sizeof(seed))) != ATCA_SUCCESS )
+				break;
+			status = atcac_hmac_drbg_reseed(&state->drbg, seed, sizeof(seed));
+			memset( seed, 0, sizeof(seed) );
+			continue;
+		}
+
+		count = (len < ATCAC_DRBG_MAX_REQUEST) ? len : ATCAC_DRBG_MAX_REQUEST;
+		if ( (status = atcac_hmac_drbg_generate(&state->drbg, out, count)) != ATCA_SUCCESS )
 			break;
-        
-        if ( (status = isATCAError(packet.data)) != ATCA_SUCCESS )
-            break;
-	
-		memcpy( rand_out, &packet.data[1], 32 );  // data[0] is the length byte of the response
-	} while(0);
-	
-	_atcab_exit();
+		out += count;
+		len -= count;
+	}
+
 	return status;
 }
 
+/** \brief atcab_ctx_random_bytes() on the default device */
+ATCA_STATUS atcab_random_bytes(uint8_t *out, size_t len)
+{
+	return atcab_ctx_random_bytes(_gDevice, out, len);
+}
+
+/** \brief have atcab_ctx_random_bytes() stretch the device's random numbers through an HMAC-DRBG.  The
+ *  DRBG is instantiated from 48 bytes of device output, entropy and nonce, and reseeded with 32 more every
+ *  ATCAB_DRBG_RESEED_INTERVAL requests.
+ *  \param[in] device - device to operate on
+ *  \param[in] enable - use the DRBG, false to go back to handing out the device's output directly
+ *  \return ATCA_STATUS
+ */
+ATCA_STATUS atcab_ctx_random_drbg(ATCADevice device, bool enable)
+{
+	ATCA_STATUS status = ATCA_SUCCESS;
+	atcab_state_t *state;
+	uint8_t seed[ATCAC_DRBG_SEED_SIZE + ATCAC_DRBG_SEED_SIZE / 2];
+
+	if ( device == NULL || (state = _atcab_state( device, true )) == NULL )
+		return ATCA_GEN_FAIL;
+
+	state->rand_drbg = false;
+	memset( &state->drbg, 0, sizeof(state->drbg) );
+	if ( !enable )
+		return ATCA_SUCCESS;
+
+	if ( (status = _atcab_random_fetch(device, state, seed, sizeof(seed))) == ATCA_SUCCESS
+	     && (status = atcac_hmac_drbg_init(&state->drbg, seed, sizeof(seed))) == ATCA_SUCCESS )
+		state->rand_drbg = true;
+
+	memset( seed, 0, sizeof(seed) );
+	return status;
+}
+
+/** \brief atcab_ctx_random_drbg() on the default device */
+ATCA_STATUS atcab_random_drbg(bool enable)
+{
+	return atcab_ctx_random_drbg(_gDevice, enable);
+}
+
+/** \brief serial number of the device of an operation, which keys the entries of its pubkey cache.  The
+ *  first step of an operation reads it with atcab_ctx_read_serial_number(), which fills the config zone
+ *  shadow.  The later steps run from atcab_ctx_poll() with a command of the operation in flight and take
+ *  it from the shadow, they can't send a command of their own.
+ *  \param[in] op - operation of the device
+ *  \param[out] serial - receives the serial number
+ *  \return the state of the device, which holds its pubkey cache, NULL if the serial number isn't at hand
+ */
+static atcab_state_t *_atcab_pubkey_serial(atcab_op_t *op, uint8_t *serial)
+{
+	atcab_state_t *state = _atcab_state( op->device, false );
+
+	if ( state == NULL )
+		return NULL;
+
+	if ( op->step == 0 )
+		return atcab_ctx_read_serial_number( op->device, serial ) == ATCA_SUCCESS ? state : NULL;
+
+	if ( !state->config_valid )
+		return NULL;
+
+	// SN[0:3] and SN[4:8] are config bytes 0-3 and 8-12
+	memcpy( serial, &state->config[0], 4 );
+	memcpy( &serial[4], &state->config[8], ATCA_SERIAL_NUM_SIZE - 4 );
+	return state;
+}
+
+/** \brief look up the public key of a slot in the pubkey cache of a device
+ *  \param[in] state - state of the device the slot is on
+ *  \param[in] serial - serial number of the device
+ *  \param[in] slot - slot of the key
+ *  \param[in] stored - a public key stored in the slot, otherwise one calculated from its private key
+ *  \return the cache entry, NULL if the key isn't cached
+ */
+static atcab_pubkey_t *_atcab_pubkey_find(atcab_state_t *state, const uint8_t *serial, uint8_t slot, bool stored)
+{
+	int i;
+
+	for ( i = 0; i < ATCAB_PUBKEY_CACHE_SIZE; i++ )
+	{
+		atcab_pubkey_t *entry = &state->pubkeys[i];
+
+		if ( entry->valid && entry->slot == slot && entry->stored == stored
+		     && memcmp( entry->serial, serial, ATCA_SERIAL_NUM_SIZE ) == 0 )
+			return entry;
+	}
+
+	return NULL;
+}
+
+/** \brief put the public key of a slot into the pubkey cache of a device, replacing the entries in turn
+ *  when it's full
+ *  \param[in] state - state of the device the slot is on
+ *  \param[in] serial - serial number of the device
+ *  \param[in] slot - slot of the key
+ *  \param[in] stored - a public key stored in the slot, otherwise one calculated from its private key
+ *  \param[in] pubkey - the 64 byte public key
+ */
+static void _atcab_pubkey_put(atcab_state_t *state, const uint8_t *serial, uint8_t slot, bool stored, const uint8_t *pubkey)
+{
+	atcab_pubkey_t *entry;
+	int i;
+
+	if ( (entry = _atcab_pubkey_find(state, serial, slot, stored)) == NULL )
+	{
+		for ( i = 0; i < ATCAB_PUBKEY_CACHE_SIZE && state->pubkeys[i].valid; i++ )
+			;
+		if ( i == ATCAB_PUBKEY_CACHE_SIZE )
+		{
+			i = state->pubkey_victim;
+			state->pubkey_victim = (state->pubkey_victim + 1) % ATCAB_PUBKEY_CACHE_SIZE;
+		}
+
+		entry = &state->pubkeys[i];
+		memcpy( entry->serial, serial, ATCA_SERIAL_NUM_SIZE );
+		entry->slot = slot;
+		entry->stored = stored;
+		entry->valid = true;
+	}
+
+	memcpy( entry->pubkey, pubkey, ATCA_PUB_KEY_SIZE );
+}
+
+/** \brief drop the public keys of a slot from the pubkey cache of a device, ahead of a command that may
+ *  change the key in the slot
+ *  \param[in] device - device the slot is on
+ *  \param[in] slot - slot that may change
+ */
+static void _atcab_pubkey_drop(ATCADevice device, uint8_t slot)
+{
+	atcab_state_t *state = _atcab_state( device, false );
+	int i;
+
+	for ( i = 0; state && i < ATCAB_PUBKEY_CACHE_SIZE; i++ )
+	{
+		if ( state->pubkeys[i].slot == slot )
+			state->pubkeys[i].valid = false;
+	}
+}
+
+/** \brief step function of the genkey operation, see atcab_op_t */
+static ATCA_STATUS _atcab_genkey_next(atcab_op_t *op)
+{
+	ATCA_STATUS status;
+	atcab_state_t *state;
+	uint8_t serial[ATCA_SERIAL_NUM_SIZE];
+
+	if ( op->step == 0 )
+	{
+		// the last step can only take the serial number from the config zone shadow, fill it now
+		_atcab_pubkey_serial(op, serial);
+
+		// build a genkey command
+		op->packet.param1 = GENKEY_MODE_PRIVATE_KEY_GENERATE;   // a random private key is generated and stored in slot keyID
+		op->packet.param2 = op->key_id;   // slot and KeyID are the same thing
+		op->command = CMD_GENKEY;
+		return atGenKey( atGetCommands(op->device), &op->packet, false );
+	}
+
+	if ( (status = isATCAError(op->packet.data)) != ATCA_SUCCESS )
+		return status;
+
+	if ( (state = _atcab_pubkey_serial(op, serial)) != NULL )
+		_atcab_pubkey_put( state, serial, (uint8_t)op->key_id, false, &op->packet.data[1] );
+	if ( op->out )
+		memcpy( op->out, &op->packet.data[1], 64 );
+	return ATCA_SUCCESS;
+}
+
 /** \brief generate a key on given slot
+ *   \param[in] device - device to operate on
+ *   \param[in] slot number where ECC key is configured
+ *   \param[out] 64 bytes of returned public key for given slot
+ *   \return ATCA_STATUS
+ */
+ATCA_STATUS atcab_ctx_genkey(ATCADevice device, int slot, uint8_t *pubkey)
+{
+	ATCA_STATUS status;
+	const uint8_t *key;
+
+	if ( (status = atcab_ctx_genkey_view(device, slot, &key)) == ATCA_SUCCESS )
+		memcpy( pubkey, key, 64 );
+	return status;
+}
+
+/** \brief generate a key on given slot, without copying the public key out of the response
+ *   \param[in] device - device to operate on
  *   \param[in] slot number where ECC key is configured
- *   \param[out] 64 bytes of returned public key for given slot
+ *   \param[out] pubkey receives a pointer to the 64 byte public key in the response, which stays valid until
+ *                      the next command on the device
  *   \return ATCA_STATUS
  */
-ATCA_STATUS atcab_genkey( int slot, uint8_t *pubkey )
+ATCA_STATUS atcab_ctx_genkey_view(ATCADevice device, int slot, const uint8_t **pubkey)
 {
-	ATCAPacket packet;
-	uint16_t execution_time = 0;
-	ATCA_STATUS status = ATCA_GEN_FAIL;
-	
-	// build a genkey command
-	packet.param1 = GENKEY_MODE_PRIVATE_KEY_GENERATE;   // a random private key is generated and stored in slot keyID
-	packet.param2 = (uint16_t)slot;   // slot and KeyID are the same thing
-	
-	do {			
-		if ( (status = atGenKey( _gCommandObj, &packet, false )) != ATCA_SUCCESS ) 
-			break;
+	ATCA_STATUS status;
+	atcab_op_t *op;
 
-		execution_time = atGetExecTime( _gCommandObj, CMD_GENKEY);
+	if ( (status = _atcab_op_get(device, &op)) != ATCA_SUCCESS )
+		return status;
 
-		if ( (status = atcab_wakeup()) != ATCA_SUCCESS )
-			break;
-			
-		// send the command
-		if ( (status = atsend( _gIface, (uint8_t *)&packet, packet.txsize )) != ATCA_SUCCESS ) 
-			break;
+	op->next = _atcab_genkey_next;
+	op->key_id = (uint16_t)slot;
+	_atcab_pubkey_drop( device, (uint8_t)slot );
+	return _atcab_run_view(op, pubkey);
+}
 
-		// delay the appropriate amount of time for command to execute
-		atca_delay_ms(execution_time);
+/** \brief atcab_ctx_genkey() on the default device */
+ATCA_STATUS atcab_genkey(int slot, uint8_t *pubkey)
+{
+	return atcab_ctx_genkey(_gDevice, slot, pubkey);
+}
 
-		// receive the response
-		if ( (status = atreceive( _gIface, packet.data, &(packet.rxsize) )) != ATCA_SUCCESS )
-			break;
+/** \brief atcab_ctx_genkey_view() on the default device */
+ATCA_STATUS atcab_genkey_view(int slot, const uint8_t **pubkey)
+{
+	return atcab_ctx_genkey_view(_gDevice, slot, pubkey);
+}
 
-		if ( (status = isATCAError(packet.data)) != ATCA_SUCCESS )
-			break;
+/** \brief start generating a key on given slot in the background
+ *   \param[in] device - device to operate on
+ *   \param[in] slot number where ECC key is configured
+ *   \param[out] 64 bytes of returned public key for given slot, must stay valid until the callback
+ *   \param[in] callback called from atcab_ctx_poll() when done, may be NULL
+ *   \param[in] context passed to the callback
+ *   \return ATCA_STATUS
+ */
+ATCA_STATUS atcab_ctx_genkey_start(ATCADevice device, int slot, uint8_t *pubkey, atcab_callback callback, void *context)
+{
+	ATCA_STATUS status;
+	atcab_op_t *op;
 
-		memcpy(pubkey, &packet.data[1], 64 );
-	} while(0);
-	
-	_atcab_exit();
-	return status;
+	if ( (status = _atcab_op_get(device, &op)) != ATCA_SUCCESS )
+		return status;
+
+	op->next = _atcab_genkey_next;
+	op->key_id = (uint16_t)slot;
+	op->out = pubkey;
+	_atcab_pubkey_drop( device, (uint8_t)slot );
+	return _atcab_async_start(op, callback, context);
+}
+
+/** \brief atcab_ctx_genkey_start() on the default device */
+ATCA_STATUS atcab_genkey_start(int slot, uint8_t *pubkey, atcab_callback callback, void *context)
+{
+	return atcab_ctx_genkey_start(_gDevice, slot, pubkey, callback, context);
 }
 
 /** \brief Execute a pass-through Nonce command to initialize TempKey to the specified value
+ *  \param[in] device - device to operate on
  *  \param[in] tempkey - pointer to 32 bytes of data which will be used to initialize TempKey
  *  \return ATCA_STATUS
  */
+ATCA_STATUS atcab_ctx_nonce(ATCADevice device, const uint8_t *tempkey)
+{
+	return atcab_ctx_challenge(device, tempkey);
+}
+
+/** \brief atcab_ctx_nonce() on the default device */
 ATCA_STATUS atcab_nonce(const uint8_t *tempkey)
 {
-	return atcab_challenge(tempkey);
+	return atcab_ctx_nonce(_gDevice, tempkey);
 }
 
 /** \brief Initialize TempKey with a random Nonce
+ *  \param[in] device - device to operate on
  *  \param[in] seed - pointer to 20 bytes of data which will be used to calculate TempKey
  *  \param[out] rand_out - pointer to 32 bytes of data that is the output of the Nonce command
  *  \return ATCA_STATUS
  */
+ATCA_STATUS atcab_ctx_nonce_rand(ATCADevice device, const uint8_t *seed, uint8_t* rand_out)
+{
+	return atcab_ctx_challenge_seed_update(device, seed, rand_out);
+}
+
+/** \brief atcab_ctx_nonce_rand() on the default device */
 ATCA_STATUS atcab_nonce_rand(const uint8_t *seed, uint8_t* rand_out)
 {
-	return atcab_challenge_seed_update(seed, rand_out);
+	return atcab_ctx_nonce_rand(_gDevice, seed, rand_out);
 }
 
 /** \brief send a challenge to the device (a pass-through nonce)
+ *  \param[in] device - device to operate on
  *  \param[in] challenge - pointer to 32 bytes of data which will be sent as the challenge
  *  \return ATCA_STATUS
  */
-ATCA_STATUS atcab_challenge(const uint8_t *challenge)
+ATCA_STATUS atcab_ctx_challenge(ATCADevice device, const uint8_t *challenge)
 {
 	ATCA_STATUS status = ATCA_GEN_FAIL;
-	ATCAPacket packet;
-	uint16_t execution_time = 0;
+	ATCAPacket *packet = NULL;
 
 	do
 	{
@@ -353,49 +1342,46 @@ ATCA_STATUS atcab_challenge(const uint8_t *challenge)
 			break;
 		}
 
-		// build a nonce command (pass through mode)
-		packet.param1 = NONCE_MODE_PASSTHROUGH;
-		packet.param2 = 0x0000;
-		memcpy( packet.data, challenge, 32 );
-
-		if ((status = atNonce( _gCommandObj, &packet )) != ATCA_SUCCESS )
-			break;
+		if ( (packet = _atcab_packet_get(device)) == NULL )
+			return ATCA_GEN_FAIL;
 
-		execution_time = atGetExecTime( _gCommandObj, CMD_NONCE);
-	
-		if ((status = atcab_wakeup()) != ATCA_SUCCESS )
-			break;
+		// build a nonce command (pass through mode)
+		packet->param1 = NONCE_MODE_PASSTHROUGH;
+		packet->param2 = 0x0000;
+		memcpy( packet->data, challenge, 32 );
 
-		// send the command
-		if ((status = atsend( _gIface, (uint8_t *)&packet, packet.txsize)) != ATCA_SUCCESS )
+		if ((status = atNonce( atGetCommands(device), packet )) != ATCA_SUCCESS )
 			break;
 
-		// delay the appropriate amount of time for command to execute
-		atca_delay_ms(execution_time);
-
-		// receive the response
-		if ((status = atreceive( _gIface, packet.data, &(packet.rxsize))) != ATCA_SUCCESS )
+		if ( (status = _atcab_execute( device, packet, CMD_NONCE )) != ATCA_SUCCESS )
 			break;
 
-		if ( (status = isATCAError(packet.data)) != ATCA_SUCCESS )
+		if ( (status = isATCAError(packet->data)) != ATCA_SUCCESS )
 			break;
 
 	} while(0);
 
-	_atcab_exit();
+	_atcab_exit(device);
+	_atcab_packet_put(device, packet);
 	return status;
 }
 
+/** \brief atcab_ctx_challenge() on the default device */
+ATCA_STATUS atcab_challenge(const uint8_t *challenge)
+{
+	return atcab_ctx_challenge(_gDevice, challenge);
+}
+
 /** \brief send a challenge to the device (a seed update nonce)
+ *  \param[in] device - device to operate on
  *  \param[in] seed - pointer to 32 bytes of data which will be sent as the challenge
  *  \param[out] rand_out - points to space to receive random number
  *  \return ATCA_STATUS
  */
-ATCA_STATUS atcab_challenge_seed_update( const uint8_t *seed, uint8_t* rand_out )
+ATCA_STATUS atcab_ctx_challenge_seed_update(ATCADevice device, const uint8_t *seed, uint8_t* rand_out)
 {
 	ATCA_STATUS status = ATCA_GEN_FAIL;
-	ATCAPacket packet;
-	uint16_t execution_time = 0;
+	ATCAPacket *packet = NULL;
 
 	do
 	{
@@ -406,41 +1392,41 @@ ATCA_STATUS atcab_challenge_seed_update( const uint8_t *seed, uint8_t* rand_out
 			break;
 		}
 
-		// build a nonce command (pass through mode)
-		packet.param1 = NONCE_MODE_SEED_UPDATE;
-		packet.param2 = 0x0000;
-		memcpy( packet.data, seed, 20 );
-
-		if ((status = atNonce(_gCommandObj, &packet)) != ATCA_SUCCESS) break;
+		if ( (packet = _atcab_packet_get(device)) == NULL )
+			return ATCA_GEN_FAIL;
 
-		execution_time = atGetExecTime(_gCommandObj, CMD_NONCE);
-
-		if ((status = atcab_wakeup()) != ATCA_SUCCESS ) break;
-
-		// send the command
-		if ( (status = atsend( _gIface, (uint8_t *)&packet, packet.txsize)) != ATCA_SUCCESS ) break;
+		// build a nonce command (pass through mode)
+		packet->param1 = NONCE_MODE_SEED_UPDATE;
+		packet->param2 = 0x0000;
+		memcpy( packet->data, seed, 20 );
 
-		// delay the appropriate amount of time for command to execute
-		atca_delay_ms(execution_time);
+		if ((status = atNonce(atGetCommands(device), packet)) != ATCA_SUCCESS) break;
 
-		// receive the response
-		if ((status = atreceive( _gIface, packet.data, &(packet.rxsize))) != ATCA_SUCCESS) break;
+		if ( (status = _atcab_execute( device, packet, CMD_NONCE )) != ATCA_SUCCESS ) break;
 
-		if ((status = isATCAError(packet.data)) != ATCA_SUCCESS) break;
+		if ((status = isATCAError(packet->data)) != ATCA_SUCCESS) break;
 
-		memcpy(&rand_out[0], &packet.data[ATCA_RSP_DATA_IDX], 32);
+		memcpy(&rand_out[0], &packet->data[ATCA_RSP_DATA_IDX], 32);
 
 	} while(0);
 
-	_atcab_exit();
+	_atcab_exit(device);
+	_atcab_packet_put(device, packet);
 	return status;
 }
 
+/** \brief atcab_ctx_challenge_seed_update() on the default device */
+ATCA_STATUS atcab_challenge_seed_update(const uint8_t *seed, uint8_t* rand_out)
+{
+	return atcab_ctx_challenge_seed_update(_gDevice, seed, rand_out);
+}
+
 /** \brief read the serial number of the device
+ *  \param[in] device - device to operate on
  *  \param[out] pointer to space to receive serial number.  This space should be 9 bytes long
  *  \return ATCA_STATUS
  */
-ATCA_STATUS atcab_read_serial_number(uint8_t* serial_number)
+ATCA_STATUS atcab_ctx_read_serial_number(ATCADevice device, uint8_t* serial_number)
 {
 	// read config zone bytes 0-3 and 4-7, concatenate the two bits into serial_number
 	uint8_t status = ATCA_GEN_FAIL;
@@ -455,7 +1441,7 @@ ATCA_STATUS atcab_read_serial_number(uint8_t* serial_number)
 		// Read first 32 byte block.  Copy the bytes into the config_data buffer
 		block = 0;
 		offset = 0;
-		if ( (status = atcab_read_zone(ATCA_ZONE_CONFIG, 0, block, offset, bytes_read, ATCA_WORD_SIZE)) != ATCA_SUCCESS )
+		if ( (status = atcab_ctx_read_zone(device, ATCA_ZONE_CONFIG, 0, block, offset, bytes_read, ATCA_WORD_SIZE)) != ATCA_SUCCESS )
 			break;
 		
 		memcpy(&serial_number[cpyIndex], bytes_read, ATCA_WORD_SIZE);
@@ -463,7 +1449,7 @@ ATCA_STATUS atcab_read_serial_number(uint8_t* serial_number)
 
 		block = 0;
 		offset = 2;
-		if ( (status = atcab_read_zone(ATCA_ZONE_CONFIG, 0, block, offset, bytes_read, ATCA_WORD_SIZE)) != ATCA_SUCCESS )
+		if ( (status = atcab_ctx_read_zone(device, ATCA_ZONE_CONFIG, 0, block, offset, bytes_read, ATCA_WORD_SIZE)) != ATCA_SUCCESS )
 			break;
 			
 		memcpy(&serial_number[cpyIndex], bytes_read, ATCA_WORD_SIZE);
@@ -471,7 +1457,7 @@ ATCA_STATUS atcab_read_serial_number(uint8_t* serial_number)
 
 		block = 0;
 		offset = 3;
-		if ( (status = atcab_read_zone(ATCA_ZONE_CONFIG, 0, block, offset, bytes_read, ATCA_WORD_SIZE)) != ATCA_SUCCESS )
+		if ( (status = atcab_ctx_read_zone(device, ATCA_ZONE_CONFIG, 0, block, offset, bytes_read, ATCA_WORD_SIZE)) != ATCA_SUCCESS )
 			break;
 			
 		memcpy(&serial_number[cpyIndex], bytes_read, 1);
@@ -481,117 +1467,236 @@ ATCA_STATUS atcab_read_serial_number(uint8_t* serial_number)
 	return status;
 }
 
+/** \brief atcab_ctx_read_serial_number() on the default device */
+ATCA_STATUS atcab_read_serial_number(uint8_t* serial_number)
+{
+	return atcab_ctx_read_serial_number(_gDevice, serial_number);
+}
+
+/** \brief step function of the verify extern operation, see atcab_op_t */
+static ATCA_STATUS _atcab_verify_extern_next(atcab_op_t *op)
+{
+	ATCA_STATUS status;
+
+	switch ( op->step )
+	{
+	case 0:
+		// nonce passthrough
+		op->packet.param1 = NONCE_MODE_PASSTHROUGH;
+		op->packet.param2 = 0x0000;
+		memcpy( op->packet.data, op->message, 32 );
+		op->command = CMD_NONCE;
+		return atNonce( atGetCommands(op->device), &op->packet );
+
+	case 1:
+		if ( (status = isATCAError(op->packet.data)) != ATCA_SUCCESS )
+			return status;
+
+		// build a verify command
+		op->packet.param1 = VERIFY_MODE_EXTERNAL; //verify the signature
+		op->packet.param2 = VERIFY_KEY_P256;
+		memcpy( &op->packet.data[0], op->signature, ATCA_SIG_SIZE);
+		memcpy( &op->packet.data[64], op->pubkey, ATCA_PUB_KEY_SIZE);
+		op->command = CMD_VERIFY;
+		return atVerify( atGetCommands(op->device), &op->packet );
+
+	default:
+		status = isATCAError(op->packet.data);
+		*op->verified = (status == 0);
+		if (status == ATCA_CHECKMAC_VERIFY_FAILED)
+			status = ATCA_SUCCESS; // Verify failed, but command succeeded
+		return status;
+	}
+}
+
 /** \brief verify a signature using CryptoAuth hardware (as opposed to an ECDSA software implementation)
+ *  \param[in] device - device to operate on
  *  \param[in] message pointer
  *  \param[in] signature pointer
  *  \param[in] pubkey pointer
  *  \param[out] result boolean whether or not the challenge/signature/pubkey verified 
  *  \return ATCA_STATUS
  */
+ATCA_STATUS atcab_ctx_verify_extern(ATCADevice device, const uint8_t *message, const uint8_t *signature, const uint8_t *pubkey, bool *verified)
+{
+	ATCA_STATUS status;
+	atcab_op_t *op;
+
+	*verified = false;
+	if ( (status = _atcab_op_get(device, &op)) != ATCA_SUCCESS )
+		return status;
+
+	op->next = _atcab_verify_extern_next;
+	op->message = message;
+	op->signature = signature;
+	op->pubkey = pubkey;
+	op->verified = verified;
+	return _atcab_run(op);
+}
+
+/** \brief atcab_ctx_verify_extern() on the default device */
 ATCA_STATUS atcab_verify_extern(const uint8_t *message, const uint8_t *signature, const uint8_t *pubkey, bool *verified)
+{
+	return atcab_ctx_verify_extern(_gDevice, message, signature, pubkey, verified);
+}
+
+/** \brief start verifying a signature using CryptoAuth hardware in the background
+ *  \param[in] device - device to operate on
+ *  \param[in] message pointer
+ *  \param[in] signature pointer
+ *  \param[in] pubkey pointer
+ *  \param[out] result boolean whether or not the challenge/signature/pubkey verified, set when the callback is called
+ *  \param[in] callback called from atcab_ctx_poll() when done, may be NULL
+ *  \param[in] context passed to the callback
+ *  \return ATCA_STATUS
+ */
+ATCA_STATUS atcab_ctx_verify_extern_start(ATCADevice device, const uint8_t *message, const uint8_t *signature, const uint8_t *pubkey, bool *verified, atcab_callback callback, void *context)
 {
 	ATCA_STATUS status;
-	ATCAPacket packet;
-	uint16_t execution_time = 0;
-	
-	do {
-        *verified = false;
-        
-		// nonce passthrough
-		if ( (status = atcab_challenge(message)) != ATCA_SUCCESS )
-			break;
-					
-		// build a verify command
-		packet.param1 = VERIFY_MODE_EXTERNAL; //verify the signature
-		packet.param2 = VERIFY_KEY_P256;
-		memcpy( &packet.data[0], signature, ATCA_SIG_SIZE);
-		memcpy( &packet.data[64], pubkey, ATCA_PUB_KEY_SIZE);
+	atcab_op_t *op;
+
+	if ( (status = _atcab_op_get(device, &op)) != ATCA_SUCCESS )
+		return status;
+
+	*verified = false;
+	op->next = _atcab_verify_extern_next;
+	op->message = message;
+	op->signature = signature;
+	op->pubkey = pubkey;
+	op->verified = verified;
+	return _atcab_async_start(op, callback, context);
+}
 
-		if ( (status = atVerify( _gCommandObj, &packet )) != ATCA_SUCCESS )
-			break;
-		
-		execution_time = atGetExecTime( _gCommandObj, CMD_VERIFY );
+/** \brief atcab_ctx_verify_extern_start() on the default device */
+ATCA_STATUS atcab_verify_extern_start(const uint8_t *message, const uint8_t *signature, const uint8_t *pubkey, bool *verified, atcab_callback callback, void *context)
+{
+	return atcab_ctx_verify_extern_start(_gDevice, message, signature, pubkey, verified, callback, context);
+}
 
-		if ( (status = atcab_wakeup()) != ATCA_SUCCESS )
-			break;
+/** \brief step function of the ecdh operation, see atcab_op_t */
+static ATCA_STATUS _atcab_ecdh_next(atcab_op_t *op)
+{
+	ATCA_STATUS status;
 
-		// send the command
-		if ( (status = atsend( _gIface, (uint8_t *)&packet, packet.txsize )) != ATCA_SUCCESS )
-			break;
-			
-		// delay the appropriate amount of time for command to execute
-		atca_delay_ms(execution_time);
+	if ( op->step == 0 )
+	{
+		// build a ecdh command
+		op->packet.param1 = ECDH_PREFIX_MODE;
+		op->packet.param2 = op->key_id;
+		memcpy( op->packet.data, op->pubkey, ATCA_PUB_KEY_SIZE );
+		op->command = CMD_ECDH;
+		return atECDH( atGetCommands(op->device), &op->packet );
+	}
 
-		// receive the response
-		if ( (status = atreceive( _gIface, packet.data, &(packet.rxsize) )) != ATCA_SUCCESS )
-			break;
-	
-		status = isATCAError(packet.data);
-        *verified = (status == 0);
-        if (status == ATCA_CHECKMAC_VERIFY_FAILED)
-            status = ATCA_SUCCESS; // Verify failed, but command succeeded
-	} while(0);
-	
-	_atcab_exit();
-	return status;
+	if ( (status = isATCAError(op->packet.data)) != ATCA_SUCCESS )
+		return status;
+
+	// The ECDH command may return a single byte. Then the CRC is copied into indices [1:2]
+	if ( op->out )
+		memcpy(op->out, &op->packet.data[ATCA_RSP_DATA_IDX], ATCA_KEY_SIZE);
+	return ATCA_SUCCESS;
 }
 
 /** \brief issues ecdh command 
+ *  \param[in] device - device to operate on
  *  \param[in] key_id slot of key for ECDH computation
  *  \param[in] pubkey public key
  *  \param[out] ret_ecdh - computed ECDH key - A buffer with size of ATCA_KEY_SIZE
  *  \return ATCA_STATUS
  */
-ATCA_STATUS atcab_ecdh(uint16_t key_id, const uint8_t* pubkey, uint8_t* ret_ecdh)
+ATCA_STATUS atcab_ctx_ecdh(ATCADevice device, uint16_t key_id, const uint8_t* pubkey, uint8_t* ret_ecdh)
 {
 	ATCA_STATUS status;
-	ATCAPacket packet;	
-	uint16_t execution_time = 0;
+	const uint8_t *secret;
 
-	do
-	{
-		if (pubkey == NULL || ret_ecdh == NULL)
-		{
-			status = ATCA_BAD_PARAM;
-			break;
-		}
-		memset(ret_ecdh, 0, ATCA_KEY_SIZE);
+	if (pubkey == NULL || ret_ecdh == NULL)
+		return ATCA_BAD_PARAM;
 
-		// build a ecdh command
-		packet.param1 = ECDH_PREFIX_MODE;   
-		packet.param2 = key_id;
-		memcpy( packet.data, pubkey, ATCA_PUB_KEY_SIZE );   
+	memset(ret_ecdh, 0, ATCA_KEY_SIZE);
+	if ( (status = atcab_ctx_ecdh_view(device, key_id, pubkey, &secret)) == ATCA_SUCCESS )
+		memcpy(ret_ecdh, secret, ATCA_KEY_SIZE);
+	return status;
+}
+
+/** \brief issues ecdh command, without copying the shared secret out of the response
+ *  \param[in] device - device to operate on
+ *  \param[in] key_id slot of key for ECDH computation
+ *  \param[in] pubkey public key
+ *  \param[out] ret_ecdh - receives a pointer to the ATCA_KEY_SIZE byte shared secret in the response, which
+ *                         stays valid until the next command on the device
+ *  \return ATCA_STATUS
+ */
+ATCA_STATUS atcab_ctx_ecdh_view(ATCADevice device, uint16_t key_id, const uint8_t* pubkey, const uint8_t** ret_ecdh)
+{
+	ATCA_STATUS status;
+	atcab_op_t *op;
+
+	if (pubkey == NULL || ret_ecdh == NULL)
+		return ATCA_BAD_PARAM;
 
-		if ( (status = atECDH( _gCommandObj, &packet )) != ATCA_SUCCESS ) break;
+	if ( (status = _atcab_op_get(device, &op)) != ATCA_SUCCESS )
+		return status;
 
-		execution_time = atGetExecTime( _gCommandObj, CMD_ECDH);
+	op->next = _atcab_ecdh_next;
+	op->key_id = key_id;
+	op->pubkey = pubkey;
+	return _atcab_run_view(op, ret_ecdh);
+}
 
-		if ( (status = atcab_wakeup()) != ATCA_SUCCESS ) break;
+/** \brief atcab_ctx_ecdh_view() on the default device */
+ATCA_STATUS atcab_ecdh_view(uint16_t key_id, const uint8_t* pubkey, const uint8_t** ret_ecdh)
+{
+	return atcab_ctx_ecdh_view(_gDevice, key_id, pubkey, ret_ecdh);
+}
 
-		if ( (status = atsend(_gIface, (uint8_t *)&packet, packet.txsize)) != ATCA_SUCCESS ) break;
+/** \brief atcab_ctx_ecdh() on the default device */
+ATCA_STATUS atcab_ecdh(uint16_t key_id, const uint8_t* pubkey, uint8_t* ret_ecdh)
+{
+	return atcab_ctx_ecdh(_gDevice, key_id, pubkey, ret_ecdh);
+}
 
-		atca_delay_ms(execution_time);
+/** \brief start an ecdh command in the background
+ *  \param[in] device - device to operate on
+ *  \param[in] key_id slot of key for ECDH computation
+ *  \param[in] pubkey public key
+ *  \param[out] ret_ecdh - computed ECDH key - A buffer with size of ATCA_KEY_SIZE, must stay valid until the callback
+ *  \param[in] callback called from atcab_ctx_poll() when done, may be NULL
+ *  \param[in] context passed to the callback
+ *  \return ATCA_STATUS
+ */
+ATCA_STATUS atcab_ctx_ecdh_start(ATCADevice device, uint16_t key_id, const uint8_t* pubkey, uint8_t* ret_ecdh, atcab_callback callback, void *context)
+{
+	ATCA_STATUS status;
+	atcab_op_t *op;
 
-		if ( (status = atreceive(_gIface, packet.data, &packet.rxsize)) != ATCA_SUCCESS ) break;
-		
-		if ( (status = isATCAError(packet.data)) != ATCA_SUCCESS ) break;
+	if (pubkey == NULL || ret_ecdh == NULL)
+		return ATCA_BAD_PARAM;
 
-		// The ECDH command may return a single byte. Then the CRC is copied into indices [1:2]
-		memcpy(ret_ecdh, &packet.data[ATCA_RSP_DATA_IDX], ATCA_KEY_SIZE);
+	if ( (status = _atcab_op_get(device, &op)) != ATCA_SUCCESS )
+		return status;
 
-	} while (0);
+	memset(ret_ecdh, 0, ATCA_KEY_SIZE);
+	op->next = _atcab_ecdh_next;
+	op->key_id = key_id;
+	op->pubkey = pubkey;
+	op->out = ret_ecdh;
+	return _atcab_async_start(op, callback, context);
+}
 
-	_atcab_exit();  
-	return status;
+/** \brief atcab_ctx_ecdh_start() on the default device */
+ATCA_STATUS atcab_ecdh_start(uint16_t key_id, const uint8_t* pubkey, uint8_t* ret_ecdh, atcab_callback callback, void *context)
+{
+	return atcab_ctx_ecdh_start(_gDevice, key_id, pubkey, ret_ecdh, callback, context);
 }
 
 /** \brief issues ecdh command 
+ *  \param[in] device - device to operate on
  *  \param[in] key_id slot of key for ECDH computation
  *  \param[in] pubkey public key
  *  \param[out] ret_ecdh - computed ECDH key - A buffer with size of ATCA_KEY_SIZE
  *  \return ATCA_STATUS
  */
-ATCA_STATUS atcab_ecdh_enc(uint16_t slotid, const uint8_t* pubkey, uint8_t* ret_ecdh, const uint8_t* enckey, const uint8_t enckeyid)
+ATCA_STATUS atcab_ctx_ecdh_enc(ATCADevice device, uint16_t slotid, const uint8_t* pubkey, uint8_t* ret_ecdh, const uint8_t* enckey, const uint8_t enckeyid)
 {
 	ATCA_STATUS status = ATCA_SUCCESS;
 	uint8_t cmpBuf[ATCA_WORD_SIZE];
@@ -606,9 +1711,9 @@ ATCA_STATUS atcab_ecdh_enc(uint16_t slotid, const uint8_t* pubkey, uint8_t* ret_
 			BREAK(status, "Bad input parameters");
 		}
 		// Send the ECDH command with the public key provided
-		if ((status = atcab_ecdh(slotid, pubkey, ret_ecdh)) != ATCA_SUCCESS) BREAK(status, "ECDH Failed");
+		if ((status = atcab_ctx_ecdh(device, slotid, pubkey, ret_ecdh)) != ATCA_SUCCESS) BREAK(status, "ECDH Failed");
 
-		// ECDH may return a key or a single byte.  The atcab_ecdh() function performs a memset to 00 on ecdhRsp.
+		// ECDH may return a key or a single byte.  The atcab_ctx_ecdh(device) function performs a memset to 00 on ecdhRsp.
 		memset(cmpBuf, 0, ATCA_WORD_SIZE);
 
 		// Compare arbitrary bytes to see if they are 00
@@ -618,15 +1723,22 @@ ATCA_STATUS atcab_ecdh_enc(uint16_t slotid, const uint8_t* pubkey, uint8_t* ret_
 			if (ret_ecdh[0] != CMD_STATUS_SUCCESS) BREAK(status, "ECDH Command Execution Failure");
 
 			// ECDH succeeded, perform an encrypted read from the n+1 slot.
-			if ((status = atcab_read_enc(slotid + 1, block, ret_ecdh, enckey, enckeyid)) != ATCA_SUCCESS) BREAK(status, "Encrypte read failed");
+			if ((status = atcab_ctx_read_enc(device, slotid + 1, block, ret_ecdh, enckey, enckeyid)) != ATCA_SUCCESS) BREAK(status, "Encrypte read failed");
 		}
 	} while (0);
 
 	return status;
 }
 
+/** \brief atcab_ctx_ecdh_enc() on the default device */
+ATCA_STATUS atcab_ecdh_enc(uint16_t slotid, const uint8_t* pubkey, uint8_t* ret_ecdh, const uint8_t* enckey, const uint8_t enckeyid)
+{
+	return atcab_ctx_ecdh_enc(_gDevice, slotid, pubkey, ret_ecdh, enckey, enckeyid);
+}
+
 
 /** \brief Compute the address given the zone, slot, block, and offset 
+ *  \param[in] device - device to operate on
  *  \param[in] zone
  *  \param[in] slot
  *  \param[in] block
@@ -635,7 +1747,7 @@ ATCA_STATUS atcab_ecdh_enc(uint16_t slotid, const uint8_t* pubkey, uint8_t* ret_
  *  \param[out] operation return status
  *  \return ATCA_STATUS
  */
-ATCA_STATUS atcab_get_addr(uint8_t zone, uint8_t slot, uint8_t block, uint8_t offset, uint16_t* addr)
+ATCA_STATUS atcab_ctx_get_addr(ATCADevice device, uint8_t zone, uint8_t slot, uint8_t block, uint8_t offset, uint16_t* addr)
 {
 	ATCA_STATUS status = ATCA_SUCCESS;
 	uint8_t memzone = zone & 0x03;
@@ -666,14 +1778,21 @@ ATCA_STATUS atcab_get_addr(uint8_t zone, uint8_t slot, uint8_t block, uint8_t of
 	return status;
 }
 
+/** \brief atcab_ctx_get_addr() on the default device */
+ATCA_STATUS atcab_get_addr(uint8_t zone, uint8_t slot, uint8_t block, uint8_t offset, uint16_t* addr)
+{
+	return atcab_ctx_get_addr(_gDevice, zone, slot, block, offset, addr);
+}
+
 
 
 /** \brief Query to see if the specified slot is locked
+ *  \param[in] device - device to operate on
  *  \param[in] slot The slot to query for locked (slot 0-15)
  *  \param[out] lock_state true if the specified slot is locked
  *  \return ATCA_STATUS
  */
-ATCA_STATUS atcab_is_slot_locked(uint8_t slot, bool *islocked)
+ATCA_STATUS atcab_ctx_is_slot_locked(ATCADevice device, uint8_t slot, bool *islocked)
 {
 	uint8_t ret = ATCA_GEN_FAIL;
 	uint8_t slotLock_data[ATCA_WORD_SIZE];
@@ -686,7 +1805,7 @@ ATCA_STATUS atcab_is_slot_locked(uint8_t slot, bool *islocked)
 	do
 	{
 		// Read the word with the lock bytes ( SlotLock[2], RFU[2] ) (config block = 2, word offset = 6)
-		if ( (ret = atcab_read_zone(ATCA_ZONE_CONFIG, 0, 2/*block*/, 6/*offset*/, slotLock_data, ATCA_WORD_SIZE)) != ATCA_SUCCESS )
+		if ( (ret = atcab_ctx_read_zone(device, ATCA_ZONE_CONFIG, 0, 2/*block*/, 6/*offset*/, slotLock_data, ATCA_WORD_SIZE)) != ATCA_SUCCESS )
 			break;
 
 		// Determine the slotlock and lockbit index into the word_data (slotLocked byte) based on the slot we are querying for
@@ -709,7 +1828,7 @@ ATCA_STATUS atcab_is_slot_locked(uint8_t slot, bool *islocked)
         else{
 			keyConfig_idx = (slot % 2) ? 2 : 0;
 			// Read the word with the lockable bytes in keyConfig block (config block = 3, word offset = depending on the slot)
-			if ( (ret = atcab_read_zone(ATCA_ZONE_CONFIG, 0, 3/*block*/, (slot >> 1)/*offset*/, lockable_data, ATCA_WORD_SIZE)) != ATCA_SUCCESS )
+			if ( (ret = atcab_ctx_read_zone(device, ATCA_ZONE_CONFIG, 0, 3/*block*/, (slot >> 1)/*offset*/, lockable_data, ATCA_WORD_SIZE)) != ATCA_SUCCESS )
 				break;
 					
 			if(((lockable_data[keyConfig_idx] >> lockableBit_idx) & 0x01) == 0x00)
@@ -723,12 +1842,19 @@ ATCA_STATUS atcab_is_slot_locked(uint8_t slot, bool *islocked)
 	return ret;
 }
 
+/** \brief atcab_ctx_is_slot_locked() on the default device */
+ATCA_STATUS atcab_is_slot_locked(uint8_t slot, bool *islocked)
+{
+	return atcab_ctx_is_slot_locked(_gDevice, slot, islocked);
+}
+
 /** \brief Query to see if the specified zone is locked
+ *  \param[in] device - device to operate on
  *  \param[in] zone The zone to query for locked (use LOCK_ZONE_CONFIG or LOCK_ZONE_DATA)
  *  \param[out] lock_state true if the specified zone is locked
  *  \return ATCA_STATUS
  */
-ATCA_STATUS atcab_is_locked(uint8_t zone, bool *islocked)
+ATCA_STATUS atcab_ctx_is_locked(ATCADevice device, uint8_t zone, bool *islocked)
 {
 	uint8_t ret = ATCA_GEN_FAIL;
 	uint8_t word_data[ATCA_WORD_SIZE];
@@ -737,28 +1863,214 @@ ATCA_STATUS atcab_is_locked(uint8_t zone, bool *islocked)
 	do
 	{
 		// Read the word with the lock bytes (UserExtra, Selector, LockValue, LockConfig) (config block = 2, word offset = 5)
-		if ( (ret = atcab_read_zone(ATCA_ZONE_CONFIG, 0, 2/*block*/, 5/*offset*/, word_data, ATCA_WORD_SIZE)) != ATCA_SUCCESS )
+		if ( (ret = atcab_ctx_read_zone(device, ATCA_ZONE_CONFIG, 0, 2/*block*/, 5/*offset*/, word_data, ATCA_WORD_SIZE)) != ATCA_SUCCESS )
 			break;
 
 		// Determine the index into the word_data based on the zone we are querying for
 		if (zone == LOCK_ZONE_DATA) zone_idx = 2;
 		if (zone == LOCK_ZONE_CONFIG) zone_idx = 3;
 
-		// Set the locked return variable base on the value.
-		if (word_data[zone_idx] == 0) 
-			*islocked = true;
-        else 
-			*islocked = false;
+		// Set the locked return variable base on the value.
+		if (word_data[zone_idx] == 0) 
+			*islocked = true;
+        else 
+			*islocked = false;
+
+	} while (0);
+
+	return ret;
+}
+
+/** \brief atcab_ctx_is_locked() on the default device */
+ATCA_STATUS atcab_is_locked(uint8_t zone, bool *islocked)
+{
+	return atcab_ctx_is_locked(_gDevice, zone, islocked);
+}
+
+/** \brief read 4 or 32 bytes of a zone from the device itself, see atcab_ctx_read_zone() */
+static ATCA_STATUS _atcab_read_zone(ATCADevice device, uint8_t zone, uint8_t slot, uint8_t block, uint8_t offset, uint8_t *data, uint8_t len)
+{
+	ATCA_STATUS status = ATCA_SUCCESS;
+	ATCAPacket *packet = NULL;
+	uint16_t addr;
+
+	do
+	{
+		// Check the input parameters
+		if (data == NULL)
+			return ATCA_BAD_PARAM;
+
+		if ( len != 4 && len != 32 )
+			return ATCA_BAD_PARAM;
+
+		// The get address function checks the remaining variables
+		if ( (status = atcab_ctx_get_addr(device, zone, slot, block, offset, &addr)) != ATCA_SUCCESS )
+			break;
+
+		// If there are 32 bytes to write, then xor the bit into the mode
+		if (len == ATCA_BLOCK_SIZE)
+		{
+			zone = zone | ATCA_ZONE_READWRITE_32;
+		}
+
+		if ( (packet = _atcab_packet_get(device)) == NULL )
+			return ATCA_GEN_FAIL;
+
+		// build a read command
+		packet->param1 = zone;
+		packet->param2 = addr;
+	
+		if ( (status = atRead( atGetCommands(device), packet )) != ATCA_SUCCESS )
+			break;
+	
+		if ( (status = _atcab_execute( device, packet, CMD_READMEM )) != ATCA_SUCCESS )
+			break;
+
+		if ( (status = isATCAError(packet->data)) != ATCA_SUCCESS )
+			break;
+	
+		memcpy( data, &packet->data[1], len );
+	} while(0);
+	
+	_atcab_exit(device);
+	_atcab_packet_put(device, packet);
+	return status;
+}
+
+/** \brief config zone bytes the device changes by itself, Counter[0..1] and LastKeyUse.  These are
+ *  always read from the device.
+ */
+#define ATCAB_SHADOW_VOLATILE_START	(52)
+#define ATCAB_SHADOW_VOLATILE_END	(84)
+
+/** \brief size of the config or OTP zone of a device */
+static uint16_t _atcab_shadow_size(ATCADevice device, uint8_t zone)
+{
+	if ( zone == ATCA_ZONE_OTP )
+		return ATCA_OTP_SIZE;
+
+	return atgetifacecfg(atGetIFace(device))->devtype == ATSHA204A ? ATCA_SHA_CONFIG_SIZE : ATCA_CONFIG_SIZE;
+}
+
+/** \brief fill the shadow of the config or OTP zone, a 32 byte read per block, all in one wake
+ *  \param[in] device - device to operate on
+ *  \param[inout] state - basic API state of the device, receives the shadow
+ *  \param[in] zone - ATCA_ZONE_CONFIG or ATCA_ZONE_OTP
+ *  \return ATCA_STATUS
+ */
+static ATCA_STATUS _atcab_shadow_load(ATCADevice device, atcab_state_t *state, uint8_t zone)
+{
+	ATCA_STATUS status = ATCA_SUCCESS;
+	uint8_t *shadow = (zone == ATCA_ZONE_OTP) ? state->otp : state->config;
+	uint16_t size = _atcab_shadow_size(device, zone);
+	uint16_t addr = 0;
+
+	atcab_ctx_session_begin(device);
+
+	while ( addr < size && status == ATCA_SUCCESS )
+	{
+		// the SHA204A config zone ends with a partial block, read word by word
+		if ( size - addr >= ATCA_BLOCK_SIZE )
+		{
+			status = _atcab_read_zone(device, zone, 0, addr / ATCA_BLOCK_SIZE, 0, &shadow[addr], ATCA_BLOCK_SIZE);
+			addr += ATCA_BLOCK_SIZE;
+		}
+		else
+		{
+			status = _atcab_read_zone(device, zone, 0, addr / ATCA_BLOCK_SIZE, (addr % ATCA_BLOCK_SIZE) / ATCA_WORD_SIZE, &shadow[addr], ATCA_WORD_SIZE);
+			addr += ATCA_WORD_SIZE;
+		}
+	}
+
+	atcab_ctx_session_end(device);
+
+	if ( zone == ATCA_ZONE_OTP )
+		state->otp_valid = (status == ATCA_SUCCESS);
+	else
+		state->config_valid = (status == ATCA_SUCCESS);
+
+	return status;
+}
+
+/** \brief serve a read of the config or OTP zone from the shadow of the zone, filling the shadow first
+ *  if it isn't yet.  The shadow stays valid until a command through this API may change the zone, a
+ *  write to it or a lock.  The volatile config bytes aren't served.
+ *  \param[in] device - device to operate on
+ *  \param[in] zone, block, offset, len - as for atcab_ctx_read_zone()
+ *  \param[out] data - receives the bytes
+ *  \return true when served, otherwise the read has to go to the device
+ */
+static bool _atcab_shadow_read(ATCADevice device, uint8_t zone, uint8_t block, uint8_t offset, uint8_t *data, uint8_t len)
+{
+	atcab_state_t *state;
+	uint16_t addr;
+	bool valid;
+
+	if ( zone != ATCA_ZONE_CONFIG && zone != ATCA_ZONE_OTP )
+		return false;
+
+	if ( len == ATCA_BLOCK_SIZE )
+		offset = 0;
+	if ( offset >= ATCA_BLOCK_SIZE / ATCA_WORD_SIZE )
+		return false;
+
+	addr = block * ATCA_BLOCK_SIZE + offset * ATCA_WORD_SIZE;
+	if ( addr + len > _atcab_shadow_size(device, zone) )
+		return false;
+
+	if ( zone == ATCA_ZONE_CONFIG && addr < ATCAB_SHADOW_VOLATILE_END && addr + len > ATCAB_SHADOW_VOLATILE_START )
+		return false;
+
+	if ( (state = _atcab_state( device, true )) == NULL )
+		return false;
+
+	valid = (zone == ATCA_ZONE_OTP) ? state->otp_valid : state->config_valid;
+	if ( !valid && _atcab_shadow_load(device, state, zone) != ATCA_SUCCESS )
+		return false;
+
+	memcpy( data, ((zone == ATCA_ZONE_OTP) ? state->otp : state->config) + addr, len );
+	return true;
+}
+
+/** \brief forget the shadow of a zone, ahead of a command that may change the zone
+ *  \param[in] device - device to operate on
+ *  \param[in] zone - zone the command may change, ATCA_ZONE_CONFIG or ATCA_ZONE_OTP
+ */
+static void _atcab_shadow_drop(ATCADevice device, uint8_t zone)
+{
+	atcab_state_t *state = _atcab_state( device, false );
+
+	if ( state == NULL )
+		return;
 
-	} while (0);
+	if ( zone == ATCA_ZONE_CONFIG )
+		state->config_valid = false;
+	else if ( zone == ATCA_ZONE_OTP )
+		state->otp_valid = false;
+}
 
-	return ret;
+/** \brief drop the copies of the config and OTP zones the basic API keeps.  They are dropped on their
+ *  own by the writes and locks made through this API, call this after changing either zone any other
+ *  way, e.g. with an UpdateExtra command or from another host.
+ *  \param[in] device - device to operate on
+ */
+void atcab_ctx_shadow_invalidate(ATCADevice device)
+{
+	_atcab_shadow_drop(device, ATCA_ZONE_CONFIG);
+	_atcab_shadow_drop(device, ATCA_ZONE_OTP);
+}
+
+/** \brief atcab_ctx_shadow_invalidate() on the default device */
+void atcab_shadow_invalidate(void)
+{
+	atcab_ctx_shadow_invalidate(_gDevice);
 }
 
 /** \brief write either 4 or 32 bytes of data into the device zone
  *
  *  see ECC108A datasheet, datazone address values, table 9-8
  *
+ *  \param[in] device - device to operate on
  *  \param[in] zone
  *  \param[in] slot
  *  \param[in] block
@@ -767,12 +2079,11 @@ ATCA_STATUS atcab_is_locked(uint8_t zone, bool *islocked)
  *  \param[in] len  Must be either 4 or 32
  *  \return ATCA_STATUS
  */
-ATCA_STATUS atcab_write_zone(uint8_t zone, uint8_t slot, uint8_t block, uint8_t offset, const uint8_t *data, uint8_t len)
+ATCA_STATUS atcab_ctx_write_zone(ATCADevice device, uint8_t zone, uint8_t slot, uint8_t block, uint8_t offset, const uint8_t *data, uint8_t len)
 {
 	ATCA_STATUS status = ATCA_GEN_FAIL;
-	ATCAPacket packet;
+	ATCAPacket *packet = NULL;
 	uint16_t addr;
-	uint16_t execution_time = 0;
 
 	// Check the input parameters
 	if (data == NULL)
@@ -781,9 +2092,13 @@ ATCA_STATUS atcab_write_zone(uint8_t zone, uint8_t slot, uint8_t block, uint8_t
 	if ( len != 4 && len != 32 )
 		return ATCA_BAD_PARAM;
 
+	_atcab_shadow_drop(device, zone);
+	if ( zone == ATCA_ZONE_DATA )
+		_atcab_pubkey_drop(device, slot);
+
 	do { 			
 		// The get address function checks the remaining variables
-		if ( (status = atcab_get_addr(zone, slot, block, offset, &addr)) != ATCA_SUCCESS )
+		if ( (status = atcab_ctx_get_addr(device, zone, slot, block, offset, &addr)) != ATCA_SUCCESS )
 			break;
 
 		// If there are 32 bytes to write, then xor the bit into the mode
@@ -792,38 +2107,35 @@ ATCA_STATUS atcab_write_zone(uint8_t zone, uint8_t slot, uint8_t block, uint8_t
 			zone = zone | ATCA_ZONE_READWRITE_32;
 		}
 	
+		if ( (packet = _atcab_packet_get(device)) == NULL )
+			return ATCA_GEN_FAIL;
+
 		// build a write command
-		packet.param1 = zone;
-		packet.param2 = addr;
-		memcpy( packet.data, data, len );
+		packet->param1 = zone;
+		packet->param2 = addr;
+		memcpy( packet->data, data, len );
 	
-		if ( (status = atWrite( _gCommandObj, &packet )) != ATCA_SUCCESS )
+		if ( (status = atWrite( atGetCommands(device), packet )) != ATCA_SUCCESS )
 			break;
 
-		execution_time = atGetExecTime( _gCommandObj, CMD_WRITEMEM);
-
-		if ( (status = atcab_wakeup()) != ATCA_SUCCESS )
-            break;
-		
-		// send the command
-		if ( (status = atsend( _gIface, (uint8_t *)&packet, packet.txsize )) != ATCA_SUCCESS )
-			break;
-	
-		// delay the appropriate amount of time for command to execute
-		atca_delay_ms(execution_time);
-
-		// receive the response
-		if ( (status = atreceive( _gIface, packet.data, &(packet.rxsize) )) != ATCA_SUCCESS )
+		if ( (status = _atcab_execute( device, packet, CMD_WRITEMEM )) != ATCA_SUCCESS )
 			break;
 		
-		status = isATCAError(packet.data);
+		status = isATCAError(packet->data);
 
 	} while(0);
 
-	_atcab_exit();
+	_atcab_exit(device);
+	_atcab_packet_put(device, packet);
 	return status;
 }
 
+/** \brief atcab_ctx_write_zone() on the default device */
+ATCA_STATUS atcab_write_zone(uint8_t zone, uint8_t slot, uint8_t block, uint8_t offset, const uint8_t *data, uint8_t len)
+{
+	return atcab_ctx_write_zone(_gDevice, zone, slot, block, offset, data, len);
+}
+
 /** \brief read either 4 or 32 bytes of data into given slot
  *
  *  for 32 byte read, offset is ignored
@@ -831,6 +2143,9 @@ ATCA_STATUS atcab_write_zone(uint8_t zone, uint8_t slot, uint8_t block, uint8_t
  *
  *  data zone must be locked and the slot configuration must not be secret for a slot to be successfully read
  *
+ *  reads of the config and OTP zones are served from a copy of the zone kept in RAM, see _atcab_shadow_read()
+ *
+ *  \param[in] device - device to operate on
  *  \param[in] zone
  *  \param[in] slot
  *  \param[in] block
@@ -839,67 +2154,31 @@ ATCA_STATUS atcab_write_zone(uint8_t zone, uint8_t slot, uint8_t block, uint8_t
  *  \param[in] len  Must be either 4 or 32
  *  returns ATCA_STATUS
  */
-ATCA_STATUS atcab_read_zone(uint8_t zone, uint8_t slot, uint8_t block, uint8_t offset, uint8_t *data, uint8_t len)
+ATCA_STATUS atcab_ctx_read_zone(ATCADevice device, uint8_t zone, uint8_t slot, uint8_t block, uint8_t offset, uint8_t *data, uint8_t len)
 {
-	ATCA_STATUS status = ATCA_SUCCESS;
-	ATCAPacket packet;
-	uint16_t addr;
-	uint16_t execution_time = 0;
-
-	do
-	{
-		// Check the input parameters
-		if (data == NULL)
-			return ATCA_BAD_PARAM;
-
-		if ( len != 4 && len != 32 )
-			return ATCA_BAD_PARAM;
-
-		// The get address function checks the remaining variables
-		if ( (status = atcab_get_addr(zone, slot, block, offset, &addr)) != ATCA_SUCCESS )
-			break;
+	// Check the input parameters
+	if (data == NULL)
+		return ATCA_BAD_PARAM;
 
-		// If there are 32 bytes to write, then xor the bit into the mode
-		if (len == ATCA_BLOCK_SIZE)
-		{
-			zone = zone | ATCA_ZONE_READWRITE_32;
-		}
+	if ( len != 4 && len != 32 )
+		return ATCA_BAD_PARAM;
 
-		// build a read command
-		packet.param1 = zone;
-		packet.param2 = addr;
-	
-		if ( (status = atRead( _gCommandObj, &packet )) != ATCA_SUCCESS )
-			break;
-	
-		execution_time = atGetExecTime( _gCommandObj, CMD_READMEM);
-	
-		if ( (status = atcab_wakeup()) != ATCA_SUCCESS ) break;
-			
-		// send the command
-		if ( (status = atsend( _gIface, (uint8_t *)&packet, packet.txsize )) != ATCA_SUCCESS )
-			break;
-	
-		// delay the appropriate amount of time for command to execute
-		atca_delay_ms(execution_time);
+	if ( _atcab_shadow_read(device, zone, block, offset, data, len) )
+		return ATCA_SUCCESS;
 
-		// receive the response
-		if ( (status = atreceive( _gIface, packet.data, &(packet.rxsize) )) != ATCA_SUCCESS )
-			break;
+	return _atcab_read_zone(device, zone, slot, block, offset, data, len);
+}
 
-		if ( (status = isATCAError(packet.data)) != ATCA_SUCCESS )
-			break;
-	
-		memcpy( data, &packet.data[1], len );
-	} while(0);
-	
-	_atcab_exit();
-	return status;
+/** \brief atcab_ctx_read_zone() on the default device */
+ATCA_STATUS atcab_read_zone(uint8_t zone, uint8_t slot, uint8_t block, uint8_t offset, uint8_t *data, uint8_t len)
+{
+	return atcab_ctx_read_zone(_gDevice, zone, slot, block, offset, data, len);
 }
 
 /** \brief Read 32 bytes of data from the given slot.  
  *		The function returns clear text bytes. Encrypted bytes are read over the wire, then subsequently decrypted
  *		Data zone must be locked and the slot configuration must be set to encrypted read for the block to be successfully read
+ *  \param[in] device - device to operate on
  *  \param[in] slot
  *  \param[in] block
  *  \param[out] data  The 32 bytes of clear text data that was read encrypted from the slot, then decrypted
@@ -907,7 +2186,7 @@ ATCA_STATUS atcab_read_zone(uint8_t zone, uint8_t slot, uint8_t block, uint8_t o
  *  \param[in] enckeyid  The keyid of the parent encryption key
  *  returns ATCA_STATUS
  */
-ATCA_STATUS atcab_read_enc(uint8_t slotid, uint8_t block, uint8_t *data, const uint8_t* enckey, const uint8_t enckeyid)
+ATCA_STATUS atcab_ctx_read_enc(ATCADevice device, uint8_t slotid, uint8_t block, uint8_t *data, const uint8_t* enckey, const uint8_t enckeyid)
 {
 	ATCA_STATUS status = ATCA_GEN_FAIL;
 	uint8_t zone = ATCA_ZONE_DATA | ATCA_ZONE_READWRITE_32;
@@ -918,6 +2197,8 @@ ATCA_STATUS atcab_read_enc(uint8_t slotid, uint8_t block, uint8_t *data, const u
 	uint8_t randout[RANDOM_NUM_SIZE] = { 0 };
 	int i = 0;
 
+	atcab_ctx_session_begin(device);
+
 	do
 	{
 		// Verify inputs parameters
@@ -934,7 +2215,7 @@ ATCA_STATUS atcab_read_enc(uint8_t slotid, uint8_t block, uint8_t *data, const u
 		nonceParam.temp_key = &tempkey;
 
 		// Send the random Nonce command
-		if ((status = atcab_nonce_rand(numin, randout)) != ATCA_SUCCESS) BREAK(status, "Nonce failed");
+		if ((status = atcab_ctx_nonce_rand(device, numin, randout)) != ATCA_SUCCESS) BREAK(status, "Nonce failed");
 
 		// Calculate Tempkey
 		if ((status = atcah_nonce(&nonceParam)) != ATCA_SUCCESS) BREAK(status, "Calc TempKey failed");
@@ -946,13 +2227,13 @@ ATCA_STATUS atcab_read_enc(uint8_t slotid, uint8_t block, uint8_t *data, const u
 		genDigParam.temp_key = &tempkey;
 
 		// Send the GenDig command
-		if ((status = atcab_gendig(GENDIG_ZONE_DATA, enckeyid)) != ATCA_SUCCESS) BREAK(status, "GenDig failed");
+		if ((status = atcab_ctx_gendig(device, GENDIG_ZONE_DATA, enckeyid)) != ATCA_SUCCESS) BREAK(status, "GenDig failed");
 
 		// Calculate Tempkey
 		if ((status = atcah_gen_dig(&genDigParam)) != ATCA_SUCCESS) BREAK(status, "");
 
 		// Read Encrypted
-		if ((status = atcab_read_zone(zone, slotid, block, 0, data, ATCA_BLOCK_SIZE)) != ATCA_SUCCESS) BREAK(status, "Read encrypted failed");
+		if ((status = atcab_ctx_read_zone(device, zone, slotid, block, 0, data, ATCA_BLOCK_SIZE)) != ATCA_SUCCESS) BREAK(status, "Read encrypted failed");
 
 		// Decrypt
 		for (i = 0; i < ATCA_BLOCK_SIZE; i++)
@@ -962,13 +2243,20 @@ ATCA_STATUS atcab_read_enc(uint8_t slotid, uint8_t block, uint8_t *data, const u
 
 	} while (0);
 
-	_atcab_exit();
+	atcab_ctx_session_end(device);
 	return status;
 }
 
+/** \brief atcab_ctx_read_enc() on the default device */
+ATCA_STATUS atcab_read_enc(uint8_t slotid, uint8_t block, uint8_t *data, const uint8_t* enckey, const uint8_t enckeyid)
+{
+	return atcab_ctx_read_enc(_gDevice, slotid, block, data, enckey, enckeyid);
+}
+
 /** \brief Write 32 bytes of data into given slot.  
  *		The function takes clear text bytes, but encrypts them for writing over the wire
  *		Data zone must be locked and the slot configuration must be set to encrypted write for the block to be successfully written
+ *  \param[in] device - device to operate on
  *  \param[in] slot
  *  \param[in] block
  *  \param[in] data  The 32 bytes of clear text data to be written to the slot
@@ -976,7 +2264,7 @@ ATCA_STATUS atcab_read_enc(uint8_t slotid, uint8_t block, uint8_t *data, const u
  *  \param[in] enckeyid  The keyid of the parent encryption key
  *  returns ATCA_STATUS
  */
-ATCA_STATUS atcab_write_enc(uint8_t slotid, uint8_t block, const uint8_t *data, const uint8_t* enckey, const uint8_t enckeyid)
+ATCA_STATUS atcab_ctx_write_enc(ATCADevice device, uint8_t slotid, uint8_t block, const uint8_t *data, const uint8_t* enckey, const uint8_t enckeyid)
 {
 	ATCA_STATUS status = ATCA_GEN_FAIL;
 	uint8_t i = 0;
@@ -987,9 +2275,11 @@ ATCA_STATUS atcab_write_enc(uint8_t slotid, uint8_t block, const uint8_t *data,
 	uint8_t numin[NONCE_NUMIN_SIZE] = { 0 };
 	uint8_t randout[RANDOM_NUM_SIZE] = { 0 };
 	uint8_t cipher_text[ATCA_KEY_SIZE] = { 0 };
-	ATCAPacket packet;
+	ATCAPacket *packet = NULL;
 	uint16_t addr;
-	uint16_t execution_time = 0;
+
+	_atcab_pubkey_drop(device, slotid);
+	atcab_ctx_session_begin(device);
 
 	do
 	{
@@ -1006,7 +2296,7 @@ ATCA_STATUS atcab_write_enc(uint8_t slotid, uint8_t block, const uint8_t *data,
 		nonceParam.temp_key = &tempkey;
 
 		// Send the random Nonce command
-		if ((status = atcab_nonce_rand(numin, randout)) != ATCA_SUCCESS) BREAK(status, "Nonce failed");
+		if ((status = atcab_ctx_nonce_rand(device, numin, randout)) != ATCA_SUCCESS) BREAK(status, "Nonce failed");
 		
 		// Calculate Tempkey
 		if ((status = atcah_nonce(&nonceParam)) != ATCA_SUCCESS) BREAK(status, "Calc TempKey failed");
@@ -1018,7 +2308,7 @@ ATCA_STATUS atcab_write_enc(uint8_t slotid, uint8_t block, const uint8_t *data,
 		genDigParam.temp_key = &tempkey;
 
 		// Send the GenDig command
-		if ((status = atcab_gendig(GENDIG_ZONE_DATA, enckeyid)) != ATCA_SUCCESS) BREAK(status, "GenDig failed");
+		if ((status = atcab_ctx_gendig(device, GENDIG_ZONE_DATA, enckeyid)) != ATCA_SUCCESS) BREAK(status, "GenDig failed");
 		
 		// Calculate Tempkey
 		if ((status = atcah_gen_dig(&genDigParam)) != ATCA_SUCCESS) BREAK(status, "");
@@ -1028,7 +2318,7 @@ ATCA_STATUS atcab_write_enc(uint8_t slotid, uint8_t block, const uint8_t *data,
 			cipher_text[i] = data[i] ^ tempkey.value[i];
 		
 		// The get address function checks the remaining variables
-		if ((status = atcab_get_addr(ATCA_ZONE_DATA, slotid, block, 0, &addr)) != ATCA_SUCCESS) BREAK(status, "Get address failed");
+		if ((status = atcab_ctx_get_addr(device, ATCA_ZONE_DATA, slotid, block, 0, &addr)) != ATCA_SUCCESS) BREAK(status, "Get address failed");
 		
 		// Calculate Auth MAC
 		genDigParam.zone = zone;
@@ -1038,196 +2328,97 @@ ATCA_STATUS atcab_write_enc(uint8_t slotid, uint8_t block, const uint8_t *data,
 	
 		if ((status = atcah_gen_mac(&genDigParam)) != ATCA_SUCCESS) BREAK(status, "Calculate Auth MAC failed");
 	
-		// build a write command for encrypted writes
-		packet.param1 = zone;
-		packet.param2 = addr;
-		memcpy(packet.data, cipher_text, ATCA_KEY_SIZE);
-		memcpy(&packet.data[ATCA_KEY_SIZE], tempkey.value, ATCA_KEY_SIZE);
-
-		if ((status = atWriteEnc(_gCommandObj, &packet)) != ATCA_SUCCESS) BREAK(status, "format write command bytes failed");
-
-		execution_time = atGetExecTime(_gCommandObj, CMD_WRITEMEM);
+		if ( (packet = _atcab_packet_get(device)) == NULL )
+			return ATCA_GEN_FAIL;
 
-		if ((status = atcab_wakeup()) != ATCA_SUCCESS) BREAK(status, "wakeup failed");
-
-		// send the command
-		if ((status = atsend(_gIface, (uint8_t *)&packet, packet.txsize)) != ATCA_SUCCESS) BREAK(status, "send write command bytes failed");
+		// build a write command for encrypted writes
+		packet->param1 = zone;
+		packet->param2 = addr;
+		memcpy(packet->data, cipher_text, ATCA_KEY_SIZE);
+		memcpy(&packet->data[ATCA_KEY_SIZE], tempkey.value, ATCA_KEY_SIZE);
 
-		// delay the appropriate amount of time for command to execute
-		atca_delay_ms(execution_time);
+		if ((status = atWriteEnc(atGetCommands(device), packet)) != ATCA_SUCCESS) BREAK(status, "format write command bytes failed");
 
-		// receive the response
-		if ((status = atreceive(_gIface, packet.data, &(packet.rxsize))) != ATCA_SUCCESS) BREAK(status, "receive write command bytes failed");
+		if ((status = _atcab_execute(device, packet, CMD_WRITEMEM)) != ATCA_SUCCESS) BREAK(status, "command execution failed");
 
-		status = isATCAError(packet.data);
+		status = isATCAError(packet->data);
 
 	} while (0);
 
-	_atcab_exit();
+	atcab_ctx_session_end(device);
+	_atcab_packet_put(device, packet);
 	return status;
 }
 
+/** \brief atcab_ctx_write_enc() on the default device */
+ATCA_STATUS atcab_write_enc(uint8_t slotid, uint8_t block, const uint8_t *data, const uint8_t* enckey, const uint8_t enckeyid)
+{
+	return atcab_ctx_write_enc(_gDevice, slotid, block, data, enckey, enckeyid);
+}
+
 
-/** \brief read the config zone by block by block
- *  for 32 byte read, offset is ignored
- *  data receives the contents read from the slot
- *  Config zone can be read regardless of it being locked or unlocked
- *  \param[in] config_data pointer to buffer containing a contiguous set of bytes to read from the config zone
+/** \brief read the whole ECC config zone.
+ *  Config zone can be read regardless of it being locked or unlocked.  Blocks 0 and 3 come from the
+ *  shadow of the zone, blocks 1 and 2 hold the counters and are read from the device.
+ *  \param[in] device - device to operate on
+ *  \param[out] config_data pointer to 128 bytes receiving the config zone
  *  returns ATCA_STATUS
  */
-ATCA_STATUS atcab_read_ecc_config_zone(uint8_t* config_data)
+ATCA_STATUS atcab_ctx_read_ecc_config_zone(ATCADevice device, uint8_t* config_data)
 {
-	ATCA_STATUS status = ATCA_GEN_FAIL;
-	ATCAPacket packet;
-	uint16_t execution_time = 0;
-	uint8_t zone=0, block=0, offset=0, slot=0, index=0;
-	uint16_t addr = 0x0000;
-
-	//reading the zone block by block until word 16 (block 2, offset 6)
-	do{
-		if((block==2)&&(offset<=7)){
-			// read 32 bytes at once
-			packet.param1 = ATCA_ZONE_CONFIG;
-			
-			// compute the word addr and build the read command
-			if ( (status = atcab_get_addr(zone, slot, block, offset, &addr)) != ATCA_SUCCESS )
-				break;
-				
-			packet.param2 =  addr;
-			status = atRead(_gCommandObj, &packet);
-			execution_time = atGetExecTime( _gCommandObj, CMD_READMEM);
-			
-			if ( (status = atcab_wakeup()) != ATCA_SUCCESS )
-                break;
-					
-			// send the command
-			if ( (status = atsend( _gIface, (uint8_t *)&packet, packet.txsize )) != ATCA_SUCCESS )
-				break;
-				
-			// delay the appropriate amount of time for command to execute
-			atca_delay_ms(execution_time);
-			
-			memset(packet.data, 0x00, 130);
-
-			// receive the response
-			if ( (status = atreceive( _gIface, packet.data, &packet.rxsize)) != ATCA_SUCCESS )
-				break;
-		    
-            if ( (status = atcab_idle()) != ATCA_SUCCESS )
-                break;
-            
-			// check for error in response
-			if ( (status = isATCAError(packet.data)) != ATCA_SUCCESS )  
-				break;
-			
-			// update the word address after reading each block
-			++offset;
-			if((block==2) && (offset>7)){
-				block=3;
-			}
-			
-			// copy the contents to a config data buffer
-			memcpy(&config_data[index], &packet.data[1], ATCA_WORD_SIZE );
-			index += ATCA_WORD_SIZE;
-		}
-		else{
-			// build a read command (read from the start of zone)
-			offset = 0;
-			// read 32 bytes at once
-			packet.param1 = ATCA_ZONE_CONFIG | ATCA_ZONE_READWRITE_32;
-			
-			// compute the word addr and build the read command
-			if ( (status = atcab_get_addr(zone, slot, block, offset, &addr)) != ATCA_SUCCESS )
-				break;
-				
-			packet.param2 =  addr;
-			status = atRead(_gCommandObj, &packet);
-			execution_time = atGetExecTime( _gCommandObj, CMD_READMEM);
-			
-			if ( (status = atcab_wakeup()) != ATCA_SUCCESS ) break;
-				
-			// send the command
-			if ( (status = atsend( _gIface, (uint8_t *)&packet, packet.txsize )) != ATCA_SUCCESS )
-				break;
-			
-			// delay the appropriate amount of time for command to execute
-			atca_delay_ms(execution_time);
-			
-			memset(packet.data, 0x00, sizeof(packet.data));
+	if ( config_data == NULL )
+		return ATCA_BAD_PARAM;
 
-			// receive the response
-			if ( (status = atreceive( _gIface, packet.data, &packet.rxsize)) != ATCA_SUCCESS )
-				break;
-                
-            if ( (status = atcab_idle()) != ATCA_SUCCESS )
-                break;
-			
-			// check for error in response
-			if ( (status = isATCAError(packet.data)) != ATCA_SUCCESS )  
-				break;
-			
-			// update the word address after reading each block
-			++block;
-			
-			// copy the contents to a config data buffer
-			memcpy(&config_data[index], &packet.data[1], ATCA_BLOCK_SIZE );
-			index += ATCA_BLOCK_SIZE;
-		}
-		
-	}while(block <= 3);
+	return atcab_ctx_read_bytes_zone(device, ATECC508A, ATCA_ZONE_CONFIG, 0x00, ATCA_CONFIG_SIZE, config_data);
+}
 
-	_atcab_exit();
-	return status;
+/** \brief atcab_ctx_read_ecc_config_zone() on the default device */
+ATCA_STATUS atcab_read_ecc_config_zone(uint8_t* config_data)
+{
+	return atcab_ctx_read_ecc_config_zone(_gDevice, config_data);
 }
 
 /** \brief given an ECC configuration zone buffer, write its parts to the device's config zone
+ *  \param[in] device - device to operate on
  *  \param[in] config_data pointer to buffer containing a contiguous set of bytes to write to the config zone
  *  \returns ATCA_STATUS
  */
-ATCA_STATUS atcab_write_ecc_config_zone(const uint8_t* config_data)
+ATCA_STATUS atcab_ctx_write_ecc_config_zone(ATCADevice device, const uint8_t* config_data)
 {
 	ATCA_STATUS status = ATCA_GEN_FAIL;
-	ATCAPacket packet;
-	uint16_t execution_time = 0;
+	ATCAPacket *packet = NULL;
 	uint8_t zone=0, block=0, offset=0, slot=0, index=0;
 	uint16_t addr = 0;
 
 	// write the ecc zone one block at a time starting after address 0x04 (block 0, offset 4)
 	offset = 4;
+	if ( (packet = _atcab_packet_get(device)) == NULL )
+		return ATCA_GEN_FAIL;
+
+	_atcab_shadow_drop(device, ATCA_ZONE_CONFIG);
+
 	do
 	{
 		if((block==0)||(block==2)){
 
 			if(offset <= 7){
-				memset(packet.data, 0x00, 130);
+				memset(packet->data, 0x00, 130);
 				// read 4 bytes at once
-				packet.param1 = ATCA_ZONE_CONFIG;
+				packet->param1 = ATCA_ZONE_CONFIG;
 				// build a write command (write from the start)
-				if ( (status = atcab_get_addr(zone, slot, block, offset, &addr)) != ATCA_SUCCESS )
+				if ( (status = atcab_ctx_get_addr(device, zone, slot, block, offset, &addr)) != ATCA_SUCCESS )
 					break;
 
-				packet.param2 =  addr;
-				memcpy(&packet.data[0], &config_data[index+16], ATCA_WORD_SIZE);
+				packet->param2 =  addr;
+				memcpy(&packet->data[0], &config_data[index+16], ATCA_WORD_SIZE);
 				index += ATCA_WORD_SIZE;
-				status = atWrite(_gCommandObj, &packet);
-				execution_time = atGetExecTime( _gCommandObj, CMD_WRITEMEM);
-
-				if ( (status = atcab_wakeup()) != ATCA_SUCCESS ) break;
-			
-				// send the command
-				if ( (status = atsend( _gIface, (uint8_t *)&packet, packet.txsize )) != ATCA_SUCCESS )
-					break;
-
-				// delay the appropriate amount of time for command to execute
-				atca_delay_ms(execution_time);
-
-				// receive the response
-				if ( (status = atreceive( _gIface, packet.data, &packet.rxsize)) != ATCA_SUCCESS )
+				status = atWrite(atGetCommands(device), packet);
+				if ( (status = _atcab_execute( device, packet, CMD_WRITEMEM )) != ATCA_SUCCESS )
 					break;
 
-				if ( (status = atcab_idle()) != ATCA_SUCCESS ) break;
+				if ( (status = atcab_ctx_idle(device)) != ATCA_SUCCESS ) break;
 
-				if ( (status = isATCAError(packet.data)) != ATCA_SUCCESS )
+				if ( (status = isATCAError(packet->data)) != ATCA_SUCCESS )
 					break;
 
 				// update the offset address after reading each block
@@ -1243,35 +2434,23 @@ ATCA_STATUS atcab_write_ecc_config_zone(const uint8_t* config_data)
 			}
 		}
 		else{
-			memset(packet.data, 0x00, 130)	;
+			memset(packet->data, 0x00, 130)	;
 			// read 32 bytes at once
-			packet.param1 = ATCA_ZONE_CONFIG | ATCA_ZONE_READWRITE_32;
+			packet->param1 = ATCA_ZONE_CONFIG | ATCA_ZONE_READWRITE_32;
 			// build a write command (write from the start)
-			atcab_get_addr(zone, slot, block, offset, &addr);
-			packet.param2 =  addr;
-			memcpy(&packet.data[0], &config_data[index+16], ATCA_BLOCK_SIZE);
+			atcab_ctx_get_addr(device, zone, slot, block, offset, &addr);
+			packet->param2 =  addr;
+			memcpy(&packet->data[0], &config_data[index+16], ATCA_BLOCK_SIZE);
 			index += ATCA_BLOCK_SIZE;
-			if ( (status = atWrite(_gCommandObj, &packet)) != ATCA_SUCCESS )
-				break;
-
-			execution_time = atGetExecTime( _gCommandObj, CMD_WRITEMEM);
-
-			if ( (status = atcab_wakeup()) != ATCA_SUCCESS ) break;
-
-			// send the command
-			if ( (status = atsend( _gIface, (uint8_t *)&packet, packet.txsize )) != ATCA_SUCCESS )
+			if ( (status = atWrite(atGetCommands(device), packet)) != ATCA_SUCCESS )
 				break;
 
-			// delay the appropriate amount of time for command to execute
-			atca_delay_ms(execution_time);
-
-			// receive the response
-			if ( (status = atreceive( _gIface, packet.data, &packet.rxsize)) != ATCA_SUCCESS )
+			if ( (status = _atcab_execute( device, packet, CMD_WRITEMEM )) != ATCA_SUCCESS )
 				break;
 
-			if ( (status = atcab_idle()) != ATCA_SUCCESS ) break;
+			if ( (status = atcab_ctx_idle(device)) != ATCA_SUCCESS ) break;
 
-			if ( (status = isATCAError(packet.data)) != ATCA_SUCCESS )
+			if ( (status = isATCAError(packet->data)) != ATCA_SUCCESS )
 				break;
 
 			// update the word address after completely reading each block
@@ -1280,15 +2459,23 @@ ATCA_STATUS atcab_write_ecc_config_zone(const uint8_t* config_data)
 
 	} while (block <= 3);
 
-	_atcab_exit();	
+	_atcab_exit(device);	
+	_atcab_packet_put(device, packet);
 	return status;
 }
 
+/** \brief atcab_ctx_write_ecc_config_zone() on the default device */
+ATCA_STATUS atcab_write_ecc_config_zone(const uint8_t* config_data)
+{
+	return atcab_ctx_write_ecc_config_zone(_gDevice, config_data);
+}
+
 /** \brief given an SHA configuration zone buffer, read its parts from the device's config zone
+ *  \param[in] device - device to operate on
  *  \param[out] config_data pointer to buffer containing a contiguous set of bytes to write to the config zone
  *  \returns ATCA_STATUS
  */
-ATCA_STATUS atcab_read_sha_config_zone(uint8_t* config_data)
+ATCA_STATUS atcab_ctx_read_sha_config_zone(ATCADevice device, uint8_t* config_data)
 {
 	ATCA_STATUS status = ATCA_GEN_FAIL;
 	uint8_t zone = ATCA_ZONE_CONFIG;
@@ -1301,7 +2488,7 @@ ATCA_STATUS atcab_read_sha_config_zone(uint8_t* config_data)
 			break;
 		}
 		
-		status = atcab_read_bytes_zone(ATSHA204A, ATCA_ZONE_CONFIG, 0x00, ATCA_SHA_CONFIG_SIZE, config_data);
+		status = atcab_ctx_read_bytes_zone(device, ATSHA204A, ATCA_ZONE_CONFIG, 0x00, ATCA_SHA_CONFIG_SIZE, config_data);
 		if ( status != ATCA_SUCCESS )
 		    break;
 		
@@ -1310,11 +2497,18 @@ ATCA_STATUS atcab_read_sha_config_zone(uint8_t* config_data)
 	return status;
 }
 
+/** \brief atcab_ctx_read_sha_config_zone() on the default device */
+ATCA_STATUS atcab_read_sha_config_zone(uint8_t* config_data)
+{
+	return atcab_ctx_read_sha_config_zone(_gDevice, config_data);
+}
+
 /** \brief given an SHA configuration zone buffer, write its parts to the device's config zone
+ *  \param[in] device - device to operate on
  *  \param[in] config_data pointer to buffer containing a contiguous set of bytes to write to the config zone
  *  \returns ATCA_STATUS
  */
-ATCA_STATUS atcab_write_sha_config_zone(const uint8_t* config_data)
+ATCA_STATUS atcab_ctx_write_sha_config_zone(ATCADevice device, const uint8_t* config_data)
 {
 	ATCA_STATUS status = ATCA_GEN_FAIL;
 	uint8_t zone = ATCA_ZONE_CONFIG;
@@ -1327,7 +2521,7 @@ ATCA_STATUS atcab_write_sha_config_zone(const uint8_t* config_data)
 			break;
 		}
 		
-		status = atcab_write_bytes_zone(ATSHA204A, ATCA_ZONE_CONFIG, 0x10, &config_data[16], 68);
+		status = atcab_ctx_write_bytes_zone(device, ATSHA204A, ATCA_ZONE_CONFIG, 0x10, &config_data[16], 68);
 		if ( status != ATCA_SUCCESS )
 		    break;
 		
@@ -1336,11 +2530,18 @@ ATCA_STATUS atcab_write_sha_config_zone(const uint8_t* config_data)
 	return status;
 }
 
+/** \brief atcab_ctx_write_sha_config_zone() on the default device */
+ATCA_STATUS atcab_write_sha_config_zone(const uint8_t* config_data)
+{
+	return atcab_ctx_write_sha_config_zone(_gDevice, config_data);
+}
+
 /** \brief given an SHA configuration zone buffer and dev type, read its parts from the device's config zone
+ *  \param[in] device - device to operate on
  *  \param[out] config_data pointer to buffer containing a contiguous set of bytes to write to the config zone
  *  \returns ATCA_STATUS
  */
-ATCA_STATUS atcab_read_config_zone(ATCADeviceType dev_type, uint8_t* config_data)
+ATCA_STATUS atcab_ctx_read_config_zone(ATCADevice device, ATCADeviceType dev_type, uint8_t* config_data)
 {
 	ATCA_STATUS status = ATCA_GEN_FAIL;
 	uint8_t zone = ATCA_ZONE_CONFIG;
@@ -1354,9 +2555,9 @@ ATCA_STATUS atcab_read_config_zone(ATCADeviceType dev_type, uint8_t* config_data
 		}
 
 		if (dev_type == ATSHA204A)		
-			status = atcab_read_bytes_zone(dev_type, ATCA_ZONE_CONFIG, 0x00, ATCA_SHA_CONFIG_SIZE, config_data);
+			status = atcab_ctx_read_bytes_zone(device, dev_type, ATCA_ZONE_CONFIG, 0x00, ATCA_SHA_CONFIG_SIZE, config_data);
 		else
-			status = atcab_read_bytes_zone(dev_type, ATCA_ZONE_CONFIG, 0x00, ATCA_CONFIG_SIZE, config_data);
+			status = atcab_ctx_read_bytes_zone(device, dev_type, ATCA_ZONE_CONFIG, 0x00, ATCA_CONFIG_SIZE, config_data);
 		
 		if ( status != ATCA_SUCCESS )
 		    break;
@@ -1366,11 +2567,18 @@ ATCA_STATUS atcab_read_config_zone(ATCADeviceType dev_type, uint8_t* config_data
 	return status;
 }
 
+/** \brief atcab_ctx_read_config_zone() on the default device */
+ATCA_STATUS atcab_read_config_zone(ATCADeviceType dev_type, uint8_t* config_data)
+{
+	return atcab_ctx_read_config_zone(_gDevice, dev_type, config_data);
+}
+
 /** \brief given an SHA configuration zone buffer and dev type, write its parts to the device's config zone
+ *  \param[in] device - device to operate on
  *  \param[in] config_data pointer to buffer containing a contiguous set of bytes to write to the config zone
  *  \returns ATCA_STATUS
  */
-ATCA_STATUS atcab_write_config_zone(ATCADeviceType dev_type, const uint8_t* config_data)
+ATCA_STATUS atcab_ctx_write_config_zone(ATCADevice device, ATCADeviceType dev_type, const uint8_t* config_data)
 {
 	ATCA_STATUS status = ATCA_GEN_FAIL;
 	uint8_t zone = ATCA_ZONE_CONFIG;
@@ -1384,9 +2592,9 @@ ATCA_STATUS atcab_write_config_zone(ATCADeviceType dev_type, const uint8_t* conf
 		}
 
 		if (dev_type == ATSHA204A)
-			status = atcab_write_bytes_zone(dev_type, ATCA_ZONE_CONFIG, 0x00, config_data, ATCA_SHA_CONFIG_SIZE);
+			status = atcab_ctx_write_bytes_zone(device, dev_type, ATCA_ZONE_CONFIG, 0x00, config_data, ATCA_SHA_CONFIG_SIZE);
 		else
-			status = atcab_write_bytes_zone(dev_type, ATCA_ZONE_CONFIG, 0x00, config_data, ATCA_CONFIG_SIZE);
+			status = atcab_ctx_write_bytes_zone(device, dev_type, ATCA_ZONE_CONFIG, 0x00, config_data, ATCA_CONFIG_SIZE);
 		
 		if ( status != ATCA_SUCCESS )
 		    break;
@@ -1396,13 +2604,20 @@ ATCA_STATUS atcab_write_config_zone(ATCADeviceType dev_type, const uint8_t* conf
 	return status;
 }
 
+/** \brief atcab_ctx_write_config_zone() on the default device */
+ATCA_STATUS atcab_write_config_zone(ATCADeviceType dev_type, const uint8_t* config_data)
+{
+	return atcab_ctx_write_config_zone(_gDevice, dev_type, config_data);
+}
+
 /** \brief This function compares all writable bytes in the configuration zone that is passed in to the bytes on the device
  *
+ *  \param[in] device - device to operate on
  *  \param[in] config_data pointer to all 128 bytes in configuration zone. Not used if NULL.
  *  \param[out] pointer to boolean status whether config data passed in matches the actual config zone
  *  \return ATCA_STATUS
  */
-ATCA_STATUS atcab_cmp_config_zone(uint8_t* config_data, bool* same_config)
+ATCA_STATUS atcab_ctx_cmp_config_zone(ATCADevice device, uint8_t* config_data, bool* same_config)
 {
 	ATCA_STATUS status = ATCA_GEN_FAIL;
 	uint8_t device_config_data[ATCA_CONFIG_SIZE];
@@ -1419,7 +2634,7 @@ ATCA_STATUS atcab_cmp_config_zone(uint8_t* config_data, bool* same_config)
 		*same_config = false;
 
 		// Read all of the configuration bytes from the device
-		if ((status = atcab_read_ecc_config_zone(device_config_data)) != ATCA_SUCCESS) BREAK(status, "Read config zone failed");
+		if ((status = atcab_ctx_read_ecc_config_zone(device, device_config_data)) != ATCA_SUCCESS) BREAK(status, "Read config zone failed");
 
 		// Compare writable bytes 16-51 & writable bytes 90-127.
 		// Skip the counter & LastKeyUse bytes [52-83]
@@ -1433,201 +2648,354 @@ ATCA_STATUS atcab_cmp_config_zone(uint8_t* config_data, bool* same_config)
 	return status;
 }
 
+/** \brief atcab_ctx_cmp_config_zone() on the default device */
+ATCA_STATUS atcab_cmp_config_zone(uint8_t* config_data, bool* same_config)
+{
+	return atcab_ctx_cmp_config_zone(_gDevice, config_data, same_config);
+}
+
 
 /** \brief lock the ATCA ECC config zone.  config zone must be unlocked for the zone to be successfully locked
  *
+ *  \param[in] device - device to operate on
  *  \param[in] lock_response
  *  \return ATCA_STATUS
  */
-ATCA_STATUS atcab_lock_config_zone(uint8_t* lock_response)
+ATCA_STATUS atcab_ctx_lock_config_zone(ATCADevice device, uint8_t* lock_response)
 {
 	ATCA_STATUS status = ATCA_GEN_FAIL;
-	ATCAPacket packet;
-	uint16_t execution_time = 0;
+	ATCAPacket *packet = NULL;
 	
+	if ( (packet = _atcab_packet_get(device)) == NULL )
+		return ATCA_GEN_FAIL;
+
 	// build command for lock zone and send
-	packet.param1 = LOCK_ZONE_NO_CRC | LOCK_ZONE_CONFIG;
+	packet->param1 = LOCK_ZONE_NO_CRC | LOCK_ZONE_CONFIG;
+	_atcab_shadow_drop(device, ATCA_ZONE_CONFIG);
 	
 	do {
-		if ( (status = atLock(_gCommandObj, &packet)) != ATCA_SUCCESS ) break;
+		if ( (status = atLock(atGetCommands(device), packet)) != ATCA_SUCCESS ) break;
 		
-		execution_time = atGetExecTime( _gCommandObj, CMD_LOCK);
-
-		if ( (status = atcab_wakeup()) != ATCA_SUCCESS ) break;
-			
-		// send the command
-		if ( (status = atsend( _gIface, (uint8_t *)&packet, packet.txsize )) != ATCA_SUCCESS )
-			break;
-	
-		// delay the appropriate amount of time for command to execute
-		atca_delay_ms(execution_time);
-
-		// receive the response
-		if ( (status = atreceive( _gIface, packet.data, &packet.rxsize)) != ATCA_SUCCESS )
+		if ( (status = _atcab_execute( device, packet, CMD_LOCK )) != ATCA_SUCCESS )
 			break;
 	
 		//check the response for error
-		if ( (status = isATCAError(packet.data)) != ATCA_SUCCESS )
+		if ( (status = isATCAError(packet->data)) != ATCA_SUCCESS )
 		    break;
         
-		memcpy(lock_response, &packet.data[1], 1);
+		memcpy(lock_response, &packet->data[1], 1);
 	} while(0);
 			
-	_atcab_exit();
+	_atcab_exit(device);
+	_atcab_packet_put(device, packet);
 	return status;
 }
 
+/** \brief atcab_ctx_lock_config_zone() on the default device */
+ATCA_STATUS atcab_lock_config_zone(uint8_t* lock_response)
+{
+	return atcab_ctx_lock_config_zone(_gDevice, lock_response);
+}
+
 /** \brief lock the ATCA ECC Data zone.  
  * 
  *	ConfigZone must be locked and DataZone must be unlocked for the zone to be successfully locked
  *
+ *  \param[in] device - device to operate on
  *  \param[in] lock_response
  *  \return ATCA_STATUS
  */
-ATCA_STATUS atcab_lock_data_zone(uint8_t* lock_response)
+ATCA_STATUS atcab_ctx_lock_data_zone(ATCADevice device, uint8_t* lock_response)
 {
 	ATCA_STATUS status = ATCA_GEN_FAIL;
-	ATCAPacket packet;
-	uint16_t execution_time = 0;
+	ATCAPacket *packet = NULL;
 	
+	if ( (packet = _atcab_packet_get(device)) == NULL )
+		return ATCA_GEN_FAIL;
+
 	// build command for lock zone and send
-	packet.param1 = LOCK_ZONE_NO_CRC | LOCK_ZONE_DATA;
-	packet.param2 = 0x0000;
+	packet->param1 = LOCK_ZONE_NO_CRC | LOCK_ZONE_DATA;
+	packet->param2 = 0x0000;
+	_atcab_shadow_drop(device, ATCA_ZONE_CONFIG);
+	_atcab_shadow_drop(device, ATCA_ZONE_OTP);
 	
 	do {
-		status = atLock(_gCommandObj, &packet);
-		execution_time = atGetExecTime( _gCommandObj, CMD_LOCK);
-
-		if ((status = atcab_wakeup()) != ATCA_SUCCESS ) break;
-		
-		// send the command
-		if ((status = atsend( _gIface, (uint8_t *)&packet, packet.txsize )) != ATCA_SUCCESS )
-			break;
-	
-		// delay the appropriate amount of time for command to execute
-		atca_delay_ms(execution_time);
-
-		// receive the response
-		if ((status = atreceive( _gIface, packet.data, &packet.rxsize)) != ATCA_SUCCESS )
+		status = atLock(atGetCommands(device), packet);
+		if ( (status = _atcab_execute( device, packet, CMD_LOCK )) != ATCA_SUCCESS )
 			break;
 	
 		//check the response for error
-		if ((status = isATCAError(packet.data)) != ATCA_SUCCESS )
+		if ((status = isATCAError(packet->data)) != ATCA_SUCCESS )
 		    break;
         
-		memcpy(lock_response, &packet.data[1], 1);
+		memcpy(lock_response, &packet->data[1], 1);
 	} while(0);
 	
-	_atcab_exit();	
+	_atcab_exit(device);	
+	_atcab_packet_put(device, packet);
 	return status;
 }
 
+/** \brief atcab_ctx_lock_data_zone() on the default device */
+ATCA_STATUS atcab_lock_data_zone(uint8_t* lock_response)
+{
+	return atcab_ctx_lock_data_zone(_gDevice, lock_response);
+}
+
 /** \brief lock the ATCA ECC Data Slot
  *  ConfigZone must be locked and DataZone may or may not be locked for a individual data slot to be locked
  *
+ *  \param[in] device - device to operate on
  *  \param[in] slot to be locked in data zone
  *  \param[in] lock_response pointer to the lock response from the chip - 0 is successful lock
  *  \return ATAC_STATUS
  */
-ATCA_STATUS atcab_lock_data_slot(uint8_t slot, uint8_t* lock_response)
+ATCA_STATUS atcab_ctx_lock_data_slot(ATCADevice device, uint8_t slot, uint8_t* lock_response)
 {
 	ATCA_STATUS status = ATCA_GEN_FAIL;
-	ATCAPacket packet;
-	uint16_t execution_time = 0;
+	ATCAPacket *packet = NULL;
 	
+	if ( (packet = _atcab_packet_get(device)) == NULL )
+		return ATCA_GEN_FAIL;
+
 	// build command for lock slot and send
-	packet.param1 = (slot << 2) | LOCK_ZONE_DATA_SLOT;
-	packet.param2 = 0x0000;
+	packet->param1 = (slot << 2) | LOCK_ZONE_DATA_SLOT;
+	packet->param2 = 0x0000;
+	_atcab_shadow_drop(device, ATCA_ZONE_CONFIG);
 	
 	do {
-		if ( (status = atLock(_gCommandObj, &packet)) != ATCA_SUCCESS ) break;
+		if ( (status = atLock(atGetCommands(device), packet)) != ATCA_SUCCESS ) break;
 		
-		execution_time = atGetExecTime( _gCommandObj, CMD_LOCK);
-
-		if ( (status = atcab_wakeup()) != ATCA_SUCCESS ) break;
-			
-		// send the command
-		if ( (status = atsend( _gIface, (uint8_t *)&packet, packet.txsize )) != ATCA_SUCCESS )
-			break;
-	
-		// delay the appropriate amount of time for command to execute
-		atca_delay_ms(execution_time);
-
-		// receive the response
-		if ( (status = atreceive( _gIface, packet.data, &packet.rxsize)) != ATCA_SUCCESS )
+		if ( (status = _atcab_execute( device, packet, CMD_LOCK )) != ATCA_SUCCESS )
 			break;
 	
 		//check the response for error
-		if ( (status = isATCAError(packet.data)) != ATCA_SUCCESS )
+		if ( (status = isATCAError(packet->data)) != ATCA_SUCCESS )
 		    break;
 	
-		memcpy(lock_response, &packet.data[1], 1);
+		memcpy(lock_response, &packet->data[1], 1);
 	} while(0);
 	
-	_atcab_exit();
+	_atcab_exit(device);
+	_atcab_packet_put(device, packet);
+	return status;
+}
+
+/** \brief atcab_ctx_lock_data_slot() on the default device */
+ATCA_STATUS atcab_lock_data_slot(uint8_t slot, uint8_t* lock_response)
+{
+	return atcab_ctx_lock_data_slot(_gDevice, slot, lock_response);
+}
+
+/** \brief step function of the sign operation, see atcab_op_t */
+static ATCA_STATUS _atcab_sign_next(atcab_op_t *op)
+{
+	ATCA_STATUS status;
+
+	// each command after the first one needs the previous one to have succeeded
+	if ( op->step > 0 && (status = isATCAError(op->packet.data)) != ATCA_SUCCESS )
+		return status;
+
+	switch ( op->step )
+	{
+	case 0:
+		// random with seed update
+		op->packet.param1 = RANDOM_SEED_UPDATE;
+		op->packet.param2 = 0x0000;
+		op->command = CMD_RANDOM;
+		return atRandom( atGetCommands(op->device), &op->packet );
+
+	case 1:
+		// nonce passthrough with the message to sign
+		op->packet.param1 = NONCE_MODE_PASSTHROUGH;
+		op->packet.param2 = 0x0000;
+		memcpy( op->packet.data, op->message, 32 );
+		op->command = CMD_NONCE;
+		return atNonce( atGetCommands(op->device), &op->packet );
+
+	case 2:
+		// build sign command
+		op->packet.param1 = SIGN_MODE_EXTERNAL;
+		op->packet.param2 = op->key_id;
+		op->command = CMD_SIGN;
+		return atSign( atGetCommands(op->device), &op->packet );
+
+	default:
+		if ( op->out )
+			memcpy( op->out, &op->packet.data[1], ATCA_SIG_SIZE );
+		return ATCA_SUCCESS;
+	}
+}
+
+/** \brief sign a buffer using private key in given slot, stuff the signature
+ *  \param[in] device - device to operate on
+ *  \param[in] slot 
+ *  \param[in] msg should point to a 32 byte buffer
+ *  \param[out] signature of msg. signature should point to buffer SIGN_RSP_SIZE big
+ *  \return ATCA_STATUS
+ */
+ATCA_STATUS atcab_ctx_sign(ATCADevice device, uint16_t slot, const uint8_t *msg, uint8_t *signature)
+{
+	ATCA_STATUS status;
+	const uint8_t *sig;
+
+	if ( (status = atcab_ctx_sign_view(device, slot, msg, &sig)) == ATCA_SUCCESS )
+		memcpy( signature, sig, ATCA_SIG_SIZE );
 	return status;
 }
 
-/** \brief sign a buffer using private key in given slot, stuff the signature
- *  \param[in] slot 
- *  \param[in] msg should point to a 32 byte buffer
- *  \param[out] signature of msg. signature should point to buffer SIGN_RSP_SIZE big
- *  \return ATCA_STATUS
+/** \brief sign a buffer using private key in given slot, without copying the signature out of the response
+ *  \param[in] device - device to operate on
+ *  \param[in] slot 
+ *  \param[in] msg should point to a 32 byte buffer
+ *  \param[out] signature receives a pointer to the ATCA_SIG_SIZE byte signature in the response, which stays
+ *                         valid until the next command on the device
+ *  \return ATCA_STATUS
+ */
+ATCA_STATUS atcab_ctx_sign_view(ATCADevice device, uint16_t slot, const uint8_t *msg, const uint8_t **signature)
+{
+	ATCA_STATUS status;
+	atcab_op_t *op;
+
+	if ( (status = _atcab_op_get(device, &op)) != ATCA_SUCCESS )
+		return status;
+
+	op->next = _atcab_sign_next;
+	op->key_id = slot;
+	op->message = msg;
+	return _atcab_run_view(op, signature);
+}
+
+/** \brief atcab_ctx_sign() on the default device */
+ATCA_STATUS atcab_sign(uint16_t slot, const uint8_t *msg, uint8_t *signature)
+{
+	return atcab_ctx_sign(_gDevice, slot, msg, signature);
+}
+
+/** \brief atcab_ctx_sign_view() on the default device */
+ATCA_STATUS atcab_sign_view(uint16_t slot, const uint8_t *msg, const uint8_t **signature)
+{
+	return atcab_ctx_sign_view(_gDevice, slot, msg, signature);
+}
+
+/** \brief start signing a buffer using private key in given slot in the background
+ *  \param[in] device - device to operate on
+ *  \param[in] slot 
+ *  \param[in] msg should point to a 32 byte buffer
+ *  \param[out] signature of msg. signature should point to buffer SIGN_RSP_SIZE big, must stay valid until the callback
+ *  \param[in] callback called from atcab_ctx_poll() when done, may be NULL
+ *  \param[in] context passed to the callback
+ *  \return ATCA_STATUS
+ */
+ATCA_STATUS atcab_ctx_sign_start(ATCADevice device, uint16_t slot, const uint8_t *msg, uint8_t *signature, atcab_callback callback, void *context)
+{
+	ATCA_STATUS status;
+	atcab_op_t *op;
+
+	if ( (status = _atcab_op_get(device, &op)) != ATCA_SUCCESS )
+		return status;
+
+	op->next = _atcab_sign_next;
+	op->key_id = slot;
+	op->message = msg;
+	op->out = signature;
+	return _atcab_async_start(op, callback, context);
+}
+
+/** \brief atcab_ctx_sign_start() on the default device */
+ATCA_STATUS atcab_sign_start(uint16_t slot, const uint8_t *msg, uint8_t *signature, atcab_callback callback, void *context)
+{
+	return atcab_ctx_sign_start(_gDevice, slot, msg, signature, callback, context);
+}
+
+/** \brief step function of the batch sign operation, see atcab_op_t.  One Random updates the seed, then
+ *  each item takes a Nonce passthrough and a Sign.
  */
-ATCA_STATUS atcab_sign(uint16_t slot, const uint8_t *msg, uint8_t *signature)
+static ATCA_STATUS _atcab_sign_batch_next(atcab_op_t *op)
 {
-	ATCA_STATUS status = ATCA_GEN_FAIL;
-	ATCAPacket packet;
-	uint16_t execution_time = 0;
-	uint8_t randomnum[64];
+	ATCA_STATUS status;
+	int item;
 
-	if ( !_gDevice )
-		return ATCA_GEN_FAIL;
+	if ( op->step > 0 && (status = isATCAError(op->packet.data)) != ATCA_SUCCESS )
+		return status;
 
-	do {
-		if ( (status = atcab_random(randomnum)) != ATCA_SUCCESS ) break;
-		if ( (status = atcab_challenge( msg )) != ATCA_SUCCESS ) break;
+	if ( op->step == 0 )
+	{
+		// random with seed update, once for the whole batch
+		op->packet.param1 = RANDOM_SEED_UPDATE;
+		op->packet.param2 = 0x0000;
+		op->command = CMD_RANDOM;
+		return atRandom( atGetCommands(op->device), &op->packet );
+	}
 
-		// build sign command
-		packet.param1 = SIGN_MODE_EXTERNAL;
-		packet.param2 = slot;
-		if ( (status = atSign( _gCommandObj, &packet )) != ATCA_SUCCESS )
-			break;
+	// steps 1, 3, 5... send the nonce of an item, steps 2, 4, 6... its sign command
+	item = (op->step - 1) / 2;
+	if ( (op->step & 1) && op->step > 1 )
+		memcpy( op->outs[item - 1], &op->packet.data[1], ATCA_SIG_SIZE );
 
-		execution_time = atGetExecTime( _gCommandObj, CMD_SIGN);
+	if ( item >= op->count )
+		return ATCA_SUCCESS;
 
-		if ( (status != atcab_wakeup()) != ATCA_SUCCESS ) break;
-			
-		// send the command
-		if ( (status = atsend( _gIface, (uint8_t *)&packet, packet.txsize )) != ATCA_SUCCESS )
-			break;
-	
-		// delay the appropriate amount of time for command to execute
-		atca_delay_ms(execution_time);
+	if ( op->step & 1 )
+	{
+		op->packet.param1 = NONCE_MODE_PASSTHROUGH;
+		op->packet.param2 = 0x0000;
+		memcpy( op->packet.data, op->messages[item], 32 );
+		op->command = CMD_NONCE;
+		return atNonce( atGetCommands(op->device), &op->packet );
+	}
 
-		// receive the response
-		if ( (status = atreceive( _gIface, packet.data, &(packet.rxsize))) != ATCA_SUCCESS )
-			break;
-	
-		// check for response
-		if ( (status = isATCAError(packet.data)) != ATCA_SUCCESS )
-			break;
-	
-		memcpy( signature, &packet.data[1], ATCA_SIG_SIZE );
-	} while(0);
-	
-	_atcab_exit();
-	return status;
+	op->packet.param1 = SIGN_MODE_EXTERNAL;
+	op->packet.param2 = op->key_id;
+	op->command = CMD_SIGN;
+	return atSign( atGetCommands(op->device), &op->packet );
+}
+
+/** \brief sign several digests with the private key in given slot, all in one wake session.  The RNG seed
+ *  is updated once for the batch rather than before every signature.
+ *  \param[in] device - device to operate on
+ *  \param[in] slot - slot of the private key
+ *  \param[in] digests - count pointers to the 32 byte digests to sign
+ *  \param[in] count - number of digests
+ *  \param[out] signatures - count pointers to buffers of ATCA_SIG_SIZE bytes receiving the signatures
+ *  \return ATCA_STATUS, on failure the signatures of the digests before the failing one are valid
+ */
+ATCA_STATUS atcab_ctx_sign_batch(ATCADevice device, uint16_t slot, const uint8_t * const digests[], uint16_t count, uint8_t *signatures[])
+{
+	ATCA_STATUS status;
+	atcab_op_t *op;
+
+	if ( count > 0 && (digests == NULL || signatures == NULL) )
+		return ATCA_BAD_PARAM;
+	if ( count == 0 )
+		return ATCA_SUCCESS;
+
+	if ( (status = _atcab_op_get(device, &op)) != ATCA_SUCCESS )
+		return status;
+
+	op->next = _atcab_sign_batch_next;
+	op->key_id = slot;
+	op->messages = digests;
+	op->outs = signatures;
+	op->count = count;
+	return _atcab_run(op);
+}
+
+/** \brief atcab_ctx_sign_batch() on the default device */
+ATCA_STATUS atcab_sign_batch(uint16_t slot, const uint8_t * const digests[], uint16_t count, uint8_t *signatures[])
+{
+	return atcab_ctx_sign_batch(_gDevice, slot, digests, count, signatures);
 }
 
 /** \brief Issues a GenDig command to SHA256 hash the source data indicated by zone with the
  *  contents of TempKey.  See the CryptoAuth datasheet for your chip to see what the values of zone
  *  correspond to.
+ *  \param[in] device - device to operate on
  *  \param[in] zone - designates the source of the data to hash with TempKey
  *  \param[in] key_id - indicates the key, OTP block or message order for shared nonce mode
  *  \return ATCA_STATUS 
  */
-ATCA_STATUS atcab_gendig(uint8_t zone, uint16_t key_id)
+ATCA_STATUS atcab_ctx_gendig(ATCADevice device, uint8_t zone, uint16_t key_id)
 {
 	ATCA_STATUS status = ATCA_GEN_FAIL;
 	uint8_t otherDat[GENDIG_OTHER_DATA_SIZE] = { 0 };
@@ -1635,79 +3003,84 @@ ATCA_STATUS atcab_gendig(uint8_t zone, uint16_t key_id)
 	do
 	{
 		// Verify that we a valid device is present
-		if (!_gDevice) return ATCA_GEN_FAIL;
+		if (!device) return ATCA_GEN_FAIL;
 
-		// Call the atcab_gendig_host() function
-		if ((status = atcab_gendig_host(zone, key_id, otherDat, GENDIG_OTHER_DATA_SIZE)) != ATCA_SUCCESS ) BREAK(status, "GenDig failed");
+		// Call the atcab_ctx_gendig_host(device) function
+		if ((status = atcab_ctx_gendig_host(device, zone, key_id, otherDat, GENDIG_OTHER_DATA_SIZE)) != ATCA_SUCCESS ) BREAK(status, "GenDig failed");
 
 	} while(0);
 	return status;
 }
 
+/** \brief atcab_ctx_gendig() on the default device */
+ATCA_STATUS atcab_gendig(uint8_t zone, uint16_t key_id)
+{
+	return atcab_ctx_gendig(_gDevice, zone, key_id);
+}
+
 /** \brief Similar to atcab_gendig except this method does the operation in software on the host.
+ *  \param[in] device - device to operate on
  *  \param[in] zone - designates the source of the data to hash with TempKey
  *  \param[in] key_id - indicates the key, OTP block or message order for shared nonce mode
  *  \param[in] other_data - pointer to 4 or 32 bytes of data depending upon the mode
  *  \param[in] len - length of data
  *  \return ATCA_STATUS 
  */
-ATCA_STATUS atcab_gendig_host(uint8_t zone, uint16_t key_id, uint8_t *other_data, uint8_t len)
+ATCA_STATUS atcab_ctx_gendig_host(ATCADevice device, uint8_t zone, uint16_t key_id, uint8_t *other_data, uint8_t len)
 {
 	ATCA_STATUS status = ATCA_GEN_FAIL;
-	ATCAPacket packet;
-	uint16_t execution_time = 0;
+	ATCAPacket *packet = NULL;
 	bool hasMACKey = 0;
 
-	if ( !_gDevice || other_data == NULL )
+	if ( !device || other_data == NULL )
 		return ATCA_GEN_FAIL;
 
 	do {
 
+		if ( (packet = _atcab_packet_get(device)) == NULL )
+			return ATCA_GEN_FAIL;
+
 		// build gendig command
-		packet.param1 = zone;
-		packet.param2 = key_id;
+		packet->param1 = zone;
+		packet->param2 = key_id;
 
-		if ( packet.param1 == 0x03 && len == 0x20) {
-			memcpy(&packet.data[0], &other_data[0], ATCA_WORD_SIZE);
-		} else if ( packet.param1 == 0x02 && len == 0x20) {
-			memcpy(&packet.data[0], &other_data[0], ATCA_WORD_SIZE);
+		if ( packet->param1 == 0x03 && len == 0x20) {
+			memcpy(&packet->data[0], &other_data[0], ATCA_WORD_SIZE);
+		} else if ( packet->param1 == 0x02 && len == 0x20) {
+			memcpy(&packet->data[0], &other_data[0], ATCA_WORD_SIZE);
 			hasMACKey = true;
 		}
 		
-		if ( (status = atGenDig( _gCommandObj, &packet, hasMACKey)) != ATCA_SUCCESS )
-			break;
-
-		execution_time = atGetExecTime( _gCommandObj, CMD_GENDIG);
-
-		if ( (status != atcab_wakeup()) != ATCA_SUCCESS ) break;
-			
-		// send the command
-		if ( (status = atsend( _gIface, (uint8_t *)&packet, packet.txsize )) != ATCA_SUCCESS )
+		if ( (status = atGenDig( atGetCommands(device), packet, hasMACKey)) != ATCA_SUCCESS )
 			break;
-	
-		// delay the appropriate amount of time for command to execute
-		atca_delay_ms(execution_time);
 
-		// receive the response
-		if ( (status = atreceive( _gIface, packet.data, &(packet.rxsize))) != ATCA_SUCCESS )
+		if ( (status = _atcab_execute( device, packet, CMD_GENDIG )) != ATCA_SUCCESS )
 			break;
 	
 		// check for response
-		if ( (status = isATCAError(packet.data)) != ATCA_SUCCESS )
+		if ( (status = isATCAError(packet->data)) != ATCA_SUCCESS )
 			break;
 	
 	} while(0);
 
-	_atcab_exit();
+	_atcab_exit(device);
+	_atcab_packet_put(device, packet);
 	return status;
 }
 
+/** \brief atcab_ctx_gendig_host() on the default device */
+ATCA_STATUS atcab_gendig_host(uint8_t zone, uint16_t key_id, uint8_t *other_data, uint8_t len)
+{
+	return atcab_ctx_gendig_host(_gDevice, zone, key_id, other_data, len);
+}
+
 /** \brief reads a signature found in one of slots 8 through F.
+ *  \param[in] device - device to operate on
  *  \param[in] slot8toF - which slot to read
  *  \param[out] sig - pointer to the space to receive the signature found in the slot
  *  \return ATCA_STATUS
  */
-ATCA_STATUS atcab_read_sig(uint8_t slot8toF, uint8_t *sig)
+ATCA_STATUS atcab_ctx_read_sig(ATCADevice device, uint8_t slot8toF, uint8_t *sig)
 {
 	uint8_t ret = ATCA_GEN_FAIL;
 	uint8_t read_buf[ATCA_BLOCK_SIZE];
@@ -1725,7 +3098,7 @@ ATCA_STATUS atcab_read_sig(uint8_t slot8toF, uint8_t *sig)
 
 		// Read the first block
 		block = 0;
-		if ( (ret = atcab_read_zone(ATCA_ZONE_DATA, slot8toF, block, offset, read_buf, ATCA_BLOCK_SIZE)) != ATCA_SUCCESS )
+		if ( (ret = atcab_ctx_read_zone(device, ATCA_ZONE_DATA, slot8toF, block, offset, read_buf, ATCA_BLOCK_SIZE)) != ATCA_SUCCESS )
 			break;
 			
 		// Copy.  first 32 bytes
@@ -1734,7 +3107,7 @@ ATCA_STATUS atcab_read_sig(uint8_t slot8toF, uint8_t *sig)
 
 		// Read the second block
 		block = 1;
-		if ( (ret = atcab_read_zone(ATCA_ZONE_DATA, slot8toF, block, offset, read_buf, ATCA_BLOCK_SIZE)) != ATCA_SUCCESS )
+		if ( (ret = atcab_ctx_read_zone(device, ATCA_ZONE_DATA, slot8toF, block, offset, read_buf, ATCA_BLOCK_SIZE)) != ATCA_SUCCESS )
 			break;
 			
 		// Copy.  next 32 bytes
@@ -1746,62 +3119,143 @@ ATCA_STATUS atcab_read_sig(uint8_t slot8toF, uint8_t *sig)
 	return ret;
 }
 
+/** \brief atcab_ctx_read_sig() on the default device */
+ATCA_STATUS atcab_read_sig(uint8_t slot8toF, uint8_t *sig)
+{
+	return atcab_ctx_read_sig(_gDevice, slot8toF, sig);
+}
+
+/** \brief step function of the get pubkey operation, see atcab_op_t.  A key in the pubkey cache completes
+ *  the operation without a command.
+ */
+static ATCA_STATUS _atcab_get_pubkey_next(atcab_op_t *op)
+{
+	ATCA_STATUS status;
+	uint8_t serial[ATCA_SERIAL_NUM_SIZE];
+	atcab_state_t *state = _atcab_pubkey_serial(op, serial);
+	atcab_pubkey_t *entry;
+
+	if ( op->step == 0 )
+	{
+		if ( state && (entry = _atcab_pubkey_find(state, serial, (uint8_t)op->key_id, false)) != NULL )
+		{
+			// hand out the response buffer as for a key calculated by the device
+			memcpy( &op->packet.data[1], entry->pubkey, ATCA_PUB_KEY_SIZE );
+			if ( op->out )
+				memcpy( op->out, entry->pubkey, ATCA_PUB_KEY_SIZE );
+			return ATCA_SUCCESS;
+		}
+
+		// build a genkey command
+		op->packet.param1 = GENKEY_MODE_PUBLIC;
+		op->packet.param2 = op->key_id;
+		op->command = CMD_GENKEY;
+		return atGenKey( atGetCommands(op->device), &op->packet, false );
+	}
+
+	if ( (status = isATCAError(op->packet.data)) != ATCA_SUCCESS )
+		return status;
+
+	if ( state )
+		_atcab_pubkey_put( state, serial, (uint8_t)op->key_id, false, &op->packet.data[1] );
+
+	// copy the response public key data
+	if ( op->out )
+		memcpy( op->out, &op->packet.data[1], 64 );
+	return ATCA_SUCCESS;
+}
+
 /** \brief returns a public key found in a designated slot.  The slot must be configured as a slot with a private key.
  *  This method will use GenKey t geenrate the corresponding public key from the private key in the given slot.
+ *  The key is kept in the pubkey cache, later calls for the slot are served from there.
+ *  \param[in] device - device to operate on
  *  \param[in] slot
  *  \param[out] pubkey - pointer to space receiving the contents of the public key that was generated
  *  \return ATCA_STATUS
  */
+ATCA_STATUS atcab_ctx_get_pubkey(ATCADevice device, uint8_t slot, uint8_t *pubkey)
+{
+	ATCA_STATUS status;
+	const uint8_t *key;
+
+	if ( (status = atcab_ctx_get_pubkey_view(device, slot, &key)) == ATCA_SUCCESS )
+		memcpy( pubkey, key, ATCA_PUB_KEY_SIZE );
+	return status;
+}
+
+/** \brief calculate the public key of the private key in given slot, without copying it out of the response
+ *  \param[in] device - device to operate on
+ *  \param[in] slot
+ *  \param[out] pubkey - receives a pointer to the 64 byte public key in the response, which stays valid until
+ *                       the next command on the device
+ *  \return ATCA_STATUS
+ */
+ATCA_STATUS atcab_ctx_get_pubkey_view(ATCADevice device, uint8_t slot, const uint8_t **pubkey)
+{
+	ATCA_STATUS status;
+	atcab_op_t *op;
+
+	if ( (status = _atcab_op_get(device, &op)) != ATCA_SUCCESS )
+		return status;
+
+	op->next = _atcab_get_pubkey_next;
+	op->key_id = slot;
+	return _atcab_run_view(op, pubkey);
+}
+
+/** \brief atcab_ctx_get_pubkey() on the default device */
 ATCA_STATUS atcab_get_pubkey(uint8_t slot, uint8_t *pubkey)
 {
-	ATCAPacket packet;
-	uint16_t execution_time = 0;
-	ATCA_STATUS status = ATCA_GEN_FAIL;
-	
-	do {
-		// build a genkey command
-		packet.param1 = GENKEY_MODE_PUBLIC;
-		packet.param2 = (uint16_t)(slot);
-	
-		if ( (status = atGenKey( _gCommandObj, &packet, false )) != ATCA_SUCCESS ) break;
+	return atcab_ctx_get_pubkey(_gDevice, slot, pubkey);
+}
 
-		execution_time = atGetExecTime( _gCommandObj, CMD_GENKEY);
-	
-		if ( (status = atcab_wakeup()) != ATCA_SUCCESS ) break;
-		
-		// send the command
-		if ( (status = atsend( _gIface, (uint8_t *)&packet, packet.txsize )) != ATCA_SUCCESS ) 
-			break;
+/** \brief atcab_ctx_get_pubkey_view() on the default device */
+ATCA_STATUS atcab_get_pubkey_view(uint8_t slot, const uint8_t **pubkey)
+{
+	return atcab_ctx_get_pubkey_view(_gDevice, slot, pubkey);
+}
 
-		// delay the appropriate amount of time for command to execute
-		atca_delay_ms(execution_time);
+/** \brief start calculating the public key of the private key in given slot in the background.  A key in
+ *  the pubkey cache is handed out by the next atcab_ctx_poll() without a command.
+ *  \param[in] device - device to operate on
+ *  \param[in] slot
+ *  \param[out] pubkey - 64 bytes of public key, must stay valid until the callback
+ *  \param[in] callback called from atcab_ctx_poll() when done, may be NULL
+ *  \param[in] context passed to the callback
+ *  \return ATCA_STATUS
+ */
+ATCA_STATUS atcab_ctx_get_pubkey_start(ATCADevice device, uint8_t slot, uint8_t *pubkey, atcab_callback callback, void *context)
+{
+	ATCA_STATUS status;
+	atcab_op_t *op;
 
-		// receive the response
-		if ( (status = atreceive( _gIface, packet.data, &(packet.rxsize) )) != ATCA_SUCCESS )
-			break;
-            
-        if ( (status = isATCAError(packet.data)) != ATCA_SUCCESS )
-            break;
+	if ( (status = _atcab_op_get(device, &op)) != ATCA_SUCCESS )
+		return status;
 
-		// copy the response public key data
-		memcpy(pubkey, &packet.data[1], 64 );
-	} while(0);
-	
-	_atcab_exit();
-	return status;
+	op->next = _atcab_get_pubkey_next;
+	op->key_id = slot;
+	op->out = pubkey;
+	return _atcab_async_start(op, callback, context);
+}
+
+/** \brief atcab_ctx_get_pubkey_start() on the default device */
+ATCA_STATUS atcab_get_pubkey_start(uint8_t slot, uint8_t *pubkey, atcab_callback callback, void *context)
+{
+	return atcab_ctx_get_pubkey_start(_gDevice, slot, pubkey, callback, context);
 }
 
 /** \brief write a P256 private key in given slot using mac computation
+ *  \param[in] device - device to operate on
  *  \param[in] slot 
  *  \param[in] priv_key first 4 bytes of 36 bytes should be zero
  *  \param[in] write_key_slot slot to make a session key
  *  \param[in] write_key key to make a session key 
  *  \return ATCA_STATUS
  */
-ATCA_STATUS atcab_priv_write(uint8_t slot, const uint8_t priv_key[36], uint8_t write_key_slot, const uint8_t write_key[32])
+ATCA_STATUS atcab_ctx_priv_write(ATCADevice device, uint8_t slot, const uint8_t priv_key[36], uint8_t write_key_slot, const uint8_t write_key[32])
 {
 	ATCA_STATUS status = ATCA_GEN_FAIL;
-	ATCAPacket packet;
+	ATCAPacket *packet = NULL;
 	atca_nonce_in_out_t nonceParam;
 	atca_gen_dig_in_out_t genDigParam;
 	atca_write_mac_in_out_t hostMacParam;
@@ -1810,26 +3264,30 @@ ATCA_STATUS atcab_priv_write(uint8_t slot, const uint8_t priv_key[36], uint8_t w
 	uint8_t randout[RANDOM_NUM_SIZE] = { 0 };
 	uint8_t cipher_text[36] = { 0 };
 	uint8_t host_mac[MAC_SIZE] = { 0 };
-	uint16_t execution_time = 0;
 
 	if (slot > 15 || priv_key == NULL)
 		return ATCA_BAD_PARAM;
 
+	if ( (packet = _atcab_packet_get(device)) == NULL )
+		return ATCA_GEN_FAIL;
+
+	_atcab_pubkey_drop(device, slot);
+
 	do {
 
 		if (write_key == NULL)
 		{
 			// Caller requested an unencrypted PrivWrite, which is only allowed when the data zone is unlocked
 			// build an PrivWrite command
-			packet.param1 = 0x00;   // Mode is unencrypted write
-			packet.param2 = slot;   // Key ID
-			memcpy(&packet.data[0], priv_key, 36); // Private key
-			memset(&packet.data[36], 0, 32);       // MAC (ignored for unencrypted write)
+			packet->param1 = 0x00;   // Mode is unencrypted write
+			packet->param2 = slot;   // Key ID
+			memcpy(&packet->data[0], priv_key, 36); // Private key
+			memset(&packet->data[36], 0, 32);       // MAC (ignored for unencrypted write)
 		}
 		else
 		{
 			// Send the random Nonce command
-			if ((status = atcab_nonce_rand(numin, randout)) != ATCA_SUCCESS)
+			if ((status = atcab_ctx_nonce_rand(device, numin, randout)) != ATCA_SUCCESS)
 				break;
 
 			// Calculate Tempkey
@@ -1841,7 +3299,7 @@ ATCA_STATUS atcab_priv_write(uint8_t slot, const uint8_t priv_key[36], uint8_t w
 				break;
 
 			// Send the GenDig command
-			if ((status = atcab_gendig_host(GENDIG_ZONE_DATA, write_key_slot, tempkey.value, 32)) != ATCA_SUCCESS) 
+			if ((status = atcab_ctx_gendig_host(device, GENDIG_ZONE_DATA, write_key_slot, tempkey.value, 32)) != ATCA_SUCCESS) 
 				break;
 
 			// Calculate Tempkey
@@ -1864,45 +3322,41 @@ ATCA_STATUS atcab_priv_write(uint8_t slot, const uint8_t priv_key[36], uint8_t w
 				break;
 
 			// build a write command for encrypted writes		
-			packet.param1 = PRIVWRITE_MODE_ENCRYPT;   // Mode is encrypted write
-			packet.param2 = slot;   // Key ID
-			memcpy(&packet.data[0], cipher_text, sizeof(cipher_text));
-			memcpy(&packet.data[36], host_mac, sizeof(host_mac));
+			packet->param1 = PRIVWRITE_MODE_ENCRYPT;   // Mode is encrypted write
+			packet->param2 = slot;   // Key ID
+			memcpy(&packet->data[0], cipher_text, sizeof(cipher_text));
+			memcpy(&packet->data[36], host_mac, sizeof(host_mac));
 		}
 
-		if ((status = atPrivWrite(_gCommandObj, &packet)) != ATCA_SUCCESS)
+		if ((status = atPrivWrite(atGetCommands(device), packet)) != ATCA_SUCCESS)
 			break;
 
-		execution_time = atGetExecTime(_gCommandObj, CMD_PRIVWRITE);
-
-		if ( (status = atcab_wakeup()) != ATCA_SUCCESS ) break;
-
-		// send the command
-		if ((status = atsend(_gIface, (uint8_t*)&packet, packet.txsize)) != ATCA_SUCCESS)
-			break;
-
-		// delay the appropriate amount of time for command to execute
-		atca_delay_ms(execution_time);
-
-		// receive the response
-		if ((status = atreceive(_gIface, packet.data, &packet.rxsize)) != ATCA_SUCCESS)
+		if ( (status = _atcab_execute( device, packet, CMD_PRIVWRITE )) != ATCA_SUCCESS )
 			break;
 
-		if ( (status = isATCAError(packet.data)) != ATCA_SUCCESS )
+		if ( (status = isATCAError(packet->data)) != ATCA_SUCCESS )
 			break;
 
 	} while(0);
 
-	_atcab_exit();
+	_atcab_exit(device);
+	_atcab_packet_put(device, packet);
 	return status;
 }
 
+/** \brief atcab_ctx_priv_write() on the default device */
+ATCA_STATUS atcab_priv_write(uint8_t slot, const uint8_t priv_key[36], uint8_t write_key_slot, const uint8_t write_key[32])
+{
+	return atcab_ctx_priv_write(_gDevice, slot, priv_key, write_key_slot, write_key);
+}
+
 /** \brief reads a pub key from a readable data slot versus atcab_get_pubkey which generates a pubkey from a private key slot
+ *  \param[in] device - device to operate on
  *  \param[in] slot8toF - slot number to read, expected value is 0x8 through 0xF
  *  \param[out] pubkey - space to receive read pubkey
  *  \return ATCA_STATUS
  */ 
-ATCA_STATUS atcab_read_pubkey(uint8_t slot8toF, uint8_t *pubkey)
+ATCA_STATUS atcab_ctx_read_pubkey(ATCADevice device, uint8_t slot8toF, uint8_t *pubkey)
 {
 	uint8_t ret = ATCA_GEN_FAIL;
 	uint8_t read_buf[ATCA_BLOCK_SIZE];
@@ -1911,6 +3365,9 @@ ATCA_STATUS atcab_read_pubkey(uint8_t slot8toF, uint8_t *pubkey)
 	uint8_t cpyIndex = 0;
 	uint8_t cpySize = 0;
 	uint8_t readIndex = 0;
+	atcab_state_t *state = NULL;
+	atcab_pubkey_t *entry;
+	uint8_t serial[ATCA_SERIAL_NUM_SIZE];
     
     // Check the pointers
     if (pubkey == NULL)
@@ -1918,6 +3375,14 @@ ATCA_STATUS atcab_read_pubkey(uint8_t slot8toF, uint8_t *pubkey)
     // Check the value of the slot
     if (slot8toF < 8 || slot8toF > 0xF)
         return ATCA_BAD_PARAM;
+
+	if ( atcab_ctx_read_serial_number(device, serial) == ATCA_SUCCESS
+	     && (state = _atcab_state(device, false)) != NULL
+	     && (entry = _atcab_pubkey_find(state, serial, slot8toF, true)) != NULL )
+	{
+		memcpy( pubkey, entry->pubkey, ATCA_PUB_KEY_SIZE );
+		return ATCA_SUCCESS;
+	}
     
 	do
 	{
@@ -1927,7 +3392,7 @@ ATCA_STATUS atcab_read_pubkey(uint8_t slot8toF, uint8_t *pubkey)
 
 		// Read the block
 		block = 0;
-		if ( (ret = atcab_read_zone(ATCA_ZONE_DATA, slot8toF, block, offset, read_buf, ATCA_BLOCK_SIZE)) != ATCA_SUCCESS )
+		if ( (ret = atcab_ctx_read_zone(device, ATCA_ZONE_DATA, slot8toF, block, offset, read_buf, ATCA_BLOCK_SIZE)) != ATCA_SUCCESS )
 			break;
 			
 		// Copy.  Account for 4 byte pad
@@ -1938,7 +3403,7 @@ ATCA_STATUS atcab_read_pubkey(uint8_t slot8toF, uint8_t *pubkey)
 
 		// Read the next block
 		block = 1;
-		if ( (ret = atcab_read_zone(ATCA_ZONE_DATA, slot8toF, block, offset, read_buf, ATCA_BLOCK_SIZE)) != ATCA_SUCCESS )
+		if ( (ret = atcab_ctx_read_zone(device, ATCA_ZONE_DATA, slot8toF, block, offset, read_buf, ATCA_BLOCK_SIZE)) != ATCA_SUCCESS )
 			break;
 			
 		// Copy.  First four bytes
@@ -1954,7 +3419,7 @@ ATCA_STATUS atcab_read_pubkey(uint8_t slot8toF, uint8_t *pubkey)
 
 		// Read the next block
 		block = 2;
-		if ( (ret = atcab_read_zone(ATCA_ZONE_DATA, slot8toF, block, offset, read_buf, ATCA_BLOCK_SIZE)) != ATCA_SUCCESS )
+		if ( (ret = atcab_ctx_read_zone(device, ATCA_ZONE_DATA, slot8toF, block, offset, read_buf, ATCA_BLOCK_SIZE)) != ATCA_SUCCESS )
 			break;
 			
 		// Copy.  The remaining 8 bytes
@@ -1962,53 +3427,330 @@ ATCA_STATUS atcab_read_pubkey(uint8_t slot8toF, uint8_t *pubkey)
 		readIndex = 0;
 		memcpy(&pubkey[cpyIndex], &read_buf[readIndex], cpySize);
 
-	} while (0);
+		if ( state )
+			_atcab_pubkey_put( state, serial, slot8toF, true, pubkey );
+	} while (0);
+
+	return ret;
+}
+
+/** \brief atcab_ctx_read_pubkey() on the default device */
+ATCA_STATUS atcab_read_pubkey(uint8_t slot8toF, uint8_t *pubkey)
+{
+	return atcab_ctx_read_pubkey(_gDevice, slot8toF, pubkey);
+}
+
+/** \brief fill the pubkey cache with the public keys of all P256 key slots of a device, in one wake session.
+ *  Slots holding a private key get the key GenKey calculates from it, slots 8-15 holding a public key get
+ *  the key read from them.  Slots whose key can't be had, e.g. because the slot isn't written yet, are
+ *  skipped.
+ *  \param[in] device - device to operate on
+ *  \return ATCA_STATUS
+ */
+ATCA_STATUS atcab_ctx_pubkey_cache_fill(ATCADevice device)
+{
+	ATCA_STATUS status = ATCA_SUCCESS;
+	uint8_t key_config[ATCA_WORD_SIZE];
+	uint8_t pubkey[ATCA_PUB_KEY_SIZE];
+	uint16_t config;
+	uint8_t slot;
+
+	if ( device == NULL )
+		return ATCA_BAD_PARAM;
+
+	if ( atgetifacecfg(atGetIFace(device))->devtype == ATSHA204A )
+		return ATCA_SUCCESS;
+
+	atcab_ctx_session_begin(device);
+
+	for ( slot = 0; slot < ATCA_KEY_COUNT; slot++ )
+	{
+		// KeyConfig of two slots per word (config block = 3, word offset = slot / 2)
+		if ( (status = atcab_ctx_read_zone(device, ATCA_ZONE_CONFIG, 0, 3, slot >> 1, key_config, ATCA_WORD_SIZE)) != ATCA_SUCCESS )
+			break;
+
+		config = key_config[(slot & 1) * 2] | (key_config[(slot & 1) * 2 + 1] << 8);
+		if ( ((config >> 2) & 0x07) != 4 )		// KeyType isn't P256
+			continue;
+
+		if ( config & 0x01 )					// Private
+			atcab_ctx_get_pubkey(device, slot, pubkey);
+		else if ( slot >= 8 )
+			atcab_ctx_read_pubkey(device, slot, pubkey);
+	}
+
+	atcab_ctx_session_end(device);
+	return status;
+}
+
+/** \brief atcab_ctx_pubkey_cache_fill() on the default device */
+ATCA_STATUS atcab_pubkey_cache_fill(void)
+{
+	return atcab_ctx_pubkey_cache_fill(_gDevice);
+}
+
+/** \brief size of a slot of the data zone
+ *  \param[in] dev_type - device type, the slots of ECC devices differ in size
+ *  \param[in] slot - slot 0-15
+ *  \param[out] size - receives the size of the slot in bytes
+ *  \return ATCA_STATUS
+ */
+ATCA_STATUS atcab_get_slot_size(ATCADeviceType dev_type, uint8_t slot, uint16_t *size)
+{
+	if (size == NULL || slot > 15)
+		return ATCA_BAD_PARAM;
+
+	if (dev_type == ATECC508A || dev_type == ATECC108A)
+		*size = slot < 8 ? 36 : (slot == 8 ? 416 : 72);
+	else
+		*size = ATCA_BLOCK_SIZE;
+
+	return ATCA_SUCCESS;
+}
+
+/** \brief find the slot a byte address of the data zone falls in.  The data zone is addressed as its slots
+ *  laid out one after the other.
+ *  \param[in] dev_type - device type
+ *  \param[in] address - byte address in the data zone
+ *  \param[out] slot - receives the slot
+ *  \param[out] offset - receives the offset of the address in the slot
+ *  \return ATCA_STATUS, ATCA_BAD_PARAM if the address is past the end of the data zone
+ */
+static ATCA_STATUS _atcab_data_slot(ATCADeviceType dev_type, uint16_t address, uint8_t *slot, uint16_t *offset)
+{
+	uint16_t start = 0, size;
+
+	for ( *slot = 0; *slot < 16; (*slot)++ )
+	{
+		atcab_get_slot_size(dev_type, *slot, &size);
+		if (address < start + size)
+		{
+			*offset = address - start;
+			return ATCA_SUCCESS;
+		}
+		start += size;
+	}
+
+	return ATCA_BAD_PARAM;
+}
+
+/** \brief read or write a range of bytes of one slot, or of the config or OTP zone.  The 32 byte blocks the
+ *  range covers take one command each, only the unaligned edges go a word at a time.  Partial words are read,
+ *  and for a write patched and written back.  Config words Write can't change are skipped, as before.
+ *  \param[in] device - device to operate on
+ *  \param[in] zone - ATCA_ZONE_CONFIG, ATCA_ZONE_OTP or ATCA_ZONE_DATA
+ *  \param[in] slot - slot of the data zone, 0 for the other zones
+ *  \param[in] offset - byte offset of the range in the slot or zone
+ *  \param[out] rdata - receives the bytes read, NULL to write
+ *  \param[in] wdata - bytes to write, NULL to read
+ *  \param[in] len - number of bytes
+ *  \return ATCA_STATUS
+ */
+static ATCA_STATUS _atcab_slot_io(ATCADevice device, uint8_t zone, uint8_t slot, uint16_t offset, uint8_t *rdata, const uint8_t *wdata, uint16_t len)
+{
+	ATCA_STATUS status = ATCA_SUCCESS;
+	uint8_t word[ATCA_WORD_SIZE];
+	uint8_t block, index, first, count;
+	uint16_t done = 0;
+	bool fixed_words;
+
+	while ( done < len )
+	{
+		block = offset / ATCA_BLOCK_SIZE;
+		index = (offset % ATCA_BLOCK_SIZE) / ATCA_WORD_SIZE;
+		fixed_words = wdata != NULL && zone == ATCA_ZONE_CONFIG && (block == 0 || block == 2);
+
+		if ( offset % ATCA_BLOCK_SIZE == 0 && len - done >= ATCA_BLOCK_SIZE && !fixed_words )
+		{
+			count = ATCA_BLOCK_SIZE;
+			if (rdata)
+				status = atcab_ctx_read_zone(device, zone, slot, block, 0, &rdata[done], ATCA_BLOCK_SIZE);
+			else
+				status = atcab_ctx_write_zone(device, zone, slot, block, 0, &wdata[done], ATCA_BLOCK_SIZE);
+		}
+		else
+		{
+			first = offset % ATCA_WORD_SIZE;
+			count = ATCA_WORD_SIZE - first;
+			if (count > len - done)
+				count = (uint8_t)(len - done);
+
+			// bytes 0-15 are fixed, bytes 84-91 only change through UpdateExtra and Lock
+			if ( fixed_words && (offset < 16 || (offset >= 84 && offset < 92)) )
+				status = ATCA_SUCCESS;
+			else if ( wdata && count == ATCA_WORD_SIZE )
+				status = atcab_ctx_write_zone(device, zone, slot, block, index, &wdata[done], ATCA_WORD_SIZE);
+			else if ( (status = atcab_ctx_read_zone(device, zone, slot, block, index, word, ATCA_WORD_SIZE)) == ATCA_SUCCESS )
+			{
+				if (rdata)
+					memcpy(&rdata[done], &word[first], count);
+				else
+				{
+					memcpy(&word[first], &wdata[done], count);
+					status = atcab_ctx_write_zone(device, zone, slot, block, index, word, ATCA_WORD_SIZE);
+				}
+			}
+		}
+		if (status != ATCA_SUCCESS)
+			break;
+
+		offset += count;
+		done += count;
+	}
+
+	return status;
+}
+
+/** \brief read or write a range of bytes of a zone, the data zone addressed as its slots laid out one
+ *  after the other.  The device is kept awake for all commands.
+ *  \param[in] device - device to operate on
+ *  \param[in] dev_type - device type, decides the sizes of the zones and slots
+ *  \param[in] zone - ATCA_ZONE_CONFIG, ATCA_ZONE_OTP or ATCA_ZONE_DATA
+ *  \param[in] address - byte address of the range in the zone
+ *  \param[out] rdata - receives the bytes read, NULL to write
+ *  \param[in] wdata - bytes to write, NULL to read
+ *  \param[in] len - number of bytes
+ *  \return ATCA_STATUS
+ */
+static ATCA_STATUS _atcab_zone_io(ATCADevice device, ATCADeviceType dev_type, uint8_t zone, uint16_t address, uint8_t *rdata, const uint8_t *wdata, uint16_t len)
+{
+	ATCA_STATUS status = ATCA_SUCCESS;
+	uint8_t slot = 0;
+	uint16_t offset = address, size, count, done = 0;
+
+	if (zone == ATCA_ZONE_CONFIG || zone == ATCA_ZONE_OTP)
+	{
+		if (zone == ATCA_ZONE_OTP)
+			size = ATCA_OTP_SIZE;
+		else
+			size = (dev_type == ATECC508A || dev_type == ATECC108A) ? ATCA_CONFIG_SIZE : ATCA_SHA_CONFIG_SIZE;
+		if (address + len > size)
+			return ATCA_BAD_PARAM;
+	}
+
+	atcab_ctx_session_begin(device);
+
+	while ( done < len )
+	{
+		count = len - done;
+		if (zone == ATCA_ZONE_DATA)
+		{
+			// a range may span several slots
+			if ( (status = _atcab_data_slot(dev_type, address + done, &slot, &offset)) != ATCA_SUCCESS )
+				break;
+			atcab_get_slot_size(dev_type, slot, &size);
+			if (count > size - offset)
+				count = size - offset;
+		}
+
+		if (rdata)
+			status = _atcab_slot_io(device, zone, slot, offset, &rdata[done], NULL, count);
+		else
+			status = _atcab_slot_io(device, zone, slot, offset, NULL, &wdata[done], count);
+		if (status != ATCA_SUCCESS)
+			break;
+
+		done += count;
+	}
+
+	atcab_ctx_session_end(device);
+	return status;
+}
+
+/** \brief write data into given slot of data zone with offset address 
+ *  \param[in] device - device to operate on
+ *  \param[in] slot to write data
+ *  \param[in] offset of pointed slot
+ *  \param[in] data pointer to write data
+ *  \param[in] data length corresponding to data
+ *  \return ATCA_STATUS
+ */
+ATCA_STATUS atcab_ctx_write_bytes_slot(ATCADevice device, uint8_t slot, uint16_t offset, const uint8_t *data, uint8_t len)
+{
+	ATCA_STATUS status;
+	uint16_t size;
+
+	if (data == NULL || slot > 15)
+		return ATCA_BAD_PARAM;
+
+	atcab_get_slot_size(atgetifacecfg(atGetIFace(device))->devtype, slot, &size);
+	if (offset + len > size)
+		return ATCA_BAD_PARAM;
+
+	atcab_ctx_session_begin(device);
+	status = _atcab_slot_io(device, ATCA_ZONE_DATA, slot, offset, NULL, data, len);
+	atcab_ctx_session_end(device);
+
+	return status;
+}
+
+/** \brief atcab_ctx_write_bytes_slot() on the default device */
+ATCA_STATUS atcab_write_bytes_slot(uint8_t slot, uint16_t offset, const uint8_t *data, uint8_t len)
+{
+	return atcab_ctx_write_bytes_slot(_gDevice, slot, offset, data, len);
+}
+
+/** \brief read a whole slot of the data zone, in 32 byte blocks and a word for the rest
+ *  \param[in] device - device to operate on
+ *  \param[in] slot - slot to read
+ *  \param[out] data - receives the slot, atcab_get_slot_size() bytes
+ *  \return ATCA_STATUS
+ */
+ATCA_STATUS atcab_ctx_read_slot(ATCADevice device, uint8_t slot, uint8_t *data)
+{
+	ATCA_STATUS status;
+	uint16_t size;
+
+	if (data == NULL || slot > 15)
+		return ATCA_BAD_PARAM;
 
-	return ret;
+	atcab_get_slot_size(atgetifacecfg(atGetIFace(device))->devtype, slot, &size);
+
+	atcab_ctx_session_begin(device);
+	status = _atcab_slot_io(device, ATCA_ZONE_DATA, slot, 0, data, NULL, size);
+	atcab_ctx_session_end(device);
+
+	return status;
 }
 
-/** \brief write data into given slot of data zone with offset address 
- *  \param[in] slot to write data
- *  \param[in] offset of pointed slot
- *  \param[in] data pointer to write data
- *  \param[in] data length corresponding to data
+/** \brief atcab_ctx_read_slot() on the default device */
+ATCA_STATUS atcab_read_slot(uint8_t slot, uint8_t *data)
+{
+	return atcab_ctx_read_slot(_gDevice, slot, data);
+}
+
+/** \brief write a whole slot of the data zone, in 32 byte blocks and a word for the rest
+ *  \param[in] device - device to operate on
+ *  \param[in] slot - slot to write
+ *  \param[in] data - atcab_get_slot_size() bytes to write
  *  \return ATCA_STATUS
  */
-ATCA_STATUS atcab_write_bytes_slot(uint8_t slot, uint16_t offset, const uint8_t *data, uint8_t len)
+ATCA_STATUS atcab_ctx_write_slot(ATCADevice device, uint8_t slot, const uint8_t *data)
 {
-	ATCA_STATUS status = ATCA_GEN_FAIL;
-
-	uint16_t currAddress = offset;
-	uint8_t currBlock = currAddress / ATCA_BLOCK_SIZE;
-	uint8_t prevBlock = currBlock;
-	uint8_t currOffset = (currAddress - (currBlock * ATCA_BLOCK_SIZE)) / ATCA_WORD_SIZE;
-	uint16_t writeIdx = 0;
+	ATCA_STATUS status;
+	uint16_t size;
 
 	if (data == NULL || slot > 15)
 		return ATCA_BAD_PARAM;
 
-	while ( writeIdx < len) { 
-		
-		status = atcab_write_zone(ATCA_ZONE_DATA, slot, currBlock, currOffset, &data[writeIdx], ATCA_WORD_SIZE);
-		if(status != ATCA_SUCCESS) break;
+	atcab_get_slot_size(atgetifacecfg(atGetIFace(device))->devtype, slot, &size);
 
-		currAddress += ATCA_WORD_SIZE;
-		currBlock = currAddress / ATCA_BLOCK_SIZE;
-		
-		if( prevBlock == currBlock) {
-			currOffset++;
-		} else {
-			currOffset = 0;
-			prevBlock = currBlock;
-		}
-		
-		writeIdx += ATCA_WORD_SIZE;	
-	}
+	atcab_ctx_session_begin(device);
+	status = _atcab_slot_io(device, ATCA_ZONE_DATA, slot, 0, NULL, data, size);
+	atcab_ctx_session_end(device);
 
 	return status;
 }
 
-/** \brief write data into config, otp or data zone with given zone and offset
+/** \brief atcab_ctx_write_slot() on the default device */
+ATCA_STATUS atcab_write_slot(uint8_t slot, const uint8_t *data)
+{
+	return atcab_ctx_write_slot(_gDevice, slot, data);
+}
+
+/** \brief write data into config, otp or data zone with given zone and offset.  Whole blocks the range
+ *  covers are written 32 bytes at a time.
+ *  \param[in] device - device to operate on
  *  \param[in] dev_type to identify device
  *  \param[in] zone to write data
  *  \param[in] offset of pointed zone
@@ -2016,126 +3758,23 @@ ATCA_STATUS atcab_write_bytes_slot(uint8_t slot, uint16_t offset, const uint8_t
  *  \param[in] data length corresponding to data
  *  \return ATCA_STATUS
  */
-ATCA_STATUS atcab_write_bytes_zone(ATCADeviceType dev_type, uint8_t zone, uint16_t address, const uint8_t *data, uint8_t len)
+ATCA_STATUS atcab_ctx_write_bytes_zone(ATCADevice device, ATCADeviceType dev_type, uint8_t zone, uint16_t address, const uint8_t *data, uint8_t len)
 {
-	ATCA_STATUS status = ATCA_GEN_FAIL;
-
-	uint8_t dataSlot = 0;
-	uint16_t currAddress = address, writeIdx = 0;
-	uint8_t currBlock, prevBlock, currOffset;
-	const static uint16_t slot8_addr = 288, slot9_addr = 704;
-
 	if (data == NULL || zone > ATCA_ZONE_DATA)
 		return ATCA_BAD_PARAM;
 
-	if (zone == ATCA_ZONE_CONFIG) {
-		
-		currBlock = currAddress / ATCA_BLOCK_SIZE;
-		prevBlock = currBlock;
-		currOffset = (currAddress - (currBlock * ATCA_BLOCK_SIZE)) / ATCA_WORD_SIZE;
-		
-		while ( writeIdx < len) { 
-
-			if (!(currBlock == 0 && (currOffset == 0 || currOffset == 1 || currOffset == 2 || currOffset == 3))
-				&& !(currBlock == 2 && (currOffset == 5 || currOffset == 6))
-			) {
-				status = atcab_write_zone(zone, 0, currBlock, currOffset, &data[writeIdx], ATCA_WORD_SIZE);
-				if(status != ATCA_SUCCESS) break;
-			}
-
-			currAddress += ATCA_WORD_SIZE;
-			currBlock = currAddress / ATCA_BLOCK_SIZE;
-			
-			if( prevBlock == currBlock) {
-				currOffset++;
-			} else {
-				currOffset = 0;
-				prevBlock = currBlock;
-			}
-			
-			writeIdx += ATCA_WORD_SIZE;		
-		}	
-
-	} else if(zone == ATCA_ZONE_OTP) {
-
-		currBlock = currAddress / ATCA_BLOCK_SIZE;
-		prevBlock = currBlock;
-		currOffset = (currAddress - (currBlock * ATCA_BLOCK_SIZE)) / ATCA_WORD_SIZE;
-		
-		while ( writeIdx < len) { 
-
-			status = atcab_write_zone(zone, 0, currBlock, currOffset, &data[writeIdx], ATCA_WORD_SIZE);
-			if(status != ATCA_SUCCESS) break;
-
-			currAddress += ATCA_WORD_SIZE;
-			currBlock = currAddress / ATCA_BLOCK_SIZE;
-			
-			if( prevBlock == currBlock) {
-				currOffset++;
-			} else {
-				currOffset = 0;
-				prevBlock = currBlock;
-			}
-			
-			writeIdx += ATCA_WORD_SIZE;		
-		}	
-		
-	} else {
-
-		if (dev_type == ATECC508A || dev_type == ATECC108A ) {
-			
-			if (currAddress < slot8_addr) {
-				dataSlot = currAddress / 36;
-				currBlock = (currAddress - (dataSlot * 36)) / ATCA_BLOCK_SIZE;
-				currOffset = (currAddress - (dataSlot * ATCA_BLOCK_SIZE)) / ATCA_WORD_SIZE;
-				currAddress = currAddress - (dataSlot * 36);			
-			} else if (currAddress < slot9_addr) {
-				dataSlot = 8;
-				currBlock = (currAddress - slot8_addr) / ATCA_BLOCK_SIZE;
-				currOffset = (currAddress - (slot8_addr)) / ATCA_WORD_SIZE;
-				currAddress = currAddress - slot8_addr;
-			} else {
-				dataSlot = (currAddress - slot9_addr) / 72;
-				currBlock = (currAddress - slot9_addr) / ATCA_BLOCK_SIZE;
-				currOffset = (currAddress - (slot9_addr)) / ATCA_WORD_SIZE;
-				currAddress = currAddress - slot9_addr;			
-			}
-
-			prevBlock = currBlock;
-			
-		} else {
-
-			dataSlot = currAddress / ATCA_BLOCK_SIZE;
-			currBlock = (currAddress - (dataSlot * ATCA_BLOCK_SIZE)) / ATCA_BLOCK_SIZE;
-			currOffset = (currAddress - (dataSlot * ATCA_BLOCK_SIZE)) / ATCA_WORD_SIZE;
-			currAddress = currAddress - (dataSlot * ATCA_BLOCK_SIZE);		
-			
-		}
-		
-		while ( writeIdx < len) { 
-
-			status = atcab_write_zone(ATCA_ZONE_DATA, dataSlot, currBlock, currOffset, &data[writeIdx], ATCA_WORD_SIZE);
-			if(status != ATCA_SUCCESS) break;
-			
-			currAddress += ATCA_WORD_SIZE;
-			currBlock = currAddress / ATCA_BLOCK_SIZE;
-			
-			if( prevBlock == currBlock) {
-				currOffset++;
-			} else {
-				currOffset = 0;
-				prevBlock = currBlock;
-			}
-			
-			writeIdx += ATCA_WORD_SIZE;			
-		}
-
-	}
+	return _atcab_zone_io(device, dev_type, zone, address, NULL, data, len);
+}
 
-	return status;
+/** \brief atcab_ctx_write_bytes_zone() on the default device */
+ATCA_STATUS atcab_write_bytes_zone(ATCADeviceType dev_type, uint8_t zone, uint16_t address, const uint8_t *data, uint8_t len)
+{
+	return atcab_ctx_write_bytes_zone(_gDevice, dev_type, zone, address, data, len);
 }
 
-/** \brief read data from config, otp or data zone with given zone, offset and len
+/** \brief read data from config, otp or data zone with given zone, offset and len.  Whole blocks the range
+ *  covers are read 32 bytes at a time.
+ *  \param[in] device - device to operate on
  *  \param[in] dev_type to identify device
  *  \param[in] zone to write data
  *  \param[in] offset of pointed zone
@@ -2143,110 +3782,33 @@ ATCA_STATUS atcab_write_bytes_zone(ATCADeviceType dev_type, uint8_t zone, uint16
  *  \param[out] data buffer to be read data 
  *  \return ATCA_STATUS
  */
-ATCA_STATUS atcab_read_bytes_zone(ATCADeviceType dev_type, uint8_t zone, uint16_t address, uint8_t len, uint8_t *data)
+ATCA_STATUS atcab_ctx_read_bytes_zone(ATCADevice device, ATCADeviceType dev_type, uint8_t zone, uint16_t address, uint8_t len, uint8_t *data)
 {
-	ATCA_STATUS status = ATCA_GEN_FAIL;
-
-	uint8_t dataSlot = 0;
-	uint16_t currAddress = address, readIdx = 0;
-	uint8_t currBlock, prevBlock, currOffset;
-	const static uint16_t slot8_addr = 288, slot9_addr = 704;
-
 	if (data == NULL || zone > ATCA_ZONE_DATA)
 		return ATCA_BAD_PARAM;
 
-	if (zone == ATCA_ZONE_CONFIG || zone == ATCA_ZONE_OTP) {
-		
-		currBlock = currAddress / ATCA_BLOCK_SIZE;
-		prevBlock = currBlock;
-		currOffset = (currAddress - (currBlock * ATCA_BLOCK_SIZE)) / ATCA_WORD_SIZE;
-		
-		while ( readIdx < len) { 
-
-			status = atcab_read_zone(zone, 0, currBlock, currOffset, &data[readIdx], ATCA_WORD_SIZE);
-			if(status != ATCA_SUCCESS) break;
-
-			currAddress += ATCA_WORD_SIZE;
-			currBlock = currAddress / ATCA_BLOCK_SIZE;
-			
-			if( prevBlock == currBlock) {
-				currOffset++;
-			} else {
-				currOffset = 0;
-				prevBlock = currBlock;
-			}
-			
-			readIdx += ATCA_WORD_SIZE;		
-		}	
-
-	} else {
-
-		if (dev_type == ATECC508A || dev_type == ATECC108A ) {
-	
-			if (currAddress < slot8_addr) {
-				dataSlot = currAddress / 36;
-				currBlock = (currAddress - (dataSlot * 36)) / ATCA_BLOCK_SIZE;
-				currOffset = (currAddress - (dataSlot * ATCA_BLOCK_SIZE)) / ATCA_WORD_SIZE;
-				currAddress = currAddress - (dataSlot * 36);			
-			} else if (currAddress < slot9_addr) {
-				dataSlot = 8;
-				currBlock = (currAddress - slot8_addr) / ATCA_BLOCK_SIZE;
-				currOffset = (currAddress - (slot8_addr)) / ATCA_WORD_SIZE;
-				currAddress = currAddress - slot8_addr;
-			} else {
-				dataSlot = (currAddress - slot9_addr) / 72;
-				currBlock = (currAddress - slot9_addr) / ATCA_BLOCK_SIZE;
-				currOffset = (currAddress - (slot9_addr)) / ATCA_WORD_SIZE;
-				currAddress = currAddress - slot9_addr;			
-			}
-
-			prevBlock = currBlock;
-		
-		} else {
-
-			dataSlot = currAddress / ATCA_BLOCK_SIZE;
-			currBlock = (currAddress - (dataSlot * ATCA_BLOCK_SIZE)) / ATCA_BLOCK_SIZE;
-			currOffset = (currAddress - (dataSlot * ATCA_BLOCK_SIZE)) / ATCA_WORD_SIZE;
-			currAddress = currAddress - (dataSlot * ATCA_BLOCK_SIZE);
-			
-		}
-		
-		while ( readIdx < len) { 
-
-			status = atcab_read_zone(ATCA_ZONE_DATA, dataSlot, currBlock, currOffset, &data[readIdx], ATCA_WORD_SIZE);
-			if(status != ATCA_SUCCESS) break;
-			
-			currAddress += ATCA_WORD_SIZE;
-			currBlock = currAddress / ATCA_BLOCK_SIZE;
-			
-			if( prevBlock == currBlock) {
-				currOffset++;
-			} else {
-				currOffset = 0;
-				prevBlock = currBlock;
-			}
-			
-			readIdx += ATCA_WORD_SIZE;			
-		}
-
-	}
+	return _atcab_zone_io(device, dev_type, zone, address, data, NULL, len);
+}
 
-	return status;
+/** \brief atcab_ctx_read_bytes_zone() on the default device */
+ATCA_STATUS atcab_read_bytes_zone(ATCADeviceType dev_type, uint8_t zone, uint16_t address, uint8_t len, uint8_t *data)
+{
+	return atcab_ctx_read_bytes_zone(_gDevice, dev_type, zone, address, len, data);
 }
 
 
 /** \brief Get a 32 byte MAC from the CryptoAuth device given a key ID and a challenge
+ *	\param[in] device - device to operate on
  *	\param[in] mode Controls which fields within the device are used in the message
  *	\param[in] key_id The key in the CryptoAuth device to use for the MAC
  *	\param[in] challenge The 32 byte challenge number
  *	\param[out] mac_response The response of the MAC command using the given challenge
  *  \return ATCA_STATUS	
 */
-ATCA_STATUS atcab_mac( uint8_t mode, uint16_t key_id, const uint8_t* challenge, uint8_t* digest )
+ATCA_STATUS atcab_ctx_mac(ATCADevice device, uint8_t mode, uint16_t key_id, const uint8_t* challenge, uint8_t* digest)
 {
 	ATCA_STATUS status = ATCA_GEN_FAIL;
-	ATCAPacket packet;
-	uint16_t execution_time = 0;
+	ATCAPacket *packet = NULL;
 
 	do {
 
@@ -2256,42 +3818,41 @@ ATCA_STATUS atcab_mac( uint8_t mode, uint16_t key_id, const uint8_t* challenge,
 			break;
 		}
 		
+		if ( (packet = _atcab_packet_get(device)) == NULL )
+			return ATCA_GEN_FAIL;
+
 		// build mac command
-		packet.param1 = mode;
-		packet.param2 = key_id;
-		memcpy( &packet.data[0], challenge, 32 );  // a 32-byte challenge
+		packet->param1 = mode;
+		packet->param2 = key_id;
+		memcpy( &packet->data[0], challenge, 32 );  // a 32-byte challenge
 		
-		if ( (status = atMAC( _gCommandObj, &packet )) != ATCA_SUCCESS )
-			break;
-
-		execution_time = atGetExecTime( _gCommandObj, CMD_MAC);
-
-		if ( (status != atcab_wakeup()) != ATCA_SUCCESS ) break;
-			
-		// send the command
-		if ( (status = atsend( _gIface, (uint8_t *)&packet, packet.txsize )) != ATCA_SUCCESS )
+		if ( (status = atMAC( atGetCommands(device), packet )) != ATCA_SUCCESS )
 			break;
-	
-		// delay the appropriate amount of time for command to execute
-		atca_delay_ms(execution_time);
 
-		// receive the response
-		if ( (status = atreceive( _gIface, packet.data, &(packet.rxsize))) != ATCA_SUCCESS )
+		if ( (status = _atcab_execute( device, packet, CMD_MAC )) != ATCA_SUCCESS )
 			break;
 	
 		// check for response
-		if ( (status = isATCAError(packet.data)) != ATCA_SUCCESS )
+		if ( (status = isATCAError(packet->data)) != ATCA_SUCCESS )
 			break;
 
-		memcpy( digest, &packet.data[ATCA_RSP_DATA_IDX], MAC_SIZE );
+		memcpy( digest, &packet->data[ATCA_RSP_DATA_IDX], MAC_SIZE );
 	
 	} while(0);
 
-	_atcab_exit();
+	_atcab_exit(device);
+	_atcab_packet_put(device, packet);
 	return status;
 }
 
+/** \brief atcab_ctx_mac() on the default device */
+ATCA_STATUS atcab_mac(uint8_t mode, uint16_t key_id, const uint8_t* challenge, uint8_t* digest)
+{
+	return atcab_ctx_mac(_gDevice, mode, key_id, challenge, digest);
+}
+
 /** \brief Compares a MAC response with input values 
+ *	\param[in] device - device to operate on
  *	\param[in] mode Controls which fields within the device are used in the message
  *	\param[in] key_id The key in the CryptoAuth device to use for the MAC
  *	\param[in] challenge The 32 byte challenge number
@@ -2299,11 +3860,10 @@ ATCA_STATUS atcab_mac( uint8_t mode, uint16_t key_id, const uint8_t* challenge,
  *	\param[in] other_data The 13 byte other data number 
  *  \return ATCA_STATUS	
 */
-ATCA_STATUS atcab_checkmac( uint8_t mode, uint16_t key_id, const uint8_t *challenge, const uint8_t *response, const uint8_t *other_data)
+ATCA_STATUS atcab_ctx_checkmac(ATCADevice device, uint8_t mode, uint16_t key_id, const uint8_t *challenge, const uint8_t *response, const uint8_t *other_data)
 {
 	ATCA_STATUS status = ATCA_GEN_FAIL;
-	ATCAPacket packet;
-	uint16_t execution_time = 0;
+	ATCAPacket *packet = NULL;
 
 	do {
 
@@ -2313,214 +3873,288 @@ ATCA_STATUS atcab_checkmac( uint8_t mode, uint16_t key_id, const uint8_t *challe
 			break;
 		}
 		
+		if ( (packet = _atcab_packet_get(device)) == NULL )
+			return ATCA_GEN_FAIL;
+
 		// build checkmac command
-		packet.param1 = mode;
-		packet.param2 = key_id;
-		memcpy( &packet.data[0], challenge, CHECKMAC_CLIENT_CHALLENGE_SIZE );
-		memcpy( &packet.data[32], response, CHECKMAC_CLIENT_RESPONSE_SIZE );
-		memcpy( &packet.data[64], other_data, CHECKMAC_OTHER_DATA_SIZE );
+		packet->param1 = mode;
+		packet->param2 = key_id;
+		memcpy( &packet->data[0], challenge, CHECKMAC_CLIENT_CHALLENGE_SIZE );
+		memcpy( &packet->data[32], response, CHECKMAC_CLIENT_RESPONSE_SIZE );
+		memcpy( &packet->data[64], other_data, CHECKMAC_OTHER_DATA_SIZE );
 	
-		if ( (status = atCheckMAC( _gCommandObj, &packet )) != ATCA_SUCCESS )
+		if ( (status = atCheckMAC( atGetCommands(device), packet )) != ATCA_SUCCESS )
 			break;
 
-		execution_time = atGetExecTime( _gCommandObj, CMD_CHECKMAC);
-
-		if ( (status != atcab_wakeup()) != ATCA_SUCCESS ) break;
-			
-		// send the command
-		if ( (status = atsend( _gIface, (uint8_t *)&packet, packet.txsize )) != ATCA_SUCCESS )
-			break;
-	
-		// delay the appropriate amount of time for command to execute
-		atca_delay_ms( execution_time );
-
-		// receive the response
-		if ( (status = atreceive( _gIface, packet.data, &(packet.rxsize))) != ATCA_SUCCESS )
+		if ( (status = _atcab_execute( device, packet, CMD_CHECKMAC )) != ATCA_SUCCESS )
 			break;
 	
 		// check for response
-		if ( (status = isATCAError(packet.data)) != ATCA_SUCCESS )
+		if ( (status = isATCAError(packet->data)) != ATCA_SUCCESS )
 			break;
 	
 	} while(0);
 
-	_atcab_exit();
+	_atcab_exit(device);
+	_atcab_packet_put(device, packet);
 	return status;
 }
 
-/** \brief Initialize SHA-256 calculation engine
- *  \return ATCA_STATUS	
+/** \brief atcab_ctx_checkmac() on the default device */
+ATCA_STATUS atcab_checkmac(uint8_t mode, uint16_t key_id, const uint8_t *challenge, const uint8_t *response, const uint8_t *other_data)
+{
+	return atcab_ctx_checkmac(_gDevice, mode, key_id, challenge, response, other_data);
+}
+
+/** \brief run one SHA command
+ *  \param[in] device - device to operate on
+ *  \param[in] mode - SHA_SHA256_START_MASK, SHA_SHA256_UPDATE_MASK or SHA_SHA256_END_MASK
+ *  \param[in] length - number of message bytes, 64 for an update and less than 64 for the end
+ *  \param[in] message - message bytes, may be NULL when length is 0
+ *  \param[out] digest - receives the digest of the end command, NULL for the other commands
+ *  \return ATCA_STATUS
  */
-ATCA_STATUS atcab_sha_start(void)
+static ATCA_STATUS _atcab_sha_cmd(ATCADevice device, uint8_t mode, uint16_t length, const uint8_t *message, uint8_t *digest)
 {
 	ATCA_STATUS status = ATCA_GEN_FAIL;
-	ATCAPacket packet;
-	uint16_t execution_time = 0;
+	ATCAPacket *packet = NULL;
+
+	if ( (packet = _atcab_packet_get(device)) == NULL )
+		return ATCA_GEN_FAIL;
 
 	do {
+		// build sha command
+		packet->param1 = mode;
+		packet->param2 = length;
+		if ( length > 0 )
+			memcpy( &packet->data[0], message, length );
 
-		// build checkmac command
-		packet.param1 = SHA_SHA256_START_MASK;
-		packet.param2 = 0;
-		
-		if ( (status = atSHA( _gCommandObj, &packet )) != ATCA_SUCCESS ) 
+		if ( (status = atSHA( atGetCommands(device), packet )) != ATCA_SUCCESS )
 			break;
 
-		execution_time = atGetExecTime( _gCommandObj, CMD_SHA);
-
-		if ( (status != atcab_wakeup()) != ATCA_SUCCESS )
-			break;
-			
-		// send the command
-		if ( (status = atsend( _gIface, (uint8_t *)&packet, packet.txsize )) != ATCA_SUCCESS )
+		if ( (status = _atcab_execute( device, packet, CMD_SHA )) != ATCA_SUCCESS )
 			break;
-	
-		// delay the appropriate amount of time for command to execute
-		atca_delay_ms( execution_time );
 
-		// receive the response
-		if ( (status = atreceive( _gIface, packet.data, &(packet.rxsize))) != ATCA_SUCCESS )
-			break;
-	
 		// check for response
-		if ( (status = isATCAError(packet.data)) != ATCA_SUCCESS )
+		if ( (status = isATCAError(packet->data)) != ATCA_SUCCESS )
 			break;
-	
+
+		if ( digest )
+			memcpy( digest, &packet->data[ATCA_RSP_DATA_IDX], SHA_DIGEST_SIZE );
+
 	} while(0);
 
-	_atcab_exit();
+	_atcab_exit(device);
+	_atcab_packet_put(device, packet);
 	return status;
 }
 
+/** \brief Initialize SHA-256 calculation engine
+ *  \param[in] device - device to operate on
+ *  \return ATCA_STATUS	
+ */
+ATCA_STATUS atcab_ctx_sha_start(ATCADevice device)
+{
+	return _atcab_sha_cmd(device, SHA_SHA256_START_MASK, 0, NULL, NULL);
+}
+
+/** \brief atcab_ctx_sha_start() on the default device */
+ATCA_STATUS atcab_sha_start(void)
+{
+	return atcab_ctx_sha_start(_gDevice);
+}
+
 /** \brief Adds the message to be digested
+ *	\param[in] device - device to operate on
  *	\param[in] length The number of bytes in the Message parameter
  *	\param[in] message up to 64 bytes of data to be included into the hash operation.
  *  \return ATCA_STATUS	
  */
+ATCA_STATUS atcab_ctx_sha_update(ATCADevice device, uint16_t length, const uint8_t *message)
+{
+	// Verify the inputs
+	if ( message == NULL || length > SHA_DATA_MAX )
+		return ATCA_BAD_PARAM;
+
+	return _atcab_sha_cmd(device, SHA_SHA256_UPDATE_MASK, length, message, NULL);
+}
+
+/** \brief atcab_ctx_sha_update() on the default device */
 ATCA_STATUS atcab_sha_update(uint16_t length, const uint8_t *message)
 {
-	ATCA_STATUS status = ATCA_GEN_FAIL;
-	ATCAPacket packet;
-	uint16_t execution_time = 0;
+	return atcab_ctx_sha_update(_gDevice, length, message);
+}
 
-	do {
+/** \brief The SHA-256 calculation is complete
+ *	\param[in] device - device to operate on
+ *	\param[out] digest The SHA256 digest that is calculated
+ *  \return ATCA_STATUS	
+ */
+ATCA_STATUS atcab_ctx_sha_end(ATCADevice device, uint8_t *digest)
+{
+	// Verify the inputs
+	if ( digest == NULL )
+		return ATCA_BAD_PARAM;
 
-		// Verify the inputs
-		if ( message == NULL || length > SHA_DATA_MAX ) {
-			status = ATCA_BAD_PARAM;
-			break;
-		}
+	return _atcab_sha_cmd(device, SHA_SHA256_END_MASK, 0, NULL, digest);
+}
 
-		// build checkmac command
-		packet.param1 = SHA_SHA256_UPDATE_MASK;
-		packet.param2 = length;
-		memcpy (&packet.data[0], message, length);
-		
-		if ( (status = atSHA( _gCommandObj, &packet )) != ATCA_SUCCESS )
-			break;
+/** \brief atcab_ctx_sha_end() on the default device */
+ATCA_STATUS atcab_sha_end(uint8_t *digest)
+{
+	return atcab_ctx_sha_end(_gDevice, digest);
+}
+
+/** \brief start hashing a message of any length with the device.  The device is kept awake from here
+ *  to atcab_ctx_sha_stream_end(), the message is sent as 64 byte update commands back to back and the
+ *  end command carries the last partial block, which the device pads.
+ *  \param[in] device - device to operate on
+ *  \param[out] ctx - stream state, kept by the caller until the stream ends
+ *  \return ATCA_STATUS
+ */
+ATCA_STATUS atcab_ctx_sha_stream_start(ATCADevice device, atcab_sha_stream_t *ctx)
+{
+	ATCA_STATUS status;
 
-		execution_time = atGetExecTime( _gCommandObj, CMD_SHA);
+	if ( device == NULL || ctx == NULL )
+		return ATCA_BAD_PARAM;
 
-		if ( (status != atcab_wakeup()) != ATCA_SUCCESS ) break;
-			
-		// send the command
-		if ( (status = atsend( _gIface, (uint8_t *)&packet, packet.txsize )) != ATCA_SUCCESS )
-			break;
-	
-		// delay the appropriate amount of time for command to execute
-		atca_delay_ms( execution_time );
+	memset( ctx, 0, sizeof(*ctx) );
+	ctx->device = device;
+	ctx->start_ms = atca_ticks_ms();
 
-		// receive the response
-		if ( (status = atreceive( _gIface, packet.data, &(packet.rxsize))) != ATCA_SUCCESS )
-			break;
-	
-		// check for response
-		if ( (status = isATCAError(packet.data)) != ATCA_SUCCESS )
-			break;
+	atcab_ctx_session_begin(device);
+	if ( (status = _atcab_sha_cmd(device, SHA_SHA256_START_MASK, 0, NULL, NULL)) != ATCA_SUCCESS )
+		atcab_ctx_session_end(device);
+	return status;
+}
 
-	} while(0);
+/** \brief add message bytes to a stream, sending every full 64 byte block
+ *  \param[inout] ctx - stream state
+ *  \param[in] message - message bytes
+ *  \param[in] length - number of bytes, any length
+ *  \return ATCA_STATUS, on failure the stream is dead and has to be ended
+ */
+ATCA_STATUS atcab_ctx_sha_stream_update(atcab_sha_stream_t *ctx, const uint8_t *message, size_t length)
+{
+	ATCA_STATUS status = ATCA_SUCCESS;
+	size_t count;
+
+	if ( ctx == NULL || (message == NULL && length > 0) )
+		return ATCA_BAD_PARAM;
+
+	ctx->length += length;
+
+	// top up a partial block first
+	if ( ctx->block_len > 0 )
+	{
+		count = SHA_DATA_MAX - ctx->block_len;
+		if ( count > length )
+			count = length;
+		memcpy( &ctx->block[ctx->block_len], message, count );
+		ctx->block_len += count;
+		message += count;
+		length -= count;
+
+		if ( ctx->block_len < SHA_DATA_MAX )
+			return ATCA_SUCCESS;
+		if ( (status = _atcab_sha_cmd(ctx->device, SHA_SHA256_UPDATE_MASK, SHA_DATA_MAX, ctx->block, NULL)) != ATCA_SUCCESS )
+			return status;
+		ctx->block_len = 0;
+	}
+
+	// then full blocks straight from the message
+	for ( ; length >= SHA_DATA_MAX; message += SHA_DATA_MAX, length -= SHA_DATA_MAX )
+	{
+		if ( (status = _atcab_sha_cmd(ctx->device, SHA_SHA256_UPDATE_MASK, SHA_DATA_MAX, message, NULL)) != ATCA_SUCCESS )
+			return status;
+	}
 
-	_atcab_exit();
+	memcpy( ctx->block, message, length );
+	ctx->block_len = (uint8_t)length;
 	return status;
 }
 
-/** \brief The SHA-256 calculation is complete
- *	\param[out] digest The SHA256 digest that is calculated
- *  \return ATCA_STATUS	
+/** \brief end a stream, sending the last partial block, and let the device idle again
+ *  \param[inout] ctx - stream state, its bytes_per_sec is set to the throughput of the stream
+ *  \param[out] digest - receives the 32 byte SHA-256 digest, NULL to abandon the stream
+ *  \return ATCA_STATUS
  */
-ATCA_STATUS atcab_sha_end(uint8_t *digest)
+ATCA_STATUS atcab_ctx_sha_stream_end(atcab_sha_stream_t *ctx, uint8_t *digest)
 {
-	ATCA_STATUS status = ATCA_GEN_FAIL;
-	ATCAPacket packet;
-	uint16_t execution_time = 0;
+	ATCA_STATUS status = ATCA_SUCCESS;
+	uint32_t elapsed_ms;
 
-	do {
+	if ( ctx == NULL || ctx->device == NULL )
+		return ATCA_BAD_PARAM;
 
-		// Verify the inputs
-		if ( digest == NULL ) {
-			status = ATCA_BAD_PARAM;
-			break;
-		}
+	if ( digest )
+		status = _atcab_sha_cmd(ctx->device, SHA_SHA256_END_MASK, ctx->block_len, ctx->block, digest);
 
-		// build checkmac command
-		packet.param1 = SHA_SHA256_END_MASK;
-		packet.param2 = 0;
+	atcab_ctx_session_end(ctx->device);
 
-		if ( (status = atSHA( _gCommandObj, &packet )) != ATCA_SUCCESS )
-			break;
+	elapsed_ms = atca_ticks_ms() - ctx->start_ms;
+	ctx->bytes_per_sec = (uint32_t)((uint64_t)ctx->length * 1000 / (elapsed_ms ? elapsed_ms : 1));
+	ctx->device = NULL;
+	return status;
+}
 
-		execution_time = atGetExecTime( _gCommandObj, CMD_SHA);
+/** \brief Computes a SHA-256 digest of a message of any length, in one wake session
+ *	\param[in] device - device to operate on
+ *	\param[in] message - message to hash
+ *	\param[in] length - number of bytes in the message
+ *	\param[out] digest - the SHA256 digest
+ *	\param[out] bytes_per_sec - receives the throughput achieved, NULL if not wanted
+ *  \return ATCA_STATUS
+ */
+ATCA_STATUS atcab_ctx_sha_stream(ATCADevice device, const uint8_t *message, size_t length, uint8_t *digest, uint32_t *bytes_per_sec)
+{
+	ATCA_STATUS status;
+	atcab_sha_stream_t ctx;
 
-		if ( (status != atcab_wakeup()) != ATCA_SUCCESS ) break;
-			
-		// send the command
-		if ( (status = atsend( _gIface, (uint8_t *)&packet, packet.txsize )) != ATCA_SUCCESS )
-			break;
-	
-		// delay the appropriate amount of time for command to execute
-		atca_delay_ms( execution_time );
+	if ( digest == NULL )
+		return ATCA_BAD_PARAM;
 
-		// receive the response
-		if ( (status = atreceive( _gIface, packet.data, &(packet.rxsize))) != ATCA_SUCCESS )
-			break;
-	
-		// check for response
-		if ( (status = isATCAError(packet.data)) != ATCA_SUCCESS )
-			break;
+	if ( (status = atcab_ctx_sha_stream_start(device, &ctx)) != ATCA_SUCCESS )
+		return status;
 
-		memcpy( digest, &packet.data[ATCA_RSP_DATA_IDX], SHA_DIGEST_SIZE );
-	
-	} while(0);
+	status = atcab_ctx_sha_stream_update(&ctx, message, length);
+	if ( status == ATCA_SUCCESS )
+		status = atcab_ctx_sha_stream_end(&ctx, digest);
+	else
+		atcab_ctx_sha_stream_end(&ctx, NULL);
 
-	_atcab_exit();
+	if ( bytes_per_sec )
+		*bytes_per_sec = ctx.bytes_per_sec;
 	return status;
 }
 
+/** \brief atcab_ctx_sha_stream_start() on the default device */
+ATCA_STATUS atcab_sha_stream_start(atcab_sha_stream_t *ctx)
+{
+	return atcab_ctx_sha_stream_start(_gDevice, ctx);
+}
+
+/** \brief atcab_ctx_sha_stream() on the default device */
+ATCA_STATUS atcab_sha_stream(const uint8_t *message, size_t length, uint8_t *digest, uint32_t *bytes_per_sec)
+{
+	return atcab_ctx_sha_stream(_gDevice, message, length, digest, bytes_per_sec);
+}
+
 /** \brief Computes a SHA-256 digest
+ *	\param[in] device - device to operate on
  *	\param[in] length The number of bytes in the message parameter
- *	\param[in] message up to 64 bytes of data to be included into the hash operation.
+ *	\param[in] message data to be hashed, any length
  *	\param[out] digest The SHA256 digest
  *  \return ATCA_STATUS	
  */
-ATCA_STATUS atcab_sha(uint16_t length, const uint8_t *message, uint8_t *digest)
+ATCA_STATUS atcab_ctx_sha(ATCADevice device, uint16_t length, const uint8_t *message, uint8_t *digest)
 {
-	ATCA_STATUS status = ATCA_GEN_FAIL;
-
-	do {
-
-		status = atcab_sha_start();
-		if ( status != ATCA_SUCCESS ) 
-			break;
-
-		status = atcab_sha_update(length, message);
-		if ( status != ATCA_SUCCESS )
-			break;
-
-		status = atcab_sha_end(digest);
-		if ( status != ATCA_SUCCESS )
-				break;
-	
-	} while(0);
+	return atcab_ctx_sha_stream(device, message, length, digest, NULL);
+}
 
-	return status;
+/** \brief atcab_ctx_sha() on the default device */
+ATCA_STATUS atcab_sha(uint16_t length, const uint8_t *message, uint8_t *digest)
+{
+	return atcab_ctx_sha(_gDevice, length, message, digest);
 }
@@ -67,6 +67,21 @@ ATCADevice atcab_getDevice(void);
 ATCA_STATUS atcab_wakeup(void);
 ATCA_STATUS atcab_idle(void);
 ATCA_STATUS atcab_sleep(void);
+ATCA_STATUS atcab_session_begin(void);
+ATCA_STATUS atcab_session_end(void);
+
+/** \brief completion callback of an operation started with one of the atcab_*_start() calls */
+typedef void (*atcab_callback)(ATCA_STATUS status, void *context);
+
+// basic background API, one operation at a time per device, driven by atcab_poll()
+ATCA_STATUS atcab_poll(void);
+bool atcab_busy(void);
+ATCA_STATUS atcab_random_start(uint8_t *rand_out, atcab_callback callback, void *context);
+ATCA_STATUS atcab_genkey_start(int slot, uint8_t *pubkey, atcab_callback callback, void *context);
+ATCA_STATUS atcab_get_pubkey_start(uint8_t slot, uint8_t *pubkey, atcab_callback callback, void *context);
+ATCA_STATUS atcab_sign_start(uint16_t slot, const uint8_t *msg, uint8_t *signature, atcab_callback callback, void *context);
+ATCA_STATUS atcab_verify_extern_start(const uint8_t *message, const uint8_t *signature, const uint8_t *pubkey, bool *verified, atcab_callback callback, void *context);
+ATCA_STATUS atcab_ecdh_start(uint16_t key_id, const uint8_t* pubkey, uint8_t* ret_ecdh, atcab_callback callback, void *context);
 
 // basic crypto API
 ATCA_STATUS atcab_info(uint8_t *revision);
@@ -75,6 +90,9 @@ ATCA_STATUS atcab_challenge_seed_update(const uint8_t *seed, uint8_t* rand_out);
 ATCA_STATUS atcab_nonce(const uint8_t *tempkey);
 ATCA_STATUS atcab_nonce_rand(const uint8_t *seed, uint8_t* rand_out);
 ATCA_STATUS atcab_random(uint8_t *rand_out);
+ATCA_STATUS atcab_random_bytes(uint8_t *out, size_t len);
+ATCA_STATUS atcab_random_idle(void);
+ATCA_STATUS atcab_random_drbg(bool enable);
 
 ATCA_STATUS atcab_is_locked(uint8_t zone, bool *lock_state);
 ATCA_STATUS atcab_is_slot_locked(uint8_t slot, bool *lock_state);
@@ -85,9 +103,14 @@ ATCA_STATUS atcab_write_zone(uint8_t zone, uint8_t slot, uint8_t block, uint8_t
 ATCA_STATUS atcab_write_bytes_slot(uint8_t slot, uint16_t offset, const uint8_t *data, uint8_t len);
 ATCA_STATUS atcab_write_bytes_zone(ATCADeviceType dev_type, uint8_t zone, uint16_t address, const uint8_t *data, uint8_t len);
 ATCA_STATUS atcab_read_bytes_zone(ATCADeviceType dev_type, uint8_t zone, uint16_t address, uint8_t len, uint8_t *data);
+ATCA_STATUS atcab_get_slot_size(ATCADeviceType dev_type, uint8_t slot, uint16_t *size);
+ATCA_STATUS atcab_read_slot(uint8_t slot, uint8_t *data);
+ATCA_STATUS atcab_write_slot(uint8_t slot, const uint8_t *data);
+void atcab_shadow_invalidate(void);
 
 ATCA_STATUS atcab_read_serial_number(uint8_t* serial_number);
 ATCA_STATUS atcab_read_pubkey(uint8_t slot8toF, uint8_t *pubkey);
+ATCA_STATUS atcab_pubkey_cache_fill(void);
 ATCA_STATUS atcab_read_sig(uint8_t slot8toF, uint8_t *sig);
 ATCA_STATUS atcab_read_ecc_config_zone(uint8_t* config_data);
 ATCA_STATUS atcab_write_ecc_config_zone(const uint8_t* config_data);
@@ -108,6 +131,7 @@ ATCA_STATUS atcab_priv_write(uint8_t slot, const uint8_t priv_key[36], uint8_t w
 ATCA_STATUS atcab_genkey( int slot, uint8_t *pubkey );
 ATCA_STATUS atcab_get_pubkey(uint8_t slot, uint8_t *pubkey);
 ATCA_STATUS atcab_sign(uint16_t slot, const uint8_t *msg, uint8_t *signature);
+ATCA_STATUS atcab_sign_batch(uint16_t slot, const uint8_t * const digests[], uint16_t count, uint8_t *signatures[]);
 ATCA_STATUS atcab_verify_extern(const uint8_t *message, const uint8_t *signature, const uint8_t *pubkey, bool *verified);
 ATCA_STATUS atcab_ecdh(uint16_t key_id, const uint8_t* pub_key, uint8_t* ret_ecdh);
 ATCA_STATUS atcab_ecdh_enc(uint16_t key_id, const uint8_t* pub_key, uint8_t* ret_ecdh, const uint8_t* enckey, const uint8_t enckeyid);
@@ -121,6 +145,115 @@ ATCA_STATUS atcab_sha_update(uint16_t length, const uint8_t *message);
 ATCA_STATUS atcab_sha_end(uint8_t *digest);
 ATCA_STATUS atcab_sha(uint16_t length, const uint8_t *message, uint8_t *digest);
 
+/** \brief state of a message of any length hashed by the device, see atcab_ctx_sha_stream_start() */
+typedef struct {
+	ATCADevice device;					// device hashing the stream, NULL once ended
+	uint8_t    block[SHA_DATA_MAX];		// message bytes not sent yet, less than a block
+	uint8_t    block_len;
+	uint32_t   length;					// message bytes taken so far
+	uint32_t   start_ms;				// atca_ticks_ms() when the stream started
+	uint32_t   bytes_per_sec;			// throughput of the whole stream, set when it ends
+} atcab_sha_stream_t;
+
+ATCA_STATUS atcab_sha_stream_start(atcab_sha_stream_t *ctx);
+ATCA_STATUS atcab_sha_stream(const uint8_t *message, size_t length, uint8_t *digest, uint32_t *bytes_per_sec);
+
+// result views, the same commands handing out a pointer to the result in the device's response packet
+// instead of copying it.  A view stays valid until the next command on the same device.
+ATCA_STATUS atcab_random_view(const uint8_t **rand_out);
+ATCA_STATUS atcab_genkey_view(int slot, const uint8_t **pubkey);
+ATCA_STATUS atcab_get_pubkey_view(uint8_t slot, const uint8_t **pubkey);
+ATCA_STATUS atcab_sign_view(uint16_t slot, const uint8_t *msg, const uint8_t **signature);
+ATCA_STATUS atcab_ecdh_view(uint16_t key_id, const uint8_t* pub_key, const uint8_t** ret_ecdh);
+
+// context API, the same methods on an explicit device handle so several devices can be used side by side.
+// The atcab_ methods above operate on the default device set up by atcab_init() or atcab_init_device().
+ATCA_STATUS atcab_ctx_wakeup(ATCADevice device);
+ATCA_STATUS atcab_ctx_idle(ATCADevice device);
+ATCA_STATUS atcab_ctx_sleep(ATCADevice device);
+ATCA_STATUS atcab_ctx_session_begin(ATCADevice device);
+ATCA_STATUS atcab_ctx_session_end(ATCADevice device);
+
+ATCA_STATUS atcab_ctx_poll(ATCADevice device);
+bool atcab_ctx_busy(ATCADevice device);
+bool atcab_ctx_due(ATCADevice device, uint32_t *due_ticks);
+ATCA_STATUS atcab_ctx_random_start(ATCADevice device, uint8_t *rand_out, atcab_callback callback, void *context);
+ATCA_STATUS atcab_ctx_genkey_start(ATCADevice device, int slot, uint8_t *pubkey, atcab_callback callback, void *context);
+ATCA_STATUS atcab_ctx_get_pubkey_start(ATCADevice device, uint8_t slot, uint8_t *pubkey, atcab_callback callback, void *context);
+ATCA_STATUS atcab_ctx_sign_start(ATCADevice device, uint16_t slot, const uint8_t *msg, uint8_t *signature, atcab_callback callback, void *context);
+ATCA_STATUS atcab_ctx_verify_extern_start(ATCADevice device, const uint8_t *message, const uint8_t *signature, const uint8_t *pubkey, bool *verified, atcab_callback callback, void *context);
+ATCA_STATUS atcab_ctx_ecdh_start(ATCADevice device, uint16_t key_id, const uint8_t* pubkey, uint8_t* ret_ecdh, atcab_callback callback, void *context);
+
+ATCA_STATUS atcab_ctx_info(ATCADevice device, uint8_t *revision);
+ATCA_STATUS atcab_ctx_challenge(ATCADevice device, const uint8_t *challenge);
+ATCA_STATUS atcab_ctx_challenge_seed_update(ATCADevice device, const uint8_t *seed, uint8_t* rand_out);
+ATCA_STATUS atcab_ctx_nonce(ATCADevice device, const uint8_t *tempkey);
+ATCA_STATUS atcab_ctx_nonce_rand(ATCADevice device, const uint8_t *seed, uint8_t* rand_out);
+ATCA_STATUS atcab_ctx_random(ATCADevice device, uint8_t *rand_out);
+ATCA_STATUS atcab_ctx_random_bytes(ATCADevice device, uint8_t *out, size_t len);
+ATCA_STATUS atcab_ctx_random_idle(ATCADevice device);
+ATCA_STATUS atcab_ctx_random_drbg(ATCADevice device, bool enable);
+
+ATCA_STATUS atcab_ctx_is_locked(ATCADevice device, uint8_t zone, bool *lock_state);
+ATCA_STATUS atcab_ctx_is_slot_locked(ATCADevice device, uint8_t slot, bool *lock_state);
+
+ATCA_STATUS atcab_ctx_get_addr(ATCADevice device, uint8_t zone, uint8_t slot, uint8_t block, uint8_t offset, uint16_t* addr);
+ATCA_STATUS atcab_ctx_read_zone(ATCADevice device, uint8_t zone, uint8_t slot, uint8_t block, uint8_t offset, uint8_t *data, uint8_t len);
+ATCA_STATUS atcab_ctx_write_zone(ATCADevice device, uint8_t zone, uint8_t slot, uint8_t block, uint8_t offset, const uint8_t *data, uint8_t len);
+ATCA_STATUS atcab_ctx_write_bytes_slot(ATCADevice device, uint8_t slot, uint16_t offset, const uint8_t *data, uint8_t len);
+ATCA_STATUS atcab_ctx_write_bytes_zone(ATCADevice device, ATCADeviceType dev_type, uint8_t zone, uint16_t address, const uint8_t *data, uint8_t len);
+ATCA_STATUS atcab_ctx_read_bytes_zone(ATCADevice device, ATCADeviceType dev_type, uint8_t zone, uint16_t address, uint8_t len, uint8_t *data);
+ATCA_STATUS atcab_ctx_read_slot(ATCADevice device, uint8_t slot, uint8_t *data);
+ATCA_STATUS atcab_ctx_write_slot(ATCADevice device, uint8_t slot, const uint8_t *data);
+void atcab_ctx_shadow_invalidate(ATCADevice device);
+
+ATCA_STATUS atcab_ctx_read_serial_number(ATCADevice device, uint8_t* serial_number);
+ATCA_STATUS atcab_ctx_read_pubkey(ATCADevice device, uint8_t slot8toF, uint8_t *pubkey);
+ATCA_STATUS atcab_ctx_pubkey_cache_fill(ATCADevice device);
+ATCA_STATUS atcab_ctx_read_sig(ATCADevice device, uint8_t slot8toF, uint8_t *sig);
+ATCA_STATUS atcab_ctx_read_ecc_config_zone(ATCADevice device, uint8_t* config_data);
+ATCA_STATUS atcab_ctx_write_ecc_config_zone(ATCADevice device, const uint8_t* config_data);
+ATCA_STATUS atcab_ctx_read_sha_config_zone(ATCADevice device, uint8_t* config_data);
+ATCA_STATUS atcab_ctx_write_sha_config_zone(ATCADevice device, const uint8_t* config_data);
+ATCA_STATUS atcab_ctx_read_config_zone(ATCADevice device, ATCADeviceType dev_type, uint8_t* config_data);
+ATCA_STATUS atcab_ctx_write_config_zone(ATCADevice device, ATCADeviceType dev_type, const uint8_t* config_data);
+ATCA_STATUS atcab_ctx_cmp_config_zone(ATCADevice device, uint8_t* config_data, bool* same_config);
+
+ATCA_STATUS atcab_ctx_read_enc(ATCADevice device, uint8_t slotid, uint8_t block, uint8_t *data, const uint8_t* enckey, const uint8_t enckeyid);
+ATCA_STATUS atcab_ctx_write_enc(ATCADevice device, uint8_t slotid, uint8_t block, const uint8_t *data, const uint8_t* enckey, const uint8_t enckeyid);
+
+ATCA_STATUS atcab_ctx_lock_config_zone(ATCADevice device, uint8_t* lock_response);
+ATCA_STATUS atcab_ctx_lock_data_zone(ATCADevice device, uint8_t* lock_response);
+ATCA_STATUS atcab_ctx_lock_data_slot(ATCADevice device, uint8_t slot, uint8_t* lock_response);
+
+ATCA_STATUS atcab_ctx_priv_write(ATCADevice device, uint8_t slot, const uint8_t priv_key[36], uint8_t write_key_slot, const uint8_t write_key[32]);
+ATCA_STATUS atcab_ctx_genkey(ATCADevice device, int slot, uint8_t *pubkey);
+ATCA_STATUS atcab_ctx_get_pubkey(ATCADevice device, uint8_t slot, uint8_t *pubkey);
+ATCA_STATUS atcab_ctx_sign(ATCADevice device, uint16_t slot, const uint8_t *msg, uint8_t *signature);
+ATCA_STATUS atcab_ctx_sign_batch(ATCADevice device, uint16_t slot, const uint8_t * const digests[], uint16_t count, uint8_t *signatures[]);
+ATCA_STATUS atcab_ctx_verify_extern(ATCADevice device, const uint8_t *message, const uint8_t *signature, const uint8_t *pubkey, bool *verified);
+ATCA_STATUS atcab_ctx_ecdh(ATCADevice device, uint16_t key_id, const uint8_t* pub_key, uint8_t* ret_ecdh);
+ATCA_STATUS atcab_ctx_ecdh_enc(ATCADevice device, uint16_t key_id, const uint8_t* pub_key, uint8_t* ret_ecdh, const uint8_t* enckey, const uint8_t enckeyid);
+ATCA_STATUS atcab_ctx_gendig(ATCADevice device, uint8_t zone, uint16_t key_id);
+ATCA_STATUS atcab_ctx_gendig_host(ATCADevice device, uint8_t zone, uint16_t key_id, uint8_t *other_data, uint8_t len);
+ATCA_STATUS atcab_ctx_mac(ATCADevice device, uint8_t mode, uint16_t key_id, const uint8_t* challenge, uint8_t* digest);
+ATCA_STATUS atcab_ctx_checkmac(ATCADevice device, uint8_t mode, uint16_t key_id, const uint8_t *challenge, const uint8_t *response, const uint8_t *other_data);
+
+ATCA_STATUS atcab_ctx_sha_start(ATCADevice device);
+ATCA_STATUS atcab_ctx_sha_update(ATCADevice device, uint16_t length, const uint8_t *message);
+ATCA_STATUS atcab_ctx_sha_end(ATCADevice device, uint8_t *digest);
+ATCA_STATUS atcab_ctx_sha(ATCADevice device, uint16_t length, const uint8_t *message, uint8_t *digest);
+ATCA_STATUS atcab_ctx_sha_stream_start(ATCADevice device, atcab_sha_stream_t *ctx);
+ATCA_STATUS atcab_ctx_sha_stream_update(atcab_sha_stream_t *ctx, const uint8_t *message, size_t length);
+ATCA_STATUS atcab_ctx_sha_stream_end(atcab_sha_stream_t *ctx, uint8_t *digest);
+ATCA_STATUS atcab_ctx_sha_stream(ATCADevice device, const uint8_t *message, size_t length, uint8_t *digest, uint32_t *bytes_per_sec);
+
+ATCA_STATUS atcab_ctx_random_view(ATCADevice device, const uint8_t **rand_out);
+ATCA_STATUS atcab_ctx_genkey_view(ATCADevice device, int slot, const uint8_t **pubkey);
+ATCA_STATUS atcab_ctx_get_pubkey_view(ATCADevice device, uint8_t slot, const uint8_t **pubkey);
+ATCA_STATUS atcab_ctx_sign_view(ATCADevice device, uint16_t slot, const uint8_t *msg, const uint8_t **signature);
+ATCA_STATUS atcab_ctx_ecdh_view(ATCADevice device, uint16_t key_id, const uint8_t* pub_key, const uint8_t** ret_ecdh);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,209 @@
+/** \brief Bus scheduler for the CryptoAuthLib Basic API.  Interleaves the transfers of background
+* operations running on several devices that share a bus.
+*
+* A device only needs the bus to receive a response and send the next command, while it executes
+* the bus is free for the other devices.  atcab_bus_poll() services the devices whose responses are
+* due, earliest first, so each device gets its next command as soon as possible and the execution
+* windows of the devices overlap instead of running one after the other.  The operations themselves
+* are started with the atcab_ctx_*_start() calls, or through a device pool.
+*
+* Copyright (c) 2015 Atmel Corporation. All rights reserved.
+*
+* \asf_license_start
+*
+* \page License
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*
+* 1. Redistributions of source code must retain the above copyright notice,
+*    this list of conditions and the following disclaimer.
+*
+* 2. Redistributions in binary form must reproduce the above copyright notice,
+*    this list of conditions and the following disclaimer in the documentation
+*    and/or other materials provided with the distribution.
+*
+* 3. The name of Atmel may not be used to endorse or promote products derived
+*    from this software without specific prior written permission.
+*
+* 4. This software may only be redistributed and used in connection with an
+*    Atmel microcontroller product.
+*
+* THIS SOFTWARE IS PROVIDED BY ATMEL "AS IS" AND ANY EXPRESS OR IMPLIED
+* WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT ARE
+* EXPRESSLY AND SPECIFICALLY DISCLAIMED. IN NO EVENT SHALL ATMEL BE LIABLE FOR
+* ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+* OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+* HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+* STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+* ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+* POSSIBILITY OF SUCH DAMAGE.
+*
+* \asf_license_stop
+ */ 
+
+#include "atca_bus.h"
+
+/** \brief initialize an empty bus
+ *  \param[out] bus - bus to initialize
+ */
+void atcab_bus_init(atcab_bus_t *bus)
+{
+	memset( bus, 0, sizeof(atcab_bus_t) );
+	bus->start_ticks = atca_ticks_ms();
+}
+
+/** \brief add a device to the bus it is connected to
+ *  \param[inout] bus - bus to add the device to
+ *  \param[in] device - device to add, stays owned by the caller
+ *  \return ATCA_STATUS, ATCA_BAD_PARAM if the device isn't on I2C or is on a different bus than the devices
+ *          added before
+ */
+ATCA_STATUS atcab_bus_add(atcab_bus_t *bus, ATCADevice device)
+{
+	ATCAIfaceCfg *cfg, *first;
+
+	if ( bus == NULL || device == NULL )
+		return ATCA_BAD_PARAM;
+
+	if ( bus->count >= ATCA_BUS_MAX_DEVICES )
+		return ATCA_INVALID_SIZE;
+
+	cfg = atgetifacecfg( atGetIFace(device) );
+	if ( cfg->iface_type != ATCA_I2C_IFACE )
+		return ATCA_BAD_PARAM;
+
+	if ( bus->count > 0 )
+	{
+		first = atgetifacecfg( atGetIFace(bus->devices[0]) );
+		if ( cfg->atcai2c.bus != first->atcai2c.bus )
+			return ATCA_BAD_PARAM;
+	}
+
+	bus->devices[bus->count++] = device;
+	bus->start_bus_us += atgetbustime( atGetIFace(device) );
+	return ATCA_SUCCESS;
+}
+
+/** \brief receive the responses that are due on the bus and send the next commands, earliest due
+ *  first.  Call this from the application main loop, completion callbacks are called from here.
+ *  \param[inout] bus - bus to service
+ *  \return ATCA_RX_NO_RESPONSE while operations are running on the bus, ATCA_SUCCESS when it is idle
+ */
+ATCA_STATUS atcab_bus_poll(atcab_bus_t *bus)
+{
+	ATCADevice due[ATCA_BUS_MAX_DEVICES];
+	uint32_t due_ticks[ATCA_BUS_MAX_DEVICES], ticks, now = atca_ticks_ms();
+	int count = 0, i, j;
+
+	if ( bus == NULL )
+		return ATCA_BAD_PARAM;
+
+	// collect the devices that can be serviced now, sorted by when their response became due
+	for ( i = 0; i < bus->count; i++ )
+	{
+		if ( !atcab_ctx_due( bus->devices[i], &ticks ) || (int32_t)(now - ticks) < 0 )
+			continue;
+
+		for ( j = count++; j > 0 && (int32_t)(due_ticks[j - 1] - ticks) > 0; j-- )
+		{
+			due[j] = due[j - 1];
+			due_ticks[j] = due_ticks[j - 1];
+		}
+		due[j] = bus->devices[i];
+		due_ticks[j] = ticks;
+	}
+
+	for ( i = 0; i < count; i++ )
+		atcab_ctx_poll( due[i] );
+
+	for ( i = 0; i < bus->count; i++ )
+	{
+		if ( atcab_ctx_busy( bus->devices[i] ) )
+			return ATCA_RX_NO_RESPONSE;
+	}
+
+	return ATCA_SUCCESS;
+}
+
+/** \brief when the bus needs to be serviced next, so the application can sleep until then
+ *  \param[in] bus - bus to check
+ *  \param[out] due_ticks - atca_ticks_ms() value at which atcab_bus_poll() has work to do
+ *  \return true if operations are running on the bus
+ */
+bool atcab_bus_next_due(atcab_bus_t *bus, uint32_t *due_ticks)
+{
+	uint32_t ticks;
+	bool running = false;
+	int i;
+
+	for ( i = 0; bus != NULL && i < bus->count; i++ )
+	{
+		if ( !atcab_ctx_due( bus->devices[i], &ticks ) )
+			continue;
+
+		if ( !running || (int32_t)(ticks - *due_ticks) < 0 )
+			*due_ticks = ticks;
+		running = true;
+	}
+
+	return running;
+}
+
+/** \brief estimated time the transfers of all devices on the bus occupied it since the load measurement started
+ *  \param[in] bus - bus to check
+ *  \param[out] bus_us - receives the time in microseconds
+ *  \return ATCA_STATUS
+ */
+ATCA_STATUS atcab_bus_time(atcab_bus_t *bus, uint32_t *bus_us)
+{
+	uint32_t total_us = 0;
+	int i;
+
+	if ( bus == NULL || bus_us == NULL )
+		return ATCA_BAD_PARAM;
+
+	for ( i = 0; i < bus->count; i++ )
+		total_us += atgetbustime( atGetIFace(bus->devices[i]) );
+
+	*bus_us = total_us - bus->start_bus_us;
+	return ATCA_SUCCESS;
+}
+
+/** \brief how busy the bus has been since the load measurement started
+ *  \param[in] bus - bus to check
+ *  \return percentage of the time the bus was transferring, 0 if bus is NULL
+ */
+uint8_t atcab_bus_load(atcab_bus_t *bus)
+{
+	uint64_t elapsed_us;
+	uint32_t bus_us;
+
+	if ( atcab_bus_time( bus, &bus_us ) != ATCA_SUCCESS )
+		return 0;
+
+	// the tick count only wraps after 49 days, microseconds in 32 bits after 71 minutes
+	elapsed_us = (uint64_t)(uint32_t)(atca_ticks_ms() - bus->start_ticks) * 1000;
+	if ( elapsed_us == 0 )
+		return 0;
+
+	if ( bus_us >= elapsed_us )
+		return 100;
+
+	return (uint8_t)((uint64_t)bus_us * 100 / elapsed_us);
+}
+
+/** \brief restart the load measurement of the bus
+ *  \param[inout] bus - bus to reset
+ */
+void atcab_bus_load_reset(atcab_bus_t *bus)
+{
+	if ( bus == NULL )
+		return;
+
+	bus->start_ticks = atca_ticks_ms();
+	bus->start_bus_us = 0;
+	atcab_bus_time( bus, &bus->start_bus_us );
+}
@@ -0,0 +1,81 @@
+/** \brief Bus scheduler for the CryptoAuthLib Basic API.  Interleaves the transfers of background
+* operations running on several devices that share a bus.
+*
+* Copyright (c) 2015 Atmel Corporation. All rights reserved.
+*
+* \asf_license_start
+*
+* \page License
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*
+* 1. Redistributions of source code must retain the above copyright notice,
+*    this list of conditions and the following disclaimer.
+*
+* 2. Redistributions in binary form must reproduce the above copyright notice,
+*    this list of conditions and the following disclaimer in the documentation
+*    and/or other materials provided with the distribution.
+*
+* 3. The name of Atmel may not be used to endorse or promote products derived
+*    from this software without specific prior written permission.
+*
+* 4. This software may only be redistributed and used in connection with an
+*    Atmel microcontroller product.
+*
+* THIS SOFTWARE IS PROVIDED BY ATMEL "AS IS" AND ANY EXPRESS OR IMPLIED
+* WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT ARE
+* EXPRESSLY AND SPECIFICALLY DISCLAIMED. IN NO EVENT SHALL ATMEL BE LIABLE FOR
+* ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+* OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+* HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+* STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+* ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+* POSSIBILITY OF SUCH DAMAGE.
+*
+* \asf_license_stop
+ */ 
+
+#ifndef ATCA_BUS_H_
+#define ATCA_BUS_H_
+
+#include "cryptoauthlib.h"
+
+/** \defgroup atcab_ Basic Crypto API methods (atcab_)
+ *
+ * \brief
+ * These methods provide the most convenient, simple API to CryptoAuth chips
+ *
+@{ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define ATCA_BUS_MAX_DEVICES    (8)     // devices sharing a bus
+
+/** \brief devices sharing one bus and the accounting of the bus time they use */
+typedef struct {
+	ATCADevice devices[ATCA_BUS_MAX_DEVICES];
+	int        count;
+	uint32_t   start_ticks;		// atca_ticks_ms() when the load measurement started
+	uint32_t   start_bus_us;	// bus time of the devices when the load measurement started
+} atcab_bus_t;
+
+void atcab_bus_init(atcab_bus_t *bus);
+ATCA_STATUS atcab_bus_add(atcab_bus_t *bus, ATCADevice device);
+ATCA_STATUS atcab_bus_poll(atcab_bus_t *bus);
+bool atcab_bus_next_due(atcab_bus_t *bus, uint32_t *due_ticks);
+ATCA_STATUS atcab_bus_time(atcab_bus_t *bus, uint32_t *bus_us);
+uint8_t atcab_bus_load(atcab_bus_t *bus);
+void atcab_bus_load_reset(atcab_bus_t *bus);
+
+#ifdef __cplusplus
+}
+#endif
+
+/** @} */
+
+#endif /* ATCA_BUS_H_ */
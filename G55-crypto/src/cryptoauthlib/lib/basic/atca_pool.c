@@ -0,0 +1,462 @@
+/** \brief Device pool for the CryptoAuthLib Basic API.  Spreads sign, verify, random and ECDH
+* operations over several devices to scale throughput with the number of chips.
+*
+* Each device of the pool runs one background operation at a time through the atcab_ctx_*_start()
+* calls.  An operation is dispatched to the ready device that holds the key and is predicted to
+* complete it first, so operations started while others are executing overlap on different chips.
+* The application keeps the pool running by calling atcab_pool_poll() from its main loop.
+*
+* Copyright (c) 2015 Atmel Corporation. All rights reserved.
+*
+* \asf_license_start
+*
+* \page License
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*
+* 1. Redistributions of source code must retain the above copyright notice,
+*    this list of conditions and the following disclaimer.
+*
+* 2. Redistributions in binary form must reproduce the above copyright notice,
+*    this list of conditions and the following disclaimer in the documentation
+*    and/or other materials provided with the distribution.
+*
+* 3. The name of Atmel may not be used to endorse or promote products derived
+*    from this software without specific prior written permission.
+*
+* 4. This software may only be redistributed and used in connection with an
+*    Atmel microcontroller product.
+*
+* THIS SOFTWARE IS PROVIDED BY ATMEL "AS IS" AND ANY EXPRESS OR IMPLIED
+* WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT ARE
+* EXPRESSLY AND SPECIFICALLY DISCLAIMED. IN NO EVENT SHALL ATMEL BE LIABLE FOR
+* ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+* OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+* HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+* STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+* ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+* POSSIBILITY OF SUCH DAMAGE.
+*
+* \asf_license_stop
+ */ 
+
+#include "atca_pool.h"
+
+/** \brief commands the pool operations consist of, used to predict their execution time */
+static const ATCA_CmdMap pool_random_cmds[] = { CMD_RANDOM };
+static const ATCA_CmdMap pool_sign_cmds[]   = { CMD_RANDOM, CMD_NONCE, CMD_SIGN };
+static const ATCA_CmdMap pool_verify_cmds[] = { CMD_NONCE, CMD_VERIFY };
+static const ATCA_CmdMap pool_ecdh_cmds[]   = { CMD_ECDH };
+
+#define POOL_CMDS(cmds)     cmds, (int)(sizeof(cmds) / sizeof(cmds[0]))
+
+/** \brief completion state of a blocking pool operation */
+typedef struct {
+	bool        done;
+	ATCA_STATUS status;
+} atcab_pool_wait_t;
+
+/** \brief initialize an empty pool
+ *  \param[out] pool - pool to initialize
+ */
+void atcab_pool_init(atcab_pool_t *pool)
+{
+	memset( pool, 0, sizeof(atcab_pool_t) );
+}
+
+/** \brief add a device to a pool
+ *  \param[inout] pool - pool to add the device to
+ *  \param[in] device - device to add, stays owned by the caller
+ *  \param[in] slot_map - ATCA_POOL_MAX_KEYS slots holding logical keys 0.. on this device, ATCA_POOL_NO_SLOT
+ *                        for keys the device doesn't hold.  NULL maps key n to slot n.
+ *  \return ATCA_STATUS
+ */
+ATCA_STATUS atcab_pool_add(atcab_pool_t *pool, ATCADevice device, const uint8_t *slot_map)
+{
+	atcab_pool_member_t *member;
+	int key;
+
+	if ( pool == NULL || device == NULL )
+		return ATCA_BAD_PARAM;
+
+	if ( pool->count >= ATCA_POOL_MAX_DEVICES )
+		return ATCA_INVALID_SIZE;
+
+	member = &pool->members[pool->count++];
+	memset( member, 0, sizeof(atcab_pool_member_t) );
+	member->device = device;
+	member->ready = true;
+	for ( key = 0; key < ATCA_POOL_MAX_KEYS; key++ )
+		member->slot_map[key] = slot_map ? slot_map[key] : (uint8_t)key;
+
+	return ATCA_SUCCESS;
+}
+
+/** \brief change the slot holding a logical key on one device of a pool
+ *  \param[inout] pool - pool of the device
+ *  \param[in] index - device index, in the order devices were added
+ *  \param[in] key - logical key
+ *  \param[in] slot - slot holding the key on the device, ATCA_POOL_NO_SLOT if it doesn't hold it
+ *  \return ATCA_STATUS
+ */
+ATCA_STATUS atcab_pool_map_key(atcab_pool_t *pool, int index, uint8_t key, uint8_t slot)
+{
+	if ( pool == NULL || index < 0 || index >= pool->count || key >= ATCA_POOL_MAX_KEYS )
+		return ATCA_BAD_PARAM;
+
+	pool->members[index].slot_map[key] = slot;
+	return ATCA_SUCCESS;
+}
+
+/** \brief take a device of a pool out of dispatch or put it back.  Devices are taken out automatically
+ *  when they fail to communicate.
+ *  \param[inout] pool - pool of the device
+ *  \param[in] index - device index, in the order devices were added
+ *  \param[in] ready - whether operations may be dispatched to the device
+ *  \return ATCA_STATUS
+ */
+ATCA_STATUS atcab_pool_set_ready(atcab_pool_t *pool, int index, bool ready)
+{
+	if ( pool == NULL || index < 0 || index >= pool->count )
+		return ATCA_BAD_PARAM;
+
+	pool->members[index].ready = ready;
+	return ATCA_SUCCESS;
+}
+
+/** \brief predicted execution time of a sequence of commands on a device, learned when available
+ *  \param[in] device - device to execute the commands
+ *  \param[in] cmds - commands
+ *  \param[in] count - number of commands
+ *  \return predicted time in us
+ */
+static uint32_t _atcab_pool_cost(ATCADevice device, const ATCA_CmdMap *cmds, int count)
+{
+	ATCACommand commands = atGetCommands( device );
+	uint32_t cost_us = 0, us;
+	int i;
+
+	for ( i = 0; i < count; i++ )
+	{
+		if ( (us = atGetLearnedExecTime( commands, cmds[i] )) == 0 )
+			us = (uint32_t)atGetExecTime( commands, cmds[i] ) * 1000;
+		cost_us += us;
+	}
+
+	return cost_us;
+}
+
+/** \brief pick the device of a pool an operation is dispatched to.  Devices that are not ready, are
+ *  running an operation or don't hold the key are skipped, among the others the one predicted to
+ *  complete the operation first wins, and on a tie the one that was given the least work so far.
+ *  \param[inout] pool - pool to pick from
+ *  \param[in] key - logical key the operation uses, -1 if it uses none
+ *  \param[in] cmds - commands of the operation
+ *  \param[in] count - number of commands
+ *  \param[out] picked - picked device
+ *  \return ATCA_STATUS, ATCA_FUNC_FAIL when all devices able to run the operation are busy,
+ *          ATCA_NO_DEVICES when no ready device holds the key
+ */
+static ATCA_STATUS _atcab_pool_pick(atcab_pool_t *pool, int key, const ATCA_CmdMap *cmds, int count, atcab_pool_member_t **picked)
+{
+	atcab_pool_member_t *member, *best = NULL;
+	uint32_t cost_us, best_us = 0;
+	bool capable = false;
+	int i;
+
+	if ( pool == NULL || key >= ATCA_POOL_MAX_KEYS )
+		return ATCA_BAD_PARAM;
+
+	for ( i = 0; i < pool->count; i++ )
+	{
+		member = &pool->members[i];
+		if ( !member->ready || (key >= 0 && member->slot_map[key] == ATCA_POOL_NO_SLOT) )
+			continue;
+
+		capable = true;
+		if ( member->busy || atcab_ctx_busy( member->device ) )
+			continue;
+
+		cost_us = _atcab_pool_cost( member->device, cmds, count );
+		if ( best == NULL || cost_us < best_us || (cost_us == best_us && member->work_us < best->work_us) )
+		{
+			best = member;
+			best_us = cost_us;
+		}
+	}
+
+	if ( best == NULL )
+		return capable ? ATCA_FUNC_FAIL : ATCA_NO_DEVICES;
+
+	best->inflight_us = best_us;
+	*picked = best;
+	return ATCA_SUCCESS;
+}
+
+/** \brief completion callback of the operations the pool starts on its devices
+ *  \param[in] status - final status of the operation
+ *  \param[in] context - pool member the operation ran on
+ */
+static void _atcab_pool_done(ATCA_STATUS status, void *context)
+{
+	atcab_pool_member_t *member = (atcab_pool_member_t *)context;
+
+	member->busy = false;
+	member->inflight_us = 0;
+
+	if ( status == ATCA_SUCCESS )
+		member->ops++;
+	else
+		member->errors++;
+
+	// the device stopped talking, stop dispatching to it until the application puts it back
+	if ( status == ATCA_COMM_FAIL || status == ATCA_TX_FAIL || status == ATCA_WAKE_FAILED || status == ATCA_TIMEOUT )
+		member->ready = false;
+
+	if ( member->callback )
+		member->callback( status, member->context );
+}
+
+/** \brief account for an operation that was started on a pool member
+ *  \param[inout] member - device the operation was started on
+ *  \param[in] status - status of starting the operation
+ *  \param[in] callback - application completion callback
+ *  \param[in] context - passed to the callback
+ *  \return status
+ */
+static ATCA_STATUS _atcab_pool_started(atcab_pool_member_t *member, ATCA_STATUS status, atcab_callback callback, void *context)
+{
+	if ( status != ATCA_SUCCESS )
+	{
+		member->inflight_us = 0;
+		return status;
+	}
+
+	member->busy = true;
+	member->work_us += member->inflight_us;
+	member->callback = callback;
+	member->context = context;
+	return ATCA_SUCCESS;
+}
+
+/** \brief advance the operations running on the devices of a pool.  Call this from the application
+ *  main loop, completion callbacks are called from here.
+ *  \param[inout] pool - pool to advance
+ *  \return ATCA_RX_NO_RESPONSE while operations are running, ATCA_SUCCESS when the pool is idle
+ */
+ATCA_STATUS atcab_pool_poll(atcab_pool_t *pool)
+{
+	int i;
+
+	if ( pool == NULL )
+		return ATCA_BAD_PARAM;
+
+	for ( i = 0; i < pool->count; i++ )
+	{
+		// also advances operations started on the device outside of the pool, which keep it from dispatch
+		if ( atcab_ctx_busy( pool->members[i].device ) )
+			atcab_ctx_poll( pool->members[i].device );
+	}
+
+	return atcab_pool_busy( pool ) ? ATCA_RX_NO_RESPONSE : ATCA_SUCCESS;
+}
+
+/** \brief whether operations are running on any device of a pool
+ *  \param[in] pool - pool to check
+ *  \return true while atcab_pool_poll() needs to be called
+ */
+bool atcab_pool_busy(atcab_pool_t *pool)
+{
+	int i;
+
+	for ( i = 0; pool != NULL && i < pool->count; i++ )
+	{
+		if ( pool->members[i].busy )
+			return true;
+	}
+
+	return false;
+}
+
+/** \brief completion callback of the blocking pool operations */
+static void _atcab_pool_wake(ATCA_STATUS status, void *context)
+{
+	atcab_pool_wait_t *wait = (atcab_pool_wait_t *)context;
+
+	wait->status = status;
+	wait->done = true;
+}
+
+/** \brief advance the pool until a blocking operation completes
+ *  \param[inout] pool - pool the operation runs on
+ *  \param[in] status - status of starting the operation
+ *  \param[inout] wait - completion state of the operation
+ *  \return final status of the operation
+ */
+static ATCA_STATUS _atcab_pool_wait(atcab_pool_t *pool, ATCA_STATUS status, atcab_pool_wait_t *wait)
+{
+	if ( status != ATCA_SUCCESS )
+		return status;
+
+	while ( !wait->done )
+		atcab_pool_poll( pool );
+
+	return wait->status;
+}
+
+/** \brief start getting a 32 byte random number from a device of the pool in the background
+ *  \param[inout] pool - pool to dispatch to
+ *  \param[out] rand_out ptr to 32 bytes of storage for random number, must stay valid until the callback
+ *  \param[in] callback called from atcab_pool_poll() when done, may be NULL
+ *  \param[in] context passed to the callback
+ *  \return ATCA_STATUS, ATCA_FUNC_FAIL while all devices are busy
+ */
+ATCA_STATUS atcab_pool_random_start(atcab_pool_t *pool, uint8_t *rand_out, atcab_callback callback, void *context)
+{
+	atcab_pool_member_t *member;
+	ATCA_STATUS status;
+
+	if ( (status = _atcab_pool_pick( pool, -1, POOL_CMDS(pool_random_cmds), &member )) != ATCA_SUCCESS )
+		return status;
+
+	status = atcab_ctx_random_start( member->device, rand_out, _atcab_pool_done, member );
+	return _atcab_pool_started( member, status, callback, context );
+}
+
+/** \brief start signing a 32 byte digest with a key held by devices of the pool in the background
+ *  \param[inout] pool - pool to dispatch to
+ *  \param[in] key - logical key, mapped to the slot of the device that signs
+ *  \param[in] msg should point to a 32 byte buffer
+ *  \param[out] signature of msg, 64 bytes, must stay valid until the callback
+ *  \param[in] callback called from atcab_pool_poll() when done, may be NULL
+ *  \param[in] context passed to the callback
+ *  \return ATCA_STATUS, ATCA_FUNC_FAIL while all devices holding the key are busy
+ */
+ATCA_STATUS atcab_pool_sign_start(atcab_pool_t *pool, uint8_t key, const uint8_t *msg, uint8_t *signature, atcab_callback callback, void *context)
+{
+	atcab_pool_member_t *member;
+	ATCA_STATUS status;
+
+	if ( (status = _atcab_pool_pick( pool, key, POOL_CMDS(pool_sign_cmds), &member )) != ATCA_SUCCESS )
+		return status;
+
+	status = atcab_ctx_sign_start( member->device, member->slot_map[key], msg, signature, _atcab_pool_done, member );
+	return _atcab_pool_started( member, status, callback, context );
+}
+
+/** \brief start verifying a signature with an external public key on a device of the pool in the background
+ *  \param[inout] pool - pool to dispatch to
+ *  \param[in] message - 32 byte digest that was signed
+ *  \param[in] signature - 64 byte signature
+ *  \param[in] pubkey - 64 byte public key
+ *  \param[out] verified - result of the verification, must stay valid until the callback
+ *  \param[in] callback called from atcab_pool_poll() when done, may be NULL
+ *  \param[in] context passed to the callback
+ *  \return ATCA_STATUS, ATCA_FUNC_FAIL while all devices are busy
+ */
+ATCA_STATUS atcab_pool_verify_extern_start(atcab_pool_t *pool, const uint8_t *message, const uint8_t *signature, const uint8_t *pubkey, bool *verified, atcab_callback callback, void *context)
+{
+	atcab_pool_member_t *member;
+	ATCA_STATUS status;
+
+	if ( (status = _atcab_pool_pick( pool, -1, POOL_CMDS(pool_verify_cmds), &member )) != ATCA_SUCCESS )
+		return status;
+
+	status = atcab_ctx_verify_extern_start( member->device, message, signature, pubkey, verified, _atcab_pool_done, member );
+	return _atcab_pool_started( member, status, callback, context );
+}
+
+/** \brief start an ECDH with a key held by devices of the pool in the background
+ *  \param[inout] pool - pool to dispatch to
+ *  \param[in] key - logical key, mapped to the slot of the device that runs the ECDH
+ *  \param[in] pubkey - 64 byte public key of the other party
+ *  \param[out] ret_ecdh - 32 byte shared secret, must stay valid until the callback
+ *  \param[in] callback called from atcab_pool_poll() when done, may be NULL
+ *  \param[in] context passed to the callback
+ *  \return ATCA_STATUS, ATCA_FUNC_FAIL while all devices holding the key are busy
+ */
+ATCA_STATUS atcab_pool_ecdh_start(atcab_pool_t *pool, uint8_t key, const uint8_t* pubkey, uint8_t* ret_ecdh, atcab_callback callback, void *context)
+{
+	atcab_pool_member_t *member;
+	ATCA_STATUS status;
+
+	if ( (status = _atcab_pool_pick( pool, key, POOL_CMDS(pool_ecdh_cmds), &member )) != ATCA_SUCCESS )
+		return status;
+
+	status = atcab_ctx_ecdh_start( member->device, member->slot_map[key], pubkey, ret_ecdh, _atcab_pool_done, member );
+	return _atcab_pool_started( member, status, callback, context );
+}
+
+/** \brief get a 32 byte random number from a device of the pool, waiting for a device if all are busy
+ *  \param[inout] pool - pool to dispatch to
+ *  \param[out] rand_out ptr to 32 bytes of storage for random number
+ *  \return ATCA_STATUS
+ */
+ATCA_STATUS atcab_pool_random(atcab_pool_t *pool, uint8_t *rand_out)
+{
+	atcab_pool_wait_t wait = { false, ATCA_SUCCESS };
+	ATCA_STATUS status;
+
+	while ( (status = atcab_pool_random_start( pool, rand_out, _atcab_pool_wake, &wait )) == ATCA_FUNC_FAIL )
+		atcab_pool_poll( pool );
+
+	return _atcab_pool_wait( pool, status, &wait );
+}
+
+/** \brief sign a 32 byte digest with a key held by devices of the pool, waiting for a device if all are busy
+ *  \param[inout] pool - pool to dispatch to
+ *  \param[in] key - logical key, mapped to the slot of the device that signs
+ *  \param[in] msg should point to a 32 byte buffer
+ *  \param[out] signature of msg, 64 bytes
+ *  \return ATCA_STATUS
+ */
+ATCA_STATUS atcab_pool_sign(atcab_pool_t *pool, uint8_t key, const uint8_t *msg, uint8_t *signature)
+{
+	atcab_pool_wait_t wait = { false, ATCA_SUCCESS };
+	ATCA_STATUS status;
+
+	while ( (status = atcab_pool_sign_start( pool, key, msg, signature, _atcab_pool_wake, &wait )) == ATCA_FUNC_FAIL )
+		atcab_pool_poll( pool );
+
+	return _atcab_pool_wait( pool, status, &wait );
+}
+
+/** \brief verify a signature with an external public key on a device of the pool, waiting for a device if all are busy
+ *  \param[inout] pool - pool to dispatch to
+ *  \param[in] message - 32 byte digest that was signed
+ *  \param[in] signature - 64 byte signature
+ *  \param[in] pubkey - 64 byte public key
+ *  \param[out] verified - result of the verification
+ *  \return ATCA_STATUS
+ */
+ATCA_STATUS atcab_pool_verify_extern(atcab_pool_t *pool, const uint8_t *message, const uint8_t *signature, const uint8_t *pubkey, bool *verified)
+{
+	atcab_pool_wait_t wait = { false, ATCA_SUCCESS };
+	ATCA_STATUS status;
+
+	while ( (status = atcab_pool_verify_extern_start( pool, message, signature, pubkey, verified, _atcab_pool_wake, &wait )) == ATCA_FUNC_FAIL )
+		atcab_pool_poll( pool );
+
+	return _atcab_pool_wait( pool, status, &wait );
+}
+
+/** \brief ECDH with a key held by devices of the pool, waiting for a device if all are busy
+ *  \param[inout] pool - pool to dispatch to
+ *  \param[in] key - logical key, mapped to the slot of the device that runs the ECDH
+ *  \param[in] pubkey - 64 byte public key of the other party
+ *  \param[out] ret_ecdh - 32 byte shared secret
+ *  \return ATCA_STATUS
+ */
+ATCA_STATUS atcab_pool_ecdh(atcab_pool_t *pool, uint8_t key, const uint8_t* pubkey, uint8_t* ret_ecdh)
+{
+	atcab_pool_wait_t wait = { false, ATCA_SUCCESS };
+	ATCA_STATUS status;
+
+	while ( (status = atcab_pool_ecdh_start( pool, key, pubkey, ret_ecdh, _atcab_pool_wake, &wait )) == ATCA_FUNC_FAIL )
+		atcab_pool_poll( pool );
+
+	return _atcab_pool_wait( pool, status, &wait );
+}
@@ -0,0 +1,106 @@
+/** \brief Device pool for the CryptoAuthLib Basic API.  Spreads sign, verify, random and ECDH
+* operations over several devices to scale throughput with the number of chips.
+*
+* Copyright (c) 2015 Atmel Corporation. All rights reserved.
+*
+* \asf_license_start
+*
+* \page License
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*
+* 1. Redistributions of source code must retain the above copyright notice,
+*    this list of conditions and the following disclaimer.
+*
+* 2. Redistributions in binary form must reproduce the above copyright notice,
+*    this list of conditions and the following disclaimer in the documentation
+*    and/or other materials provided with the distribution.
+*
+* 3. The name of Atmel may not be used to endorse or promote products derived
+*    from this software without specific prior written permission.
+*
+* 4. This software may only be redistributed and used in connection with an
+*    Atmel microcontroller product.
+*
+* THIS SOFTWARE IS PROVIDED BY ATMEL "AS IS" AND ANY EXPRESS OR IMPLIED
+* WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT ARE
+* EXPRESSLY AND SPECIFICALLY DISCLAIMED. IN NO EVENT SHALL ATMEL BE LIABLE FOR
+* ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+* OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+* HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+* STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+* ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+* POSSIBILITY OF SUCH DAMAGE.
+*
+* \asf_license_stop
+ */ 
+
+#ifndef ATCA_POOL_H_
+#define ATCA_POOL_H_
+
+#include "cryptoauthlib.h"
+
+/** \defgroup atcab_ Basic Crypto API methods (atcab_)
+ *
+ * \brief
+ * These methods provide the most convenient, simple API to CryptoAuth chips
+ *
+@{ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define ATCA_POOL_MAX_DEVICES   (8)     // devices in a pool
+#define ATCA_POOL_MAX_KEYS      (16)    // logical keys mapped to device slots
+#define ATCA_POOL_NO_SLOT       (0xFF)  // slot map entry of a key the device doesn't hold
+
+/** \brief a device of a pool and its accounting */
+typedef struct {
+	ATCADevice     device;
+	uint8_t        slot_map[ATCA_POOL_MAX_KEYS];	// logical key to slot on this device
+	bool           ready;			// cleared when the device fails to communicate
+	bool           busy;			// an operation is running on the device
+	uint32_t       inflight_us;		// predicted execution time of the running operation
+	uint32_t       work_us;			// predicted execution time of all operations given to the device
+	uint32_t       ops;				// operations completed
+	uint32_t       errors;			// operations failed
+	atcab_callback callback;		// completion callback of the running operation
+	void          *context;
+} atcab_pool_member_t;
+
+/** \brief a set of devices operations are dispatched to */
+typedef struct {
+	atcab_pool_member_t members[ATCA_POOL_MAX_DEVICES];
+	int                 count;
+} atcab_pool_t;
+
+void atcab_pool_init(atcab_pool_t *pool);
+ATCA_STATUS atcab_pool_add(atcab_pool_t *pool, ATCADevice device, const uint8_t *slot_map);
+ATCA_STATUS atcab_pool_map_key(atcab_pool_t *pool, int index, uint8_t key, uint8_t slot);
+ATCA_STATUS atcab_pool_set_ready(atcab_pool_t *pool, int index, bool ready);
+ATCA_STATUS atcab_pool_poll(atcab_pool_t *pool);
+bool atcab_pool_busy(atcab_pool_t *pool);
+
+// background dispatch, ATCA_FUNC_FAIL when no device can take the operation right now
+ATCA_STATUS atcab_pool_random_start(atcab_pool_t *pool, uint8_t *rand_out, atcab_callback callback, void *context);
+ATCA_STATUS atcab_pool_sign_start(atcab_pool_t *pool, uint8_t key, const uint8_t *msg, uint8_t *signature, atcab_callback callback, void *context);
+ATCA_STATUS atcab_pool_verify_extern_start(atcab_pool_t *pool, const uint8_t *message, const uint8_t *signature, const uint8_t *pubkey, bool *verified, atcab_callback callback, void *context);
+ATCA_STATUS atcab_pool_ecdh_start(atcab_pool_t *pool, uint8_t key, const uint8_t* pubkey, uint8_t* ret_ecdh, atcab_callback callback, void *context);
+
+// blocking dispatch, other operations of the pool keep running while waiting
+ATCA_STATUS atcab_pool_random(atcab_pool_t *pool, uint8_t *rand_out);
+ATCA_STATUS atcab_pool_sign(atcab_pool_t *pool, uint8_t key, const uint8_t *msg, uint8_t *signature);
+ATCA_STATUS atcab_pool_verify_extern(atcab_pool_t *pool, const uint8_t *message, const uint8_t *signature, const uint8_t *pubkey, bool *verified);
+ATCA_STATUS atcab_pool_ecdh(atcab_pool_t *pool, uint8_t key, const uint8_t* pubkey, uint8_t* ret_ecdh);
+
+#ifdef __cplusplus
+}
+#endif
+
+/** @} */
+
+#endif /* ATCA_POOL_H_ */
@@ -0,0 +1,154 @@
+/** \brief HMAC-DRBG with SHA-256 (NIST SP 800-90A, section 10.1.2).  The caller supplies all entropy,
+* this module doesn't gather any itself.
+*
+* Copyright (c) 2015 Atmel Corporation. All rights reserved.
+*
+* \asf_license_start
+*
+* \page License
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*
+* 1. Redistributions of source code must retain the above copyright notice,
+*    this list of conditions and the following disclaimer.
+*
+* 2. Redistributions in binary form must reproduce the above copyright notice,
+*    this list of conditions and the following disclaimer in the documentation
+*    and/or other materials provided with the distribution.
+*
+* 3. The name of Atmel may not be used to endorse or promote products derived
+*    from this software without specific prior written permission.
+*
+* 4. This software may only be redistributed and used in connection with an
+*    Atmel microcontroller product.
+*
+* THIS SOFTWARE IS PROVIDED BY ATMEL "AS IS" AND ANY EXPRESS OR IMPLIED
+* WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT ARE
+* EXPRESSLY AND SPECIFICALLY DISCLAIMED. IN NO EVENT SHALL ATMEL BE LIABLE FOR
+* ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+* OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+* HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+* STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+* ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+* POSSIBILITY OF SUCH DAMAGE.
+*
+* \asf_license_stop
+*/
+
+#include <string.h>
+#include "atca_crypto_sw_drbg.h"
+#include "atca_crypto_sw_sha2.h"
+
+/** \brief HMAC-SHA256 with a 32 byte key over up to three pieces of data, NULL pieces are skipped */
+static void hmac_sha256(const uint8_t key[32], const uint8_t* d1, size_t d1_size, const uint8_t* d2, size_t d2_size,
+                        const uint8_t* d3, size_t d3_size, uint8_t mac[32])
+{
+    atcac_sha2_256_ctx ctx;
+    uint8_t pad[64];
+    uint8_t inner[ATCA_SHA2_256_DIGEST_SIZE];
+    int i;
+
+    for (i = 0; i < 64; i++)
+        pad[i] = (i < 32 ? key[i] : 0) ^ 0x36;
+    atcac_sw_sha2_256_init(&ctx);
+    atcac_sw_sha2_256_update(&ctx, pad, sizeof(pad));
+    if (d1)
+        atcac_sw_sha2_256_update(&ctx, d1, d1_size);
+    if (d2)
+        atcac_sw_sha2_256_update(&ctx, d2, d2_size);
+    if (d3)
+        atcac_sw_sha2_256_update(&ctx, d3, d3_size);
+    atcac_sw_sha2_256_finish(&ctx, inner);
+
+    for (i = 0; i < 64; i++)
+        pad[i] ^= 0x36 ^ 0x5C;
+    atcac_sw_sha2_256_init(&ctx);
+    atcac_sw_sha2_256_update(&ctx, pad, sizeof(pad));
+    atcac_sw_sha2_256_update(&ctx, inner, sizeof(inner));
+    atcac_sw_sha2_256_finish(&ctx, mac);
+
+    memset(pad, 0, sizeof(pad));
+    memset(inner, 0, sizeof(inner));
+}
+
+/** \brief HMAC_DRBG_Update, mixes the provided data (may be NULL) into Key and V */
+static void hmac_drbg_update(atcac_hmac_drbg_ctx* ctx, const uint8_t* data, size_t data_size)
+{
+    static const uint8_t zero = 0x00, one = 0x01;
+
+    hmac_sha256(ctx->key, ctx->v, sizeof(ctx->v), &zero, 1, data, data_size, ctx->key);
+    hmac_sha256(ctx->key, ctx->v, sizeof(ctx->v), NULL, 0, NULL, 0, ctx->v);
+    if (data == NULL || data_size == 0)
+        return;
+
+    hmac_sha256(ctx->key, ctx->v, sizeof(ctx->v), &one, 1, data, data_size, ctx->key);
+    hmac_sha256(ctx->key, ctx->v, sizeof(ctx->v), NULL, 0, NULL, 0, ctx->v);
+}
+
+/** \brief instantiate the DRBG
+ * \param[out] ctx        DRBG state
+ * \param[in]  seed       entropy input, nonce and personalization string, at least ATCAC_DRBG_SEED_SIZE bytes
+ * \param[in]  seed_size  number of bytes in seed
+ * \return ATCA_SUCCESS
+ */
+int atcac_hmac_drbg_init(atcac_hmac_drbg_ctx* ctx, const uint8_t* seed, size_t seed_size)
+{
+    if (ctx == NULL || seed == NULL || seed_size < ATCAC_DRBG_SEED_SIZE)
+        return ATCA_BAD_PARAM;
+
+    memset(ctx->key, 0x00, sizeof(ctx->key));
+    memset(ctx->v, 0x01, sizeof(ctx->v));
+    hmac_drbg_update(ctx, seed, seed_size);
+    ctx->reseed_counter = 1;
+
+    return ATCA_SUCCESS;
+}
+
+/** \brief reseed the DRBG with fresh entropy
+ * \param[inout] ctx      DRBG state
+ * \param[in]  seed       entropy input and additional input, at least ATCAC_DRBG_SEED_SIZE bytes
+ * \param[in]  seed_size  number of bytes in seed
+ * \return ATCA_SUCCESS
+ */
+int atcac_hmac_drbg_reseed(atcac_hmac_drbg_ctx* ctx, const uint8_t* seed, size_t seed_size)
+{
+    if (ctx == NULL || seed == NULL || seed_size < ATCAC_DRBG_SEED_SIZE)
+        return ATCA_BAD_PARAM;
+
+    hmac_drbg_update(ctx, seed, seed_size);
+    ctx->reseed_counter = 1;
+
+    return ATCA_SUCCESS;
+}
+
+/** \brief generate random bytes
+ * \param[inout] ctx      DRBG state
+ * \param[out] data       receives the random bytes
+ * \param[in]  data_size  number of bytes, at most ATCAC_DRBG_MAX_REQUEST
+ * \return ATCA_SUCCESS, ATCA_FUNC_FAIL when the DRBG has to be reseeded first
+ */
+int atcac_hmac_drbg_generate(atcac_hmac_drbg_ctx* ctx, uint8_t* data, size_t data_size)
+{
+    size_t done, count;
+
+    if (ctx == NULL || (data == NULL && data_size > 0) || data_size > ATCAC_DRBG_MAX_REQUEST)
+        return ATCA_BAD_PARAM;
+
+    if (ctx->reseed_counter > ATCAC_DRBG_RESEED_INTERVAL)
+        return ATCA_FUNC_FAIL;
+
+    for (done = 0; done < data_size; done += count)
+    {
+        hmac_sha256(ctx->key, ctx->v, sizeof(ctx->v), NULL, 0, NULL, 0, ctx->v);
+        count = data_size - done < sizeof(ctx->v) ? data_size - done : sizeof(ctx->v);
+        memcpy(&data[done], ctx->v, count);
+    }
+
+    hmac_drbg_update(ctx, NULL, 0);
+    ctx->reseed_counter++;
+
+    return ATCA_SUCCESS;
+}
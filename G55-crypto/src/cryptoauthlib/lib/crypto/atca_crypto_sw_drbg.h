@@ -0,0 +1,75 @@
+/** \brief HMAC-DRBG with SHA-256 (NIST SP 800-90A), for stretching the output of a hardware RNG
+*
+* Copyright (c) 2015 Atmel Corporation. All rights reserved.
+*
+* \asf_license_start
+*
+* \page License
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*
+* 1. Redistributions of source code must retain the above copyright notice,
+*    this list of conditions and the following disclaimer.
+*
+* 2. Redistributions in binary form must reproduce the above copyright notice,
+*    this list of conditions and the following disclaimer in the documentation
+*    and/or other materials provided with the distribution.
+*
+* 3. The name of Atmel may not be used to endorse or promote products derived
+*    from this software without specific prior written permission.
+*
+* 4. This software may only be redistributed and used in connection with an
+*    Atmel microcontroller product.
+*
+* THIS SOFTWARE IS PROVIDED BY ATMEL "AS IS" AND ANY EXPRESS OR IMPLIED
+* WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT ARE
+* EXPRESSLY AND SPECIFICALLY DISCLAIMED. IN NO EVENT SHALL ATMEL BE LIABLE FOR
+* ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+* OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+* HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+* STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+* ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+* POSSIBILITY OF SUCH DAMAGE.
+*
+* \asf_license_stop
+*/
+
+#ifndef ATCA_CRYPTO_SW_DRBG_H
+#define ATCA_CRYPTO_SW_DRBG_H
+
+#include "atca_crypto_sw.h"
+#include <stddef.h>
+#include <stdint.h>
+
+/** \ingroup atcac_
+@{ */
+
+#define ATCAC_DRBG_SEED_SIZE        (32)        //!< entropy taken for an instantiate or a reseed
+#define ATCAC_DRBG_MAX_REQUEST      (65536)     //!< most bytes one generate call may return
+#ifndef ATCAC_DRBG_RESEED_INTERVAL
+#define ATCAC_DRBG_RESEED_INTERVAL  (1024)      //!< generate calls between reseeds
+#endif
+
+typedef struct {
+    uint8_t  key[32];
+    uint8_t  v[32];
+    uint32_t reseed_counter;    //!< generate calls since the last (re)seed, plus one
+} atcac_hmac_drbg_ctx;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+int atcac_hmac_drbg_init(atcac_hmac_drbg_ctx* ctx, const uint8_t* seed, size_t seed_size);
+int atcac_hmac_drbg_reseed(atcac_hmac_drbg_ctx* ctx, const uint8_t* seed, size_t seed_size);
+int atcac_hmac_drbg_generate(atcac_hmac_drbg_ctx* ctx, uint8_t* data, size_t data_size);
+
+#ifdef __cplusplus
+}
+#endif
+
+/** @} */
+#endif
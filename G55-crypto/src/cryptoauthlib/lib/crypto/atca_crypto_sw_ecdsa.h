@@ -66,6 +66,12 @@ int atcac_sw_ecdsa_verify_p256( const uint8_t msg[ATCA_ECC_P256_FIELD_SIZE],
                                 const uint8_t signature[ATCA_ECC_P256_SIGNATURE_SIZE],
                                 const uint8_t public_key[ATCA_ECC_P256_PUBLIC_KEY_SIZE]);
 
+int atcac_sw_ecdsa_verify_p256_batch( const uint8_t* const msgs[],
+                                      const uint8_t* const signatures[],
+                                      const uint8_t* const public_keys[],
+                                      int                  results[],
+                                      size_t               count);
+
 #ifdef __cplusplus
 }
 #endif
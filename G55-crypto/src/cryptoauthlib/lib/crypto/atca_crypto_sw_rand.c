@@ -1,4 +1,6 @@
-/** \brief 
+/** \brief Software random number generator, ChaCha20 with fast key erasure: every refill runs ChaCha20
+* with the current key, takes the first 32 bytes of keystream as the next key and hands out the rest,
+* wiping each byte as it goes.  An earlier state can't be recovered from a later one.
 *
 * Copyright (c) 2015 Atmel Corporation. All rights reserved.
 *
@@ -37,9 +39,239 @@
 * \asf_license_stop
 */ 
 
+#include <string.h>
 #include "atca_crypto_sw_rand.h"
+#include "atca_crypto_sw_sha2.h"
 
+#ifdef ATCAC_RANDOM_GETRANDOM
+#include <errno.h>
+#include <pthread.h>
+#include <sys/random.h>
+#define ATCAC_THREAD_LOCAL __thread
+#else
+#define ATCAC_THREAD_LOCAL
+#endif
+
+#define CHACHA20_BLOCK_SIZE (64)
+
+/** \brief state of a generator */
+typedef struct {
+    uint32_t key[8];
+    uint8_t  buf[ATCAC_RANDOM_BLOCKS * CHACHA20_BLOCK_SIZE - 32];  //!< keystream not handed out yet, taken from the end
+    size_t   avail;             //!< bytes left in buf
+    size_t   since_reseed;      //!< bytes handed out since the last seed from the OS
+    int      seeded;
+} atcac_random_state;
+
+static ATCAC_THREAD_LOCAL atcac_random_state rand_state;
+
+#define ROTL32(v, n)    (((v) << (n)) | ((v) >> (32 - (n))))
+#define QUARTERROUND(a, b, c, d) \
+    a += b; d ^= a; d = ROTL32(d, 16); \
+    c += d; b ^= c; b = ROTL32(b, 12); \
+    a += b; d ^= a; d = ROTL32(d, 8);  \
+    c += d; b ^= c; b = ROTL32(b, 7)
+
+/** \brief ChaCha20 block function (RFC 8439, section 2.3) */
+static void chacha20_block(const uint32_t in[16], uint8_t out[CHACHA20_BLOCK_SIZE])
+{
+    uint32_t x[16];
+    int i;
+
+    memcpy(x, in, sizeof(x));
+    for (i = 0; i < 10; i++)
+    {
+        QUARTERROUND(x[0], x[4], x[8],  x[12]);
+        QUARTERROUND(x[1], x[5], x[9],  x[13]);
+        QUARTERROUND(x[2], x[6], x[10], x[14]);
+        QUARTERROUND(x[3], x[7], x[11], x[15]);
+        QUARTERROUND(x[0], x[5], x[10], x[15]);
+        QUARTERROUND(x[1], x[6], x[11], x[12]);
+        QUARTERROUND(x[2], x[7], x[8],  x[13]);
+        QUARTERROUND(x[3], x[4], x[9],  x[14]);
+    }
+    for (i = 0; i < 16; i++)
+    {
+        x[i] += in[i];
+        out[4 * i + 0] = (uint8_t)(x[i]);
+        out[4 * i + 1] = (uint8_t)(x[i] >> 8);
+        out[4 * i + 2] = (uint8_t)(x[i] >> 16);
+        out[4 * i + 3] = (uint8_t)(x[i] >> 24);
+    }
+    memset(x, 0, sizeof(x));
+}
+
+/** \brief loads 32 bytes as the little endian words of a ChaCha20 key */
+static void key_from_bytes(uint32_t key[8], const uint8_t bytes[32])
+{
+    int i;
+
+    for (i = 0; i < 8; i++)
+        key[i] = (uint32_t)bytes[4 * i] | ((uint32_t)bytes[4 * i + 1] << 8) | ((uint32_t)bytes[4 * i + 2] << 16) | ((uint32_t)bytes[4 * i + 3] << 24);
+}
+
+/** \brief runs ChaCha20 with the current key, replaces the key and refills the buffer */
+static void rand_refill(atcac_random_state* st)
+{
+    static const uint32_t sigma[4] = { 0x61707865, 0x3320646e, 0x79622d32, 0x6b206574 };  // "expand 32-byte k"
+    uint32_t in[16];
+    uint8_t block[CHACHA20_BLOCK_SIZE];
+    int i;
+
+    memcpy(&in[0], sigma, sizeof(sigma));
+    memcpy(&in[4], st->key, sizeof(st->key));
+    memset(&in[12], 0, 4 * sizeof(uint32_t));     // block counter and nonce, a key is only ever used once
+
+    chacha20_block(in, block);
+    key_from_bytes(st->key, block);
+    memcpy(st->buf, &block[32], 32);
+    for (i = 1; i < ATCAC_RANDOM_BLOCKS; i++)
+    {
+        in[12] = (uint32_t)i;
+        chacha20_block(in, &st->buf[i * CHACHA20_BLOCK_SIZE - 32]);
+    }
+    st->avail = sizeof(st->buf);
+
+    memset(in, 0, sizeof(in));
+    memset(block, 0, sizeof(block));
+}
+
+/** \brief mixes entropy into the key, key = SHA-256(key || entropy), and drops the buffered output */
+static void rand_mix(atcac_random_state* st, const uint8_t* entropy, size_t entropy_size)
+{
+    atcac_sha2_256_ctx ctx;
+    uint8_t key[ATCA_SHA2_256_DIGEST_SIZE];
+
+    atcac_sw_sha2_256_init(&ctx);
+    if (st->seeded)
+        atcac_sw_sha2_256_update(&ctx, (const uint8_t*)st->key, sizeof(st->key));
+    atcac_sw_sha2_256_update(&ctx, entropy, entropy_size);
+    atcac_sw_sha2_256_finish(&ctx, key);
+    key_from_bytes(st->key, key);
+
+    memset(st->buf, 0, sizeof(st->buf));
+    st->avail = 0;
+    st->seeded = 1;
+
+    memset(&ctx, 0, sizeof(ctx));
+    memset(key, 0, sizeof(key));
+}
+
+#ifdef ATCAC_RANDOM_GETRANDOM
+static pthread_once_t rand_atfork_once = PTHREAD_ONCE_INIT;
+
+/** \brief in a forked child, which runs only the forking thread, forgets the state shared with the parent */
+static void rand_atfork_child(void)
+{
+    memset(&rand_state, 0, sizeof(rand_state));
+}
+
+static void rand_atfork_register(void)
+{
+    pthread_atfork(NULL, NULL, rand_atfork_child);
+}
+
+/** \brief reads entropy from the OS, blocking only until the OS has seeded its own generator after boot */
+static int rand_getrandom(uint8_t* entropy, size_t entropy_size, unsigned int flags)
+{
+    ssize_t ret;
+    size_t done = 0;
+
+    while (done < entropy_size)
+    {
+        ret = getrandom(&entropy[done], entropy_size - done, flags);
+        if (ret < 0 && errno == EINTR)
+            continue;
+        if (ret <= 0)
+            return ATCA_FUNC_FAIL;
+        done += (size_t)ret;
+    }
+    return ATCA_SUCCESS;
+}
+#endif
+
+/** \brief seeds the generator from the OS on first use, and reseeds it every ATCAC_RANDOM_RESEED_BYTES */
+static int rand_seed(atcac_random_state* st)
+{
+#ifdef ATCAC_RANDOM_GETRANDOM
+    uint8_t entropy[ATCAC_RANDOM_SEED_SIZE];
+
+    if (!st->seeded)
+    {
+        pthread_once(&rand_atfork_once, rand_atfork_register);
+        if (rand_getrandom(entropy, sizeof(entropy), 0) != ATCA_SUCCESS)
+            return ATCA_FUNC_FAIL;
+    }
+    else if (rand_getrandom(entropy, sizeof(entropy), GRND_NONBLOCK) != ATCA_SUCCESS)
+    {
+        // a reseed is a precaution, the current key is still good
+        st->since_reseed = 0;
+        return ATCA_SUCCESS;
+    }
+    rand_mix(st, entropy, sizeof(entropy));
+    st->since_reseed = 0;
+    memset(entropy, 0, sizeof(entropy));
+    return ATCA_SUCCESS;
+#else
+    // no OS entropy, the application seeds with atcac_sw_random_reseed()
+    st->since_reseed = 0;
+    return st->seeded ? ATCA_SUCCESS : ATCA_FUNC_FAIL;
+#endif
+}
+
+/** \brief generates random bytes.  Each thread draws from its own generator, without locking.
+ * \param[out] data       receives the random bytes
+ * \param[in]  data_size  number of bytes
+ * \return ATCA_SUCCESS, ATCA_FUNC_FAIL if the generator couldn't be seeded
+ */
 int atcac_sw_random(uint8_t* data, size_t data_size)
 {
-    return ATCA_UNIMPLEMENTED;
-}
\ No newline at end of file
+    atcac_random_state* st = &rand_state;
+    size_t count;
+
+    if (data == NULL && data_size > 0)
+        return ATCA_BAD_PARAM;
+
+    if (!st->seeded || st->since_reseed >= ATCAC_RANDOM_RESEED_BYTES)
+    {
+        if (rand_seed(st) != ATCA_SUCCESS)
+            return ATCA_FUNC_FAIL;
+    }
+
+    while (data_size > 0)
+    {
+        if (st->avail == 0)
+            rand_refill(st);
+        count = data_size < st->avail ? data_size : st->avail;
+        st->avail -= count;
+        memcpy(data, &st->buf[st->avail], count);
+        memset(&st->buf[st->avail], 0, count);
+        data += count;
+        data_size -= count;
+        st->since_reseed += count;
+    }
+
+    return ATCA_SUCCESS;
+}
+
+/** \brief mixes entropy into the calling thread's generator, e.g. output of atcab_random().  Targets without
+ *         OS entropy have to seed this way before the first atcac_sw_random().
+ * \param[in] entropy       entropy to mix in
+ * \param[in] entropy_size  number of bytes, at least ATCAC_RANDOM_SEED_SIZE for a first seed
+ * \return ATCA_SUCCESS, ATCA_BAD_PARAM for too little entropy to seed, ATCA_FUNC_FAIL without OS entropy
+ */
+int atcac_sw_random_reseed(const uint8_t* entropy, size_t entropy_size)
+{
+    atcac_random_state* st = &rand_state;
+
+    if (entropy == NULL || (!st->seeded && entropy_size < ATCAC_RANDOM_SEED_SIZE))
+        return ATCA_BAD_PARAM;
+
+#ifdef ATCAC_RANDOM_GETRANDOM
+    // seed from the OS first, so extra entropy never replaces it
+    if (!st->seeded && rand_seed(st) != ATCA_SUCCESS)
+        return ATCA_FUNC_FAIL;
+#endif
+    rand_mix(st, entropy, entropy_size);
+    return ATCA_SUCCESS;
+}
@@ -1,4 +1,4 @@
-/** \brief 
+/** \brief Software random number generator, ChaCha20 with fast key erasure.
 *
 * Copyright (c) 2015 Atmel Corporation. All rights reserved.
 *
@@ -51,11 +51,26 @@
  * algorithms
  *
 @{ */
+#define ATCAC_RANDOM_SEED_SIZE      (32)        //!< entropy taken from the OS for a seed
+#define ATCAC_RANDOM_BLOCKS         (8)         //!< ChaCha20 blocks per refill, the first 32 bytes become the next key
+#ifndef ATCAC_RANDOM_RESEED_BYTES
+#define ATCAC_RANDOM_RESEED_BYTES   (1048576)   //!< output between reseeds from the OS
+#endif
+
+/* Each thread has its own generator on Linux, seeded from getrandom() on first use, so threads never
+ * contend.  Other targets have one generator and no OS entropy, it has to be seeded with
+ * atcac_sw_random_reseed(), e.g. from atcab_random(), before use.
+ */
+#if defined(__linux__)
+#define ATCAC_RANDOM_GETRANDOM
+#endif
+
 #ifdef __cplusplus
 extern "C" {
 #endif
 
 int atcac_sw_random(uint8_t* data, size_t data_size);
+int atcac_sw_random_reseed(const uint8_t* entropy, size_t entropy_size);
 
 #ifdef __cplusplus
 }
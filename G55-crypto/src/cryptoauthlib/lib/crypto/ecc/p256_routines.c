@@ -0,0 +1,1348 @@
+/** \brief Software implementation of NIST P-256 elliptic curve arithmetic: key generation,
+ * ECDSA sign and verify and ECDH.
+ *
+ * Copyright (c) 2015 Atmel Corporation. All rights reserved.
+ *
+ * \asf_license_start
+ *
+ * \page License
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. The name of Atmel may not be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * 4. This software may only be redistributed and used in connection with an
+ *    Atmel microcontroller product.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ATMEL "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT ARE
+ * EXPRESSLY AND SPECIFICALLY DISCLAIMED. IN NO EVENT SHALL ATMEL BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * \asf_license_stop
+ */
+
+#include <string.h>
+#include "p256_routines.h"
+
+#if P256_LIMB_BITS == 64
+typedef unsigned __int128 p256_dlimb;
+#define P256_N_INV      (0xCCD1C8AAEE00BC4Full)
+#else
+typedef uint64_t p256_dlimb;
+#define P256_N_INV      (0xEE00BC4Ful)
+#endif
+
+/** \brief modulus and the constants Montgomery multiplication needs for it */
+typedef struct {
+    p256_limb m[P256_LIMBS];    //!< modulus
+    p256_limb rr[P256_LIMBS];   //!< R^2 mod m, R = 2^256
+    p256_limb m_inv;            //!< -m^-1 mod 2^P256_LIMB_BITS
+} p256_modulus;
+
+// field prime p = 2^256 - 2^224 + 2^192 + 2^96 - 1, reduced by fe_reduce() rather than Montgomery multiplication
+static const p256_limb p256_p[P256_LIMBS] = {
+    P256_LIMB_INIT(0xFFFFFFFF, 0xFFFFFFFF), P256_LIMB_INIT(0xFFFFFFFF, 0x00000000), P256_LIMB_INIT(0x00000000, 0x00000000), P256_LIMB_INIT(0x00000001, 0xFFFFFFFF) };
+
+// group order n, scalars are worked in Montgomery form
+static const p256_modulus p256_n = {
+    { P256_LIMB_INIT(0xFC632551, 0xF3B9CAC2), P256_LIMB_INIT(0xA7179E84, 0xBCE6FAAD), P256_LIMB_INIT(0xFFFFFFFF, 0xFFFFFFFF), P256_LIMB_INIT(0x00000000, 0xFFFFFFFF) },
+    { P256_LIMB_INIT(0xBE79EEA2, 0x83244C95), P256_LIMB_INIT(0x49BD6FA6, 0x4699799C), P256_LIMB_INIT(0x2B6BEC59, 0x2845B239), P256_LIMB_INIT(0xF3D95620, 0x66E12D94) },
+    P256_N_INV
+};
+
+// curve coefficient b and base point G
+static const p256_limb p256_b[P256_LIMBS] = {
+    P256_LIMB_INIT(0x27D2604B, 0x3BCE3C3E), P256_LIMB_INIT(0xCC53B0F6, 0x651D06B0), P256_LIMB_INIT(0x769886BC, 0xB3EBBD55), P256_LIMB_INIT(0xAA3A93E7, 0x5AC635D8) };
+static const p256_limb p256_gx[P256_LIMBS] = {
+    P256_LIMB_INIT(0xD898C296, 0xF4A13945), P256_LIMB_INIT(0x2DEB33A0, 0x77037D81), P256_LIMB_INIT(0x63A440F2, 0xF8BCE6E5), P256_LIMB_INIT(0xE12C4247, 0x6B17D1F2) };
+static const p256_limb p256_gy[P256_LIMBS] = {
+    P256_LIMB_INIT(0x37BF51F5, 0xCBB64068), P256_LIMB_INIT(0x6B315ECE, 0x2BCE3357), P256_LIMB_INIT(0x7C0F9E16, 0x8EE7EB4A), P256_LIMB_INIT(0xFE1A7F9B, 0x4FE342E2) };
+static const p256_limb p256_one[P256_LIMBS] = { 1 };
+
+/**
+* \brief Loads a 32 byte big endian number into little endian limbs.
+*/
+static void bn_from_bytes(p256_limb r[P256_LIMBS], const uint8_t bytes[P256_FIELD_SIZE])
+{
+    int i;
+
+    memset(r, 0, P256_FIELD_SIZE);
+    for (i = 0; i < P256_FIELD_SIZE; i++)
+        r[i / sizeof(p256_limb)] |= (p256_limb)bytes[P256_FIELD_SIZE - 1 - i] << (8 * (i % sizeof(p256_limb)));
+}
+
+/**
+* \brief Stores little endian limbs as a 32 byte big endian number.
+*/
+static void bn_to_bytes(uint8_t bytes[P256_FIELD_SIZE], const p256_limb a[P256_LIMBS])
+{
+    int i;
+
+    for (i = 0; i < P256_FIELD_SIZE; i++)
+        bytes[P256_FIELD_SIZE - 1 - i] = (uint8_t)(a[i / sizeof(p256_limb)] >> (8 * (i % sizeof(p256_limb))));
+}
+
+static int bn_is_zero(const p256_limb a[P256_LIMBS])
+{
+    p256_limb acc = 0;
+    int i;
+
+    for (i = 0; i < P256_LIMBS; i++)
+        acc |= a[i];
+    return acc == 0;
+}
+
+/**
+* \brief Compares two numbers.
+* \return -1, 0 or 1 as a is less than, equal to or greater than b
+*/
+static int bn_cmp(const p256_limb a[P256_LIMBS], const p256_limb b[P256_LIMBS])
+{
+    int i;
+
+    for (i = P256_LIMBS - 1; i >= 0; i--)
+    {
+        if (a[i] != b[i])
+            return a[i] > b[i] ? 1 : -1;
+    }
+    return 0;
+}
+
+/**
+* \brief Two bits of a number, bits i + 1 and i.
+*/
+static unsigned bn_bits2(const p256_limb a[P256_LIMBS], int i)
+{
+    return (unsigned)(a[i / P256_LIMB_BITS] >> (i % P256_LIMB_BITS)) & 3;
+}
+
+/**
+* \brief r = a + b
+* \return carry out
+*/
+static p256_limb bn_add(p256_limb r[P256_LIMBS], const p256_limb a[P256_LIMBS], const p256_limb b[P256_LIMBS])
+{
+    p256_dlimb c = 0;
+    int i;
+
+    for (i = 0; i < P256_LIMBS; i++)
+    {
+        c += (p256_dlimb)a[i] + b[i];
+        r[i] = (p256_limb)c;
+        c >>= P256_LIMB_BITS;
+    }
+    return (p256_limb)c;
+}
+
+/**
+* \brief r = a - b
+* \return borrow out
+*/
+static p256_limb bn_sub(p256_limb r[P256_LIMBS], const p256_limb a[P256_LIMBS], const p256_limb b[P256_LIMBS])
+{
+    p256_dlimb c;
+    p256_limb borrow = 0;
+    int i;
+
+    for (i = 0; i < P256_LIMBS; i++)
+    {
+        c = (p256_dlimb)a[i] - b[i] - borrow;
+        r[i] = (p256_limb)c;
+        borrow = (p256_limb)(c >> P256_LIMB_BITS) & 1;
+    }
+    return borrow;
+}
+
+/**
+* \brief r = a + b mod m, for a and b less than m
+*/
+static void mod_add(p256_limb r[P256_LIMBS], const p256_limb a[P256_LIMBS], const p256_limb b[P256_LIMBS], const p256_limb m[P256_LIMBS])
+{
+    if (bn_add(r, a, b) || bn_cmp(r, m) >= 0)
+        bn_sub(r, r, m);
+}
+
+/**
+* \brief r = a - b mod m, for a and b less than m
+*/
+static void mod_sub(p256_limb r[P256_LIMBS], const p256_limb a[P256_LIMBS], const p256_limb b[P256_LIMBS], const p256_limb m[P256_LIMBS])
+{
+    if (bn_sub(r, a, b))
+        bn_add(r, r, m);
+}
+
+/**
+* \brief Montgomery multiplication r = a * b / R mod m, for a and b less than m.  r may alias a or b.
+*/
+static void mod_mul(p256_limb r[P256_LIMBS], const p256_limb a[P256_LIMBS], const p256_limb b[P256_LIMBS], const p256_modulus* mod)
+{
+    p256_limb t[P256_LIMBS + 2];
+    p256_limb u;
+    p256_dlimb c;
+    int i, j;
+
+    memset(t, 0, sizeof(t));
+    for (i = 0; i < P256_LIMBS; i++)
+    {
+        // t += a * b[i]
+        c = 0;
+        for (j = 0; j < P256_LIMBS; j++)
+        {
+            c += (p256_dlimb)t[j] + (p256_dlimb)a[j] * b[i];
+            t[j] = (p256_limb)c;
+            c >>= P256_LIMB_BITS;
+        }
+        c += t[P256_LIMBS];
+        t[P256_LIMBS] = (p256_limb)c;
+        t[P256_LIMBS + 1] = (p256_limb)(c >> P256_LIMB_BITS);
+
+        // t = (t + u * m) / 2^P256_LIMB_BITS, with u chosen so the low limb cancels
+        u = t[0] * mod->m_inv;
+        c = ((p256_dlimb)t[0] + (p256_dlimb)u * mod->m[0]) >> P256_LIMB_BITS;
+        for (j = 1; j < P256_LIMBS; j++)
+        {
+            c += (p256_dlimb)t[j] + (p256_dlimb)u * mod->m[j];
+            t[j - 1] = (p256_limb)c;
+            c >>= P256_LIMB_BITS;
+        }
+        c += t[P256_LIMBS];
+        t[P256_LIMBS - 1] = (p256_limb)c;
+        t[P256_LIMBS] = t[P256_LIMBS + 1] + (p256_limb)(c >> P256_LIMB_BITS);
+    }
+
+    if (t[P256_LIMBS] || bn_cmp(t, mod->m) >= 0)
+        bn_sub(t, t, mod->m);
+    memcpy(r, t, P256_FIELD_SIZE);
+}
+
+/**
+* \brief Converts a number less than m into Montgomery form.
+*/
+static void mod_to_mont(p256_limb r[P256_LIMBS], const p256_limb a[P256_LIMBS], const p256_modulus* mod)
+{
+    mod_mul(r, a, mod->rr, mod);
+}
+
+/**
+* \brief Converts a number out of Montgomery form.
+*/
+static void mod_from_mont(p256_limb r[P256_LIMBS], const p256_limb a[P256_LIMBS], const p256_modulus* mod)
+{
+    mod_mul(r, a, p256_one, mod);
+}
+
+/**
+* \brief Inverse of a non-zero number in Montgomery form, a^(m-2) mod m.
+*/
+static void mod_inv(p256_limb r[P256_LIMBS], const p256_limb a[P256_LIMBS], const p256_modulus* mod)
+{
+    p256_limb e[P256_LIMBS];
+    p256_limb x[P256_LIMBS];
+    static const p256_limb two[P256_LIMBS] = { 2 };
+    int i;
+
+    bn_sub(e, mod->m, two);
+    memcpy(x, a, P256_FIELD_SIZE);
+    // the top bit of n - 2 is set, so start with x = a
+    for (i = 255 - 1; i >= 0; i--)
+    {
+        mod_mul(x, x, x, mod);
+        if ((e[i / P256_LIMB_BITS] >> (i % P256_LIMB_BITS)) & 1)
+            mod_mul(x, x, a, mod);
+    }
+    memcpy(r, x, P256_FIELD_SIZE);
+}
+
+/**
+* \brief Reduces a 256-bit number less than 2 * m modulo m.
+*/
+static void mod_reduce_once(p256_limb r[P256_LIMBS], const p256_limb a[P256_LIMBS], const p256_limb m[P256_LIMBS])
+{
+    memcpy(r, a, P256_FIELD_SIZE);
+    if (bn_cmp(r, m) >= 0)
+        bn_sub(r, r, m);
+}
+
+// 32-bit word i of a number, whatever the limb size
+#define P256_WORD(a, i) ((uint32_t)((a)[(i) * 32 / P256_LIMB_BITS] >> (((i) * 32) % P256_LIMB_BITS)))
+
+/**
+* \brief r = t mod p for a 512-bit product t, by the fast reduction for the NIST prime (FIPS 186-4 D.2.3).
+*        With the 32-bit words c15..c0 of t, r = s1 + 2 s2 + 2 s3 + s4 + s5 - d1 - d2 - d3 - d4, where each
+*        term is a 256-bit number made of words of t.  The sum is formed one word at a time.
+*/
+static void fe_reduce(p256_limb r[P256_LIMBS], const p256_limb t[2 * P256_LIMBS])
+{
+    uint32_t c[16], w[8];
+    int64_t acc, top;
+    int i;
+
+    for (i = 0; i < 16; i++)
+        c[i] = P256_WORD(t, i);
+
+    acc  = (int64_t)c[0] + c[8] + c[9] - c[11] - c[12] - c[13] - c[14];
+    w[0] = (uint32_t)acc; acc >>= 32;
+    acc += (int64_t)c[1] + c[9] + c[10] - c[12] - c[13] - c[14] - c[15];
+    w[1] = (uint32_t)acc; acc >>= 32;
+    acc += (int64_t)c[2] + c[10] + c[11] - c[13] - c[14] - c[15];
+    w[2] = (uint32_t)acc; acc >>= 32;
+    acc += (int64_t)c[3] + 2 * (int64_t)c[11] + 2 * (int64_t)c[12] + c[13] - c[15] - c[8] - c[9];
+    w[3] = (uint32_t)acc; acc >>= 32;
+    acc += (int64_t)c[4] + 2 * (int64_t)c[12] + 2 * (int64_t)c[13] + c[14] - c[9] - c[10];
+    w[4] = (uint32_t)acc; acc >>= 32;
+    acc += (int64_t)c[5] + 2 * (int64_t)c[13] + 2 * (int64_t)c[14] + c[15] - c[10] - c[11];
+    w[5] = (uint32_t)acc; acc >>= 32;
+    acc += (int64_t)c[6] + 3 * (int64_t)c[14] + 2 * (int64_t)c[15] + c[13] - c[8] - c[9];
+    w[6] = (uint32_t)acc; acc >>= 32;
+    acc += (int64_t)c[7] + 3 * (int64_t)c[15] + c[8] - c[10] - c[11] - c[12] - c[13];
+    w[7] = (uint32_t)acc; top = acc >> 32;
+
+    // fold what overflowed 2^256 back in, 2^256 = 2^224 - 2^192 - 2^96 + 1 mod p, until nothing does
+    while (top != 0)
+    {
+        acc = (int64_t)w[0] + top;
+        w[0] = (uint32_t)acc; acc >>= 32;
+        for (i = 1; i < 8; i++)
+        {
+            acc += w[i];
+            if (i == 3 || i == 6)
+                acc -= top;
+            else if (i == 7)
+                acc += top;
+            w[i] = (uint32_t)acc;
+            acc >>= 32;
+        }
+        top = acc;
+    }
+
+    for (i = 0; i < P256_LIMBS; i++)
+    {
+#if P256_LIMB_BITS == 64
+        r[i] = ((p256_limb)w[2 * i + 1] << 32) | w[2 * i];
+#else
+        r[i] = w[i];
+#endif
+    }
+    if (bn_cmp(r, p256_p) >= 0)
+        bn_sub(r, r, p256_p);
+}
+
+/**
+* \brief r = a * b mod p.  r may alias a or b.
+*/
+static void fe_mul(p256_limb r[P256_LIMBS], const p256_limb a[P256_LIMBS], const p256_limb b[P256_LIMBS])
+{
+    p256_limb t[2 * P256_LIMBS];
+    p256_dlimb c;
+    int i, j;
+
+    memset(t, 0, sizeof(t));
+    for (i = 0; i < P256_LIMBS; i++)
+    {
+        c = 0;
+        for (j = 0; j < P256_LIMBS; j++)
+        {
+            c += (p256_dlimb)t[i + j] + (p256_dlimb)a[j] * b[i];
+            t[i + j] = (p256_limb)c;
+            c >>= P256_LIMB_BITS;
+        }
+        t[i + P256_LIMBS] = (p256_limb)c;
+    }
+    fe_reduce(r, t);
+}
+
+/**
+* \brief r = a^2 mod p, each cross product computed once and doubled.  r may alias a.
+*/
+static void fe_sqr(p256_limb r[P256_LIMBS], const p256_limb a[P256_LIMBS])
+{
+    p256_limb t[2 * P256_LIMBS];
+    p256_limb hi, carry;
+    p256_dlimb c;
+    int i, j;
+
+    // products a[i] * a[j] for i < j
+    memset(t, 0, sizeof(t));
+    for (i = 0; i < P256_LIMBS; i++)
+    {
+        c = 0;
+        for (j = i + 1; j < P256_LIMBS; j++)
+        {
+            c += (p256_dlimb)t[i + j] + (p256_dlimb)a[i] * a[j];
+            t[i + j] = (p256_limb)c;
+            c >>= P256_LIMB_BITS;
+        }
+        t[i + P256_LIMBS] = (p256_limb)c;
+    }
+
+    // doubled, plus the squares a[i]^2
+    carry = 0;
+    for (i = 0; i < 2 * P256_LIMBS; i++)
+    {
+        hi = t[i] >> (P256_LIMB_BITS - 1);
+        t[i] = (t[i] << 1) | carry;
+        carry = hi;
+    }
+    c = 0;
+    for (i = 0; i < P256_LIMBS; i++)
+    {
+        c += (p256_dlimb)t[2 * i] + (p256_dlimb)a[i] * a[i];
+        t[2 * i] = (p256_limb)c;
+        c >>= P256_LIMB_BITS;
+        c += t[2 * i + 1];
+        t[2 * i + 1] = (p256_limb)c;
+        c >>= P256_LIMB_BITS;
+    }
+    fe_reduce(r, t);
+}
+
+/**
+* \brief Inverse of a non-zero field element, a^(p-2) mod p.
+*/
+static void fe_inv(p256_limb r[P256_LIMBS], const p256_limb a[P256_LIMBS])
+{
+    p256_limb e[P256_LIMBS];
+    p256_limb x[P256_LIMBS];
+    static const p256_limb two[P256_LIMBS] = { 2 };
+    int i;
+
+    bn_sub(e, p256_p, two);
+    memcpy(x, a, P256_FIELD_SIZE);
+    // the top bit of p - 2 is set, so start with x = a
+    for (i = 255 - 1; i >= 0; i--)
+    {
+        fe_sqr(x, x);
+        if ((e[i / P256_LIMB_BITS] >> (i % P256_LIMB_BITS)) & 1)
+            fe_mul(x, x, a);
+    }
+    memcpy(r, x, P256_FIELD_SIZE);
+}
+
+/**
+* \brief Inverts count non-zero field elements in place with a single inversion (Montgomery's trick): the
+*        running products a[0] * ... * a[i] are inverted once and the inverse peeled off one element at a time.
+* \param[inout] a       elements to invert
+* \param[out]   prefix  scratch space for count running products
+* \param[in]    count   number of elements
+*/
+static void fe_inv_batch(p256_limb* const a[], p256_limb (*prefix)[P256_LIMBS], int count)
+{
+    p256_limb inv[P256_LIMBS], t[P256_LIMBS];
+    int i;
+
+    if (count == 0)
+        return;
+
+    memcpy(prefix[0], a[0], P256_FIELD_SIZE);
+    for (i = 1; i < count; i++)
+        fe_mul(prefix[i], prefix[i - 1], a[i]);
+
+    fe_inv(inv, prefix[count - 1]);
+    for (i = count - 1; i > 0; i--)
+    {
+        fe_mul(t, inv, prefix[i - 1]);  // a[i]^-1
+        fe_mul(inv, inv, a[i]);         // (a[0] * ... * a[i-1])^-1
+        memcpy(a[i], t, P256_FIELD_SIZE);
+    }
+    memcpy(a[0], inv, P256_FIELD_SIZE);
+}
+
+/**
+* \brief Inverts count non-zero numbers in Montgomery form modulo m in place, as fe_inv_batch() does.
+*/
+static void mod_inv_batch(p256_limb* const a[], p256_limb (*prefix)[P256_LIMBS], int count, const p256_modulus* mod)
+{
+    p256_limb inv[P256_LIMBS], t[P256_LIMBS];
+    int i;
+
+    if (count == 0)
+        return;
+
+    memcpy(prefix[0], a[0], P256_FIELD_SIZE);
+    for (i = 1; i < count; i++)
+        mod_mul(prefix[i], prefix[i - 1], a[i], mod);
+
+    mod_inv(inv, prefix[count - 1], mod);
+    for (i = count - 1; i > 0; i--)
+    {
+        mod_mul(t, inv, prefix[i - 1], mod);
+        mod_mul(inv, inv, a[i], mod);
+        memcpy(a[i], t, P256_FIELD_SIZE);
+    }
+    memcpy(a[0], inv, P256_FIELD_SIZE);
+}
+
+static void point_set_infinity(sw_p256_point* r)
+{
+    memset(r, 0, sizeof(*r));
+}
+
+static int point_is_infinity(const sw_p256_point* a)
+{
+    return bn_is_zero(a->z);
+}
+
+/**
+* \brief r = 2 * a, for a = -3 (dbl-2001-b).  r may alias a.
+*/
+static void point_double(sw_p256_point* r, const sw_p256_point* a)
+{
+    p256_limb delta[P256_LIMBS], gamma[P256_LIMBS], beta[P256_LIMBS], alpha[P256_LIMBS];
+    p256_limb t1[P256_LIMBS], t2[P256_LIMBS];
+    const p256_limb* p = p256_p;
+
+    if (point_is_infinity(a) || bn_is_zero(a->y))
+    {
+        point_set_infinity(r);
+        return;
+    }
+
+    fe_sqr(delta, a->z);
+    fe_sqr(gamma, a->y);
+    fe_mul(beta, a->x, gamma);
+
+    // alpha = 3 * (X - delta) * (X + delta)
+    mod_sub(t1, a->x, delta, p);
+    mod_add(t2, a->x, delta, p);
+    fe_mul(alpha, t1, t2);
+    mod_add(t1, alpha, alpha, p);
+    mod_add(alpha, t1, alpha, p);
+
+    // Z3 = (Y + Z)^2 - gamma - delta
+    mod_add(t1, a->y, a->z, p);
+    fe_sqr(t1, t1);
+    mod_sub(t1, t1, gamma, p);
+    mod_sub(r->z, t1, delta, p);
+
+    // X3 = alpha^2 - 8 * beta
+    mod_add(beta, beta, beta, p);
+    mod_add(beta, beta, beta, p);   // 4 * beta
+    mod_add(t2, beta, beta, p);     // 8 * beta
+    fe_sqr(t1, alpha);
+    mod_sub(r->x, t1, t2, p);
+
+    // Y3 = alpha * (4 * beta - X3) - 8 * gamma^2
+    mod_sub(t1, beta, r->x, p);
+    fe_mul(t1, alpha, t1);
+    fe_sqr(gamma, gamma);
+    mod_add(gamma, gamma, gamma, p);
+    mod_add(gamma, gamma, gamma, p);
+    mod_add(gamma, gamma, gamma, p);
+    mod_sub(r->y, t1, gamma, p);
+}
+
+/**
+* \brief r = a + b.  r may alias a or b.
+*/
+static void point_add(sw_p256_point* r, const sw_p256_point* a, const sw_p256_point* b)
+{
+    p256_limb z1z1[P256_LIMBS], z2z2[P256_LIMBS], u1[P256_LIMBS], u2[P256_LIMBS];
+    p256_limb s1[P256_LIMBS], s2[P256_LIMBS], h[P256_LIMBS], rr[P256_LIMBS];
+    p256_limb hh[P256_LIMBS], hhh[P256_LIMBS], v[P256_LIMBS], t[P256_LIMBS];
+    const p256_limb* p = p256_p;
+
+    if (point_is_infinity(a))
+    {
+        *r = *b;
+        return;
+    }
+    if (point_is_infinity(b))
+    {
+        *r = *a;
+        return;
+    }
+
+    fe_sqr(z1z1, a->z);
+    fe_sqr(z2z2, b->z);
+    fe_mul(u1, a->x, z2z2);
+    fe_mul(u2, b->x, z1z1);
+    fe_mul(s1, a->y, b->z);
+    fe_mul(s1, s1, z2z2);
+    fe_mul(s2, b->y, a->z);
+    fe_mul(s2, s2, z1z1);
+    mod_sub(h, u2, u1, p);
+    mod_sub(rr, s2, s1, p);
+
+    if (bn_is_zero(h))
+    {
+        if (bn_is_zero(rr))
+            point_double(r, a);
+        else
+            point_set_infinity(r);
+        return;
+    }
+
+    fe_sqr(hh, h);
+    fe_mul(hhh, h, hh);
+    fe_mul(v, u1, hh);
+
+    // Z3 = Z1 * Z2 * H
+    fe_mul(t, a->z, b->z);
+    fe_mul(r->z, t, h);
+
+    // X3 = r^2 - H^3 - 2 * V
+    fe_sqr(t, rr);
+    mod_sub(t, t, hhh, p);
+    mod_sub(t, t, v, p);
+    mod_sub(r->x, t, v, p);
+
+    // Y3 = r * (V - X3) - S1 * H^3
+    mod_sub(t, v, r->x, p);
+    fe_mul(t, rr, t);
+    fe_mul(s1, s1, hhh);
+    mod_sub(r->y, t, s1, p);
+}
+
+/**
+* \brief r = a + b, for b = (bx, by) in affine coordinates (madd-2004-hmv).  r may alias a.
+*/
+static void point_add_affine(sw_p256_point* r, const sw_p256_point* a, const p256_limb bx[P256_LIMBS], const p256_limb by[P256_LIMBS])
+{
+    p256_limb z1z1[P256_LIMBS], u2[P256_LIMBS], s2[P256_LIMBS], h[P256_LIMBS], rr[P256_LIMBS];
+    p256_limb hh[P256_LIMBS], hhh[P256_LIMBS], v[P256_LIMBS], t[P256_LIMBS];
+    const p256_limb* p = p256_p;
+
+    if (point_is_infinity(a))
+    {
+        memcpy(r->x, bx, P256_FIELD_SIZE);
+        memcpy(r->y, by, P256_FIELD_SIZE);
+        memcpy(r->z, p256_one, P256_FIELD_SIZE);
+        return;
+    }
+
+    fe_sqr(z1z1, a->z);
+    fe_mul(u2, bx, z1z1);
+    fe_mul(s2, by, a->z);
+    fe_mul(s2, s2, z1z1);
+    mod_sub(h, u2, a->x, p);
+    mod_sub(rr, s2, a->y, p);
+
+    if (bn_is_zero(h))
+    {
+        if (bn_is_zero(rr))
+            point_double(r, a);
+        else
+            point_set_infinity(r);
+        return;
+    }
+
+    fe_sqr(hh, h);
+    fe_mul(hhh, h, hh);
+    fe_mul(v, a->x, hh);
+
+    // Z3 = Z1 * H
+    fe_mul(r->z, a->z, h);
+
+    // X3 = r^2 - H^3 - 2 * V
+    fe_sqr(t, rr);
+    mod_sub(t, t, hhh, p);
+    mod_sub(t, t, v, p);
+    mod_sub(r->x, t, v, p);
+
+    // Y3 = r * (V - X3) - Y1 * H^3
+    mod_sub(t, v, r->x, p);
+    fe_mul(t, rr, t);
+    fe_mul(hhh, a->y, hhh);
+    mod_sub(r->y, t, hhh, p);
+}
+
+/**
+* \brief r = k * a, by double and add from the most significant bit
+*/
+static void point_mul(sw_p256_point* r, const p256_limb k[P256_LIMBS], const sw_p256_point* a)
+{
+    sw_p256_point acc;
+    int i;
+
+    point_set_infinity(&acc);
+    for (i = 255; i >= 0; i--)
+    {
+        point_double(&acc, &acc);
+        if ((k[i / P256_LIMB_BITS] >> (i % P256_LIMB_BITS)) & 1)
+            point_add(&acc, &acc, a);
+    }
+    *r = acc;
+}
+
+static void point_base(sw_p256_point* r)
+{
+    memcpy(r->x, p256_gx, P256_FIELD_SIZE);
+    memcpy(r->y, p256_gy, P256_FIELD_SIZE);
+    memcpy(r->z, p256_one, P256_FIELD_SIZE);
+}
+
+// comb table of the base point G, generated by tools/p256_comb_gen into p256_comb_g.c
+extern const sw_p256_comb p256_comb_g;
+
+/**
+* \brief Index into a comb table for column i of a scalar, the bits i + j * P256_COMB_SPACING as bit j.
+*/
+static unsigned comb_index(const p256_limb k[P256_LIMBS], int i)
+{
+    unsigned idx = 0;
+    int j, bit;
+
+    for (j = 0, bit = i; j < P256_COMB_TEETH && bit < 256; j++, bit += P256_COMB_SPACING)
+        idx |= (unsigned)((k[bit / P256_LIMB_BITS] >> (bit % P256_LIMB_BITS)) & 1) << j;
+    return idx;
+}
+
+/**
+* \brief r = k * P with the comb table of P: P256_COMB_SPACING doublings, each followed by at most one
+*        mixed addition.
+*/
+static void point_mul_comb(sw_p256_point* r, const p256_limb k[P256_LIMBS], const sw_p256_comb* comb)
+{
+    sw_p256_point acc;
+    unsigned idx;
+    int i;
+
+    point_set_infinity(&acc);
+    for (i = P256_COMB_SPACING - 1; i >= 0; i--)
+    {
+        point_double(&acc, &acc);
+        if ((idx = comb_index(k, i)) != 0)
+            point_add_affine(&acc, &acc, comb->points[idx - 1].x, comb->points[idx - 1].y);
+    }
+    *r = acc;
+}
+
+/**
+* \brief Converts a point to affine coordinates.
+* \return P256_INVALID for the point at infinity
+*/
+static int point_to_affine(p256_limb x[P256_LIMBS], p256_limb y[P256_LIMBS], const sw_p256_point* a)
+{
+    p256_limb zinv[P256_LIMBS], zinv2[P256_LIMBS];
+
+    if (point_is_infinity(a))
+        return P256_INVALID;
+
+    fe_inv(zinv, a->z);
+    fe_sqr(zinv2, zinv);
+    fe_mul(x, a->x, zinv2);
+    if (y)
+    {
+        fe_mul(y, a->y, zinv2);
+        fe_mul(y, y, zinv);
+    }
+    return P256_SUCCESS;
+}
+
+/**
+* \brief Loads an affine public key and checks it is a point on the curve.
+*/
+static int point_from_public_key(sw_p256_point* r, const uint8_t public_key[P256_PUBLIC_KEY_SIZE])
+{
+    p256_limb lhs[P256_LIMBS], rhs[P256_LIMBS];
+    const p256_limb* p = p256_p;
+
+    bn_from_bytes(r->x, &public_key[0]);
+    bn_from_bytes(r->y, &public_key[P256_FIELD_SIZE]);
+    if (bn_cmp(r->x, p) >= 0 || bn_cmp(r->y, p) >= 0)
+        return P256_INVALID;
+    memcpy(r->z, p256_one, P256_FIELD_SIZE);
+
+    // y^2 = x^3 - 3x + b
+    fe_sqr(lhs, r->y);
+    fe_sqr(rhs, r->x);
+    fe_mul(rhs, rhs, r->x);
+    mod_sub(rhs, rhs, r->x, p);
+    mod_sub(rhs, rhs, r->x, p);
+    mod_sub(rhs, rhs, r->x, p);
+    mod_add(rhs, rhs, p256_b, p);
+    if (bn_cmp(lhs, rhs) != 0)
+        return P256_INVALID;
+
+    return P256_SUCCESS;
+}
+
+/**
+* \brief Loads a scalar and checks it is in [1, n-1].
+*/
+static int scalar_from_bytes(p256_limb r[P256_LIMBS], const uint8_t bytes[P256_FIELD_SIZE])
+{
+    bn_from_bytes(r, bytes);
+    if (bn_is_zero(r) || bn_cmp(r, p256_n.m) >= 0)
+        return P256_INVALID;
+    return P256_SUCCESS;
+}
+
+/**
+* \brief Checks a private key is in [1, n-1].
+* \return P256_SUCCESS or P256_INVALID
+*/
+int sw_p256_check_private_key(const uint8_t private_key[P256_FIELD_SIZE])
+{
+    p256_limb d[P256_LIMBS];
+
+    return scalar_from_bytes(d, private_key);
+}
+
+/**
+* \brief Checks a public key is a point on the curve.
+* \return P256_SUCCESS or P256_INVALID
+*/
+int sw_p256_check_public_key(const uint8_t public_key[P256_PUBLIC_KEY_SIZE])
+{
+    sw_p256_point q;
+
+    return point_from_public_key(&q, public_key);
+}
+
+/**
+* \brief Calculates the public key of a private key.
+*
+* \param[in]  private_key  Private key, big endian
+* \param[out] public_key   Public key X || Y, big endian
+* \return P256_SUCCESS or P256_INVALID
+*/
+int sw_p256_public_key(const uint8_t private_key[P256_FIELD_SIZE], uint8_t public_key[P256_PUBLIC_KEY_SIZE])
+{
+    p256_limb d[P256_LIMBS], x[P256_LIMBS], y[P256_LIMBS];
+    sw_p256_point q;
+
+    if (scalar_from_bytes(d, private_key) != P256_SUCCESS)
+        return P256_INVALID;
+
+    point_mul_comb(&q, d, &p256_comb_g);
+    if (point_to_affine(x, y, &q) != P256_SUCCESS)
+        return P256_INVALID;
+
+    bn_to_bytes(&public_key[0], x);
+    bn_to_bytes(&public_key[P256_FIELD_SIZE], y);
+    return P256_SUCCESS;
+}
+
+/**
+* \brief Calculates an ECDSA signature of a digest.
+*
+* \param[in]  private_key  Private key, big endian
+* \param[in]  digest       Message digest, big endian
+* \param[in]  k            Per signature secret random number in [1, n-1], big endian
+* \param[out] signature    R || S, big endian
+* \return P256_SUCCESS, P256_INVALID for a bad key or if k yields R or S of zero and must be drawn again
+*/
+int sw_p256_sign(const uint8_t private_key[P256_FIELD_SIZE], const uint8_t digest[P256_FIELD_SIZE],
+                 const uint8_t k[P256_FIELD_SIZE], uint8_t signature[P256_SIGNATURE_SIZE])
+{
+    p256_limb d[P256_LIMBS], kk[P256_LIMBS], e[P256_LIMBS], r[P256_LIMBS], s[P256_LIMBS], x[P256_LIMBS];
+    p256_limb t[P256_LIMBS];
+    const p256_modulus* n = &p256_n;
+    sw_p256_point q;
+
+    if (scalar_from_bytes(d, private_key) != P256_SUCCESS || scalar_from_bytes(kk, k) != P256_SUCCESS)
+        return P256_INVALID;
+
+    // R = k * G, r = R.x mod n
+    point_mul_comb(&q, kk, &p256_comb_g);
+    if (point_to_affine(x, NULL, &q) != P256_SUCCESS)
+        return P256_INVALID;
+    mod_reduce_once(r, x, n->m);
+    if (bn_is_zero(r))
+        return P256_INVALID;
+
+    // s = k^-1 * (e + r * d) mod n, worked in Montgomery form
+    bn_from_bytes(e, digest);
+    mod_reduce_once(e, e, n->m);
+    mod_to_mont(e, e, n);
+    mod_to_mont(t, r, n);
+    mod_to_mont(d, d, n);
+    mod_mul(t, t, d, n);
+    mod_add(t, t, e, n->m);
+    mod_to_mont(kk, kk, n);
+    mod_inv(kk, kk, n);
+    mod_mul(s, kk, t, n);
+    mod_from_mont(s, s, n);
+    if (bn_is_zero(s))
+        return P256_INVALID;
+
+    bn_to_bytes(&signature[0], r);
+    bn_to_bytes(&signature[P256_FIELD_SIZE], s);
+    return P256_SUCCESS;
+}
+
+// comb tables of pinned public keys, see sw_p256_comb_pin().  Shared by all threads, read only.
+static const sw_p256_comb* const* p256_comb_pinned;
+static int p256_comb_pinned_count;
+
+#if P256_COMB_CACHE_SIZE > 0
+// comb tables built at run time, the least recently used one is replaced.  Each thread has its own.
+static P256_THREAD_LOCAL sw_p256_comb p256_comb_cache[P256_COMB_CACHE_SIZE];
+static P256_THREAD_LOCAL uint32_t p256_comb_cache_used[P256_COMB_CACHE_SIZE];    // use stamps, 0 for an empty entry
+static P256_THREAD_LOCAL uint32_t p256_comb_cache_clock;
+
+// public keys that recently missed the cache, by the first bytes of X.  A key gets a table on its second miss.
+#define P256_COMB_MISSED        (2 * P256_COMB_CACHE_SIZE)
+#define P256_COMB_MISSED_BYTES  (8)
+static P256_THREAD_LOCAL uint8_t p256_comb_missed[P256_COMB_MISSED][P256_COMB_MISSED_BYTES];
+static P256_THREAD_LOCAL int p256_comb_missed_next;
+#endif
+
+/**
+* \brief Builds the fixed-base comb table of a public key, which makes verifying signatures under that key
+*        several times faster.  The table can be pinned with sw_p256_comb_pin(), or generated at build time
+*        with tools/p256_comb_gen.
+*
+* \param[in]  public_key  Public key X || Y, big endian
+* \param[out] comb        Receives the table
+* \return P256_SUCCESS, or P256_INVALID if the public key isn't a point on the curve
+*/
+int sw_p256_comb_build(const uint8_t public_key[P256_PUBLIC_KEY_SIZE], sw_p256_comb* comb)
+{
+    sw_p256_point base[P256_COMB_TEETH], t;
+    p256_limb z[P256_COMB_POINTS][P256_LIMBS];
+    p256_limb prefix[P256_COMB_POINTS][P256_LIMBS];
+    p256_limb* inv[P256_COMB_POINTS];
+    p256_limb zz[P256_LIMBS];
+    int i, j;
+
+    if (point_from_public_key(&base[0], public_key) != P256_SUCCESS)
+        return P256_INVALID;
+
+    // base[j] = 2^(j * P256_COMB_SPACING) * P
+    for (j = 1; j < P256_COMB_TEETH; j++)
+    {
+        base[j] = base[j - 1];
+        for (i = 0; i < P256_COMB_SPACING; i++)
+            point_double(&base[j], &base[j]);
+    }
+
+    // entry i is the entry of i without its lowest bit j, plus base[j].  Z is kept aside until the end.
+    for (i = 1; i <= P256_COMB_POINTS; i++)
+    {
+        for (j = 0; !(i & (1 << j)); j++)
+            ;
+        if (i == (1 << j))
+            t = base[j];
+        else
+        {
+            memcpy(t.x, comb->points[(i & (i - 1)) - 1].x, P256_FIELD_SIZE);
+            memcpy(t.y, comb->points[(i & (i - 1)) - 1].y, P256_FIELD_SIZE);
+            memcpy(t.z, z[(i & (i - 1)) - 1], P256_FIELD_SIZE);
+            point_add(&t, &t, &base[j]);
+        }
+        if (point_is_infinity(&t))
+            return P256_INVALID;
+
+        memcpy(comb->points[i - 1].x, t.x, P256_FIELD_SIZE);
+        memcpy(comb->points[i - 1].y, t.y, P256_FIELD_SIZE);
+        memcpy(z[i - 1], t.z, P256_FIELD_SIZE);
+    }
+
+    // to affine coordinates, with a single inversion
+    for (i = 0; i < P256_COMB_POINTS; i++)
+        inv[i] = z[i];
+    fe_inv_batch(inv, prefix, P256_COMB_POINTS);
+    for (i = 0; i < P256_COMB_POINTS; i++)
+    {
+        fe_sqr(zz, z[i]);
+        fe_mul(comb->points[i].x, comb->points[i].x, zz);
+        fe_mul(zz, zz, z[i]);
+        fe_mul(comb->points[i].y, comb->points[i].y, zz);
+    }
+
+    memcpy(comb->public_key, public_key, P256_PUBLIC_KEY_SIZE);
+    return P256_SUCCESS;
+}
+
+/**
+* \brief Pins comb tables, typically generated at build time and kept in flash.  Verifies against their
+*        public keys use them from then on.  The tables aren't copied, they have to stay in place.
+*        All threads share the pinned tables, pin them before verifies start on other threads.
+*
+* \param[in] combs  Tables, replacing any pinned before.  NULL to unpin all.
+* \param[in] count  Number of tables
+*/
+void sw_p256_comb_pin(const sw_p256_comb* const combs[], int count)
+{
+    p256_comb_pinned = combs;
+    p256_comb_pinned_count = combs ? count : 0;
+}
+
+/**
+* \brief Finds the comb table of a public key, pinned or cached.
+* \return the table, NULL if there is none
+*/
+static const sw_p256_comb* comb_find(const uint8_t public_key[P256_PUBLIC_KEY_SIZE])
+{
+    int i;
+
+    for (i = 0; i < p256_comb_pinned_count; i++)
+    {
+        if (memcmp(p256_comb_pinned[i]->public_key, public_key, P256_PUBLIC_KEY_SIZE) == 0)
+            return p256_comb_pinned[i];
+    }
+#if P256_COMB_CACHE_SIZE > 0
+    for (i = 0; i < P256_COMB_CACHE_SIZE; i++)
+    {
+        if (p256_comb_cache_used[i] && memcmp(p256_comb_cache[i].public_key, public_key, P256_PUBLIC_KEY_SIZE) == 0)
+        {
+            p256_comb_cache_used[i] = ++p256_comb_cache_clock;
+            return &p256_comb_cache[i];
+        }
+    }
+#endif
+    return NULL;
+}
+
+/**
+* \brief Builds the comb table of a public key into the cache of run time tables, replacing the least
+*        recently used one.  Verifies against keys without a table do this on their own on the second
+*        verify against the same key.  On Linux each thread has its own cache, this adds to the caller's.
+*
+* \param[in] public_key  Public key X || Y, big endian
+* \return P256_SUCCESS, or P256_INVALID for a public key that isn't a point on the curve or without a cache
+*/
+int sw_p256_comb_cache_add(const uint8_t public_key[P256_PUBLIC_KEY_SIZE])
+{
+#if P256_COMB_CACHE_SIZE > 0
+    int i, victim = 0;
+
+    if (comb_find(public_key) != NULL)
+        return P256_SUCCESS;
+
+    for (i = 1; i < P256_COMB_CACHE_SIZE; i++)
+    {
+        if (p256_comb_cache_used[i] < p256_comb_cache_used[victim])
+            victim = i;
+    }
+
+    p256_comb_cache_used[victim] = 0;
+    if (sw_p256_comb_build(public_key, &p256_comb_cache[victim]) != P256_SUCCESS)
+        return P256_INVALID;
+    p256_comb_cache_used[victim] = ++p256_comb_cache_clock;
+    return P256_SUCCESS;
+#else
+    (void)public_key;
+    return P256_INVALID;
+#endif
+}
+
+/**
+* \brief Empties the calling thread's cache of run time comb tables.
+*/
+void sw_p256_comb_cache_clear(void)
+{
+#if P256_COMB_CACHE_SIZE > 0
+    memset(p256_comb_cache_used, 0, sizeof(p256_comb_cache_used));
+    memset(p256_comb_missed, 0, sizeof(p256_comb_missed));
+#endif
+}
+
+/**
+* \brief Notes a verify against a public key without a comb table, and builds it one the second time.
+*/
+static void comb_missed(const uint8_t public_key[P256_PUBLIC_KEY_SIZE])
+{
+#if P256_COMB_CACHE_SIZE > 0
+    int i;
+
+    for (i = 0; i < P256_COMB_MISSED; i++)
+    {
+        if (memcmp(p256_comb_missed[i], public_key, P256_COMB_MISSED_BYTES) == 0)
+        {
+            memset(p256_comb_missed[i], 0, P256_COMB_MISSED_BYTES);
+            sw_p256_comb_cache_add(public_key);
+            return;
+        }
+    }
+    memcpy(p256_comb_missed[p256_comb_missed_next], public_key, P256_COMB_MISSED_BYTES);
+    p256_comb_missed_next = (p256_comb_missed_next + 1) % P256_COMB_MISSED;
+#else
+    (void)public_key;
+#endif
+}
+
+/** \brief a signature of a batch being verified */
+typedef struct {
+    int            valid;           //!< still a candidate, parsed fine so far
+    int            missed;          //!< first signature of a public key without a comb table
+    p256_limb      r[P256_LIMBS];
+    p256_limb      w[P256_LIMBS];   //!< s, then s^-1, in Montgomery form
+    const sw_p256_comb* comb;       //!< comb table of the public key Q, if it has one
+    sw_p256_point  own[12];         //!< otherwise own[i + 4 * (j - 1)] = i * G + j * Q for j > 0, see verify_batch()
+    sw_p256_point* table;           //!< own, or the table of an earlier signature with the same public key
+} p256_verify_item;
+
+/** \brief points a batch of count signatures brings to affine coordinates: 0, G, 2 G and 3 G once, and
+ *  the 12 sums with a multiple of Q per public key
+ */
+#define P256_VERIFY_POINTS(count)   (3 + 12 * (count))
+
+/**
+* \brief Verifies up to P256_VERIFY_BATCH signatures.  Each signature is checked by computing
+*        u1 * G + u2 * Q with Shamir's trick over a joint window of two bits: the 15 sums i * G + j * Q,
+*        i and j in 0..3, are tabulated, then every two doublings are followed by at most one addition of
+*        the sum the next two bits of u1 and u2 select.  The sums without Q, the multiples of G, are
+*        computed once for the whole batch, the 12 others per public key.  Work is shared across the batch
+*        where it needs an inversion: the s values are inverted together modulo n, and all the tables are
+*        brought to affine coordinates together, which makes the additions mixed additions.  Each takes one
+*        inversion, however many signatures there are.  Signatures under the same public key share one
+*        table.  Public keys with a comb table, pinned or cached, instead go with the comb of G through
+*        P256_COMB_SPACING doublings, each followed by up to two mixed additions.
+*
+*        The caller provides the frame, sized for count signatures, so that a single verify doesn't carry
+*        the stack of a whole batch: items holds count entries, inv, points and prefix
+*        P256_VERIFY_POINTS(count).
+*/
+static int verify_batch(const uint8_t* const public_keys[], const uint8_t* const digests[],
+                        const uint8_t* const signatures[], int results[], int count,
+                        p256_verify_item items[], p256_limb* inv[], sw_p256_point* points[],
+                        p256_limb (*prefix)[P256_LIMBS])
+{
+    p256_limb e[P256_LIMBS], u1[P256_LIMBS], u2[P256_LIMBS], zz[P256_LIMBS];
+    const p256_modulus* n = &p256_n;
+    sw_p256_point g[4], acc;
+    const sw_p256_point* sum;
+    p256_verify_item* item;
+    int i, j, k, inv_count, all = P256_SUCCESS;
+    unsigned idx;
+
+    // parse, w = s in Montgomery form
+    inv_count = 0;
+    for (k = 0; k < count; k++)
+    {
+        item = &items[k];
+        item->missed = 0;
+        item->table = item->own;
+        if ((item->comb = comb_find(public_keys[k])) != NULL)
+            item->table = NULL;
+        for (j = 0; j < k && item->table; j++)
+        {
+            if (items[j].valid && items[j].table == items[j].own && memcmp(public_keys[j], public_keys[k], P256_PUBLIC_KEY_SIZE) == 0)
+                item->table = items[j].own;
+        }
+
+        item->valid = scalar_from_bytes(item->r, &signatures[k][0]) == P256_SUCCESS
+                      && scalar_from_bytes(item->w, &signatures[k][P256_FIELD_SIZE]) == P256_SUCCESS
+                      && (item->table != item->own || point_from_public_key(&item->own[0], public_keys[k]) == P256_SUCCESS);
+        if (item->valid && item->table == item->own)
+            item->missed = 1;
+        if (!item->valid)
+            continue;
+        mod_to_mont(item->w, item->w, n);
+        inv[inv_count++] = item->w;
+    }
+
+    // w = s^-1 for all of them
+    mod_inv_batch(inv, prefix, inv_count, n);
+
+    // multiples of G, shared by the batch, then the tables in Jacobian coordinates
+    inv_count = 0;
+    for (k = 0; k < count; k++)
+    {
+        sw_p256_point* table = items[k].own;
+
+        if (!items[k].valid || items[k].table != table)
+            continue;
+
+        if (inv_count == 0)
+        {
+            point_set_infinity(&g[0]);
+            point_base(&g[1]);
+            point_double(&g[2], &g[1]);
+            point_add(&g[3], &g[2], &g[1]);
+            for (i = 2; i < 4; i++)
+            {
+                points[inv_count] = &g[i];
+                inv[inv_count++] = g[i].z;
+            }
+        }
+        point_double(&table[4], &table[0]);
+        point_add(&table[8], &table[4], &table[0]);
+        for (j = 0; j < 12; j += 4)
+        {
+            for (i = 1; i < 4; i++)
+                point_add(&table[i + j], &table[j], &g[i]);
+        }
+
+        for (i = 0; i < 12; i++)
+        {
+            if (!point_is_infinity(&table[i]) && bn_cmp(table[i].z, p256_one) != 0)
+            {
+                points[inv_count] = &table[i];
+                inv[inv_count++] = table[i].z;
+            }
+        }
+    }
+
+    // Z^-1 for all the table points, then (X, Y) = (X * Z^-2, Y * Z^-3)
+    fe_inv_batch(inv, prefix, inv_count);
+    for (i = 0; i < inv_count; i++)
+    {
+        sw_p256_point* point = points[i];
+
+        fe_sqr(zz, point->z);
+        fe_mul(point->x, point->x, zz);
+        fe_mul(zz, zz, point->z);
+        fe_mul(point->y, point->y, zz);
+        memcpy(point->z, p256_one, P256_FIELD_SIZE);
+    }
+
+    for (k = 0; k < count; k++)
+    {
+        item = &items[k];
+        results[k] = P256_INVALID;
+        if (!item->valid)
+        {
+            all = P256_INVALID;
+            continue;
+        }
+
+        // u1 = e * w, u2 = r * w
+        bn_from_bytes(e, digests[k]);
+        mod_reduce_once(e, e, n->m);
+        mod_mul(u1, e, item->w, n);     // Montgomery factors of w and of the plain operand cancel
+        mod_mul(u2, item->r, item->w, n);
+
+        // X = u1 * G + u2 * Q
+        point_set_infinity(&acc);
+        if (item->comb)
+        {
+            for (i = P256_COMB_SPACING - 1; i >= 0; i--)
+            {
+                point_double(&acc, &acc);
+                if ((idx = comb_index(u1, i)) != 0)
+                    point_add_affine(&acc, &acc, p256_comb_g.points[idx - 1].x, p256_comb_g.points[idx - 1].y);
+                if ((idx = comb_index(u2, i)) != 0)
+                    point_add_affine(&acc, &acc, item->comb->points[idx - 1].x, item->comb->points[idx - 1].y);
+            }
+        }
+        else
+        {
+            for (i = 254; i >= 0; i -= 2)
+            {
+                point_double(&acc, &acc);
+                point_double(&acc, &acc);
+                idx = bn_bits2(u1, i) | (bn_bits2(u2, i) << 2);
+                sum = (idx < 4) ? &g[idx] : &item->table[idx - 4];
+                if (!point_is_infinity(sum))
+                    point_add_affine(&acc, &acc, sum->x, sum->y);
+            }
+        }
+
+        // x mod n == r, with x = X / Z^2 in [0, p), holds for x = r or x = r + n.  Both are checked as
+        // X == x * Z^2, which saves converting X to affine coordinates.
+        if (!point_is_infinity(&acc))
+        {
+            fe_sqr(zz, acc.z);
+            fe_mul(u1, item->r, zz);
+            if (bn_cmp(u1, acc.x) == 0)
+                results[k] = P256_SUCCESS;
+            else if (bn_add(e, item->r, n->m) == 0 && bn_cmp(e, p256_p) < 0)
+            {
+                fe_mul(u1, e, zz);
+                if (bn_cmp(u1, acc.x) == 0)
+                    results[k] = P256_SUCCESS;
+            }
+        }
+        if (results[k] != P256_SUCCESS)
+            all = P256_INVALID;
+    }
+
+    // only now that the batch is done with the cached tables may one of them be replaced
+    for (k = 0; k < count; k++)
+    {
+        if (items[k].missed)
+            comb_missed(public_keys[k]);
+    }
+
+    return all;
+}
+
+/**
+* \brief Verifies an ECDSA signature of a digest.
+*
+* \param[in] public_key  Public key X || Y, big endian
+* \param[in] digest      Message digest, big endian
+* \param[in] signature   R || S, big endian
+* \return P256_SUCCESS if the signature is valid, otherwise P256_INVALID
+*/
+int sw_p256_verify(const uint8_t public_key[P256_PUBLIC_KEY_SIZE], const uint8_t digest[P256_FIELD_SIZE],
+                   const uint8_t signature[P256_SIGNATURE_SIZE])
+{
+    p256_verify_item item;
+    p256_limb* inv[P256_VERIFY_POINTS(1)];
+    sw_p256_point* points[P256_VERIFY_POINTS(1)];
+    p256_limb prefix[P256_VERIFY_POINTS(1)][P256_LIMBS];
+    int result;
+
+    return verify_batch(&public_key, &digest, &signature, &result, 1, &item, inv, points, prefix);
+}
+
+/**
+* \brief Verifies a batch of ECDSA signatures, each against its own digest and public key, P256_VERIFY_BATCH
+*        at a time.  The batch shares its inversions and the multiples of G, and signatures under the same
+*        public key share their table, which leaves about 15 % less work per signature than verifying them
+*        one by one when the public keys differ.
+*
+* \param[in]  public_keys  Public keys X || Y, big endian
+* \param[in]  digests      Message digests, big endian
+* \param[in]  signatures   R || S, big endian
+* \param[out] results      P256_SUCCESS or P256_INVALID for each signature
+* \param[in]  count        Number of signatures
+* \return P256_SUCCESS if all signatures are valid, otherwise P256_INVALID
+*/
+int sw_p256_verify_batch(const uint8_t* const public_keys[], const uint8_t* const digests[],
+                         const uint8_t* const signatures[], int results[], int count)
+{
+    p256_verify_item items[P256_VERIFY_BATCH];
+    p256_limb* inv[P256_VERIFY_POINTS(P256_VERIFY_BATCH)];
+    sw_p256_point* points[P256_VERIFY_POINTS(P256_VERIFY_BATCH)];
+    p256_limb prefix[P256_VERIFY_POINTS(P256_VERIFY_BATCH)][P256_LIMBS];
+    int done, chunk, ret = P256_SUCCESS;
+
+    for (done = 0; done < count; done += chunk)
+    {
+        chunk = (count - done < P256_VERIFY_BATCH) ? count - done : P256_VERIFY_BATCH;
+        if (verify_batch(&public_keys[done], &digests[done], &signatures[done], &results[done], chunk,
+                         items, inv, points, prefix) != P256_SUCCESS)
+            ret = P256_INVALID;
+    }
+    return ret;
+}
+
+/**
+* \brief Calculates the ECDH shared secret, the X coordinate of private_key * public_key.
+*
+* \param[in]  private_key    Private key, big endian
+* \param[in]  public_key     Public key X || Y of the other party, big endian
+* \param[out] shared_secret  X coordinate of the shared point, big endian
+* \return P256_SUCCESS or P256_INVALID
+*/
+int sw_p256_ecdh(const uint8_t private_key[P256_FIELD_SIZE], const uint8_t public_key[P256_PUBLIC_KEY_SIZE],
+                 uint8_t shared_secret[P256_FIELD_SIZE])
+{
+    p256_limb d[P256_LIMBS], x[P256_LIMBS];
+    sw_p256_point q;
+
+    if (scalar_from_bytes(d, private_key) != P256_SUCCESS)
+        return P256_INVALID;
+    if (point_from_public_key(&q, public_key) != P256_SUCCESS)
+        return P256_INVALID;
+
+    point_mul(&q, d, &q);
+    if (point_to_affine(x, NULL, &q) != P256_SUCCESS)
+        return P256_INVALID;
+
+    bn_to_bytes(shared_secret, x);
+    return P256_SUCCESS;
+}
@@ -0,0 +1,168 @@
+/** \brief Software implementation of NIST P-256 elliptic curve arithmetic: key generation,
+ * ECDSA sign and verify and ECDH.
+ *
+ * Copyright (c) 2015 Atmel Corporation. All rights reserved.
+ *
+ * \asf_license_start
+ *
+ * \page License
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. The name of Atmel may not be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * 4. This software may only be redistributed and used in connection with an
+ *    Atmel microcontroller product.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ATMEL "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT ARE
+ * EXPRESSLY AND SPECIFICALLY DISCLAIMED. IN NO EVENT SHALL ATMEL BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * \asf_license_stop
+ */
+
+#ifndef P256_ROUTINES_H
+#define P256_ROUTINES_H
+
+#include <stdint.h>
+
+#define P256_FIELD_SIZE     (32)    //!< size of a field element, private key or signature component
+#define P256_PUBLIC_KEY_SIZE (64)   //!< X || Y
+#define P256_SIGNATURE_SIZE (64)    //!< R || S
+
+/* Numbers are kept as little endian arrays of limbs.  Hosts with a 128-bit integer type use 64-bit limbs,
+ * 32-bit targets such as the Cortex-M4 use 32-bit limbs, whose 32x32->64 multiply accumulates in one
+ * instruction.  Define P256_LIMB_BITS as 32 or 64 to override the choice.
+ */
+#ifndef P256_LIMB_BITS
+#if defined(__SIZEOF_INT128__)
+#define P256_LIMB_BITS      (64)
+#else
+#define P256_LIMB_BITS      (32)
+#endif
+#endif
+
+#if P256_LIMB_BITS == 64
+typedef uint64_t p256_limb;
+#define P256_LIMB_INIT(lo, hi)  (((uint64_t)(hi) << 32) | (lo))     //!< initializer of the limbs of two 32-bit words
+#else
+typedef uint32_t p256_limb;
+#define P256_LIMB_INIT(lo, hi)  (lo), (hi)
+#endif
+#define P256_LIMBS          (256 / P256_LIMB_BITS)  //!< limbs in a field element
+
+/* sw_p256_verify_batch() keeps its whole batch on the stack, about 1.8 kB a signature, which hosts can
+ * afford more easily than the few kB of stack of a microcontroller.  sw_p256_verify() takes one signature's
+ * worth whatever the batch size.
+ */
+#ifndef P256_VERIFY_BATCH
+#if defined(__linux__)
+#define P256_VERIFY_BATCH   (8)     //!< signatures sw_p256_verify_batch() verifies together
+#else
+#define P256_VERIFY_BATCH   (2)
+#endif
+#endif
+
+/* Fixed-base comb tables, see sw_p256_comb_build().  A table takes 4 kB, and cuts a verify against its
+ * public key to 43 doublings.
+ */
+#define P256_COMB_TEETH     (6)     //!< bits of a scalar one comb lookup covers
+#define P256_COMB_SPACING   ((256 + P256_COMB_TEETH - 1) / P256_COMB_TEETH)    //!< 43, distance between the bits
+#define P256_COMB_POINTS    ((1 << P256_COMB_TEETH) - 1)
+
+/* Tables built at run time for frequent public keys are cached per thread where there is thread local
+ * storage (Linux), so concurrent verifies never share a cache.  Elsewhere a cache would be shared without
+ * a lock, so it is off unless P256_COMB_CACHE_SIZE is defined, which is only safe with a single thread
+ * doing software verifies.
+ */
+#if defined(__linux__)
+#define P256_THREAD_LOCAL   __thread
+#ifndef P256_COMB_CACHE_SIZE
+#define P256_COMB_CACHE_SIZE (4)    //!< run time tables per thread, 0 for none
+#endif
+#else
+#define P256_THREAD_LOCAL
+#ifndef P256_COMB_CACHE_SIZE
+#define P256_COMB_CACHE_SIZE (0)
+#endif
+#endif
+
+#define P256_SUCCESS        (0)     //!< operation succeeded, signature is valid
+#define P256_INVALID        (1)     //!< invalid key or signature, signature doesn't verify
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** \brief point on the curve in Jacobian coordinates (X/Z^2, Y/Z^3), coordinates fully reduced modulo p.
+ *  Z of zero is the point at infinity.
+ */
+typedef struct {
+    p256_limb x[P256_LIMBS];
+    p256_limb y[P256_LIMBS];
+    p256_limb z[P256_LIMBS];
+} sw_p256_point;
+
+/** \brief point on the curve in affine coordinates */
+typedef struct {
+    p256_limb x[P256_LIMBS];
+    p256_limb y[P256_LIMBS];
+} sw_p256_affine;
+
+/** \brief fixed-base comb table of a public key P.  points[i - 1] is the sum of 2^(j * P256_COMB_SPACING) * P
+ *  over the bits j set in i.  Tables for pinned keys can be generated at build time with
+ *  tools/p256_comb_gen and kept in flash.
+ */
+typedef struct {
+    uint8_t        public_key[P256_PUBLIC_KEY_SIZE];    //!< P as X || Y, big endian
+    sw_p256_affine points[P256_COMB_POINTS];
+} sw_p256_comb;
+
+int sw_p256_check_private_key(const uint8_t private_key[P256_FIELD_SIZE]);
+
+int sw_p256_check_public_key(const uint8_t public_key[P256_PUBLIC_KEY_SIZE]);
+
+int sw_p256_public_key(const uint8_t private_key[P256_FIELD_SIZE], uint8_t public_key[P256_PUBLIC_KEY_SIZE]);
+
+int sw_p256_sign(const uint8_t private_key[P256_FIELD_SIZE], const uint8_t digest[P256_FIELD_SIZE],
+                 const uint8_t k[P256_FIELD_SIZE], uint8_t signature[P256_SIGNATURE_SIZE]);
+
+int sw_p256_verify(const uint8_t public_key[P256_PUBLIC_KEY_SIZE], const uint8_t digest[P256_FIELD_SIZE],
+                   const uint8_t signature[P256_SIGNATURE_SIZE]);
+
+int sw_p256_verify_batch(const uint8_t* const public_keys[], const uint8_t* const digests[],
+                         const uint8_t* const signatures[], int results[], int count);
+
+int sw_p256_comb_build(const uint8_t public_key[P256_PUBLIC_KEY_SIZE], sw_p256_comb* comb);
+
+void sw_p256_comb_pin(const sw_p256_comb* const combs[], int count);
+
+int sw_p256_comb_cache_add(const uint8_t public_key[P256_PUBLIC_KEY_SIZE]);
+
+void sw_p256_comb_cache_clear(void);
+
+int sw_p256_ecdh(const uint8_t private_key[P256_FIELD_SIZE], const uint8_t public_key[P256_PUBLIC_KEY_SIZE],
+                 uint8_t shared_secret[P256_FIELD_SIZE]);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // P256_ROUTINES_H
@@ -50,6 +50,8 @@
 #include "atca_cfgs.h"
 #include "basic/atca_basic.h"
 #include "basic/atca_helpers.h"
+#include "basic/atca_pool.h"
+#include "basic/atca_bus.h"
 
 #define BREAK(status, message) break
 #define DBGOUT(message) break
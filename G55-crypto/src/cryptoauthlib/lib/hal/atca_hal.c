@@ -70,6 +70,7 @@ ATCA_STATUS hal_iface_init( ATCAIfaceCfg *cfg, ATCAHAL_t *hal )
 		hal->halsleep = &hal_i2c_sleep;
 		hal->halwake = &hal_i2c_wake;
 		hal->halidle = &hal_i2c_idle;
+		hal->halresync = &hal_i2c_resync;
 		hal->halrelease = &hal_i2c_release;
 		hal->hal_data = NULL;
 
@@ -85,6 +86,7 @@ ATCA_STATUS hal_iface_init( ATCAIfaceCfg *cfg, ATCAHAL_t *hal )
 		hal->halsleep = &hal_swi_sleep;
 		hal->halwake = &hal_swi_wake;
 		hal->halidle = &hal_swi_idle;
+		hal->halresync = NULL;
 		hal->halrelease = &hal_swi_release;
 		hal->hal_data = NULL;
 
@@ -103,6 +105,7 @@ ATCA_STATUS hal_iface_init( ATCAIfaceCfg *cfg, ATCAHAL_t *hal )
 		hal->halsleep = &hal_kit_cdc_sleep;
 		hal->halwake = &hal_kit_cdc_wake;
 		hal->halidle = &hal_kit_cdc_idle;
+		hal->halresync = NULL;
 		hal->halrelease = &hal_kit_cdc_release;
 		hal->hal_data = NULL;
 
@@ -123,9 +126,42 @@ ATCA_STATUS hal_iface_init( ATCAIfaceCfg *cfg, ATCAHAL_t *hal )
 		hal->halsleep = &hal_kit_hid_sleep;
 		hal->halwake = &hal_kit_hid_wake;
 		hal->halidle = &hal_kit_hid_idle;
+		hal->halresync = NULL;
 		hal->halrelease = &hal_kit_hid_release;
 		hal->hal_data = NULL;
 
+		status = ATCA_SUCCESS;
+		#endif
+		break;
+	case ATCA_SOCKET_IFACE:
+		#ifdef ATCA_HAL_SOCKET
+		hal->halinit = &hal_socket_init;
+		hal->halpostinit = &hal_socket_post_init;
+		hal->halreceive = &hal_socket_receive;
+		hal->halsend = &hal_socket_send;
+		hal->halsleep = &hal_socket_sleep;
+		hal->halwake = &hal_socket_wake;
+		hal->halidle = &hal_socket_idle;
+		hal->halresync = NULL;
+		hal->halrelease = &hal_socket_release;
+		hal->hal_data = NULL;
+
+		status = ATCA_SUCCESS;
+		#endif
+		break;
+	case ATCA_EMU_IFACE:
+		#ifdef ATCA_HAL_EMU
+		hal->halinit = &hal_emu_init;
+		hal->halpostinit = &hal_emu_post_init;
+		hal->halreceive = &hal_emu_receive;
+		hal->halsend = &hal_emu_send;
+		hal->halsleep = &hal_emu_sleep;
+		hal->halwake = &hal_emu_wake;
+		hal->halidle = &hal_emu_idle;
+		hal->halresync = &hal_emu_resync;
+		hal->halrelease = &hal_emu_release;
+		hal->hal_data = NULL;
+
 		status = ATCA_SUCCESS;
 		#endif
 		break;
@@ -171,6 +207,16 @@ ATCA_STATUS hal_iface_release( ATCAIfaceType ifacetype, void *hal_data )
 				status = hal_kit_hid_release(hal_data);
 			#endif
 			break;
+		case ATCA_SOCKET_IFACE:
+			#ifdef ATCA_HAL_SOCKET
+				status = hal_socket_release(hal_data);
+			#endif
+			break;
+		case ATCA_EMU_IFACE:
+			#ifdef ATCA_HAL_EMU
+				status = hal_emu_release(hal_data);
+			#endif
+			break;
 	}	
 
 	return status;	
@@ -67,6 +67,7 @@ typedef struct {
 		ATCA_STATUS (*halwake)(ATCAIface iface);
 		ATCA_STATUS (*halidle)(ATCAIface iface);
 		ATCA_STATUS (*halsleep)(ATCAIface iface);
+		ATCA_STATUS (*halresync)(ATCAIface iface);	// optional, NULL where the response can't be read again
 		ATCA_STATUS (*halrelease)(void* hal_data);
 		
 		void *hal_data;   // points to whatever the HAL implementation for this interface wants it to, HAL manages.
@@ -91,6 +92,11 @@ extern ATCA_STATUS hal_iface_release(ATCAIfaceType, void* hal_data);
 //#define ATCA_HAL_UART
 //#define ATCA_HAL_KIT_HID
 //#define ATCA_HAL_KIT_CDC
+//#define ATCA_HAL_SOCKET
+//#define ATCA_HAL_EMU
+
+// Optionally add ATCA_I2C_PDC to move I2C transfers to the PDC and TWI interrupts instead of polling each byte
+//#define ATCA_I2C_PDC
 
 // forward declare known physical layer APIs that must be implemented by the HAL layer (./hal/xyz) for this interface type
 
@@ -102,6 +108,7 @@ ATCA_STATUS hal_i2c_receive( ATCAIface iface, uint8_t *rxdata, uint16_t *rxlengt
 ATCA_STATUS hal_i2c_wake(ATCAIface iface);
 ATCA_STATUS hal_i2c_idle(ATCAIface iface);
 ATCA_STATUS hal_i2c_sleep(ATCAIface iface);
+ATCA_STATUS hal_i2c_resync(ATCAIface iface);
 ATCA_STATUS hal_i2c_release(void *hal_data );
 #endif
 
@@ -160,10 +167,34 @@ ATCA_STATUS hal_kit_hid_sleep(ATCAIface iface);
 ATCA_STATUS hal_kit_hid_release(void *hal_data);
 #endif
 
+#ifdef ATCA_HAL_SOCKET
+ATCA_STATUS hal_socket_init(void *hal, ATCAIfaceCfg *cfg);
+ATCA_STATUS hal_socket_post_init(ATCAIface iface);
+ATCA_STATUS hal_socket_send(ATCAIface iface, uint8_t *txdata, int txlength);
+ATCA_STATUS hal_socket_receive(ATCAIface iface, uint8_t *rxdata, uint16_t *rxlength);
+ATCA_STATUS hal_socket_wake(ATCAIface iface);
+ATCA_STATUS hal_socket_idle(ATCAIface iface);
+ATCA_STATUS hal_socket_sleep(ATCAIface iface);
+ATCA_STATUS hal_socket_release(void *hal_data);
+#endif
+
+#ifdef ATCA_HAL_EMU
+ATCA_STATUS hal_emu_init(void *hal, ATCAIfaceCfg *cfg);
+ATCA_STATUS hal_emu_post_init(ATCAIface iface);
+ATCA_STATUS hal_emu_send(ATCAIface iface, uint8_t *txdata, int txlength);
+ATCA_STATUS hal_emu_receive(ATCAIface iface, uint8_t *rxdata, uint16_t *rxlength);
+ATCA_STATUS hal_emu_wake(ATCAIface iface);
+ATCA_STATUS hal_emu_idle(ATCAIface iface);
+ATCA_STATUS hal_emu_sleep(ATCAIface iface);
+ATCA_STATUS hal_emu_resync(ATCAIface iface);
+ATCA_STATUS hal_emu_release(void *hal_data);
+#endif
+
 /** \brief Timer API implemented at the HAL level */
 void atca_delay_us(uint32_t delay);
 void atca_delay_10us(uint32_t delay);
 void atca_delay_ms(uint32_t delay);
+uint32_t atca_ticks_ms(void);
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,1310 @@
+/** \brief ATCA Hardware abstraction layer for an ATECC508A emulated in-process.  Runs the x08a command
+* set against an emulated device so atcab_* code can be exercised and load tested without a chip.
+*
+* Copyright (c) 2015 Atmel Corporation. All rights reserved.
+*
+* \asf_license_start
+*
+* \page License
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*
+* 1. Redistributions of source code must retain the above copyright notice,
+*    this list of conditions and the following disclaimer.
+*
+* 2. Redistributions in binary form must reproduce the above copyright notice,
+*    this list of conditions and the following disclaimer in the documentation
+*    and/or other materials provided with the distribution.
+*
+* 3. The name of Atmel may not be used to endorse or promote products derived
+*    from this software without specific prior written permission.
+*
+* 4. This software may only be redistributed and used in connection with an
+*    Atmel microcontroller product.
+*
+* THIS SOFTWARE IS PROVIDED BY ATMEL "AS IS" AND ANY EXPRESS OR IMPLIED
+* WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT ARE
+* EXPRESSLY AND SPECIFICALLY DISCLAIMED. IN NO EVENT SHALL ATMEL BE LIABLE FOR
+* ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+* OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+* HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+* STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+* ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+* POSSIBILITY OF SUCH DAMAGE.
+*
+* \asf_license_stop
+ */ 
+
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include "atca_hal.h"
+#include "hal_emu_x08a.h"
+#include "crypto/ecc/p256_routines.h"
+
+/** \defgroup hal_ Crypto hardware abstraction layer (hal_)
+ *
+ * \brief
+ * These methods define the hardware abstraction layer for communicating with an ATECC508A
+ * emulated in-process.
+ *
+ * The emulated device parses the command packets sent to it and executes them against its config,
+ * OTP and data zones with the lock and slot config rules of the datasheet: what can be read or written
+ * in the clear, encrypted or not at all, which slots hold private keys and what they may be used for.
+ * It stays busy for the execution time of each command from exectimes_x08a, as the real device, scaled,
+ * or not at all (ATCAEmuTiming), and NACKs while busy, asleep or when the watchdog has put it to sleep.
+ *
+ * Not emulated: internal Sign, GenKey digest modes, the Verify validate modes, CheckMac copy,
+ * and the DeriveKey, HMAC, Counter, Pause and UpdateExtra commands, which answer with a parse error.
+ *
+@{ */
+
+// config zone layout
+#define EMU_SLOT_CONFIG			(20)	// SlotConfig[16], two bytes each
+#define EMU_USER_EXTRA			(84)
+#define EMU_LOCK_VALUE			(86)	// data and OTP zones
+#define EMU_LOCK_CONFIG			(87)
+#define EMU_SLOT_LOCKED			(88)	// one bit per slot, 0 once locked
+#define EMU_KEY_CONFIG			(96)	// KeyConfig[16], two bytes each
+#define EMU_OTP_MODE			(18)
+#define EMU_UNLOCKED			(0x55)
+
+// SlotConfig bits
+#define EMU_SC_READKEY(sc)		((sc) & 0x000F)
+#define EMU_SC_EXT_SIGN			(0x0001)	// private keys: ReadKey bit 0, external messages may be signed
+#define EMU_SC_ECDH				(0x0004)	// private keys: ReadKey bit 2, ECDH permitted
+#define EMU_SC_ECDH_TO_SLOT		(0x0008)	// private keys: ReadKey bit 3, ECDH result goes to slot N+1
+#define EMU_SC_CHECK_ONLY		(0x0010)
+#define EMU_SC_ENCRYPT_READ		(0x0040)
+#define EMU_SC_IS_SECRET		(0x0080)
+#define EMU_SC_WRITEKEY(sc)		(((sc) >> 8) & 0x000F)
+#define EMU_SC_WRITECONFIG(sc)	(((sc) >> 12) & 0x000F)
+#define EMU_WC_GENKEY			(0x2)		// WriteConfig bit 1, GenKey may write the slot after data lock
+#define EMU_WC_ENCRYPT			(0x4)		// WriteConfig bit 2, writes must be encrypted
+
+// KeyConfig bits
+#define EMU_KC_PRIVATE			(0x0001)
+#define EMU_KC_PUB_INFO			(0x0002)
+#define EMU_KC_KEY_TYPE(kc)		(((kc) >> 2) & 0x0007)
+#define EMU_KC_LOCKABLE			(0x0020)
+
+#define EMU_PRIV_KEY_PAD		(4)			// private keys are stored as 4 pad bytes and the 32 byte key
+#define EMU_SIGN_ATTEMPTS		(8)			// random k that yields r or s of zero is drawn again
+
+/** \brief the factory config zone of the emulated device.  SN[2:3] and SN[4:7] are filled in from the seed */
+static const uint8_t emu_factory_config[ATCA_CONFIG_SIZE] = {
+	0x01, 0x23, 0x00, 0x00, 0x00, 0x00, 0x50, 0x00,  0x00, 0x00, 0x00, 0x00, 0xEE, 0x00, 0x01, 0x00,
+	0xC0, 0x00, 0x55, 0x00, 0x8F, 0x20, 0xC4, 0x44,  0x87, 0x20, 0xC4, 0x44, 0x8F, 0x0F, 0x8F, 0x8F,
+	0x9F, 0x8F, 0x83, 0x64, 0xC4, 0x44, 0xC4, 0x44,  0x0F, 0x0F, 0x0F, 0x0F, 0x0F, 0x0F, 0x0F, 0x0F,
+	0x0F, 0x0F, 0x0F, 0x0F, 0xFF, 0xFF, 0xFF, 0xFF,  0x00, 0x00, 0x00, 0x00, 0xFF, 0xFF, 0xFF, 0xFF,
+	0x00, 0x00, 0x00, 0x00, 0xFF, 0xFF, 0xFF, 0xFF,  0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0x00, 0x00, 0x55, 0x55,  0xFF, 0xFF, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x33, 0x00, 0x1C, 0x00, 0x13, 0x00, 0x1C, 0x00,  0x3C, 0x00, 0x1C, 0x00, 0x1C, 0x00, 0x33, 0x00,
+	0x1C, 0x00, 0x1C, 0x00, 0x3C, 0x00, 0x3C, 0x00,  0x3C, 0x00, 0x3C, 0x00, 0x3C, 0x00, 0x3C, 0x00 };
+
+/** \brief status byte answers, see isATCAError() */
+#define EMU_STATUS_OK			(0x00)
+#define EMU_STATUS_MISCOMPARE	(0x01)
+
+/** \brief current time of the monotonic clock in microseconds */
+static uint64_t emu_now_us(void)
+{
+	struct timespec ts;
+	
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t)ts.tv_sec * 1000000 + (uint64_t)ts.tv_nsec / 1000;
+}
+
+/** \brief scale a real device time by the timing model of the emulated device
+ * \param[in] dev - emulated device
+ * \param[in] us - time the real device takes
+ * \return time the emulated device takes
+ */
+static uint64_t emu_scale_us(ATCAEmuDevice_t *dev, uint64_t us)
+{
+	switch (dev->timing)
+	{
+	case ATCA_EMU_TIMING_REAL:
+		return us;
+	case ATCA_EMU_TIMING_SCALED:
+		return us * dev->time_scale / 100;
+	default:
+		return 0;
+	}
+}
+
+/** \brief next 32 random bytes of the emulated device */
+static void emu_random(ATCAEmuDevice_t *dev, uint8_t *out)
+{
+	uint8_t block[sizeof(dev->drbg_key) + 4];
+	
+	memcpy(block, dev->drbg_key, sizeof(dev->drbg_key));
+	block[32] = (uint8_t)(dev->drbg_counter);
+	block[33] = (uint8_t)(dev->drbg_counter >> 8);
+	block[34] = (uint8_t)(dev->drbg_counter >> 16);
+	block[35] = (uint8_t)(dev->drbg_counter >> 24);
+	dev->drbg_counter++;
+	
+	sw_sha256(block, sizeof(block), out);
+}
+
+static bool emu_config_locked(ATCAEmuDevice_t *dev)
+{
+	return dev->config[EMU_LOCK_CONFIG] != EMU_UNLOCKED;
+}
+
+static bool emu_data_locked(ATCAEmuDevice_t *dev)
+{
+	return dev->config[EMU_LOCK_VALUE] != EMU_UNLOCKED;
+}
+
+static uint16_t emu_slot_config(ATCAEmuDevice_t *dev, uint8_t slot)
+{
+	return dev->config[EMU_SLOT_CONFIG + 2 * slot] | (dev->config[EMU_SLOT_CONFIG + 2 * slot + 1] << 8);
+}
+
+static uint16_t emu_key_config(ATCAEmuDevice_t *dev, uint8_t slot)
+{
+	return dev->config[EMU_KEY_CONFIG + 2 * slot] | (dev->config[EMU_KEY_CONFIG + 2 * slot + 1] << 8);
+}
+
+static bool emu_slot_locked(ATCAEmuDevice_t *dev, uint8_t slot)
+{
+	uint16_t slot_locked = dev->config[EMU_SLOT_LOCKED] | (dev->config[EMU_SLOT_LOCKED + 1] << 8);
+	
+	return ((slot_locked >> slot) & 1) == 0;
+}
+
+/** \brief whether a slot is configured to hold a P256 private key */
+static bool emu_is_private_key(ATCAEmuDevice_t *dev, uint8_t slot)
+{
+	uint16_t key_config = emu_key_config(dev, slot);
+	
+	return (key_config & EMU_KC_PRIVATE) && EMU_KC_KEY_TYPE(key_config) == ATCA_P256_KEY_TYPE;
+}
+
+/** \brief size of a slot in bytes, slots 0-7 hold 36 bytes, slot 8 416 and slots 9-15 72 */
+static uint16_t emu_slot_size(uint8_t slot)
+{
+	if (slot < 8)
+		return 36;
+	if (slot == 8)
+		return ATCA_EMU_SLOT_STORAGE;
+	return 72;
+}
+
+/** \brief the 9 byte serial number */
+static void emu_serial_number(ATCAEmuDevice_t *dev, uint8_t *sn)
+{
+	memcpy(&sn[0], &dev->config[0], 4);
+	memcpy(&sn[4], &dev->config[8], 5);
+}
+
+/** \brief public key from the 72 byte layout of a public key slot, X and Y each behind 4 pad bytes */
+static void emu_stored_public_key(ATCAEmuDevice_t *dev, uint8_t slot, uint8_t *public_key)
+{
+	memcpy(&public_key[0], &dev->slots[slot][ATCA_PUB_KEY_PAD], 32);
+	memcpy(&public_key[32], &dev->slots[slot][2 * ATCA_PUB_KEY_PAD + 32], 32);
+}
+
+/** \brief clear the volatile state, as the device going to sleep does */
+static void emu_clear_volatile(ATCAEmuDevice_t *dev)
+{
+	memset(&dev->temp_key, 0, sizeof(dev->temp_key));
+	memset(&dev->sha, 0, sizeof(dev->sha));
+	dev->sha_started = false;
+}
+
+/** \brief put the device to sleep if the watchdog expired since it was woken */
+static void emu_check_watchdog(ATCAEmuDevice_t *dev, uint64_t now)
+{
+	if (dev->awake && dev->watchdog_us != 0 && now - dev->wake_us >= dev->watchdog_us)
+	{
+		dev->awake = false;
+		emu_clear_volatile(dev);
+	}
+}
+
+/** \brief load the output buffer with a response
+ * \param[in] dev - emulated device
+ * \param[in] data - response data
+ * \param[in] length - number of data bytes
+ */
+static void emu_respond(ATCAEmuDevice_t *dev, const uint8_t *data, uint8_t length)
+{
+	dev->response[0] = length + ATCA_PACKET_OVERHEAD;
+	memcpy(&dev->response[1], data, length);
+	atCRC(length + 1, dev->response, &dev->response[length + 1]);
+}
+
+/** \brief load the output buffer with a single status byte */
+static void emu_status(ATCAEmuDevice_t *dev, uint8_t status)
+{
+	emu_respond(dev, &status, 1);
+}
+
+/** \brief locate the bytes a Read or Write command addresses
+ * \param[in] dev - emulated device
+ * \param[in] zone - ATCA_ZONE_CONFIG, ATCA_ZONE_OTP or ATCA_ZONE_DATA
+ * \param[in] address - param2 of the command
+ * \param[in] length - 4 or 32
+ * \param[out] slot - slot addressed in the data zone
+ * \return the addressed bytes, NULL if the address is out of range
+ */
+static uint8_t *emu_locate(ATCAEmuDevice_t *dev, uint8_t zone, uint16_t address, uint8_t length, uint8_t *slot)
+{
+	uint16_t offset = (length == ATCA_BLOCK_SIZE) ? 0 : (address & 0x07) * ATCA_WORD_SIZE;
+	
+	switch (zone)
+	{
+	case ATCA_ZONE_CONFIG:
+		if (address & ~ATCA_ADDRESS_MASK_CONFIG)
+			return NULL;
+		offset += ((address >> 3) & 0x03) * ATCA_BLOCK_SIZE;
+		return &dev->config[offset];
+	
+	case ATCA_ZONE_OTP:
+		if (address & ~ATCA_ADDRESS_MASK_OTP)
+			return NULL;
+		offset += ((address >> 3) & 0x01) * ATCA_BLOCK_SIZE;
+		return &dev->otp[offset];
+	
+	case ATCA_ZONE_DATA:
+		*slot = (address >> 3) & 0x0F;
+		offset += (address >> 8) * ATCA_BLOCK_SIZE;
+		// a 32 byte access may run past the end of the slot into the rest of its last block
+		if (offset + (length == ATCA_BLOCK_SIZE ? 1 : length) > emu_slot_size(*slot) || offset + length > ATCA_EMU_SLOT_STORAGE)
+			return NULL;
+		return &dev->slots[*slot][offset];
+	}
+	
+	return NULL;
+}
+
+/** \brief Info command */
+static uint8_t emu_info(ATCAEmuDevice_t *dev, uint8_t mode, uint16_t param2)
+{
+	uint8_t out[INFO_SIZE] = { 0 };
+	
+	switch (mode)
+	{
+	case INFO_MODE_REVISION:
+		memcpy(out, &dev->config[4], INFO_SIZE);
+		break;
+	case INFO_MODE_KEY_VALID:
+		if (param2 > ATCA_KEY_ID_MAX)
+			return CMD_STATUS_BYTE_PARSE;
+		out[0] = emu_is_private_key(dev, (uint8_t)param2)
+		         && sw_p256_check_private_key(&dev->slots[param2][EMU_PRIV_KEY_PAD]) == P256_SUCCESS;
+		break;
+	case INFO_MODE_STATE:
+		out[0] = dev->temp_key.key_id | (dev->temp_key.source_flag << 4) | (dev->temp_key.gen_data << 5) | (dev->temp_key.valid << 7);
+		break;
+	case INFO_MODE_GPIO:
+		break;
+	default:
+		return CMD_STATUS_BYTE_PARSE;
+	}
+	
+	emu_respond(dev, out, sizeof(out));
+	return EMU_STATUS_OK;
+}
+
+/** \brief random numbers are a fixed pattern until the config zone is locked */
+static void emu_rand_out(ATCAEmuDevice_t *dev, uint8_t *out)
+{
+	int i;
+	
+	if (!emu_config_locked(dev))
+	{
+		for (i = 0; i < RANDOM_NUM_SIZE; i += 4)
+		{
+			out[i] = 0xFF;
+			out[i + 1] = 0xFF;
+			out[i + 2] = 0x00;
+			out[i + 3] = 0x00;
+		}
+		return;
+	}
+	emu_random(dev, out);
+}
+
+/** \brief Random command */
+static uint8_t emu_cmd_random(ATCAEmuDevice_t *dev, uint8_t mode)
+{
+	uint8_t out[RANDOM_NUM_SIZE];
+	
+	if (mode > RANDOM_NO_SEED_UPDATE)
+		return CMD_STATUS_BYTE_PARSE;
+	
+	emu_rand_out(dev, out);
+	emu_respond(dev, out, sizeof(out));
+	return EMU_STATUS_OK;
+}
+
+/** \brief Nonce command */
+static uint8_t emu_cmd_nonce(ATCAEmuDevice_t *dev, uint8_t mode, const uint8_t *data, uint8_t data_size)
+{
+	atca_nonce_in_out_t nonce;
+	uint8_t rand_out[RANDOM_NUM_SIZE];
+	
+	if ((mode & ~NONCE_MODE_MASK) || mode == NONCE_MODE_INVALID)
+		return CMD_STATUS_BYTE_PARSE;
+	
+	nonce.mode = mode;
+	nonce.num_in = (uint8_t *)data;
+	nonce.rand_out = rand_out;
+	nonce.temp_key = &dev->temp_key;
+	
+	if (mode == NONCE_MODE_PASSTHROUGH)
+	{
+		if (data_size != NONCE_NUMIN_SIZE_PASSTHROUGH)
+			return CMD_STATUS_BYTE_PARSE;
+		atcah_nonce(&nonce);
+		emu_status(dev, EMU_STATUS_OK);
+		return EMU_STATUS_OK;
+	}
+	
+	if (data_size != NONCE_NUMIN_SIZE)
+		return CMD_STATUS_BYTE_PARSE;
+	emu_rand_out(dev, rand_out);
+	atcah_nonce(&nonce);
+	emu_respond(dev, rand_out, sizeof(rand_out));
+	return EMU_STATUS_OK;
+}
+
+/** \brief GenDig command */
+static uint8_t emu_cmd_gendig(ATCAEmuDevice_t *dev, uint8_t zone, uint16_t key_id)
+{
+	atca_gen_dig_in_out_t gen_dig;
+	
+	gen_dig.zone = zone;
+	gen_dig.key_id = key_id;
+	gen_dig.temp_key = &dev->temp_key;
+	
+	switch (zone)
+	{
+	case GENDIG_ZONE_CONFIG:
+		if (key_id > 3)
+			return CMD_STATUS_BYTE_PARSE;
+		gen_dig.stored_value = &dev->config[key_id * ATCA_BLOCK_SIZE];
+		break;
+	case GENDIG_ZONE_OTP:
+		if (key_id > ATCA_OTP_BLOCK_MAX)
+			return CMD_STATUS_BYTE_PARSE;
+		gen_dig.stored_value = &dev->otp[key_id * ATCA_BLOCK_SIZE];
+		break;
+	case GENDIG_ZONE_DATA:
+		if (key_id > ATCA_KEY_ID_MAX)
+			return CMD_STATUS_BYTE_PARSE;
+		if (!emu_data_locked(dev) || emu_is_private_key(dev, (uint8_t)key_id))
+			return CMD_STATUS_BYTE_EXEC;
+		gen_dig.stored_value = dev->slots[key_id];
+		break;
+	default:
+		return CMD_STATUS_BYTE_PARSE;
+	}
+	
+	if (atcah_gen_dig(&gen_dig) != ATCA_SUCCESS)
+		return CMD_STATUS_BYTE_EXEC;
+	
+	emu_status(dev, EMU_STATUS_OK);
+	return EMU_STATUS_OK;
+}
+
+/** \brief TempKey holds a digest generated from the given slot, as encrypted reads and writes require */
+static bool emu_temp_key_from(ATCAEmuDevice_t *dev, uint8_t key_id)
+{
+	return dev->temp_key.valid && dev->temp_key.gen_data && dev->temp_key.key_id == key_id;
+}
+
+/** \brief Read command */
+static uint8_t emu_cmd_read(ATCAEmuDevice_t *dev, uint8_t param1, uint16_t address)
+{
+	uint8_t zone = param1 & ATCA_ZONE_MASK;
+	uint8_t length = (param1 & ATCA_ZONE_READWRITE_32) ? ATCA_BLOCK_SIZE : ATCA_WORD_SIZE;
+	uint8_t out[ATCA_BLOCK_SIZE];
+	uint8_t slot = 0;
+	uint16_t slot_config;
+	uint8_t *mem;
+	int i;
+	
+	if ((param1 & ~READ_ZONE_MASK) || zone == 0x03)
+		return CMD_STATUS_BYTE_PARSE;
+	if ((mem = emu_locate(dev, zone, address, length, &slot)) == NULL)
+		return CMD_STATUS_BYTE_PARSE;
+	
+	memcpy(out, mem, length);
+	
+	// OTP and data can't be read before the data zone is locked
+	if (zone != ATCA_ZONE_CONFIG && !emu_data_locked(dev))
+		return CMD_STATUS_BYTE_EXEC;
+	
+	if (zone == ATCA_ZONE_DATA)
+	{
+		slot_config = emu_slot_config(dev, slot);
+		if (emu_key_config(dev, slot) & EMU_KC_PRIVATE)
+			return CMD_STATUS_BYTE_EXEC;
+		
+		if (slot_config & EMU_SC_IS_SECRET)
+		{
+			// secrets only leave the device encrypted with a TempKey digest of their ReadKey
+			if (!(slot_config & EMU_SC_ENCRYPT_READ) || length != ATCA_BLOCK_SIZE)
+				return CMD_STATUS_BYTE_EXEC;
+			if (!emu_temp_key_from(dev, EMU_SC_READKEY(slot_config)))
+				return CMD_STATUS_BYTE_EXEC;
+			for (i = 0; i < ATCA_BLOCK_SIZE; i++)
+				out[i] ^= dev->temp_key.value[i];
+		}
+	}
+	
+	emu_respond(dev, out, length);
+	return EMU_STATUS_OK;
+}
+
+/** \brief Write command */
+static uint8_t emu_cmd_write(ATCAEmuDevice_t *dev, uint8_t param1, uint16_t address, const uint8_t *data, uint8_t data_size)
+{
+	uint8_t zone = param1 & ATCA_ZONE_MASK;
+	uint8_t length = (param1 & ATCA_ZONE_READWRITE_32) ? ATCA_BLOCK_SIZE : ATCA_WORD_SIZE;
+	bool encrypted = (param1 & WRITE_ZONE_WITH_MAC) != 0;
+	uint8_t plain[ATCA_BLOCK_SIZE];
+	uint8_t slot = 0;
+	uint16_t slot_config, offset;
+	uint8_t write_config;
+	uint8_t *mem;
+	int i;
+	
+	if ((param1 & ~WRITE_ZONE_MASK) || zone == 0x03)
+		return CMD_STATUS_BYTE_PARSE;
+	if (data_size != length + (encrypted ? WRITE_MAC_SIZE : 0))
+		return CMD_STATUS_BYTE_PARSE;
+	if ((mem = emu_locate(dev, zone, address, length, &slot)) == NULL)
+		return CMD_STATUS_BYTE_PARSE;
+	
+	memcpy(plain, data, length);
+	
+	if (zone == ATCA_ZONE_CONFIG)
+	{
+		// bytes 0-15 are fixed, bytes 84-87 only change through UpdateExtra and Lock
+		offset = (uint16_t)(mem - dev->config);
+		if (emu_config_locked(dev) || encrypted)
+			return CMD_STATUS_BYTE_EXEC;
+		if (offset < 16 || (offset < EMU_LOCK_CONFIG + 1 && offset + length > EMU_USER_EXTRA))
+			return CMD_STATUS_BYTE_EXEC;
+		memcpy(mem, plain, length);
+		emu_status(dev, EMU_STATUS_OK);
+		return EMU_STATUS_OK;
+	}
+	
+	if (!emu_config_locked(dev))
+		return CMD_STATUS_BYTE_EXEC;
+	
+	if (zone == ATCA_ZONE_OTP)
+	{
+		if (encrypted)
+			return CMD_STATUS_BYTE_EXEC;
+		if (emu_data_locked(dev))
+		{
+			// once locked, only consumption mode OTP can be written, and only by clearing bits
+			if (dev->config[EMU_OTP_MODE] != 0x55)
+				return CMD_STATUS_BYTE_EXEC;
+			for (i = 0; i < length; i++)
+				plain[i] &= mem[i];
+		}
+		memcpy(mem, plain, length);
+		emu_status(dev, EMU_STATUS_OK);
+		return EMU_STATUS_OK;
+	}
+	
+	// data zone, private keys can only be written with PrivWrite
+	slot_config = emu_slot_config(dev, slot);
+	write_config = EMU_SC_WRITECONFIG(slot_config);
+	if (emu_key_config(dev, slot) & EMU_KC_PRIVATE)
+		return CMD_STATUS_BYTE_EXEC;
+	
+	if (emu_data_locked(dev))
+	{
+		if (emu_slot_locked(dev, slot))
+			return CMD_STATUS_BYTE_EXEC;
+		
+		if (write_config & EMU_WC_ENCRYPT)
+		{
+			atca_gen_dig_in_out_t gen_mac;
+			atca_temp_key_t mac_key;
+			
+			if (!encrypted || length != ATCA_BLOCK_SIZE || !emu_temp_key_from(dev, EMU_SC_WRITEKEY(slot_config)))
+				return CMD_STATUS_BYTE_EXEC;
+			
+			for (i = 0; i < ATCA_BLOCK_SIZE; i++)
+				plain[i] ^= dev->temp_key.value[i];
+			
+			// the input MAC is SHA-256(TempKey, opcode, param1, param2, SN, plain text)
+			mac_key = dev->temp_key;
+			gen_mac.zone = param1;
+			gen_mac.key_id = address;
+			gen_mac.stored_value = plain;
+			gen_mac.temp_key = &mac_key;
+			atcah_gen_mac(&gen_mac);
+			dev->temp_key.valid = 0;
+			if (memcmp(mac_key.value, &data[ATCA_BLOCK_SIZE], WRITE_MAC_SIZE) != 0)
+				return EMU_STATUS_MISCOMPARE;
+		}
+		else if (write_config > 1 || encrypted)
+		{
+			// WriteConfig Never, or an encrypted write to a clear text slot
+			return CMD_STATUS_BYTE_EXEC;
+		}
+	}
+	else if (encrypted)
+	{
+		return CMD_STATUS_BYTE_EXEC;
+	}
+	
+	memcpy(mem, plain, length);
+	emu_status(dev, EMU_STATUS_OK);
+	return EMU_STATUS_OK;
+}
+
+/** \brief Lock command */
+static uint8_t emu_cmd_lock(ATCAEmuDevice_t *dev, uint8_t param1, uint16_t summary)
+{
+	uint8_t zone = param1 & 0x03;
+	uint8_t slot = (param1 >> 2) & 0x0F;
+	bool check_crc = !(param1 & LOCK_ZONE_NO_CRC);
+	uint16_t crc = 0;
+	uint16_t slot_locked;
+	int i;
+	
+	if (param1 & ~LOCK_ZONE_MASK)
+		return CMD_STATUS_BYTE_PARSE;
+	
+	switch (zone)
+	{
+	case LOCK_ZONE_CONFIG:
+		if (emu_config_locked(dev))
+			return CMD_STATUS_BYTE_EXEC;
+		crc = atCRCUpdate(0, dev->config, sizeof(dev->config));
+		if (check_crc && crc != summary)
+			return CMD_STATUS_BYTE_EXEC;
+		dev->config[EMU_LOCK_CONFIG] = 0x00;
+		break;
+	
+	case LOCK_ZONE_DATA:
+		if (!emu_config_locked(dev) || emu_data_locked(dev))
+			return CMD_STATUS_BYTE_EXEC;
+		for (i = 0; i < ATCA_KEY_COUNT; i++)
+			crc = atCRCUpdate(crc, dev->slots[i], emu_slot_size(i));
+		crc = atCRCUpdate(crc, dev->otp, sizeof(dev->otp));
+		if (check_crc && crc != summary)
+			return CMD_STATUS_BYTE_EXEC;
+		dev->config[EMU_LOCK_VALUE] = 0x00;
+		break;
+	
+	case LOCK_ZONE_DATA_SLOT:
+		if (!emu_data_locked(dev) || emu_slot_locked(dev, slot) || !(emu_key_config(dev, slot) & EMU_KC_LOCKABLE))
+			return CMD_STATUS_BYTE_EXEC;
+		crc = atCRCUpdate(0, dev->slots[slot], emu_slot_size(slot));
+		if (check_crc && crc != summary)
+			return CMD_STATUS_BYTE_EXEC;
+		slot_locked = dev->config[EMU_SLOT_LOCKED] | (dev->config[EMU_SLOT_LOCKED + 1] << 8);
+		slot_locked &= ~(1 << slot);
+		dev->config[EMU_SLOT_LOCKED] = (uint8_t)slot_locked;
+		dev->config[EMU_SLOT_LOCKED + 1] = (uint8_t)(slot_locked >> 8);
+		break;
+	
+	default:
+		return CMD_STATUS_BYTE_PARSE;
+	}
+	
+	emu_status(dev, EMU_STATUS_OK);
+	return EMU_STATUS_OK;
+}
+
+/** \brief GenKey command, private key generation and public key calculation */
+static uint8_t emu_cmd_genkey(ATCAEmuDevice_t *dev, uint8_t mode, uint16_t key_id)
+{
+	uint8_t public_key[ATCA_PUB_KEY_SIZE];
+	uint8_t *private_key;
+	uint16_t slot_config;
+	int i;
+	
+	if (key_id > ATCA_KEY_ID_MAX)
+		return CMD_STATUS_BYTE_PARSE;
+	if (mode != GENKEY_MODE_PRIVATE && mode != GENKEY_MODE_PUBLIC)
+		return CMD_STATUS_BYTE_PARSE;
+	if (!emu_config_locked(dev) || !emu_is_private_key(dev, (uint8_t)key_id))
+		return CMD_STATUS_BYTE_EXEC;
+	
+	slot_config = emu_slot_config(dev, (uint8_t)key_id);
+	private_key = &dev->slots[key_id][EMU_PRIV_KEY_PAD];
+	
+	if (mode == GENKEY_MODE_PRIVATE)
+	{
+		if (emu_data_locked(dev) && (!(EMU_SC_WRITECONFIG(slot_config) & EMU_WC_GENKEY) || emu_slot_locked(dev, (uint8_t)key_id)))
+			return CMD_STATUS_BYTE_EXEC;
+		
+		memset(dev->slots[key_id], 0, EMU_PRIV_KEY_PAD);
+		for (i = 0; i < EMU_SIGN_ATTEMPTS; i++)
+		{
+			emu_random(dev, private_key);
+			if (sw_p256_check_private_key(private_key) == P256_SUCCESS)
+				break;
+		}
+	}
+	else if (emu_data_locked(dev) && !(emu_key_config(dev, (uint8_t)key_id) & EMU_KC_PUB_INFO))
+	{
+		return CMD_STATUS_BYTE_EXEC;
+	}
+	
+	if (sw_p256_public_key(private_key, public_key) != P256_SUCCESS)
+		return CMD_STATUS_BYTE_EXEC;
+	
+	emu_respond(dev, public_key, sizeof(public_key));
+	return EMU_STATUS_OK;
+}
+
+/** \brief PrivWrite command */
+static uint8_t emu_cmd_privwrite(ATCAEmuDevice_t *dev, uint8_t mode, uint16_t key_id, const uint8_t *data)
+{
+	uint8_t value[ATCA_PRIV_KEY_SIZE + EMU_PRIV_KEY_PAD];
+	uint8_t message[ATCA_MSG_SIZE_PRIVWRITE_MAC];
+	uint8_t digest[ATCA_KEY_SIZE];
+	uint16_t slot_config;
+	uint8_t *p;
+	int i;
+	
+	if ((mode & ~PRIVWRITE_ZONE_MASK) || key_id > ATCA_KEY_ID_MAX)
+		return CMD_STATUS_BYTE_PARSE;
+	if (!emu_config_locked(dev) || !emu_is_private_key(dev, (uint8_t)key_id))
+		return CMD_STATUS_BYTE_EXEC;
+	
+	slot_config = emu_slot_config(dev, (uint8_t)key_id);
+	memcpy(value, data, sizeof(value));
+	
+	if (emu_data_locked(dev) && (!(mode & PRIVWRITE_MODE_ENCRYPT) || !(EMU_SC_WRITECONFIG(slot_config) & EMU_WC_ENCRYPT)
+	                             || emu_slot_locked(dev, (uint8_t)key_id)))
+		return CMD_STATUS_BYTE_EXEC;
+	
+	if (mode & PRIVWRITE_MODE_ENCRYPT)
+	{
+		if (!emu_temp_key_from(dev, EMU_SC_WRITEKEY(slot_config)))
+			return CMD_STATUS_BYTE_EXEC;
+		
+		// the first 32 bytes are encrypted with TempKey, the last 4 with SHA-256(TempKey)
+		atcah_sha256(ATCA_KEY_SIZE, dev->temp_key.value, digest);
+		for (i = 0; i < ATCA_KEY_SIZE; i++)
+			value[i] ^= dev->temp_key.value[i];
+		for (i = ATCA_KEY_SIZE; i < (int)sizeof(value); i++)
+			value[i] ^= digest[i - ATCA_KEY_SIZE];
+		
+		p = message;
+		memcpy(p, dev->temp_key.value, ATCA_KEY_SIZE);
+		p += ATCA_KEY_SIZE;
+		*p++ = ATCA_PRIVWRITE;
+		*p++ = mode;
+		*p++ = (uint8_t)key_id;
+		*p++ = (uint8_t)(key_id >> 8);
+		*p++ = dev->config[12];
+		*p++ = dev->config[0];
+		*p++ = dev->config[1];
+		memset(p, 0, ATCA_PRIVWRITE_MAC_ZEROS_SIZE);
+		p += ATCA_PRIVWRITE_MAC_ZEROS_SIZE;
+		memcpy(p, value, sizeof(value));
+		atcah_sha256(sizeof(message), message, digest);
+		
+		dev->temp_key.valid = 0;
+		if (memcmp(digest, &data[sizeof(value)], MAC_SIZE) != 0)
+			return EMU_STATUS_MISCOMPARE;
+	}
+	
+	if (sw_p256_check_private_key(&value[EMU_PRIV_KEY_PAD]) != P256_SUCCESS)
+		return CMD_STATUS_BYTE_EXEC;
+	
+	memcpy(dev->slots[key_id], value, sizeof(value));
+	emu_status(dev, EMU_STATUS_OK);
+	return EMU_STATUS_OK;
+}
+
+/** \brief Sign command, external messages only */
+static uint8_t emu_cmd_sign(ATCAEmuDevice_t *dev, uint8_t mode, uint16_t key_id)
+{
+	uint8_t signature[ATCA_SIG_SIZE];
+	uint8_t k[ATCA_PRIV_KEY_SIZE];
+	int i, ret = P256_INVALID;
+	
+	if ((mode & ~SIGN_MODE_MASK) || key_id > ATCA_KEY_ID_MAX)
+		return CMD_STATUS_BYTE_PARSE;
+	if (!(mode & SIGN_MODE_EXTERNAL))
+		return CMD_STATUS_BYTE_PARSE;	// internal messages are not emulated
+	if (!emu_data_locked(dev) || !emu_is_private_key(dev, (uint8_t)key_id))
+		return CMD_STATUS_BYTE_EXEC;
+	if (!(EMU_SC_READKEY(emu_slot_config(dev, (uint8_t)key_id)) & EMU_SC_EXT_SIGN) || !dev->temp_key.valid)
+		return CMD_STATUS_BYTE_EXEC;
+	
+	for (i = 0; i < EMU_SIGN_ATTEMPTS && ret != P256_SUCCESS; i++)
+	{
+		emu_random(dev, k);
+		ret = sw_p256_sign(&dev->slots[key_id][EMU_PRIV_KEY_PAD], dev->temp_key.value, k, signature);
+	}
+	dev->temp_key.valid = 0;
+	if (ret != P256_SUCCESS)
+		return CMD_STATUS_BYTE_EXEC;
+	
+	emu_respond(dev, signature, sizeof(signature));
+	return EMU_STATUS_OK;
+}
+
+/** \brief Verify command, stored and external modes */
+static uint8_t emu_cmd_verify(ATCAEmuDevice_t *dev, uint8_t mode, uint16_t param2, const uint8_t *data, uint8_t data_size)
+{
+	uint8_t public_key[ATCA_PUB_KEY_SIZE];
+	int ret;
+	
+	switch (mode)
+	{
+	case VERIFY_MODE_EXTERNAL:
+		if (param2 != VERIFY_KEY_P256 || data_size != VERIFY_256_SIGNATURE_SIZE + VERIFY_256_KEY_SIZE)
+			return CMD_STATUS_BYTE_PARSE;
+		memcpy(public_key, &data[VERIFY_256_SIGNATURE_SIZE], sizeof(public_key));
+		break;
+	case VERIFY_MODE_STORED:
+		if (param2 > ATCA_KEY_ID_MAX || data_size != VERIFY_256_SIGNATURE_SIZE)
+			return CMD_STATUS_BYTE_PARSE;
+		if (!emu_data_locked(dev) || (emu_key_config(dev, (uint8_t)param2) & EMU_KC_PRIVATE)
+		    || EMU_KC_KEY_TYPE(emu_key_config(dev, (uint8_t)param2)) != ATCA_P256_KEY_TYPE)
+			return CMD_STATUS_BYTE_EXEC;
+		emu_stored_public_key(dev, (uint8_t)param2, public_key);
+		break;
+	default:
+		return CMD_STATUS_BYTE_PARSE;	// validate and invalidate modes are not emulated
+	}
+	
+	if (!dev->temp_key.valid)
+		return CMD_STATUS_BYTE_EXEC;
+	
+	ret = sw_p256_verify(public_key, dev->temp_key.value, data);
+	dev->temp_key.valid = 0;
+	
+	emu_status(dev, ret == P256_SUCCESS ? EMU_STATUS_OK : EMU_STATUS_MISCOMPARE);
+	return EMU_STATUS_OK;
+}
+
+/** \brief ECDH command */
+static uint8_t emu_cmd_ecdh(ATCAEmuDevice_t *dev, uint8_t mode, uint16_t key_id, const uint8_t *data, uint8_t data_size)
+{
+	uint8_t shared_secret[ECDH_KEY_SIZE];
+	uint16_t slot_config;
+	
+	if (mode != ECDH_PREFIX_MODE || key_id > ATCA_KEY_ID_MAX || data_size != ECDH_PUBKEYIN_SIZE)
+		return CMD_STATUS_BYTE_PARSE;
+	if (!emu_data_locked(dev) || !emu_is_private_key(dev, (uint8_t)key_id))
+		return CMD_STATUS_BYTE_EXEC;
+	
+	slot_config = emu_slot_config(dev, (uint8_t)key_id);
+	if (!(slot_config & EMU_SC_ECDH))
+		return CMD_STATUS_BYTE_EXEC;
+	
+	if (sw_p256_ecdh(&dev->slots[key_id][EMU_PRIV_KEY_PAD], data, shared_secret) != P256_SUCCESS)
+		return CMD_STATUS_BYTE_EXEC;
+	
+	if (slot_config & EMU_SC_ECDH_TO_SLOT)
+	{
+		// the premaster secret stays on the device, in the odd slot following the key
+		if (key_id & 1)
+			return CMD_STATUS_BYTE_EXEC;
+		memcpy(dev->slots[key_id + 1], shared_secret, sizeof(shared_secret));
+		emu_status(dev, EMU_STATUS_OK);
+		return EMU_STATUS_OK;
+	}
+	
+	emu_respond(dev, shared_secret, sizeof(shared_secret));
+	return EMU_STATUS_OK;
+}
+
+/** \brief SHA command, SHA-256 start, update and end */
+static uint8_t emu_cmd_sha(ATCAEmuDevice_t *dev, uint8_t mode, uint16_t length, const uint8_t *data, uint8_t data_size)
+{
+	uint8_t digest[SHA_DIGEST_SIZE];
+	
+	switch (mode)
+	{
+	case SHA_SHA256_START_MASK:
+		sw_sha256_init(&dev->sha);
+		dev->sha_started = true;
+		emu_status(dev, EMU_STATUS_OK);
+		break;
+	
+	case SHA_SHA256_UPDATE_MASK:
+		if (length == 0)
+			length = SHA_DATA_MAX;
+		if (length > SHA_DATA_MAX || length > data_size)
+			return CMD_STATUS_BYTE_PARSE;
+		if (!dev->sha_started)
+			return CMD_STATUS_BYTE_EXEC;
+		sw_sha256_update(&dev->sha, data, length);
+		emu_status(dev, EMU_STATUS_OK);
+		break;
+	
+	case SHA_SHA256_END_MASK:
+		if (length >= SHA_DATA_MAX || length > data_size)
+			return CMD_STATUS_BYTE_PARSE;
+		if (!dev->sha_started)
+			return CMD_STATUS_BYTE_EXEC;
+		sw_sha256_update(&dev->sha, data, length);
+		sw_sha256_final(&dev->sha, digest);
+		dev->sha_started = false;
+		
+		// the digest is also left in TempKey, ready to be signed
+		memcpy(dev->temp_key.value, digest, sizeof(digest));
+		dev->temp_key.key_id = 0;
+		dev->temp_key.source_flag = 1;
+		dev->temp_key.gen_data = 0;
+		dev->temp_key.check_flag = 0;
+		dev->temp_key.valid = 1;
+		emu_respond(dev, digest, sizeof(digest));
+		break;
+	
+	default:
+		return CMD_STATUS_BYTE_PARSE;
+	}
+	
+	return EMU_STATUS_OK;
+}
+
+/** \brief MAC command */
+static uint8_t emu_cmd_mac(ATCAEmuDevice_t *dev, uint8_t mode, uint16_t key_id, const uint8_t *data, uint8_t data_size)
+{
+	struct atca_mac_in_out mac;
+	uint8_t sn[ATCA_SERIAL_NUM_SIZE];
+	uint8_t response[MAC_SIZE];
+	
+	if ((mode & ~MAC_MODE_MASK) || key_id > ATCA_KEY_ID_MAX)
+		return CMD_STATUS_BYTE_PARSE;
+	if (data_size != ((mode & MAC_MODE_BLOCK2_TEMPKEY) ? 0 : MAC_CHALLENGE_SIZE))
+		return CMD_STATUS_BYTE_PARSE;
+	if (!(mode & MAC_MODE_BLOCK1_TEMPKEY))
+	{
+		if (!emu_data_locked(dev) || (emu_key_config(dev, (uint8_t)key_id) & EMU_KC_PRIVATE)
+		    || (emu_slot_config(dev, (uint8_t)key_id) & EMU_SC_CHECK_ONLY))
+			return CMD_STATUS_BYTE_EXEC;
+	}
+	
+	emu_serial_number(dev, sn);
+	mac.mode = mode;
+	mac.key_id = key_id;
+	mac.challenge = (uint8_t *)data;
+	mac.key = dev->slots[key_id];
+	mac.otp = dev->otp;
+	mac.sn = sn;
+	mac.response = response;
+	mac.temp_key = &dev->temp_key;
+	if (atcah_mac(&mac) != ATCA_SUCCESS)
+		return CMD_STATUS_BYTE_EXEC;
+	
+	emu_respond(dev, response, sizeof(response));
+	return EMU_STATUS_OK;
+}
+
+/** \brief CheckMac command */
+static uint8_t emu_cmd_checkmac(ATCAEmuDevice_t *dev, uint8_t mode, uint16_t key_id, const uint8_t *data, uint8_t data_size)
+{
+	const uint8_t *challenge = &data[0];
+	const uint8_t *response = &data[CHECKMAC_CLIENT_CHALLENGE_SIZE];
+	const uint8_t *other_data = &data[CHECKMAC_CLIENT_CHALLENGE_SIZE + CHECKMAC_CLIENT_RESPONSE_SIZE];
+	uint8_t message[ATCA_MSG_SIZE_MAC];
+	uint8_t digest[MAC_SIZE];
+	uint8_t *p = message;
+	bool match;
+	
+	if ((mode & ~CHECKMAC_MODE_MASK) || key_id > ATCA_KEY_ID_MAX)
+		return CMD_STATUS_BYTE_PARSE;
+	if (data_size != CHECKMAC_CLIENT_CHALLENGE_SIZE + CHECKMAC_CLIENT_RESPONSE_SIZE + CHECKMAC_OTHER_DATA_SIZE)
+		return CMD_STATUS_BYTE_PARSE;
+	
+	if (mode & (CHECKMAC_MODE_BLOCK1_TEMPKEY | CHECKMAC_MODE_BLOCK2_TEMPKEY))
+	{
+		if (!dev->temp_key.valid || dev->temp_key.check_flag
+		    || !(mode & CHECKMAC_MODE_SOURCE_FLAG_MATCH) != !dev->temp_key.source_flag)
+		{
+			dev->temp_key.valid = 0;
+			return CMD_STATUS_BYTE_EXEC;
+		}
+	}
+	if (!(mode & CHECKMAC_MODE_BLOCK1_TEMPKEY))
+	{
+		if (!emu_data_locked(dev) || (emu_key_config(dev, (uint8_t)key_id) & EMU_KC_PRIVATE))
+			return CMD_STATUS_BYTE_EXEC;
+	}
+	
+	// the same message the MAC command hashes, with the client's OtherData in place of the command fields
+	memcpy(p, (mode & CHECKMAC_MODE_BLOCK1_TEMPKEY) ? dev->temp_key.value : dev->slots[key_id], ATCA_KEY_SIZE);
+	p += ATCA_KEY_SIZE;
+	memcpy(p, (mode & CHECKMAC_MODE_BLOCK2_TEMPKEY) ? dev->temp_key.value : challenge, ATCA_KEY_SIZE);
+	p += ATCA_KEY_SIZE;
+	memcpy(p, &other_data[0], ATCA_OTHER_DATA_SIZE_4);
+	p += ATCA_OTHER_DATA_SIZE_4;
+	if (mode & CHECKMAC_MODE_INCLUDE_OTP_64)
+		memcpy(p, dev->otp, ATCA_OTP_SIZE_8);
+	else
+		memset(p, 0, ATCA_OTP_SIZE_8);
+	p += ATCA_OTP_SIZE_8;
+	memcpy(p, &other_data[4], ATCA_OTHER_DATA_SIZE_3);
+	p += ATCA_OTHER_DATA_SIZE_3;
+	*p++ = dev->config[12];
+	memcpy(p, &other_data[7], ATCA_OTHER_DATA_SIZE_4);
+	p += ATCA_OTHER_DATA_SIZE_4;
+	*p++ = dev->config[0];
+	*p++ = dev->config[1];
+	memcpy(p, &other_data[11], ATCA_OTHER_DATA_SIZE_2);
+	
+	atcah_sha256(sizeof(message), message, digest);
+	match = memcmp(digest, response, MAC_SIZE) == 0;
+	dev->temp_key.valid = 0;
+	
+	emu_status(dev, match ? EMU_STATUS_OK : EMU_STATUS_MISCOMPARE);
+	return EMU_STATUS_OK;
+}
+
+/** \brief map an opcode to its entry in the execution time table */
+static ATCA_CmdMap emu_command(uint8_t opcode)
+{
+	switch (opcode)
+	{
+	case ATCA_CHECKMAC:		return CMD_CHECKMAC;
+	case ATCA_COUNTER:		return CMD_COUNTER;
+	case ATCA_DERIVE_KEY:	return CMD_DERIVEKEY;
+	case ATCA_ECDH:			return CMD_ECDH;
+	case ATCA_GENDIG:		return CMD_GENDIG;
+	case ATCA_GENKEY:		return CMD_GENKEY;
+	case ATCA_HMAC:			return CMD_HMAC;
+	case ATCA_INFO:			return CMD_INFO;
+	case ATCA_LOCK:			return CMD_LOCK;
+	case ATCA_MAC:			return CMD_MAC;
+	case ATCA_NONCE:		return CMD_NONCE;
+	case ATCA_PAUSE:		return CMD_PAUSE;
+	case ATCA_PRIVWRITE:	return CMD_PRIVWRITE;
+	case ATCA_RANDOM:		return CMD_RANDOM;
+	case ATCA_READ:			return CMD_READMEM;
+	case ATCA_SHA:			return CMD_SHA;
+	case ATCA_SIGN:			return CMD_SIGN;
+	case ATCA_UPDATE_EXTRA:	return CMD_UPDATEEXTRA;
+	case ATCA_VERIFY:		return CMD_VERIFY;
+	case ATCA_WRITE:		return CMD_WRITEMEM;
+	default:				return CMD_LASTCOMMAND;
+	}
+}
+
+/** \brief execute a command packet and load the output buffer with its response
+ * \param[in] dev - emulated device
+ * \param[in] packet - count, opcode, param1, param2, data and CRC as sent on the bus
+ * \param[in] length - number of bytes received
+ * \return execution time of the real device in milliseconds
+ */
+static uint16_t emu_execute(ATCAEmuDevice_t *dev, const uint8_t *packet, int length)
+{
+	uint8_t crc[ATCA_CRC_SIZE];
+	uint8_t count = packet[ATCA_COUNT_IDX];
+	uint8_t opcode, param1, data_size;
+	uint16_t param2;
+	const uint8_t *data;
+	ATCA_CmdMap command;
+	uint8_t status;
+	
+	if (count != length || count < ATCA_CMD_SIZE_MIN || count > ATCA_CMD_SIZE_MAX)
+	{
+		emu_status(dev, CMD_STATUS_BYTE_COMM);
+		return 0;
+	}
+	atCRC(count - ATCA_CRC_SIZE, (uint8_t *)packet, crc);
+	if (memcmp(crc, &packet[count - ATCA_CRC_SIZE], ATCA_CRC_SIZE) != 0)
+	{
+		emu_status(dev, CMD_STATUS_BYTE_COMM);
+		return 0;
+	}
+	
+	opcode = packet[ATCA_OPCODE_IDX];
+	param1 = packet[ATCA_PARAM1_IDX];
+	param2 = packet[ATCA_PARAM2_IDX] | (packet[ATCA_PARAM2_IDX + 1] << 8);
+	data = &packet[ATCA_DATA_IDX];
+	data_size = count - ATCA_CMD_SIZE_MIN;
+	
+	switch (opcode)
+	{
+	case ATCA_INFO:			status = emu_info(dev, param1, param2); break;
+	case ATCA_RANDOM:		status = emu_cmd_random(dev, param1); break;
+	case ATCA_NONCE:		status = emu_cmd_nonce(dev, param1, data, data_size); break;
+	case ATCA_GENDIG:		status = emu_cmd_gendig(dev, param1, param2); break;
+	case ATCA_READ:			status = emu_cmd_read(dev, param1, param2); break;
+	case ATCA_WRITE:		status = emu_cmd_write(dev, param1, param2, data, data_size); break;
+	case ATCA_LOCK:			status = emu_cmd_lock(dev, param1, param2); break;
+	case ATCA_GENKEY:		status = emu_cmd_genkey(dev, param1, param2); break;
+	case ATCA_SIGN:			status = emu_cmd_sign(dev, param1, param2); break;
+	case ATCA_VERIFY:		status = emu_cmd_verify(dev, param1, param2, data, data_size); break;
+	case ATCA_ECDH:			status = emu_cmd_ecdh(dev, param1, param2, data, data_size); break;
+	case ATCA_SHA:			status = emu_cmd_sha(dev, param1, param2, data, data_size); break;
+	case ATCA_MAC:			status = emu_cmd_mac(dev, param1, param2, data, data_size); break;
+	case ATCA_CHECKMAC:		status = emu_cmd_checkmac(dev, param1, param2, data, data_size); break;
+	case ATCA_PRIVWRITE:
+		status = (data_size == PRIVWRITE_COUNT - ATCA_CMD_SIZE_MIN) ? emu_cmd_privwrite(dev, param1, param2, data) : CMD_STATUS_BYTE_PARSE;
+		break;
+	default:				status = CMD_STATUS_BYTE_PARSE; break;
+	}
+	
+	// errors answer with the status byte alone, successful commands have loaded their response
+	if (status != EMU_STATUS_OK)
+		emu_status(dev, status);
+	
+	command = emu_command(opcode);
+	return command == CMD_LASTCOMMAND ? 0 : exectimes_x08a[command];
+}
+
+/** \brief initialize an emulated device using given config.  Every interface gets a device of its own,
+ * starting with the factory config zone (or cfg->atcaemu.config) and empty OTP and data zones.
+ * \param[in] hal - opaque ptr to HAL data
+ * \param[in] cfg - interface configuration
+ */
+ATCA_STATUS hal_emu_init(void *hal, ATCAIfaceCfg *cfg)
+{
+	ATCAHAL_t *phal = (ATCAHAL_t *)hal;
+	ATCAEmuDevice_t *dev;
+	uint8_t seed[16];
+	uint8_t sn[RANDOM_NUM_SIZE];
+	uint64_t now = emu_now_us();
+	
+	if (cfg->atcaemu.timing > ATCA_EMU_TIMING_ZERO)
+	{
+		return ATCA_BAD_PARAM;
+	}
+	
+	dev = calloc(1, sizeof(ATCAEmuDevice_t));
+	if (dev == NULL)
+	{
+		return ATCA_GEN_FAIL;
+	}
+	
+	dev->timing = cfg->atcaemu.timing;
+	dev->time_scale = cfg->atcaemu.time_scale;
+	dev->watchdog_us = (dev->timing == ATCA_EMU_TIMING_ZERO) ? 0 : (uint32_t)emu_scale_us(dev, ATCA_WATCHDOG_US);
+	
+	// a fixed seed gives the same serial number and the same sequence of random numbers on every run
+	memset(seed, 0, sizeof(seed));
+	memcpy(&seed[0], &cfg->atcaemu.seed, sizeof(cfg->atcaemu.seed));
+	if (cfg->atcaemu.seed == 0)
+	{
+		memcpy(&seed[4], &now, sizeof(now));
+		seed[12] = (uint8_t)getpid();
+		seed[13] = (uint8_t)((uintptr_t)dev >> 4);
+	}
+	sw_sha256(seed, sizeof(seed), dev->drbg_key);
+	
+	if (cfg->atcaemu.config)
+	{
+		memcpy(dev->config, cfg->atcaemu.config, sizeof(dev->config));
+	}
+	else
+	{
+		memcpy(dev->config, emu_factory_config, sizeof(dev->config));
+		emu_random(dev, sn);
+		memcpy(&dev->config[2], &sn[0], 2);
+		memcpy(&dev->config[8], &sn[2], 4);
+	}
+	
+	phal->hal_data = dev;
+	
+	return ATCA_SUCCESS;
+}
+
+/** \brief HAL implementation of emulator post init
+	* \param[in] ATCAIface instance
+	* \return ATCA_STATUS
+ */
+ATCA_STATUS hal_emu_post_init(ATCAIface iface)
+{
+	return ATCA_SUCCESS;
+}
+
+/** \brief HAL implementation of emulator send, the emulated device executes the command right away and
+ * stays busy for its execution time
+	* \param[in] ATCAIface instance
+	* \param[in] txdata pointer to space to bytes to send
+	* \param[in] txlength number of bytes to send
+	* \return ATCA_STATUS
+ */
+ATCA_STATUS hal_emu_send(ATCAIface iface, uint8_t *txdata, int txlength)
+{
+	ATCAEmuDevice_t *dev = (ATCAEmuDevice_t *)atgetifacehaldat(iface);
+	uint64_t now = emu_now_us();
+	uint16_t execution_time;
+	
+	txdata[0] = 0x03;   // insert the Word Address Value, Command token
+	
+	emu_check_watchdog(dev, now);
+	if (!dev->awake || now < dev->ready_us || dev->hung)
+	{
+		return ATCA_COMM_FAIL;	// NACK, asleep or still busy
+	}
+	
+	execution_time = emu_execute(dev, &txdata[1], txlength);
+	dev->ready_us = now + emu_scale_us(dev, (uint64_t)execution_time * 1000);
+	
+	return ATCA_SUCCESS;
+}
+
+/** \brief HAL implementation of emulator receive
+ * \param[in] ATCAIface instance
+ * \param[in] rxdata pointer to space to receive the data
+ * \param[in] ptr to expected number of receive bytes to request
+ * \return ATCA_STATUS
+ */
+ATCA_STATUS hal_emu_receive(ATCAIface iface, uint8_t *rxdata, uint16_t *rxlength)
+{
+	ATCAEmuDevice_t *dev = (ATCAEmuDevice_t *)atgetifacehaldat(iface);
+	uint64_t now = emu_now_us();
+	uint16_t length;
+	
+	emu_check_watchdog(dev, now);
+	if (!dev->awake || now < dev->ready_us || dev->hung)
+	{
+		// a single read, as the SAM I2C HAL makes, atwaitreceive() paces the retries and a NACK just means "not done yet"
+		return ATCA_RX_NO_RESPONSE;
+	}
+	
+	// reading past the end of the response clocks out 0xFF, as on the bus
+	length = dev->response[ATCA_COUNT_IDX];
+	if (length > *rxlength)
+	{
+		length = *rxlength;
+	}
+	memcpy(rxdata, dev->response, length);
+	memset(&rxdata[length], 0xFF, *rxlength - length);
+	if (dev->corrupt_reads > 0 && length > 1)
+	{
+		dev->corrupt_reads--;
+		rxdata[length - 1] ^= 0x01;		// a bit lost on the bus, the output buffer itself is intact
+	}
+	
+	return ATCA_SUCCESS;
+}
+
+/** \brief wake up the emulated device.  A device that is already awake ignores the wake token and
+ * answers with whatever is in its output buffer, as the real device does.
+ * \param[in] interface to logical device to wakeup
+ */
+ATCA_STATUS hal_emu_wake(ATCAIface iface)
+{
+	ATCAIfaceCfg *cfg = atgetifacecfg(iface);
+	ATCAEmuDevice_t *dev = (ATCAEmuDevice_t *)atgetifacehaldat(iface);
+	uint8_t wake_status = CMD_STATUS_WAKEUP;
+	uint8_t expected[4] = { 0x04,0x11,0x33,0x43 };
+	uint64_t now;
+	
+	if (dev->timing != ATCA_EMU_TIMING_ZERO)
+	{
+		atca_delay_us((uint32_t)emu_scale_us(dev, cfg->wake_delay));	// wait tWHI + tWLO
+	}
+	
+	now = emu_now_us();
+	emu_check_watchdog(dev, now);
+	if (!dev->awake)
+	{
+		dev->awake = true;
+		dev->wake_us = now;
+		dev->ready_us = now;
+		emu_status(dev, wake_status);
+	}
+	else if (now < dev->ready_us || dev->hung)
+	{
+		return ATCA_COMM_FAIL;
+	}
+	
+	if (memcmp(dev->response, expected, sizeof(expected)) == 0)
+	{
+		return ATCA_SUCCESS;
+	}
+	
+	return ATCA_COMM_FAIL;
+}
+
+/** \brief idle the emulated device, it keeps TempKey and the SHA context
+ * \param[in] interface to logical device to idle
+ */
+ATCA_STATUS hal_emu_idle(ATCAIface iface)
+{
+	ATCAEmuDevice_t *dev = (ATCAEmuDevice_t *)atgetifacehaldat(iface);
+	
+	emu_check_watchdog(dev, emu_now_us());
+	dev->awake = false;
+	
+	return ATCA_SUCCESS;
+}
+
+/** \brief reset the read address of the emulated device's output buffer.  The response stays in place,
+ * only a device that is asleep or still busy NACKs.
+ * \param[in] interface to logical device
+ */
+ATCA_STATUS hal_emu_resync(ATCAIface iface)
+{
+	ATCAEmuDevice_t *dev = (ATCAEmuDevice_t *)atgetifacehaldat(iface);
+	uint64_t now = emu_now_us();
+	
+	emu_check_watchdog(dev, now);
+	if (!dev->awake || now < dev->ready_us || dev->hung)
+	{
+		return ATCA_COMM_FAIL;
+	}
+	
+	return ATCA_SUCCESS;
+}
+
+/** \brief test hook, makes the next count response reads arrive with a bit flipped, as from a noisy bus
+ * \param[in] iface - interface of an emulated device
+ * \param[in] count - number of reads to corrupt
+ */
+void hal_emu_corrupt_reads(ATCAIface iface, int count)
+{
+	ATCAEmuDevice_t *dev = (ATCAEmuDevice_t *)atgetifacehaldat(iface);
+	
+	dev->corrupt_reads = count;
+}
+
+/** \brief test hook, makes the device NACK everything on the bus from now on, as one stuck busy, or
+ * answer again
+ * \param[in] iface - interface of an emulated device
+ * \param[in] hung - true to NACK, false to answer again
+ */
+void hal_emu_hang(ATCAIface iface, bool hung)
+{
+	ATCAEmuDevice_t *dev = (ATCAEmuDevice_t *)atgetifacehaldat(iface);
+	
+	dev->hung = hung;
+}
+
+/** \brief sleep the emulated device, it loses TempKey and the SHA context
+ * \param[in] interface to logical device to sleep
+ */
+ATCA_STATUS hal_emu_sleep(ATCAIface iface)
+{
+	ATCAEmuDevice_t *dev = (ATCAEmuDevice_t *)atgetifacehaldat(iface);
+	
+	dev->awake = false;
+	emu_clear_volatile(dev);
+	
+	return ATCA_SUCCESS;
+}
+
+/** \brief release the emulated device, discarding its contents
+ * \param[in] hal_data - opaque pointer to hal data structure - known only to the HAL implementation
+ */
+ATCA_STATUS hal_emu_release(void *hal_data)
+{
+	free(hal_data);
+	
+	return ATCA_SUCCESS;
+}
+
+/** @} */
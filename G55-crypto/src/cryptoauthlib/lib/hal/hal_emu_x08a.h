@@ -0,0 +1,91 @@
+/** \brief ATCA Hardware abstraction layer for an ATECC508A emulated in-process.  Runs the x08a command
+* set against an emulated device so atcab_* code can be exercised and load tested without a chip.
+*
+* Copyright (c) 2015 Atmel Corporation. All rights reserved.
+*
+* \asf_license_start
+*
+* \page License
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*
+* 1. Redistributions of source code must retain the above copyright notice,
+*    this list of conditions and the following disclaimer.
+*
+* 2. Redistributions in binary form must reproduce the above copyright notice,
+*    this list of conditions and the following disclaimer in the documentation
+*    and/or other materials provided with the distribution.
+*
+* 3. The name of Atmel may not be used to endorse or promote products derived
+*    from this software without specific prior written permission.
+*
+* 4. This software may only be redistributed and used in connection with an
+*    Atmel microcontroller product.
+*
+* THIS SOFTWARE IS PROVIDED BY ATMEL "AS IS" AND ANY EXPRESS OR IMPLIED
+* WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT ARE
+* EXPRESSLY AND SPECIFICALLY DISCLAIMED. IN NO EVENT SHALL ATMEL BE LIABLE FOR
+* ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+* OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+* HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+* STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+* ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+* POSSIBILITY OF SUCH DAMAGE.
+*
+* \asf_license_stop
+ */ 
+
+#ifndef HAL_EMU_X08A_H_
+#define HAL_EMU_X08A_H_
+
+#include <stdbool.h>
+#include "atca_hal.h"
+#include "host/atca_host.h"
+#include "crypto/hashes/sha2_routines.h"
+
+/** \defgroup hal_ Crypto hardware abstraction layer (hal_)
+ *
+ * \brief
+ * These methods define the hardware abstraction layer for communicating with an ATECC508A
+ * emulated in-process.
+ *
+@{ */
+
+#define ATCA_EMU_SLOT_STORAGE   (416)   // slot 8, the largest slot; every slot is stored in a buffer this size
+#define ATCA_EMU_RESPONSE_MAX   (ATCA_RSP_SIZE_MAX)
+
+/** \brief state of one emulated device */
+typedef struct atcaEmuDevice {
+	uint8_t config[ATCA_CONFIG_SIZE];		// config zone, including the lock bytes
+	uint8_t otp[ATCA_OTP_SIZE];				// OTP zone
+	uint8_t slots[ATCA_KEY_COUNT][ATCA_EMU_SLOT_STORAGE];	// data zone, slot by slot
+	
+	// volatile state, lost when the device sleeps
+	atca_temp_key_t temp_key;
+	sw_sha256_ctx sha;						// SHA command context
+	bool sha_started;
+	
+	bool awake;
+	uint64_t wake_us;						// when the device was woken, for the watchdog
+	uint64_t ready_us;						// when the command executing now completes
+	uint8_t response[ATCA_EMU_RESPONSE_MAX];	// output buffer, count || data || crc
+	int corrupt_reads;						// test hook, reads still to come that arrive with a bit flipped
+	bool hung;								// test hook, NACKs everything as a device stuck busy
+	
+	ATCAEmuTiming timing;
+	uint16_t time_scale;
+	uint32_t watchdog_us;					// 0 disables the watchdog
+	
+	uint8_t drbg_key[32];					// random numbers are SHA-256(drbg_key || drbg_counter)
+	uint32_t drbg_counter;
+} ATCAEmuDevice_t;
+
+void hal_emu_corrupt_reads(ATCAIface iface, int count);
+void hal_emu_hang(ATCAIface iface, bool hung);
+
+/** @} */
+
+#endif /* HAL_EMU_X08A_H_ */
@@ -0,0 +1,625 @@
+/** \brief ATCA Hardware abstraction layer for a CryptoAuth device on an Atmel kit board, driven over
+* the kit's USB CDC serial port with the ASCII kit protocol.
+*
+* Copyright (c) 2015 Atmel Corporation. All rights reserved.
+*
+* \asf_license_start
+*
+* \page License
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*
+* 1. Redistributions of source code must retain the above copyright notice,
+*    this list of conditions and the following disclaimer.
+*
+* 2. Redistributions in binary form must reproduce the above copyright notice,
+*    this list of conditions and the following disclaimer in the documentation
+*    and/or other materials provided with the distribution.
+*
+* 3. The name of Atmel may not be used to endorse or promote products derived
+*    from this software without specific prior written permission.
+*
+* 4. This software may only be redistributed and used in connection with an
+*    Atmel microcontroller product.
+*
+* THIS SOFTWARE IS PROVIDED BY ATMEL "AS IS" AND ANY EXPRESS OR IMPLIED
+* WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT ARE
+* EXPRESSLY AND SPECIFICALLY DISCLAIMED. IN NO EVENT SHALL ATMEL BE LIABLE FOR
+* ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+* OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+* HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+* STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+* ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+* POSSIBILITY OF SUCH DAMAGE.
+*
+* \asf_license_stop
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <termios.h>
+#include <unistd.h>
+#include "atca_hal.h"
+#include "hal_kit_cdc.h"
+
+/** \defgroup hal_ Crypto hardware abstraction layer (hal_)
+ *
+ * \brief
+ * These methods define the hardware abstraction layer for communicating with a CryptoAuth device
+ * on a kit board over the board's CDC serial port.
+ *
+@{ */
+
+static const char kit_hex[] = "0123456789ABCDEF";
+
+/** \brief value of a hex digit
+ * \param[in] c - character
+ * \return 0 to 15, or -1 if c isn't a hex digit
+ */
+static int kit_hex_value(char c)
+{
+	if (c >= '0' && c <= '9')
+		return c - '0';
+	if (c >= 'A' && c <= 'F')
+		return c - 'A' + 10;
+	if (c >= 'a' && c <= 'f')
+		return c - 'a' + 10;
+	return -1;
+}
+
+/** \brief the request sent index requests after the oldest one still outstanding */
+static ATCAKitRequest_t *kit_request_at(ATCAKitCdc_t *kit, int index)
+{
+	return &kit->requests[(kit->head + index) % ATCA_KIT_PIPELINE_DEPTH];
+}
+
+/** \brief decode a complete reply line, "SS(HEX...)", into the oldest request still waiting for one
+ * \param[inout] kit - kit interface
+ */
+static void kit_parse_line(ATCAKitCdc_t *kit)
+{
+	ATCAKitRequest_t *req;
+	const char *p = kit->line;
+	int len = kit->line_len;
+	int hi, lo;
+
+	// strip the carriage return of a CRLF line end, blank lines aren't replies
+	if (len > 0 && p[len - 1] == '\r')
+		len--;
+	if (len == 0)
+		return;
+
+	if (kit->stale > 0)
+	{
+		kit->stale--;
+		return;
+	}
+	if (kit->parsed >= kit->count)
+		return;     // nothing was asked, not a reply to us
+
+	req = kit_request_at(kit, kit->parsed++);
+	req->status = 0xFF;
+	req->length = 0;
+
+	if (kit->line_overflow || len < 4 || (hi = kit_hex_value(p[0])) < 0 || (lo = kit_hex_value(p[1])) < 0 || p[2] != '(' || p[len - 1] != ')')
+		return;
+
+	for (p += 3, len -= 4; len >= 2; p += 2, len -= 2)
+	{
+		int dhi = kit_hex_value(p[0]), dlo = kit_hex_value(p[1]);
+
+		if (dhi < 0 || dlo < 0 || req->length >= ATCA_KIT_DATA_MAX)
+			return;
+		req->data[req->length++] = (uint8_t)(dhi << 4 | dlo);
+	}
+	if (len != 0)
+		return;
+
+	req->status = (uint8_t)(hi << 4 | lo);
+}
+
+/** \brief feed bytes read from the tty to the reply parser.  Whole runs up to the next line end are
+ *  copied at once, so the parser only looks at line boundaries and not at every byte.
+ * \param[inout] kit - kit interface
+ * \param[in] data - bytes read
+ * \param[in] length - number of bytes
+ */
+static void kit_parse(ATCAKitCdc_t *kit, const char *data, size_t length)
+{
+	while (length > 0)
+	{
+		const char *eol = memchr(data, '\n', length);
+		size_t run = eol ? (size_t)(eol - data) : length;
+
+		if (kit->line_len + run > sizeof(kit->line))
+			kit->line_overflow = true;
+		else
+		{
+			memcpy(&kit->line[kit->line_len], data, run);
+			kit->line_len += (int)run;
+		}
+
+		if (eol == NULL)
+			return;
+
+		kit_parse_line(kit);
+		kit->line_len = 0;
+		kit->line_overflow = false;
+
+		data += run + 1;
+		length -= run + 1;
+	}
+}
+
+/** \brief read whatever the kit has sent and parse it
+ * \param[inout] kit - kit interface
+ * \param[in] timeout_ms - how long to wait for the first byte, 0 to only take what is already there
+ * \return ATCA_SUCCESS if bytes were read, ATCA_RX_NO_RESPONSE if none came, ATCA_COMM_FAIL if the tty failed
+ */
+static ATCA_STATUS kit_fill(ATCAKitCdc_t *kit, int timeout_ms)
+{
+	char chunk[ATCA_KIT_READ_CHUNK];
+	struct pollfd pfd = { .fd = kit->fd, .events = POLLIN };
+	ssize_t ret;
+	int n;
+
+	do {
+		n = poll(&pfd, 1, timeout_ms);
+	} while (n < 0 && errno == EINTR);
+	if (n < 0)
+		return ATCA_COMM_FAIL;
+	if (n == 0)
+		return ATCA_RX_NO_RESPONSE;
+
+	do {
+		ret = read(kit->fd, chunk, sizeof(chunk));
+	} while (ret < 0 && errno == EINTR);
+	if (ret < 0 && errno == EAGAIN)
+		return ATCA_RX_NO_RESPONSE;
+	if (ret <= 0)
+		return ATCA_COMM_FAIL;
+
+	kit_parse(kit, chunk, (size_t)ret);
+	return ATCA_SUCCESS;
+}
+
+/** \brief write all of buf to the tty
+ * \param[in] kit - kit interface
+ * \param[in] buf - bytes to write
+ * \param[in] length - number of bytes
+ * \param[out] written - number of bytes written, also when the write failed part way
+ * \return ATCA_SUCCESS or ATCA_TX_FAIL
+ */
+static ATCA_STATUS kit_write(ATCAKitCdc_t *kit, const char *buf, size_t length, size_t *written)
+{
+	struct pollfd pfd = { .fd = kit->fd, .events = POLLOUT };
+	ssize_t ret;
+
+	*written = 0;
+	while (length > 0)
+	{
+		ret = write(kit->fd, buf, length);
+		if (ret > 0)
+		{
+			buf += ret;
+			length -= (size_t)ret;
+			*written += (size_t)ret;
+		}
+		else if (ret < 0 && errno == EAGAIN)
+		{
+			if (poll(&pfd, 1, ATCA_KIT_RX_TIMEOUT_MS) == 0)
+				return ATCA_TX_FAIL;
+		}
+		else if (ret < 0 && errno != EINTR)
+		{
+			return ATCA_TX_FAIL;
+		}
+	}
+
+	return ATCA_SUCCESS;
+}
+
+/** \brief give up on all outstanding requests, after a timeout or before a wake.  Replies still to
+ *  come for them are dropped when they arrive, so they aren't taken for replies to later requests.
+ * \param[inout] kit - kit interface
+ */
+static void kit_abandon(ATCAKitCdc_t *kit)
+{
+	kit->stale += kit->count - kit->parsed;
+	kit->head = 0;
+	kit->count = 0;
+	kit->parsed = 0;
+}
+
+/** \brief drop the wake, idle and sleep requests at the head whose replies came in, nobody claims those
+ * \param[inout] kit - kit interface
+ */
+static void kit_retire(ATCAKitCdc_t *kit)
+{
+	while (kit->parsed > 0 && !kit->requests[kit->head].talk)
+	{
+		kit->head = (kit->head + 1) % ATCA_KIT_PIPELINE_DEPTH;
+		kit->count--;
+		kit->parsed--;
+	}
+}
+
+/** \brief wait for the reply to the oldest request the caller claims, retiring wake/idle/sleep replies on the way
+ * \param[inout] kit - kit interface
+ * \param[in] block - wait up to ATCA_KIT_RX_TIMEOUT_MS of silence from the kit, otherwise only look at what arrived
+ * \return ATCA_SUCCESS once the head request has its reply, ATCA_RX_NO_RESPONSE if it hasn't yet and
+ *         block is false, ATCA_COMM_FAIL if nothing is outstanding, the kit went silent or the tty failed
+ */
+static ATCA_STATUS kit_wait_head(ATCAKitCdc_t *kit, bool block)
+{
+	ATCA_STATUS status;
+
+	for (;;)
+	{
+		kit_retire(kit);
+		if (kit->count == 0)
+			return ATCA_COMM_FAIL;
+		if (kit->parsed > 0)
+			return ATCA_SUCCESS;
+
+		status = kit_fill(kit, block ? ATCA_KIT_RX_TIMEOUT_MS : 0);
+		if (status == ATCA_RX_NO_RESPONSE && !block)
+			return ATCA_RX_NO_RESPONSE;
+		if (status != ATCA_SUCCESS)
+		{
+			kit_abandon(kit);
+			return ATCA_COMM_FAIL;
+		}
+	}
+}
+
+/** \brief queue a request and write its line to the kit without waiting for the reply.  A line the tty
+ *  took only part of is ended in front of the next request, the kit answers the broken line and that
+ *  reply is dropped like the one of an abandoned request.
+ * \param[inout] kit - kit interface
+ * \param[in] function - kit protocol function letter, 't', 'w', 'i' or 's'
+ * \param[in] data - argument bytes, for 't' the command packet from its count byte
+ * \param[in] length - number of argument bytes
+ * \return ATCA_STATUS, ATCA_FUNC_FAIL if ATCA_KIT_PIPELINE_DEPTH replies are already waiting to be claimed
+ */
+static ATCA_STATUS kit_send_request(ATCAKitCdc_t *kit, char function, const uint8_t *data, int length)
+{
+	char frame[7 + 2 * 255];
+	ATCAKitRequest_t *req;
+	ATCA_STATUS status;
+	size_t written;
+	int i, pos = 0, start;
+
+	if (length < 0 || length > 255)
+		return ATCA_BAD_PARAM;
+
+	// make room by waiting out the oldest wake/idle/sleep replies, talk replies stay until received
+	while (kit->count == ATCA_KIT_PIPELINE_DEPTH && !kit->requests[kit->head].talk)
+	{
+		if (kit->parsed > 0)
+		{
+			kit_retire(kit);
+		}
+		else if (kit_fill(kit, ATCA_KIT_RX_TIMEOUT_MS) != ATCA_SUCCESS)
+		{
+			kit_abandon(kit);
+			return ATCA_COMM_FAIL;
+		}
+	}
+	if (kit->count == ATCA_KIT_PIPELINE_DEPTH)
+		return ATCA_FUNC_FAIL;
+
+	if (kit->partial)
+		frame[pos++] = '\n';
+	start = pos;
+	frame[pos++] = kit->target;
+	frame[pos++] = ':';
+	frame[pos++] = function;
+	frame[pos++] = '(';
+	for (i = 0; i < length; i++)
+	{
+		frame[pos++] = kit_hex[data[i] >> 4];
+		frame[pos++] = kit_hex[data[i] & 0x0F];
+	}
+	frame[pos++] = ')';
+	frame[pos++] = '\n';
+
+	req = kit_request_at(kit, kit->count);
+	req->talk = (function == 't');
+	req->length = 0;
+
+	status = kit_write(kit, frame, (size_t)pos, &written);
+	if (kit->partial && written > 0)
+	{
+		kit->partial = false;
+		kit->stale++;
+	}
+	if (status != ATCA_SUCCESS)
+	{
+		kit->partial = (written > (size_t)start);
+		return ATCA_TX_FAIL;
+	}
+
+	kit->count++;
+	return ATCA_SUCCESS;
+}
+
+/** \brief hand the reply of the oldest outstanding command packet to the caller
+ * \param[inout] kit - kit interface, the head request must have its reply
+ * \param[out] rxdata - receives the device's response
+ * \param[inout] rxlength - in: room in rxdata, out: number of bytes the device returned
+ * \return ATCA_SUCCESS, ATCA_COMM_FAIL if the kit couldn't talk to the device, ATCA_INVALID_SIZE if rxdata is too small
+ */
+static ATCA_STATUS kit_take_reply(ATCAKitCdc_t *kit, uint8_t *rxdata, uint16_t *rxlength)
+{
+	ATCAKitRequest_t *req = &kit->requests[kit->head];
+	ATCA_STATUS status = ATCA_SUCCESS;
+
+	if (req->status != 0x00 || req->length == 0)
+		status = ATCA_COMM_FAIL;
+	else if (req->length > *rxlength)
+		status = ATCA_INVALID_SIZE;
+	else
+	{
+		memcpy(rxdata, req->data, req->length);
+		*rxlength = req->length;
+	}
+
+	kit->head = (kit->head + 1) % ATCA_KIT_PIPELINE_DEPTH;
+	kit->count--;
+	kit->parsed--;
+
+	return status;
+}
+
+/** \brief termios speed for a baud rate
+ * \param[in] baud - baud rate
+ * \param[out] speed - termios speed
+ * \return true if the rate is supported
+ */
+static bool kit_speed(uint32_t baud, speed_t *speed)
+{
+	switch (baud)
+	{
+		case 9600:    *speed = B9600;    return true;
+		case 19200:   *speed = B19200;   return true;
+		case 38400:   *speed = B38400;   return true;
+		case 57600:   *speed = B57600;   return true;
+		case 115200:  *speed = B115200;  return true;
+		case 230400:  *speed = B230400;  return true;
+		#ifdef B460800
+		case 460800:  *speed = B460800;  return true;
+		#endif
+		#ifdef B921600
+		case 921600:  *speed = B921600;  return true;
+		#endif
+		default:      return false;
+	}
+}
+
+/** \brief initialize a kit CDC interface using given config, opening and setting up the tty
+ * \param[in] hal - opaque ptr to HAL data
+ * \param[in] cfg - interface configuration
+ */
+ATCA_STATUS hal_kit_cdc_init(void *hal, ATCAIfaceCfg *cfg)
+{
+	ATCAHAL_t *phal = (ATCAHAL_t *)hal;
+	char path[32];
+	const char *device = cfg->atcauart.device;
+	struct termios tio;
+	speed_t speed;
+	ATCAKitCdc_t *kit;
+
+	if (!kit_speed(cfg->atcauart.baud, &speed) || cfg->atcauart.wordsize < 5 || cfg->atcauart.wordsize > 8)
+		return ATCA_BAD_PARAM;
+
+	if (device == NULL)
+	{
+		snprintf(path, sizeof(path), "/dev/ttyACM%d", cfg->atcauart.port);
+		device = path;
+	}
+
+	kit = malloc(sizeof(ATCAKitCdc_t));
+	if (kit == NULL)
+		return ATCA_GEN_FAIL;
+	memset(kit, 0, sizeof(ATCAKitCdc_t));
+	kit->target = (cfg->devtype == ATSHA204A) ? 's' : 'e';
+
+	kit->fd = open(device, O_RDWR | O_NOCTTY | O_NONBLOCK);
+	if (kit->fd < 0)
+	{
+		free(kit);
+		return ATCA_COMM_FAIL;
+	}
+
+	// raw 8N1-style line as configured, the kit protocol is plain ASCII lines
+	if (tcgetattr(kit->fd, &tio) == 0)
+	{
+		static const tcflag_t sizes[] = { CS5, CS6, CS7, CS8 };
+
+		cfmakeraw(&tio);
+		tio.c_cflag &= ~(CSIZE | PARENB | PARODD | CSTOPB);
+		tio.c_cflag |= CLOCAL | CREAD | sizes[cfg->atcauart.wordsize - 5];
+		if (cfg->atcauart.parity == 0)
+			tio.c_cflag |= PARENB;
+		else if (cfg->atcauart.parity == 1)
+			tio.c_cflag |= PARENB | PARODD;
+		if (cfg->atcauart.stopbits == 2)
+			tio.c_cflag |= CSTOPB;
+		cfsetispeed(&tio, speed);
+		cfsetospeed(&tio, speed);
+		tcsetattr(kit->fd, TCSANOW, &tio);
+	}
+
+	phal->hal_data = kit;
+
+	return ATCA_SUCCESS;
+}
+
+/** \brief HAL implementation of kit CDC post init, drops anything the kit sent before we opened it
+	* \param[in] ATCAIface instance
+	* \return ATCA_STATUS
+ */
+ATCA_STATUS hal_kit_cdc_post_init(ATCAIface iface)
+{
+	ATCAKitCdc_t *kit = (ATCAKitCdc_t *)atgetifacehaldat(iface);
+
+	tcflush(kit->fd, TCIFLUSH);
+
+	return ATCA_SUCCESS;
+}
+
+/** \brief HAL implementation of kit CDC send.  Writes the command packet as a talk request and returns
+ *  without waiting for the reply, so further packets can be sent while the kit works on this one.
+	* \param[in] ATCAIface instance
+	* \param[in] txdata pointer to space to bytes to send
+	* \param[in] txlength number of bytes to send
+	* \return ATCA_STATUS
+ */
+ATCA_STATUS hal_kit_cdc_send(ATCAIface iface, uint8_t *txdata, int txlength)
+{
+	ATCAKitCdc_t *kit = (ATCAKitCdc_t *)atgetifacehaldat(iface);
+
+	// the kit takes the packet from its count byte, the word address value slot isn't sent
+	return kit_send_request(kit, 't', &txdata[1], txlength);
+}
+
+/** \brief HAL implementation of kit CDC receive, returns the reply to the oldest packet sent and not yet received
+ * \param[in] ATCAIface instance
+ * \param[in] rxdata pointer to space to receive the data
+ * \param[inout] ptr to room in rxdata, receives the number of bytes the device returned
+ * \return ATCA_STATUS
+ */
+ATCA_STATUS hal_kit_cdc_receive(ATCAIface iface, uint8_t *rxdata, uint16_t *rxlength)
+{
+	ATCAIfaceCfg *cfg = atgetifacecfg(iface);
+	ATCAKitCdc_t *kit = (ATCAKitCdc_t *)atgetifacehaldat(iface);
+	ATCA_STATUS status;
+
+	// when polling for completion, atwaitreceive() paces the retries and no reply just means "not done yet"
+	status = kit_wait_head(kit, cfg->exec_mode != ATCA_EXEC_POLL);
+	if (status != ATCA_SUCCESS)
+		return status;
+
+	return kit_take_reply(kit, rxdata, rxlength);
+}
+
+/** \brief send a batch of command packets and receive their responses, keeping up to
+ *  ATCA_KIT_PIPELINE_DEPTH of them in flight so the serial transfer of one packet overlaps the
+ *  execution of the ones before it.  The device must be awake and must not need to be woken again
+ *  before the batch is done.
+ * \param[in] iface - kit CDC interface
+ * \param[in] txdata - command packets, in the layout hal_kit_cdc_send() takes
+ * \param[in] txlength - number of bytes to send of each packet
+ * \param[out] rxdata - receive the responses
+ * \param[inout] rxlength - room in each rxdata, receive the number of bytes of each response
+ * \param[in] count - number of packets
+ * \return ATCA_SUCCESS if every packet got a response, otherwise the status of the first that didn't
+ */
+ATCA_STATUS hal_kit_cdc_pipeline(ATCAIface iface, uint8_t *txdata[], const int txlength[], uint8_t *rxdata[], uint16_t rxlength[], int count)
+{
+	ATCAKitCdc_t *kit = (ATCAKitCdc_t *)atgetifacehaldat(iface);
+	ATCA_STATUS status, first = ATCA_SUCCESS;
+	int sent = 0, received = 0;
+
+	while (received < count)
+	{
+		// top the pipeline up, then take one reply
+		while (sent < count && sent - received < ATCA_KIT_PIPELINE_DEPTH && kit->count < ATCA_KIT_PIPELINE_DEPTH)
+		{
+			if ((status = kit_send_request(kit, 't', &txdata[sent][1], txlength[sent])) != ATCA_SUCCESS)
+			{
+				kit_abandon(kit);
+				return first != ATCA_SUCCESS ? first : status;
+			}
+			sent++;
+		}
+
+		if ((status = kit_wait_head(kit, true)) != ATCA_SUCCESS)
+			return first != ATCA_SUCCESS ? first : status;
+
+		status = kit_take_reply(kit, rxdata[received], &rxlength[received]);
+		if (status != ATCA_SUCCESS && first == ATCA_SUCCESS)
+			first = status;
+		received++;
+	}
+
+	return first;
+}
+
+/** \brief wake up CryptoAuth device on the kit.  A wake starts over, replies still due to earlier
+ *  requests nobody received are dropped.
+ * \param[in] interface to logical device to wakeup
+ */
+ATCA_STATUS hal_kit_cdc_wake(ATCAIface iface)
+{
+	ATCAKitCdc_t *kit = (ATCAKitCdc_t *)atgetifacehaldat(iface);
+	uint8_t expected[4] = { 0x04,0x11,0x33,0x43 };
+	ATCAKitRequest_t *req;
+	ATCA_STATUS status;
+
+	kit_abandon(kit);
+
+	if ((status = kit_send_request(kit, 'w', NULL, 0)) != ATCA_SUCCESS)
+		return ATCA_COMM_FAIL;
+
+	// the wake request is the only one outstanding, wait for its reply without retiring it
+	while (kit->parsed == 0)
+	{
+		if (kit_fill(kit, ATCA_KIT_RX_TIMEOUT_MS) != ATCA_SUCCESS)
+		{
+			// the kit went quiet, so no reply is still coming for anything sent before
+			kit_abandon(kit);
+			kit->stale = 0;
+			tcflush(kit->fd, TCIFLUSH);
+			return ATCA_COMM_FAIL;
+		}
+	}
+
+	req = &kit->requests[kit->head];
+	status = (req->status == 0x00 && req->length == 4 && memcmp(req->data, expected, 4) == 0) ? ATCA_SUCCESS : ATCA_COMM_FAIL;
+	kit_retire(kit);
+
+	return status;
+}
+
+/** \brief idle CryptoAuth device on the kit, the reply is collected with the next one
+ * \param[in] interface to logical device to idle
+ */
+ATCA_STATUS hal_kit_cdc_idle(ATCAIface iface)
+{
+	return kit_send_request((ATCAKitCdc_t *)atgetifacehaldat(iface), 'i', NULL, 0);
+}
+
+/** \brief sleep CryptoAuth device on the kit, the reply is collected with the next one
+ * \param[in] interface to logical device to sleep
+ */
+ATCA_STATUS hal_kit_cdc_sleep(ATCAIface iface)
+{
+	return kit_send_request((ATCAKitCdc_t *)atgetifacehaldat(iface), 's', NULL, 0);
+}
+
+/** \brief closes the tty of the kit
+ * \param[in] hal_data - opaque pointer to hal data structure - known only to the HAL implementation
+ */
+ATCA_STATUS hal_kit_cdc_release(void *hal_data)
+{
+	ATCAKitCdc_t *kit = (ATCAKitCdc_t *)hal_data;
+
+	if (kit)
+	{
+		close(kit->fd);
+		free(kit);
+	}
+
+	return ATCA_SUCCESS;
+}
+
+/** @} */
@@ -0,0 +1,108 @@
+/** \brief ATCA Hardware abstraction layer for a CryptoAuth device on an Atmel kit board, driven over
+* the kit's USB CDC serial port with the ASCII kit protocol.
+*
+* Copyright (c) 2015 Atmel Corporation. All rights reserved.
+*
+* \asf_license_start
+*
+* \page License
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*
+* 1. Redistributions of source code must retain the above copyright notice,
+*    this list of conditions and the following disclaimer.
+*
+* 2. Redistributions in binary form must reproduce the above copyright notice,
+*    this list of conditions and the following disclaimer in the documentation
+*    and/or other materials provided with the distribution.
+*
+* 3. The name of Atmel may not be used to endorse or promote products derived
+*    from this software without specific prior written permission.
+*
+* 4. This software may only be redistributed and used in connection with an
+*    Atmel microcontroller product.
+*
+* THIS SOFTWARE IS PROVIDED BY ATMEL "AS IS" AND ANY EXPRESS OR IMPLIED
+* WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT ARE
+* EXPRESSLY AND SPECIFICALLY DISCLAIMED. IN NO EVENT SHALL ATMEL BE LIABLE FOR
+* ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+* OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+* HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+* STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+* ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+* POSSIBILITY OF SUCH DAMAGE.
+*
+* \asf_license_stop
+ */
+
+#ifndef HAL_KIT_CDC_H_
+#define HAL_KIT_CDC_H_
+
+#include <stdbool.h>
+#include "atca_hal.h"
+
+/** \defgroup hal_ Crypto hardware abstraction layer (hal_)
+ *
+ * \brief
+ * These methods define the hardware abstraction layer for communicating with a CryptoAuth device
+ * on a kit board over the board's CDC serial port.
+ *
+@{ */
+
+/* Kit protocol.  Every request is one line of ASCII, a target letter ('e' for ECC devices, 's' for SHA
+ * devices), a colon, a function letter and its argument as hex in parentheses:
+ *
+ *     e:w()           wake the device                 reply: 00(04113343)
+ *     e:i()           idle the device                 reply: 00()
+ *     e:s()           sleep the device                reply: 00()
+ *     e:t(0703...)    send a command packet, starting
+ *                     at its count byte, and return
+ *                     the device's response           reply: 00(0400...)
+ *
+ * The kit answers every request with one line, a two digit kit status (00 when it could talk to the
+ * device) followed by the bytes the device returned.  A line it can't make sense of gets a reply too.  The kit runs the requests it receives in order,
+ * so a host may send the next requests before the earlier replies come back and match the replies up
+ * by position.  This HAL keeps up to ATCA_KIT_PIPELINE_DEPTH requests in flight that way.
+ */
+#define ATCA_KIT_PIPELINE_DEPTH (8)     // requests that may be sent ahead of their replies
+#define ATCA_KIT_DATA_MAX       (130)   // largest reply from the device, same as ATCAPacket.data
+#define ATCA_KIT_LINE_MAX       (2 * ATCA_KIT_DATA_MAX + 8)  // longest reply line kept, longer lines are discarded
+#define ATCA_KIT_READ_CHUNK     (512)   // bytes taken from the tty per read()
+#define ATCA_KIT_RX_TIMEOUT_MS  (1000)  // a reply is given up on after the kit was quiet this long
+
+/** \brief a request sent to the kit and, once its reply line arrived, the reply */
+typedef struct atcaKitRequest
+{
+	bool     talk;       // a command packet whose reply is for the caller, otherwise wake/idle/sleep
+	uint8_t  status;     // kit status of the reply, 0xFF if the reply line was malformed
+	uint16_t length;     // number of bytes in data
+	uint8_t  data[ATCA_KIT_DATA_MAX];
+} ATCAKitRequest_t;
+
+/** \brief this is the hal_data for a kit CDC interface, each interface has its own tty */
+typedef struct atcaKitCdc
+{
+	int  fd;
+	char target;                // target letter of the device type, see kit protocol above
+
+	// requests in the order they were sent, the oldest at head.  The first parsed of them have their reply.
+	ATCAKitRequest_t requests[ATCA_KIT_PIPELINE_DEPTH];
+	int  head;
+	int  count;
+	int  parsed;
+	int  stale;                 // replies still to come for requests that were abandoned, these are dropped
+	bool partial;               // the last request line was cut off by a failed write and isn't ended yet
+
+	// reply line being assembled from the bytes read so far
+	char line[ATCA_KIT_LINE_MAX];
+	int  line_len;
+	bool line_overflow;
+} ATCAKitCdc_t;
+
+ATCA_STATUS hal_kit_cdc_pipeline(ATCAIface iface, uint8_t *txdata[], const int txlength[], uint8_t *rxdata[], uint16_t rxlength[], int count);
+
+/** @} */
+#endif /* HAL_KIT_CDC_H_ */
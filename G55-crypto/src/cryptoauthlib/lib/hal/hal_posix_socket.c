@@ -0,0 +1,328 @@
+/** \brief ATCA Hardware abstraction layer for a device served by a local process over a Unix
+* domain socket.  Lets the library run on a POSIX host against a device process instead of a TWI bus.
+*
+* Copyright (c) 2015 Atmel Corporation. All rights reserved.
+*
+* \asf_license_start
+*
+* \page License
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*
+* 1. Redistributions of source code must retain the above copyright notice,
+*    this list of conditions and the following disclaimer.
+*
+* 2. Redistributions in binary form must reproduce the above copyright notice,
+*    this list of conditions and the following disclaimer in the documentation
+*    and/or other materials provided with the distribution.
+*
+* 3. The name of Atmel may not be used to endorse or promote products derived
+*    from this software without specific prior written permission.
+*
+* 4. This software may only be redistributed and used in connection with an
+*    Atmel microcontroller product.
+*
+* THIS SOFTWARE IS PROVIDED BY ATMEL "AS IS" AND ANY EXPRESS OR IMPLIED
+* WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT ARE
+* EXPRESSLY AND SPECIFICALLY DISCLAIMED. IN NO EVENT SHALL ATMEL BE LIABLE FOR
+* ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+* OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+* HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+* STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+* ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+* POSSIBILITY OF SUCH DAMAGE.
+*
+* \asf_license_stop
+ */ 
+
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include "atca_hal.h"
+#include "hal_posix_socket.h"
+
+/** \defgroup hal_ Crypto hardware abstraction layer (hal_)
+ *
+ * \brief
+ * These methods define the hardware abstraction layer for communicating with a CryptoAuth device
+ * served by a local process over a Unix domain socket.
+ *
+@{ */
+
+/** \brief send a request frame to the device process and receive its reply
+ * \param[in] sock - connection to the device process
+ * \param[in] op - ATCA_SOCKET_OP_* request
+ * \param[in] payload - request payload
+ * \param[in] length - number of payload bytes
+ * \param[out] rxdata - receives the data of the reply, may be NULL if none is expected
+ * \param[inout] rxlength - in: room in rxdata, out: number of data bytes received.  May be NULL if no data is expected
+ * \return ATCA_SUCCESS if the device acked, ATCA_RX_NO_RESPONSE if it nacked, ATCA_COMM_FAIL if the exchange failed
+ */
+static ATCA_STATUS socket_xfer(ATCASocket_t *sock, uint8_t op, const uint8_t *payload, int length, uint8_t *rxdata, uint16_t *rxlength)
+{
+	uint8_t frame[ATCA_SOCKET_FRAME_MAX];
+	ssize_t ret;
+	
+	if (length < 0 || length + 1 > (int)sizeof(frame))
+	{
+		return ATCA_BAD_PARAM;
+	}
+	
+	frame[0] = op;
+	if (length > 0)
+	{
+		memcpy(&frame[1], payload, length);
+	}
+	
+	do {
+		ret = send(sock->fd, frame, length + 1, MSG_NOSIGNAL);
+	} while (ret < 0 && errno == EINTR);
+	if (ret != length + 1)
+	{
+		return ATCA_COMM_FAIL;
+	}
+	
+	do {
+		ret = recv(sock->fd, frame, sizeof(frame), 0);
+	} while (ret < 0 && errno == EINTR);
+	if (ret < 1)
+	{
+		return ATCA_COMM_FAIL;
+	}
+	
+	if (frame[0] == ATCA_SOCKET_NACK)
+	{
+		return ATCA_RX_NO_RESPONSE;
+	}
+	if (frame[0] != ATCA_SOCKET_ACK)
+	{
+		return ATCA_COMM_FAIL;
+	}
+	
+	if (rxlength)
+	{
+		if (ret - 1 > *rxlength)
+		{
+			return ATCA_INVALID_SIZE;
+		}
+		*rxlength = (uint16_t)(ret - 1);
+		memcpy(rxdata, &frame[1], *rxlength);
+	}
+	
+	return ATCA_SUCCESS;
+}
+
+/** \brief read bytes from the device, as an I2C read would
+ * \param[in] sock - connection to the device process
+ * \param[out] rxdata - receives the bytes read
+ * \param[in] length - number of bytes to read
+ * \return ATCA_SUCCESS if all bytes were read, ATCA_RX_NO_RESPONSE if the device nacked, otherwise ATCA_COMM_FAIL
+ */
+static ATCA_STATUS socket_read(ATCASocket_t *sock, uint8_t *rxdata, uint16_t length)
+{
+	uint8_t request[2] = { (uint8_t)(length & 0xFF), (uint8_t)(length >> 8) };
+	uint16_t rxlength = length;
+	ATCA_STATUS status;
+	
+	status = socket_xfer(sock, ATCA_SOCKET_OP_READ, request, sizeof(request), rxdata, &rxlength);
+	if (status == ATCA_SUCCESS && rxlength != length)
+	{
+		return ATCA_COMM_FAIL;
+	}
+	
+	return status;
+}
+
+/** \brief write a word address value and no data, used for idle and sleep
+ * \param[in] iface - interface of the device
+ * \param[in] word_address - word address value to write
+ * \return ATCA_STATUS
+ */
+static ATCA_STATUS socket_write_word_address(ATCAIface iface, uint8_t word_address)
+{
+	ATCASocket_t *sock = (ATCASocket_t *)atgetifacehaldat(iface);
+	
+	if (socket_xfer(sock, ATCA_SOCKET_OP_WRITE, &word_address, 1, NULL, NULL) != ATCA_SUCCESS)
+	{
+		return ATCA_COMM_FAIL;
+	}
+	
+	return ATCA_SUCCESS;
+}
+
+/** \brief initialize a socket interface using given config, connecting to the device process
+ * \param[in] hal - opaque ptr to HAL data
+ * \param[in] cfg - interface configuration
+ */
+ATCA_STATUS hal_socket_init(void *hal, ATCAIfaceCfg *cfg)
+{
+	ATCAHAL_t *phal = (ATCAHAL_t *)hal;
+	struct sockaddr_un addr;
+	ATCASocket_t *sock;
+	
+	if (cfg->atcasocket.path == NULL || strlen(cfg->atcasocket.path) >= sizeof(addr.sun_path))
+	{
+		return ATCA_BAD_PARAM;
+	}
+	
+	memset(&addr, 0, sizeof(addr));
+	addr.sun_family = AF_UNIX;
+	strcpy(addr.sun_path, cfg->atcasocket.path);
+	
+	sock = malloc(sizeof(ATCASocket_t));
+	if (sock == NULL)
+	{
+		return ATCA_GEN_FAIL;
+	}
+	
+	sock->fd = socket(AF_UNIX, SOCK_SEQPACKET, 0);
+	if (sock->fd < 0 || connect(sock->fd, (struct sockaddr *)&addr, sizeof(addr)) != 0)
+	{
+		if (sock->fd >= 0)
+		{
+			close(sock->fd);
+		}
+		free(sock);
+		return ATCA_COMM_FAIL;
+	}
+	
+	phal->hal_data = sock;
+	
+	return ATCA_SUCCESS;
+}
+
+/** \brief HAL implementation of socket post init
+	* \param[in] ATCAIface instance
+	* \return ATCA_STATUS
+ */
+ATCA_STATUS hal_socket_post_init(ATCAIface iface)
+{
+	return ATCA_SUCCESS;
+}
+
+/** \brief HAL implementation of socket send, writes the command packet as hal_i2c_send() would
+	* \param[in] ATCAIface instance
+	* \param[in] txdata pointer to space to bytes to send
+	* \param[in] txlength number of bytes to send
+	* \return ATCA_STATUS
+ */
+ATCA_STATUS hal_socket_send(ATCAIface iface, uint8_t *txdata, int txlength)
+{
+	ATCASocket_t *sock = (ATCASocket_t *)atgetifacehaldat(iface);
+	
+	txdata[0] = 0x03;   // insert the Word Address Value, Command token
+	txlength++;         // account for word address value byte.
+	
+	if (socket_xfer(sock, ATCA_SOCKET_OP_WRITE, txdata, txlength, NULL, NULL) != ATCA_SUCCESS)
+	{
+		return ATCA_COMM_FAIL;
+	}
+	
+	return ATCA_SUCCESS;
+}
+
+/** \brief HAL implementation of socket receive
+ * \param[in] ATCAIface instance
+ * \param[in] rxdata pointer to space to receive the data
+ * \param[in] ptr to expected number of receive bytes to request
+ * \return ATCA_STATUS
+ */
+ATCA_STATUS hal_socket_receive(ATCAIface iface, uint8_t *rxdata, uint16_t *rxlength)
+{
+	ATCAIfaceCfg *cfg = atgetifacecfg(iface);
+	ATCASocket_t *sock = (ATCASocket_t *)atgetifacehaldat(iface);
+	int retries = cfg->rx_retries;
+	ATCA_STATUS status = ATCA_RX_NO_RESPONSE;
+	
+	// when polling for completion, atwaitreceive() paces the retries and a NACK just means "not done yet"
+	if (cfg->exec_mode == ATCA_EXEC_POLL)
+	{
+		retries = 1;
+	}
+	
+	while (retries-- > 0 && status == ATCA_RX_NO_RESPONSE)
+	{
+		status = socket_read(sock, rxdata, *rxlength);
+	}
+	if (status != ATCA_SUCCESS)
+	{
+		if (status == ATCA_RX_NO_RESPONSE && cfg->exec_mode == ATCA_EXEC_POLL)
+		{
+			return ATCA_RX_NO_RESPONSE;
+		}
+		return ATCA_COMM_FAIL;
+	}
+	
+	return ATCA_SUCCESS;
+}
+
+/** \brief wake up CryptoAuth device served over the socket
+ * \param[in] interface to logical device to wakeup
+ */
+ATCA_STATUS hal_socket_wake(ATCAIface iface)
+{
+	ATCAIfaceCfg *cfg = atgetifacecfg(iface);
+	ATCASocket_t *sock = (ATCASocket_t *)atgetifacehaldat(iface);
+	int retries = cfg->rx_retries;
+	uint8_t data[4], expected[4] = { 0x04,0x11,0x33,0x43 };
+	ATCA_STATUS status = ATCA_RX_NO_RESPONSE;
+	
+	if (socket_xfer(sock, ATCA_SOCKET_OP_WAKE, NULL, 0, NULL, NULL) != ATCA_SUCCESS)
+	{
+		return ATCA_COMM_FAIL;
+	}
+	
+	atca_delay_us(cfg->wake_delay);	// wait tWHI + tWLO which is configured based on device type and configuration structure
+	
+	while (retries-- > 0 && status == ATCA_RX_NO_RESPONSE)
+	{
+		status = socket_read(sock, data, sizeof(data));
+	}
+	
+	if (status == ATCA_SUCCESS && memcmp(data, expected, 4) == 0)
+	{
+		return ATCA_SUCCESS;
+	}
+	
+	return ATCA_COMM_FAIL;
+}
+
+/** \brief idle CryptoAuth device served over the socket
+ * \param[in] interface to logical device to idle
+ */
+ATCA_STATUS hal_socket_idle(ATCAIface iface)
+{
+	return socket_write_word_address(iface, 0x02);	// idle word address value
+}
+
+/** \brief sleep CryptoAuth device served over the socket
+ * \param[in] interface to logical device to sleep
+ */
+ATCA_STATUS hal_socket_sleep(ATCAIface iface)
+{
+	return socket_write_word_address(iface, 0x01);	// sleep word address value
+}
+
+/** \brief closes the connection to the device process
+ * \param[in] hal_data - opaque pointer to hal data structure - known only to the HAL implementation
+ */
+ATCA_STATUS hal_socket_release(void *hal_data)
+{
+	ATCASocket_t *sock = (ATCASocket_t *)hal_data;
+	
+	if (sock)
+	{
+		close(sock->fd);
+		free(sock);
+	}
+	
+	return ATCA_SUCCESS;
+}
+
+/** @} */
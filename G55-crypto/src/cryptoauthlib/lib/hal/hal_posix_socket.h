@@ -0,0 +1,76 @@
+/** \brief ATCA Hardware abstraction layer for a device served by a local process over a Unix
+* domain socket.  Lets the library run on a POSIX host against a device process instead of a TWI bus.
+*
+* Copyright (c) 2015 Atmel Corporation. All rights reserved.
+*
+* \asf_license_start
+*
+* \page License
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*
+* 1. Redistributions of source code must retain the above copyright notice,
+*    this list of conditions and the following disclaimer.
+*
+* 2. Redistributions in binary form must reproduce the above copyright notice,
+*    this list of conditions and the following disclaimer in the documentation
+*    and/or other materials provided with the distribution.
+*
+* 3. The name of Atmel may not be used to endorse or promote products derived
+*    from this software without specific prior written permission.
+*
+* 4. This software may only be redistributed and used in connection with an
+*    Atmel microcontroller product.
+*
+* THIS SOFTWARE IS PROVIDED BY ATMEL "AS IS" AND ANY EXPRESS OR IMPLIED
+* WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT ARE
+* EXPRESSLY AND SPECIFICALLY DISCLAIMED. IN NO EVENT SHALL ATMEL BE LIABLE FOR
+* ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+* OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+* HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+* STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+* ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+* POSSIBILITY OF SUCH DAMAGE.
+*
+* \asf_license_stop
+ */ 
+
+#ifndef HAL_POSIX_SOCKET_H_
+#define HAL_POSIX_SOCKET_H_
+
+#include "atca_hal.h"
+
+/** \defgroup hal_ Crypto hardware abstraction layer (hal_)
+ *
+ * \brief
+ * These methods define the hardware abstraction layer for communicating with a CryptoAuth device
+ * served by a local process over a Unix domain socket.
+ *
+@{ */
+
+/* Wire protocol.  The socket is a SOCK_SEQPACKET socket, every message is one frame.  The host sends a
+ * request frame, an op byte followed by its payload, and the device process answers every request
+ * with a reply frame, an ack byte followed by any data read.  Together they mirror the I2C transactions
+ * of hal_sam4s_i2c_asf.c, so the device process sees the same byte stream a chip on the bus would.
+ */
+#define ATCA_SOCKET_OP_WAKE     ((uint8_t)0x00)  // wake pulse, no payload
+#define ATCA_SOCKET_OP_WRITE    ((uint8_t)0x01)  // payload: word address followed by the bytes written
+#define ATCA_SOCKET_OP_READ     ((uint8_t)0x02)  // payload: number of bytes to read, 16 bit little endian
+
+#define ATCA_SOCKET_ACK         ((uint8_t)0x00)  // the device took the request, a read reply carries the data
+#define ATCA_SOCKET_NACK        ((uint8_t)0x01)  // the device is asleep or busy executing a command
+
+#define ATCA_SOCKET_FRAME_MAX   (260)            // largest frame either way, a 255 byte packet plus headers
+
+/** \brief this is the hal_data for a socket interface, each interface has its own connection
+ */
+typedef struct atcaSocket
+{
+	int fd;
+} ATCASocket_t;
+
+/** @} */
+#endif /* HAL_POSIX_SOCKET_H_ */
@@ -0,0 +1,98 @@
+/** \brief ATCA Hardware abstraction layer timer for POSIX hosts, over nanosleep() and CLOCK_MONOTONIC.
+*
+* Copyright (c) 2015 Atmel Corporation. All rights reserved.
+*
+* \asf_license_start
+*
+* \page License
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*
+* 1. Redistributions of source code must retain the above copyright notice,
+*    this list of conditions and the following disclaimer.
+*
+* 2. Redistributions in binary form must reproduce the above copyright notice,
+*    this list of conditions and the following disclaimer in the documentation
+*    and/or other materials provided with the distribution.
+*
+* 3. The name of Atmel may not be used to endorse or promote products derived
+*    from this software without specific prior written permission.
+*
+* 4. This software may only be redistributed and used in connection with an
+*    Atmel microcontroller product.
+*
+* THIS SOFTWARE IS PROVIDED BY ATMEL "AS IS" AND ANY EXPRESS OR IMPLIED
+* WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT ARE
+* EXPRESSLY AND SPECIFICALLY DISCLAIMED. IN NO EVENT SHALL ATMEL BE LIABLE FOR
+* ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+* OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+* HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+* STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+* ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+* POSSIBILITY OF SUCH DAMAGE.
+*
+* \asf_license_stop
+ */ 
+
+#include <time.h>
+#include <errno.h>
+#include "atca_hal.h"
+
+/** \defgroup hal_ Hardware abstraction layer (hal_)
+ *
+ * \brief
+ * These methods define the hardware abstraction layer for communicating with a CryptoAuth device
+ *
+@{ */
+
+/** \brief This function delays for a number of microseconds.
+ *
+ * \param[in] delay number of microseconds to delay
+ */
+void atca_delay_us(uint32_t delay)
+{
+	struct timespec ts = { .tv_sec = delay / 1000000, .tv_nsec = (long)(delay % 1000000) * 1000 };
+	
+	// sleep out the remainder if a signal interrupts the delay
+	while (nanosleep(&ts, &ts) != 0 && errno == EINTR)
+		;
+}
+
+/** \brief This function delays for a number of tens of microseconds.
+ *
+ * \param[in] delay number of 0.01 milliseconds to delay
+ */
+void atca_delay_10us(uint32_t delay)
+{
+	atca_delay_us(delay * 10);
+}
+
+/** \brief This function delays for a number of milliseconds.
+ *
+ * \param[in] delay number of milliseconds to delay
+ */
+void atca_delay_ms(uint32_t delay)
+{
+	struct timespec ts = { .tv_sec = delay / 1000, .tv_nsec = (long)(delay % 1000) * 1000000 };
+	
+	while (nanosleep(&ts, &ts) != 0 && errno == EINTR)
+		;
+}
+
+/** \brief This function returns a free running millisecond tick count, used to time
+ *         commands running in the background without blocking.
+ *
+ * \return milliseconds of CLOCK_MONOTONIC, wrapping at 32 bits
+ */
+uint32_t atca_ticks_ms(void)
+{
+	struct timespec ts;
+	
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint32_t)((uint64_t)ts.tv_sec * 1000 + ts.tv_nsec / 1000000);
+}
+
+/** @} */
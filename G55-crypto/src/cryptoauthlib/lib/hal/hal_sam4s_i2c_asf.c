@@ -93,6 +93,255 @@ static void print_array(uint8_t *data, uint32_t data_size)
 }
 #endif
 
+#ifdef ATCA_I2C_PDC
+/** \brief states of a PDC and interrupt driven transfer, see the datasheet section on using the PDC with the TWI */
+enum {
+	I2C_XFER_IDLE,
+	I2C_XFER_WRITE,         // PDC sends all bytes but the last, wait for ENDTX
+	I2C_XFER_WRITE_LAST,    // wait for TXRDY, then STOP and the last byte
+	I2C_XFER_READ,          // PDC receives all bytes but the last two, wait for ENDRX
+	I2C_XFER_READ_LAST2,    // wait for RXRDY, then STOP and read the penultimate byte
+	I2C_XFER_READ_LAST,     // wait for RXRDY, then read the last byte
+	I2C_XFER_STOP           // wait for TXCOMP
+};
+
+/** \brief transfer in flight on a bus, owned by the TWI interrupt handler until state returns to I2C_XFER_IDLE */
+typedef struct {
+	volatile uint8_t  state;
+	volatile uint32_t status;   // TWI_SUCCESS or error of the last completed transfer
+	uint8_t *buffer;
+	uint32_t length;
+	uint32_t byte_us;           // time a byte and its ACK take on the wire at the bus clock, see hal_i2c_set_speed()
+} i2c_xfer_t;
+
+#define I2C_XFER_IRQS       (TWI_IDR_ENDTX | TWI_IDR_ENDRX | TWI_IDR_TXRDY | TWI_IDR_RXRDY | TWI_IDR_TXCOMP | TWI_IDR_NACK)
+#define I2C_XFER_MARGIN_MS  (2)     // allowed on top of the time a transfer takes on the wire, covers the tick resolution
+
+static Twi * const i2c_twi[MAX_I2C_BUSES] = { TWI_Channel0, TWI_Channel1 };
+static const IRQn_Type i2c_irq[MAX_I2C_BUSES] = { TWI4_IRQn, TWI1_IRQn };
+static i2c_xfer_t i2c_xfer[MAX_I2C_BUSES];
+static hal_i2c_xfer_callback i2c_xfer_callback = NULL;
+
+/** \brief register a function called from interrupt context each time a PDC transfer completes
+ * \param[in] callback - function receiving the logical bus and the TWI status, NULL to remove
+ */
+void hal_i2c_set_xfer_callback(hal_i2c_xfer_callback callback)
+{
+	i2c_xfer_callback = callback;
+}
+
+/** \brief ends the transfer on a bus and notifies the waiter
+ * \param[in] bus - logical bus number
+ * \param[in] status - TWI status of the transfer
+ */
+static void i2c_xfer_done(int bus, uint32_t status)
+{
+	Twi *twi = i2c_twi[bus];
+	
+	twi_disable_interrupt(twi, I2C_XFER_IRQS);
+	twi_master_pdc_disable(twi);
+	i2c_xfer[bus].status = status;
+	i2c_xfer[bus].state = I2C_XFER_IDLE;
+	
+	if (i2c_xfer_callback)
+	{
+		i2c_xfer_callback(bus, status);
+	}
+}
+
+/** \brief advances the transfer on a bus, called from the TWI interrupt handler
+ * \param[in] bus - logical bus number
+ */
+static void i2c_xfer_isr(int bus)
+{
+	Twi *twi = i2c_twi[bus];
+	i2c_xfer_t *xfer = &i2c_xfer[bus];
+	uint32_t status = twi_get_interrupt_status(twi);    // reading clears NACK, so read it once
+	
+	if (xfer->state == I2C_XFER_IDLE)
+	{
+		twi_disable_interrupt(twi, I2C_XFER_IRQS);
+		return;
+	}
+	
+	if (status & TWI_SR_NACK)
+	{
+		i2c_xfer_done(bus, TWI_RECEIVE_NACK);
+		return;
+	}
+	
+	switch (xfer->state)
+	{
+		case I2C_XFER_WRITE:
+			if (status & TWI_SR_ENDTX)
+			{
+				twi_master_pdc_disable(twi);
+				twi_disable_interrupt(twi, TWI_IDR_ENDTX);
+				xfer->state = I2C_XFER_WRITE_LAST;
+				twi_enable_interrupt(twi, TWI_IER_TXRDY);
+			}
+			break;
+			
+		case I2C_XFER_WRITE_LAST:
+			if (status & TWI_SR_TXRDY)
+			{
+				twi->TWI_CR = TWI_CR_STOP;
+				twi->TWI_THR = xfer->buffer[xfer->length - 1];
+				twi_disable_interrupt(twi, TWI_IDR_TXRDY);
+				xfer->state = I2C_XFER_STOP;
+				twi_enable_interrupt(twi, TWI_IER_TXCOMP);
+			}
+			break;
+			
+		case I2C_XFER_READ:
+			if (status & TWI_SR_ENDRX)
+			{
+				twi_master_pdc_disable(twi);
+				twi_disable_interrupt(twi, TWI_IDR_ENDRX);
+				xfer->state = I2C_XFER_READ_LAST2;
+				twi_enable_interrupt(twi, TWI_IER_RXRDY);
+			}
+			break;
+			
+		case I2C_XFER_READ_LAST2:
+			if (status & TWI_SR_RXRDY)
+			{
+				twi->TWI_CR = TWI_CR_STOP;
+				xfer->buffer[xfer->length - 2] = twi->TWI_RHR;
+				xfer->state = I2C_XFER_READ_LAST;
+			}
+			break;
+			
+		case I2C_XFER_READ_LAST:
+			if (status & TWI_SR_RXRDY)
+			{
+				xfer->buffer[xfer->length - 1] = twi->TWI_RHR;
+				twi_disable_interrupt(twi, TWI_IDR_RXRDY);
+				xfer->state = I2C_XFER_STOP;
+				twi_enable_interrupt(twi, TWI_IER_TXCOMP);
+			}
+			break;
+			
+		case I2C_XFER_STOP:
+			if (status & TWI_SR_TXCOMP)
+			{
+				i2c_xfer_done(bus, TWI_SUCCESS);
+			}
+			break;
+	}
+}
+
+void TWI4_Handler(void)
+{
+	i2c_xfer_isr(0);
+}
+
+void TWI1_Handler(void)
+{
+	i2c_xfer_isr(1);
+}
+
+/** \brief sleeps until the transfer on a bus completes or times out.  The timeout is the time the address
+ *  and data bytes take at the bus clock plus I2C_XFER_MARGIN_MS, a 160 byte read takes 14.5 ms at 100 kHz.
+ * \param[in] bus - logical bus number
+ * \return TWI status of the transfer
+ */
+static uint32_t i2c_xfer_wait(int bus)
+{
+	uint32_t start = atca_ticks_ms();
+	uint32_t timeout_ms = ((i2c_xfer[bus].length + 1) * i2c_xfer[bus].byte_us + 999) / 1000 + I2C_XFER_MARGIN_MS;
+	
+	while (i2c_xfer[bus].state != I2C_XFER_IDLE)
+	{
+		if (atca_ticks_ms() - start > timeout_ms)
+		{
+			NVIC_DisableIRQ(i2c_irq[bus]);
+			if (i2c_xfer[bus].state != I2C_XFER_IDLE)
+			{
+				i2c_twi[bus]->TWI_CR = TWI_CR_STOP;
+				i2c_xfer_done(bus, TWI_ERROR_TIMEOUT);
+			}
+			NVIC_EnableIRQ(i2c_irq[bus]);
+			break;
+		}
+		__WFI();    // woken by the TWI interrupt, or at the latest by the next SysTick
+	}
+	
+	return i2c_xfer[bus].status;
+}
+#endif
+
+/** \brief writes a packet on a bus, through the PDC when ATCA_I2C_PDC is defined
+ * \param[in] bus - logical bus number
+ * \param[in] packet - TWI packet to write
+ * \return TWI status
+ */
+static uint32_t hal_i2c_write(int bus, twi_packet_t *packet)
+{
+	if (bus < 0 || bus >= MAX_I2C_BUSES)
+	{
+		return TWI_INVALID_ARGUMENT;
+	}
+	
+#ifdef ATCA_I2C_PDC
+	uint32_t status;
+	
+	i2c_xfer[bus].buffer = packet->buffer;
+	i2c_xfer[bus].length = packet->length;
+	i2c_xfer[bus].state = packet->length > 1 ? I2C_XFER_WRITE : I2C_XFER_WRITE_LAST;
+	
+	if ((status = twi_master_pdc_write_start(i2c_twi[bus], packet)) != TWI_SUCCESS)
+	{
+		i2c_xfer[bus].state = I2C_XFER_IDLE;
+		return status;
+	}
+	twi_enable_interrupt(i2c_twi[bus], TWI_IER_NACK | (packet->length > 1 ? TWI_IER_ENDTX : TWI_IER_TXRDY));
+	
+	return i2c_xfer_wait(bus);
+#else
+	return twi_master_write(bus == 0 ? TWI_Channel0 : TWI_Channel1, packet);
+#endif
+}
+
+/** \brief reads a packet from a bus, through the PDC when ATCA_I2C_PDC is defined
+ * \param[in] bus - logical bus number
+ * \param[in] packet - TWI packet to read into
+ * \return TWI status
+ */
+static uint32_t hal_i2c_read(int bus, twi_packet_t *packet)
+{
+	if (bus < 0 || bus >= MAX_I2C_BUSES)
+	{
+		return TWI_INVALID_ARGUMENT;
+	}
+	
+#ifdef ATCA_I2C_PDC
+	uint32_t status;
+	
+	i2c_xfer[bus].buffer = packet->buffer;
+	i2c_xfer[bus].length = packet->length;
+	if (packet->length > 2)
+	{
+		i2c_xfer[bus].state = I2C_XFER_READ;
+	}
+	else
+	{
+		i2c_xfer[bus].state = packet->length == 2 ? I2C_XFER_READ_LAST2 : I2C_XFER_READ_LAST;
+	}
+	
+	if ((status = twi_master_pdc_read_start(i2c_twi[bus], packet)) != TWI_SUCCESS)
+	{
+		i2c_xfer[bus].state = I2C_XFER_IDLE;
+		return status;
+	}
+	twi_enable_interrupt(i2c_twi[bus], TWI_IER_NACK | (packet->length > 2 ? TWI_IER_ENDRX : TWI_IER_RXRDY));
+	
+	return i2c_xfer_wait(bus);
+#else
+	return twi_master_read(bus == 0 ? TWI_Channel0 : TWI_Channel1, packet);
+#endif
+}
+
 /** \brief
 	- this HAL implementation assumes you've included the ASF SERCOM I2C libraries in your project, otherwise, 
 	the HAL layer will not compile because the ASF I2C drivers are a dependency *
@@ -104,6 +353,8 @@ static void print_array(uint8_t *data, uint32_t data_size)
  * multiple i2c buses, so hal_i2c_init manages these things and ATCAIFace is abstracted from the physical details.
  */
 
+static void hal_i2c_set_speed(int bus, uint32_t speed);
+
 /** \brief initialize an I2C interface using given config
  * \param[in] hal - opaque ptr to HAL data
  * \param[in] cfg - interface configuration
@@ -131,37 +382,17 @@ ATCA_STATUS hal_i2c_init(void *hal, ATCAIfaceCfg *cfg)
 			i2c_hal_data[bus] = malloc(sizeof(ATCAI2CMaster_t));
 			i2c_hal_data[bus]->ref_ct = 1;	// buses are shared, this is the first instance
 			
-			switch(bus)
-			{
-				/*
-				case 0: pmc_enable_periph_clk(ID_TWI0); break;				
-				case 1: pmc_enable_periph_clk(ID_TWI1); break;
-				*/
-				case 0:
-					//flexcom_enable(FLEXCOM0);
-					//flexcom_set_opmode(FLEXCOM0, FLEXCOM_TWI);
-					flexcom_enable(FLEX_Channel0);
-					flexcom_set_opmode(FLEX_Channel0, FLEXCOM_TWI);
-					break;
-					
-				case 1:
-					flexcom_enable(FLEX_Channel1);
-					flexcom_set_opmode(FLEX_Channel1, FLEXCOM_TWI);
-					break;
-			}
-			
-			opt_twi_master.master_clk = sysclk_get_cpu_hz();
-			opt_twi_master.speed = cfg->atcai2c.baud;
-			opt_twi_master.smbus = 0;
-			
-			switch(bus)
-			{
-				case 0: twi_master_init(TWI_Channel0, &opt_twi_master);break;
-				case 1: twi_master_init(TWI_Channel1, &opt_twi_master);break;
-			}
+			hal_i2c_set_speed(bus, cfg->atcai2c.baud);
 			
 			// store this for use during the release phase
 			i2c_hal_data[bus]->bus_index = bus;
+			
+#ifdef ATCA_I2C_PDC
+			i2c_xfer[bus].state = I2C_XFER_IDLE;
+			twi_disable_interrupt(i2c_twi[bus], I2C_XFER_IRQS);
+			NVIC_ClearPendingIRQ(i2c_irq[bus]);
+			NVIC_EnableIRQ(i2c_irq[bus]);
+#endif
 		}
 		else
 		{
@@ -229,7 +460,7 @@ ATCA_STATUS hal_i2c_send(ATCAIface iface, uint8_t *txdata, int txlength)
 	};*/
 	twi_packet_t packet = {
 		.chip			= cfg->atcai2c.slave_address >> 1,
-		.addr[0]     = NULL,
+		.addr[0]     = 0,
 		.addr_length	= 0,
 		.buffer			= (void*)txdata,
 		.length			= (uint32_t)txlength //(uint32_t)txdata[1]
@@ -240,21 +471,9 @@ ATCA_STATUS hal_i2c_send(ATCAIface iface, uint8_t *txdata, int txlength)
 	// other device types that don't require i/o tokens on the front end of a command need a different hal_i2c_send and wire it up instead of this one
 	// this covers devices such as ATSHA204A and ATECCx08A that require a word address value pre-pended to the packet
 	
-	switch(bus)
+	if (hal_i2c_write(bus, &packet) != TWI_SUCCESS)
 	{
-		case 0:
-			//if (twi_master_write(TWI0, &packet) != TWI_SUCCESS)
-			if (twi_master_write(TWI_Channel0, &packet) != TWI_SUCCESS)
-			{
-				return ATCA_COMM_FAIL;
-			}
-			break;
-		case 1:
-			if (twi_master_write(TWI_Channel1, &packet) != TWI_SUCCESS)
-			{
-				return ATCA_COMM_FAIL;
-			}
-			break;
+		return ATCA_COMM_FAIL;
 	}
 	
 	return ATCA_SUCCESS;
@@ -273,37 +492,26 @@ ATCA_STATUS hal_i2c_receive( ATCAIface iface, uint8_t *rxdata, uint16_t *rxlengt
 #endif
 	
 	ATCAIfaceCfg *cfg = atgetifacecfg(iface);
-	int retries = cfg->rx_retries;
 	int bus = cfg->atcai2c.bus;
-	uint32_t status = !TWI_SUCCESS;
+	uint32_t status;
 	
 	//twi_package_t packet = {
 	twi_packet_t packet = {	
 		.chip        = cfg->atcai2c.slave_address >> 1,
-		.addr[0]     = NULL,
+		.addr[0]     = 0,
 		.addr_length = 0,
 		.buffer      = (void *)rxdata,
 		.length      = (uint32_t)*rxlength
 	};
 	
-	switch(bus)
-	{
-		case 0:
-			while(retries-- > 0 && status != TWI_SUCCESS)
-			{
-				//status = twi_master_read(TWI0, &packet);
-				status = twi_master_read(TWI_Channel0, &packet);
-			}
-			break;
-		case 1:
-			while(retries-- > 0 && status != TWI_SUCCESS)
-			{
-				status = twi_master_read(TWI_Channel1, &packet);
-			}
-			break;
-	}
+	// a single read, atwaitreceive() paces the retries and a NACK just means the device is still busy
+	status = hal_i2c_read(bus, &packet);
 	if (status != TWI_SUCCESS)
 	{
+		if (status == TWI_RECEIVE_NACK)
+		{
+			return ATCA_RX_NO_RESPONSE;
+		}
 		return ATCA_COMM_FAIL;
 	}
 	
@@ -321,113 +529,188 @@ ATCA_STATUS hal_i2c_receive( ATCAIface iface, uint8_t *rxdata, uint16_t *rxlengt
 	return ATCA_SUCCESS;
 }
 
-/** \brief method to change the bus speed of I2C
- * \param[in] interface on which to change bus speed
- * \param[in] baud rate (typically 100000 or 400000)
+/** \brief program the clock of a bus.  ASF's twi_set_speed() stops at 400 kHz, faster clocks up to the
+ *  1 MHz of Fast-mode Plus are programmed into the clock waveform generator here the same way.
+ * \param[in] bus - logical bus number
+ * \param[in] speed - bus clock in Hz
  */
-void change_i2c_speed( ATCAIface iface, uint32_t speed )
+static void hal_i2c_set_speed(int bus, uint32_t speed)
 {
-	ATCAIfaceCfg *cfg = atgetifacecfg(iface);
-	int bus = cfg->atcai2c.bus;
+	Twi *twi = bus == 0 ? TWI_Channel0 : TWI_Channel1;
+	uint32_t mck = sysclk_get_cpu_hz();
+	uint32_t ckdiv = 0, c_lh_div;
 	
 	switch(bus)
 	{
 		case 0:
-			//pmc_enable_periph_clk(ID_TWI0);
-			//flexcom_enable(FLEXCOM0);
-			//flexcom_set_opmode(FLEXCOM0, FLEXCOM_TWI);
 			flexcom_enable(FLEX_Channel0);
 			flexcom_set_opmode(FLEX_Channel0, FLEXCOM_TWI);
-			
-			opt_twi_master.master_clk = sysclk_get_cpu_hz();
-			opt_twi_master.speed      = speed;
-			opt_twi_master.smbus      = 0;
-			//twi_master_init(TWI0, &opt_twi_master);
-			twi_master_init(TWI_Channel0, &opt_twi_master);
-			
 			break;
 		case 1:
-			//pmc_enable_periph_clk(ID_TWI1);
 			flexcom_enable(FLEX_Channel1);
 			flexcom_set_opmode(FLEX_Channel1, FLEXCOM_TWI);
-			
-			opt_twi_master.master_clk = sysclk_get_cpu_hz();
-			opt_twi_master.speed      = speed;
-			opt_twi_master.smbus      = 0;
-			twi_master_init(TWI_Channel1, &opt_twi_master);
 			break;
 	}
+	
+	opt_twi_master.master_clk = mck;
+	opt_twi_master.speed      = speed > I2C_FM_SPEED ? I2C_FM_SPEED : speed;
+	opt_twi_master.smbus      = 0;
+	twi_master_init(twi, &opt_twi_master);
+	
+	if (speed > I2C_FM_SPEED)
+	{
+		if (speed > I2C_FMP_SPEED)
+		{
+			speed = I2C_FMP_SPEED;
+		}
+		
+		c_lh_div = mck / (speed * 2) - 4;
+		while (c_lh_div > 0xFF && ckdiv < 7)
+		{
+			ckdiv++;
+			c_lh_div /= 2;
+		}
+		twi->TWI_CWGR = TWI_CWGR_CLDIV(c_lh_div) | TWI_CWGR_CHDIV(c_lh_div) | TWI_CWGR_CKDIV(ckdiv);
+	}
+	
+	if (i2c_hal_data[bus] != NULL)
+	{
+		i2c_hal_data[bus]->speed = speed;
+	}
+	
+#ifdef ATCA_I2C_PDC
+	// 9 clocks a byte, 8 data bits and the ACK, rounded up
+	i2c_xfer[bus].byte_us = (9 * 1000000 + speed - 1) / speed;
+#endif
 }
 
-/** \brief wake up CryptoAuth device using I2C bus
- * \param[in] interface to logical device to wakeup
+/** \brief method to change the bus speed of I2C
+ * \param[in] interface on which to change bus speed
+ * \param[in] baud rate (typically 100000 or 400000, up to 1000000)
  */
-ATCA_STATUS hal_i2c_wake(ATCAIface iface)
+void change_i2c_speed( ATCAIface iface, uint32_t speed )
 {
 	ATCAIfaceCfg *cfg = atgetifacecfg(iface);
 	int bus = cfg->atcai2c.bus;
-	int retries = cfg->rx_retries;
-	uint32_t bdrt = cfg->atcai2c.baud;
-	uint8_t data[4], expected[4] = { 0x04,0x11,0x33,0x43 };
-	int status = !TWI_SUCCESS;
 	
-	// if not already at 100KHz, change it
-	if (bdrt != 100000)
+	if (bus < 0 || bus >= MAX_I2C_BUSES)
 	{
-		change_i2c_speed(iface, 100000);
+		return;
 	}
 	
-	// Send 0x00 as wake pulse
-	switch(bus)
+	// devices sharing a bus mostly run at the same speed, reprogramming the TWI resets it
+	if (i2c_hal_data[bus] != NULL && i2c_hal_data[bus]->speed == speed)
 	{
-		//case 0: twi_write_byte(TWI0, 0x00); break;
-		case 0: twi_write_byte(TWI_Channel0,0);break;
-		case 1: twi_write_byte(TWI_Channel1,0); break;
+		return;
 	}
 	
-	atca_delay_us(cfg->wake_delay);	// wait tWHI + tWLO which is configured based on device type and configuration structure
+	hal_i2c_set_speed(bus, speed);
+}
+
+/** \brief send the wake pulse, SDA held low for at least tWLO
+ * \param[in] iface - interface of the device to wake, all devices on its bus wake up
+ */
+static void hal_i2c_wake_pulse(ATCAIface iface)
+{
+	ATCAIfaceCfg *cfg = atgetifacecfg(iface);
+	int bus = cfg->atcai2c.bus;
+#ifdef ATCA_I2C_CLOCK_WAKE
+	uint32_t bdrt = cfg->atcai2c.baud;
+	
+	// a 0x00 address byte at 100 kHz holds SDA low long enough
+	change_i2c_speed(iface, 100000);
+	twi_write_byte(bus == 0 ? TWI_Channel0 : TWI_Channel1, 0);
+	change_i2c_speed(iface, bdrt);
+#else
+	ioport_pin_t sda = bus == 0 ? ATCA_I2C_SDA_GPIO0 : ATCA_I2C_SDA_GPIO1;
+	
+	// take the pin from the TWI and drive it low directly, so the bus clock stays as it is
+	ioport_set_pin_level(sda, IOPORT_PIN_LEVEL_LOW);
+	ioport_set_pin_dir(sda, IOPORT_DIR_OUTPUT);
+	ioport_enable_pin(sda);
+	atca_delay_us(ATCA_WAKE_LOW_US);
+	ioport_set_pin_dir(sda, IOPORT_DIR_INPUT);
+	ioport_disable_pin(sda);
+#endif
+}
+
+/** \brief wake up CryptoAuth device using I2C bus.  The wake token is read as soon as the device answers,
+ *  and how long that took calibrates the wait after the next wake pulse.
+ * \param[in] interface to logical device to wakeup
+ */
+ATCA_STATUS hal_i2c_wake(ATCAIface iface)
+{
+	ATCAIfaceCfg *cfg = atgetifacecfg(iface);
+	int bus = cfg->atcai2c.bus;
+	int retries = cfg->rx_retries;
+	uint32_t wake_delay = atgetwakedelay(iface);
+	uint32_t waited_us = wake_delay;
+	uint8_t data[4], expected[4] = { 0x04,0x11,0x33,0x43 };
+	uint32_t status = !TWI_SUCCESS;
 	
-	//twi_package_t packet = {
 	twi_packet_t packet = {
 		.chip        = cfg->atcai2c.slave_address >> 1,
-		.addr[0]     = NULL,
+		.addr[0]     = 0,
 		.addr_length = 0,
 		.buffer      = (void *)data,
 		.length      = 4
 	};
 	
-	// if necessary, revert baud rate to what came in.
-	if (bdrt != 100000)
+	hal_i2c_wake_pulse(iface);
+	atca_delay_us(wake_delay);	// wait tWHI, calibrated from the configured wake_delay
+	
+	// the device NACKs until it is up.  atretry() sends another wake pulse if it never answers.
+	while (retries-- > 0 && (status = hal_i2c_read(bus, &packet)) != TWI_SUCCESS && retries > 0)
 	{
-		change_i2c_speed(iface, bdrt);
+		atca_delay_us(ATCA_WAKE_POLL_US);
+		waited_us += ATCA_WAKE_POLL_US;
 	}
 	
-	switch(bus)
+	if (status != TWI_SUCCESS || memcmp(data, expected, 4) != 0)
 	{
-		case 0:
-			//if (twi_master_read(TWI0, &packet) != TWI_SUCCESS)
-			while (retries-- > 0 && status != TWI_SUCCESS)
-				status = twi_master_read(TWI_Channel0, &packet);
-			/*if (twi_master_read(TWI_Channel0, &packet) != TWI_SUCCESS)
-			{
-				return ATCA_COMM_FAIL;
-			}*/
-			break;
-		case 1:
-			/*
-			if (twi_master_read(TWI_Channel1, &packet) != TWI_SUCCESS)
-			{
-				return ATCA_COMM_FAIL;
-			}*/
-			break;
+		return ATCA_COMM_FAIL;
 	}
 	
-	if (memcmp(data, expected, 4) == 0)
+	// answered on the first read, try a little less next time.  Otherwise wait as long as it took.
+	if (waited_us == wake_delay)
 	{
-		return ATCA_SUCCESS;
+		waited_us -= wake_delay / 16;
+		if (waited_us < ATCA_WAKE_DELAY_MIN_US)
+		{
+			waited_us = ATCA_WAKE_DELAY_MIN_US;
+		}
 	}
+	atsetwakedelay(iface, (uint16_t)waited_us);
 	
-	return ATCA_COMM_FAIL;
+	return ATCA_SUCCESS;
+}
+
+/** \brief reset the address counter of the device's I/O buffer, so the next read returns the response again
+ *  from its first byte.  Used to read a response again after a CRC error or a short read, without idling
+ *  the device, which would discard its output buffer.
+ * \param[in] interface to logical device
+ */
+ATCA_STATUS hal_i2c_resync(ATCAIface iface)
+{
+	ATCAIfaceCfg *cfg = atgetifacecfg(iface);
+	uint8_t data[1];
+	
+	data[0] = 0x00;	// reset word address value
+	
+	twi_packet_t packet = {
+		.chip        = cfg->atcai2c.slave_address >> 1,
+		.addr[0]     = 0,
+		.addr_length = 0,
+		.buffer      = (void *)data,
+		.length      = 1
+	};
+	
+	if (hal_i2c_write(cfg->atcai2c.bus, &packet) != TWI_SUCCESS)
+	{
+		return ATCA_COMM_FAIL;
+	}
+	
+	return ATCA_SUCCESS;
 }
 
 /** \brief idle CryptoAuth device using I2C bus
@@ -444,27 +727,15 @@ ATCA_STATUS hal_i2c_idle(ATCAIface iface)
 	//twi_package_t packet = {
 	twi_packet_t packet = {
 		.chip        = cfg->atcai2c.slave_address >> 1,
-		.addr[0]     = NULL,
+		.addr[0]     = 0,
 		.addr_length = 0,
 		.buffer      = (void *)data,
 		.length      = 1
 	};
 	
-	switch(bus)
+	if (hal_i2c_write(bus, &packet) != TWI_SUCCESS)
 	{
-		case 0:
-			//if (twi_master_write(TWI0, &packet) != TWI_SUCCESS)
-			if (twi_master_write(TWI_Channel0, &packet) != TWI_SUCCESS)
-			{
-				return ATCA_COMM_FAIL;
-			}
-			break;
-		case 1:
-			if (twi_master_write(TWI_Channel1, &packet) != TWI_SUCCESS)
-			{
-				return ATCA_COMM_FAIL;
-			}
-			break;
+		return ATCA_COMM_FAIL;
 	}
 	
 	return ATCA_SUCCESS;
@@ -484,27 +755,15 @@ ATCA_STATUS hal_i2c_sleep(ATCAIface iface)
 	//twi_package_t packet = {
 	twi_packet_t packet = {
 		.chip        = cfg->atcai2c.slave_address >> 1,
-		.addr[0]     = NULL,
+		.addr[0]     = 0,
 		.addr_length = 0,
 		.buffer      = (void *)data,
 		.length      = 1
 	};
 	
-	switch(bus)
+	if (hal_i2c_write(bus, &packet) != TWI_SUCCESS)
 	{
-		case 0:
-			//if (twi_master_write(TWI0, &packet) != TWI_SUCCESS)
-			if (twi_master_write(TWI_Channel0, &packet) != TWI_SUCCESS)
-			{
-				return ATCA_COMM_FAIL;
-			}
-			break;
-		case 1:
-			if (twi_master_write(TWI_Channel1, &packet) != TWI_SUCCESS)
-			{
-				return ATCA_COMM_FAIL;
-			}
-			break;
+		return ATCA_COMM_FAIL;
 	}
 	
 	return ATCA_SUCCESS;
@@ -522,6 +781,11 @@ ATCA_STATUS hal_i2c_release( void *hal_data )
 	// if the use count for this bus has gone to 0 references, disable it.  protect against an unbracketed release
 	if (hal && --(hal->ref_ct) <= 0 && i2c_hal_data[hal->bus_index] != NULL)
 	{
+#ifdef ATCA_I2C_PDC
+		NVIC_DisableIRQ(i2c_irq[hal->bus_index]);
+		twi_disable_interrupt(i2c_twi[hal->bus_index], I2C_XFER_IRQS);
+		twi_master_pdc_disable(i2c_twi[hal->bus_index]);
+#endif
 		switch(hal->bus_index)
 		{
 			//case 0: twi_reset(TWI0); break;
@@ -62,9 +62,39 @@ typedef struct atcaI2Cmaster
 	int ref_ct;
 	// for conveniences during interface release phase
 	int bus_index;
+	uint32_t speed;		// clock the bus is programmed for
 } ATCAI2CMaster_t;
 
+#define I2C_FM_SPEED			(400000)	// fastest clock ASF's TWI driver programs
+#define I2C_FMP_SPEED			(1000000)	// Fast-mode Plus, the fastest clock of the CryptoAuth devices
+
+/* The wake pulse holds SDA low for tWLO.  The HAL drives the SDA pin low through the PIO for that long, so the
+ * bus clock doesn't have to be reprogrammed around every wake.  Boards with other pins define their own
+ * ATCA_I2C_SDA_GPIOn, or ATCA_I2C_CLOCK_WAKE to send a 0x00 byte at 100 kHz as the wake pulse instead. */
+#ifndef ATCA_I2C_CLOCK_WAKE
+#ifndef ATCA_I2C_SDA_GPIO0
+#define ATCA_I2C_SDA_GPIO0		TWI4_DATA_GPIO	// SDA of logical bus 0
+#endif
+#ifndef ATCA_I2C_SDA_GPIO1
+#define ATCA_I2C_SDA_GPIO1		TWI1_DATA_GPIO	// SDA of logical bus 1
+#endif
+#endif
+
+#define ATCA_WAKE_LOW_US		(60)	// tWLO, SDA low time that wakes the device
+#define ATCA_WAKE_POLL_US		(100)	// time between reads of the wake token while the device isn't up yet
+#define ATCA_WAKE_DELAY_MIN_US	(100)	// calibration doesn't shorten the wait after the wake pulse below this
+
 void change_i2c_speed( ATCAIface iface, uint32_t speed );
 
+#ifdef ATCA_I2C_PDC
+/** \brief called from interrupt context when a PDC transfer on a bus completes
+ * \param[in] bus - logical bus number
+ * \param[in] status - TWI_SUCCESS or the TWI error of the transfer
+ */
+typedef void (*hal_i2c_xfer_callback)(int bus, uint32_t status);
+
+void hal_i2c_set_xfer_callback(hal_i2c_xfer_callback callback);
+#endif
+
 /** @} */
 #endif /* HAL_SAMD21_I2C_ASF_H_ */
\ No newline at end of file
@@ -81,4 +81,17 @@ void atca_delay_ms(uint32_t delay)
 	delay_ms(delay);
 }
 
+/** \brief millisecond tick count maintained by the application's SysTick handler */
+extern volatile uint32_t g_ul_ms_ticks;
+
+/** \brief This function returns a free running millisecond tick count, used to time
+ *         commands running in the background without blocking.
+ *
+ * \return milliseconds since the tick count was started
+ */
+uint32_t atca_ticks_ms(void)
+{
+	return g_ul_ms_ticks;
+}
+
 /** @} */
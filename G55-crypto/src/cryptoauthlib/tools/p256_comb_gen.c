@@ -0,0 +1,127 @@
+/** \brief p256_comb_gen, a host tool that generates the C source of a P-256 fixed-base comb table, so
+ *  that software verifies against a pinned public key use a table kept in flash.  See sw_p256_comb_build()
+ *  and sw_p256_comb_pin().  Build with "make tools".
+ *
+ *      p256_comb_gen <name> <public key as 128 hex digits, X || Y>  > file.c
+ *      p256_comb_gen <name> G                                       > file.c
+ *
+ * Copyright (c) 2015 Atmel Corporation. All rights reserved.
+ *
+ * \asf_license_start
+ *
+ * \page License
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. The name of Atmel may not be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * 4. This software may only be redistributed and used in connection with an
+ *    Atmel microcontroller product.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ATMEL "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT ARE
+ * EXPRESSLY AND SPECIFICALLY DISCLAIMED. IN NO EVENT SHALL ATMEL BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * \asf_license_stop
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "crypto/ecc/p256_routines.h"
+
+static const uint8_t p256_g[P256_PUBLIC_KEY_SIZE] = {
+	0x6B, 0x17, 0xD1, 0xF2, 0xE1, 0x2C, 0x42, 0x47, 0xF8, 0xBC, 0xE6, 0xE5, 0x63, 0xA4, 0x40, 0xF2,
+	0x77, 0x03, 0x7D, 0x81, 0x2D, 0xEB, 0x33, 0xA0, 0xF4, 0xA1, 0x39, 0x45, 0xD8, 0x98, 0xC2, 0x96,
+	0x4F, 0xE3, 0x42, 0xE2, 0xFE, 0x1A, 0x7F, 0x9B, 0x8E, 0xE7, 0xEB, 0x4A, 0x7C, 0x0F, 0x9E, 0x16,
+	0x2B, 0xCE, 0x33, 0x57, 0x6B, 0x31, 0x5E, 0xCE, 0xCB, 0xB6, 0x40, 0x68, 0x37, 0xBF, 0x51, 0xF5
+};
+
+static int parse_hex(const char *hex, uint8_t *bin, size_t size)
+{
+	size_t i;
+	unsigned int byte;
+
+	if (strlen(hex) != 2 * size)
+		return -1;
+	for (i = 0; i < size; i++)
+	{
+		if (sscanf(&hex[2 * i], "%2x", &byte) != 1)
+			return -1;
+		bin[i] = (uint8_t)byte;
+	}
+	return 0;
+}
+
+/** \brief prints a number as P256_LIMB_INIT() pairs of 32-bit words, which fit either limb size */
+static void print_number(const p256_limb *n)
+{
+	int w;
+	uint32_t lo, hi;
+
+	printf("{ ");
+	for (w = 0; w < 8; w += 2)
+	{
+		lo = (uint32_t)(n[w * 32 / P256_LIMB_BITS] >> (w * 32 % P256_LIMB_BITS));
+		hi = (uint32_t)(n[(w + 1) * 32 / P256_LIMB_BITS] >> ((w + 1) * 32 % P256_LIMB_BITS));
+		printf("P256_LIMB_INIT(0x%08X, 0x%08X)%s", (unsigned)lo, (unsigned)hi, w < 6 ? ", " : " }");
+	}
+}
+
+int main(int argc, char *argv[])
+{
+	static sw_p256_comb comb;
+	uint8_t public_key[P256_PUBLIC_KEY_SIZE];
+	int i;
+
+	if (argc != 3)
+	{
+		fprintf(stderr, "usage: %s <name> <public key as 128 hex digits | G>\n", argv[0]);
+		return 2;
+	}
+	if (strcmp(argv[2], "G") == 0)
+		memcpy(public_key, p256_g, sizeof(public_key));
+	else if (parse_hex(argv[2], public_key, sizeof(public_key)) != 0)
+	{
+		fprintf(stderr, "%s: public key must be 128 hex digits\n", argv[0]);
+		return 2;
+	}
+	if (sw_p256_comb_build(public_key, &comb) != P256_SUCCESS)
+	{
+		fprintf(stderr, "%s: public key isn't a point on the curve\n", argv[0]);
+		return 1;
+	}
+
+	printf("/* Generated by tools/p256_comb_gen, do not edit.  P-256 comb table for sw_p256_comb_pin(). */\n\n");
+	printf("#include \"crypto/ecc/p256_routines.h\"\n\n");
+	printf("const sw_p256_comb %s = {\n\t{\n", argv[1]);
+	for (i = 0; i < P256_PUBLIC_KEY_SIZE; i++)
+		printf("%s0x%02X%s", i % 16 ? " " : "\t\t", public_key[i], i == P256_PUBLIC_KEY_SIZE - 1 ? "\n" : i % 16 == 15 ? ",\n" : ",");
+	printf("\t},\n\t{\n");
+	for (i = 0; i < P256_COMB_POINTS; i++)
+	{
+		printf("\t\t{ ");
+		print_number(comb.points[i].x);
+		printf(",\n\t\t  ");
+		print_number(comb.points[i].y);
+		printf(" }%s\n", i < P256_COMB_POINTS - 1 ? "," : "");
+	}
+	printf("\t}\n};\n");
+	return 0;
+}
@@ -42,8 +42,10 @@
 #define CERT_DEF_1_SIGNER_H
 
 #include "atcacert/atcacert_def.h"
+#include "crypto/ecc/p256_routines.h"
 
 extern const uint8_t g_signer_1_ca_public_key[];
+extern const sw_p256_comb g_signer_1_ca_comb;   // comb table of g_signer_1_ca_public_key for sw_p256_comb_pin(), see cert_def_1_signer_comb.c
 extern const atcacert_def_t g_cert_def_1_signer;
 
 #endif // CERT_DEF_1_SIGNER_H
\ No newline at end of file
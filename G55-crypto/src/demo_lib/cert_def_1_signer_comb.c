@@ -0,0 +1,140 @@
+/* Generated by tools/p256_comb_gen, do not edit.  P-256 comb table for sw_p256_comb_pin(). */
+
+#include "crypto/ecc/p256_routines.h"
+
+const sw_p256_comb g_signer_1_ca_comb = {
+	{
+		0xF9, 0x29, 0x04, 0xF3, 0xBF, 0xD0, 0x6C, 0x5C, 0x42, 0x02, 0x4C, 0xC3, 0x5E, 0x04, 0x8B, 0x3F,
+		0xA3, 0xC7, 0xC3, 0xC8, 0x07, 0xC6, 0x6F, 0xA9, 0xE4, 0x18, 0x42, 0x1E, 0x34, 0x0F, 0x94, 0x7C,
+		0xBD, 0x4D, 0xDF, 0x52, 0x6F, 0xD9, 0x5A, 0xA0, 0x55, 0x7E, 0x48, 0x08, 0xAC, 0x11, 0xFB, 0x85,
+		0x50, 0x09, 0xCF, 0x59, 0xDB, 0x4F, 0x05, 0x0B, 0x4D, 0x3D, 0x67, 0xAA, 0xE9, 0x97, 0xC4, 0x91
+	},
+	{
+		{ { P256_LIMB_INIT(0x340F947C, 0xE418421E), P256_LIMB_INIT(0x07C66FA9, 0xA3C7C3C8), P256_LIMB_INIT(0x5E048B3F, 0x42024CC3), P256_LIMB_INIT(0xBFD06C5C, 0xF92904F3) },
+		  { P256_LIMB_INIT(0xE997C491, 0x4D3D67AA), P256_LIMB_INIT(0xDB4F050B, 0x5009CF59), P256_LIMB_INIT(0xAC11FB85, 0x557E4808), P256_LIMB_INIT(0x6FD95AA0, 0xBD4DDF52) } },
+		{ { P256_LIMB_INIT(0xA6D420C7, 0xAEFA8F1D), P256_LIMB_INIT(0xD611B4D7, 0x07A51404), P256_LIMB_INIT(0x834770F7, 0xAF5B93E1), P256_LIMB_INIT(0x3403DE04, 0x9ABAF26A) },
+		  { P256_LIMB_INIT(0x3AD4CE59, 0x7B8A23C0), P256_LIMB_INIT(0x4C2654BB, 0xDD1899C4), P256_LIMB_INIT(0x8378F0D5, 0x69374837), P256_LIMB_INIT(0x4E3A81A2, 0xAA7B09C3) } },
+		{ { P256_LIMB_INIT(0xD360184E, 0xDA441C85), P256_LIMB_INIT(0x3A51893C, 0xE9D0E9A5), P256_LIMB_INIT(0x950D38FE, 0xF65877A9), P256_LIMB_INIT(0xD0963A3D, 0xF55C514D) },
+		  { P256_LIMB_INIT(0xAB3A00A0, 0xFEC91DAB), P256_LIMB_INIT(0x0B3D5A69, 0x70840C4A), P256_LIMB_INIT(0x2B873F63, 0x0C39E7B8), P256_LIMB_INIT(0x73F47B8B, 0x1FFF6105) } },
+		{ { P256_LIMB_INIT(0x87D9276E, 0x898D1290), P256_LIMB_INIT(0x2BD0939B, 0xB00759D9), P256_LIMB_INIT(0x12EE1F58, 0xC5B6C721), P256_LIMB_INIT(0x37199D9D, 0x458B5972) },
+		  { P256_LIMB_INIT(0x8F2DE77C, 0x2E35EA7C), P256_LIMB_INIT(0x831A53F9, 0x0848901C), P256_LIMB_INIT(0x088ED049, 0x422DBA30), P256_LIMB_INIT(0x61D3C19C, 0xA030A738) } },
+		{ { P256_LIMB_INIT(0x82055248, 0xBF96990A), P256_LIMB_INIT(0xCC15C3A7, 0x1E025515), P256_LIMB_INIT(0xF6D3659F, 0x7EE2009E), P256_LIMB_INIT(0x48540772, 0x84B3CEC5) },
+		  { P256_LIMB_INIT(0xA5196A44, 0x92C5F5F9), P256_LIMB_INIT(0x2598C353, 0x4F91E3D3), P256_LIMB_INIT(0x3D7B7A5D, 0x68885048), P256_LIMB_INIT(0xB4E396D9, 0x3D65BD37) } },
+		{ { P256_LIMB_INIT(0xEBF74E18, 0x6018E31D), P256_LIMB_INIT(0x26912CD2, 0x7C2583DF), P256_LIMB_INIT(0x075A3A28, 0x6F960982), P256_LIMB_INIT(0xA0B3C271, 0xA95661A5) },
+		  { P256_LIMB_INIT(0x0635331E, 0x1F84923C), P256_LIMB_INIT(0x2CFE9C86, 0x623A244F), P256_LIMB_INIT(0xDFD375AD, 0xCCF290C8), P256_LIMB_INIT(0x226A4304, 0x230011F7) } },
+		{ { P256_LIMB_INIT(0x13B0919C, 0x772CDE9B), P256_LIMB_INIT(0x47245EBA, 0x7DFBB796), P256_LIMB_INIT(0x11879908, 0x0E5C94A8), P256_LIMB_INIT(0xCA38806B, 0x14F5135B) },
+		  { P256_LIMB_INIT(0x736034CA, 0x7830006D), P256_LIMB_INIT(0x0697E513, 0xACC352FA), P256_LIMB_INIT(0xA832606D, 0x35DAE670), P256_LIMB_INIT(0x81F728B7, 0x21788281) } },
+		{ { P256_LIMB_INIT(0x89A1A2AF, 0xAD3F7A9F), P256_LIMB_INIT(0x9D681332, 0xF2356790), P256_LIMB_INIT(0xA6C46C8A, 0xBD708797), P256_LIMB_INIT(0xE9CF24EC, 0x5CC8D665) },
+		  { P256_LIMB_INIT(0x38605196, 0x2568BBE3), P256_LIMB_INIT(0x23CC0555, 0x8EFD5FF3), P256_LIMB_INIT(0x9DBC4930, 0xC21ADFD2), P256_LIMB_INIT(0x25DC807C, 0x1B8877A7) } },
+		{ { P256_LIMB_INIT(0x98347C62, 0x1E9E68A7), P256_LIMB_INIT(0x10350B11, 0xDBDAE3B6), P256_LIMB_INIT(0xA7353D37, 0x42C9662F), P256_LIMB_INIT(0xBF002420, 0x8849C9E8) },
+		  { P256_LIMB_INIT(0x5EDC45BE, 0x512FA8CD), P256_LIMB_INIT(0x40E9C30E, 0x46F44C92), P256_LIMB_INIT(0x02C4A1C9, 0xD83C1479), P256_LIMB_INIT(0x4991B376, 0xC0B723B9) } },
+		{ { P256_LIMB_INIT(0xD80DF1C2, 0x1A11F2C4), P256_LIMB_INIT(0x30CF5F0E, 0xB4BA9629), P256_LIMB_INIT(0x358697EB, 0xB1FEE6B5), P256_LIMB_INIT(0xAB8D47C9, 0x733077A9) },
+		  { P256_LIMB_INIT(0x49226625, 0x555D1586), P256_LIMB_INIT(0xD2F71C6C, 0x5D726979), P256_LIMB_INIT(0x7935E072, 0x33E3CD00), P256_LIMB_INIT(0x260C373D, 0x708FAD6C) } },
+		{ { P256_LIMB_INIT(0x72A1F614, 0x4319E9B6), P256_LIMB_INIT(0xA0623458, 0x5BD24BD6), P256_LIMB_INIT(0x45FF6B73, 0xDC868737), P256_LIMB_INIT(0xA488B1AF, 0x5D2E122F) },
+		  { P256_LIMB_INIT(0x54838AC7, 0x0D1525D5), P256_LIMB_INIT(0xF705C3F8, 0xB7E2B2DD), P256_LIMB_INIT(0xFE62AD39, 0x97500E8B), P256_LIMB_INIT(0x8D656B1B, 0x98075C37) } },
+		{ { P256_LIMB_INIT(0xF47A965A, 0x491DD958), P256_LIMB_INIT(0x99A9B498, 0x15B07D49), P256_LIMB_INIT(0xCF9A81D9, 0x8B07B963), P256_LIMB_INIT(0xBAB13613, 0x01ACC44D) },
+		  { P256_LIMB_INIT(0xE6573A4B, 0xD34BBDEB), P256_LIMB_INIT(0x98886370, 0x9E10D96A), P256_LIMB_INIT(0x6E25DDD1, 0x6B81B664), P256_LIMB_INIT(0x7A72D081, 0x24D9A230) } },
+		{ { P256_LIMB_INIT(0xD0D7E70C, 0x3FEF5025), P256_LIMB_INIT(0x07241126, 0x3AE5E1E0), P256_LIMB_INIT(0x95B52944, 0x73A594D2), P256_LIMB_INIT(0x67F9B47F, 0xABC49315) },
+		  { P256_LIMB_INIT(0x2175BABF, 0xF08FD218), P256_LIMB_INIT(0x6FBA39D4, 0xCCCC946C), P256_LIMB_INIT(0x488C25C2, 0x2C97E231), P256_LIMB_INIT(0x1E6AB520, 0xE6FC24EE) } },
+		{ { P256_LIMB_INIT(0x871A57F8, 0x2E89394A), P256_LIMB_INIT(0x3BADBB5D, 0xBF3F36BB), P256_LIMB_INIT(0x3C6368A7, 0xD9FB3C36), P256_LIMB_INIT(0xB5AE02BC, 0xC4CDDC01) },
+		  { P256_LIMB_INIT(0xA0E27DCB, 0x14FF4C37), P256_LIMB_INIT(0x8BD44A0A, 0x441E0351), P256_LIMB_INIT(0x10DF7A8F, 0x830093DB), P256_LIMB_INIT(0xCE3D9BD1, 0xA765ED40) } },
+		{ { P256_LIMB_INIT(0x9979B2A8, 0x5C76E8EB), P256_LIMB_INIT(0x46B9C0C0, 0xE45A0F05), P256_LIMB_INIT(0x9735C65B, 0xB22B43D9), P256_LIMB_INIT(0x05718777, 0x0B97C10C) },
+		  { P256_LIMB_INIT(0x78E0E904, 0xC20A4A48), P256_LIMB_INIT(0xAC6FA18C, 0x6B65CC7D), P256_LIMB_INIT(0x2E591DE2, 0xBE42DCB0), P256_LIMB_INIT(0x44EBFEEA, 0xF94FC037) } },
+		{ { P256_LIMB_INIT(0x93D8407E, 0xBEF8FEF2), P256_LIMB_INIT(0x1B6654A0, 0x0E744D45), P256_LIMB_INIT(0x28EF4E04, 0x0254F660), P256_LIMB_INIT(0xBAF8B006, 0x414CA4A8) },
+		  { P256_LIMB_INIT(0xF836D06F, 0x9C95ECC9), P256_LIMB_INIT(0x911D0003, 0xE4DB9C16), P256_LIMB_INIT(0x3441D568, 0xB4DF02C9), P256_LIMB_INIT(0xED8CAC60, 0xE9F4E560) } },
+		{ { P256_LIMB_INIT(0x2CF929E2, 0x8039F71E), P256_LIMB_INIT(0x5EB073B3, 0x102F4F79), P256_LIMB_INIT(0x63C02B8F, 0x54C8ED81), P256_LIMB_INIT(0x348A4F65, 0x1459197C) },
+		  { P256_LIMB_INIT(0x65B557C3, 0xF5C604CD), P256_LIMB_INIT(0xAABF3119, 0x5C3F1B51), P256_LIMB_INIT(0x850A5DB9, 0x46813C1E), P256_LIMB_INIT(0x85610B6B, 0x783B6649) } },
+		{ { P256_LIMB_INIT(0x54E9D01F, 0xAC53AB87), P256_LIMB_INIT(0x5F25EF1B, 0xBA8E42EE), P256_LIMB_INIT(0x98FB3E9A, 0x276FEE89), P256_LIMB_INIT(0x5F3D5567, 0x59C5449B) },
+		  { P256_LIMB_INIT(0x69D93C71, 0x36821023), P256_LIMB_INIT(0xA797DF1D, 0xBE5B62C2), P256_LIMB_INIT(0xA7CC3F15, 0x6B0D408E), P256_LIMB_INIT(0xE95DD077, 0x26AF25C2) } },
+		{ { P256_LIMB_INIT(0x047F17DA, 0x4C6CCBC6), P256_LIMB_INIT(0x575740D9, 0x34E100D2), P256_LIMB_INIT(0x06C39FB1, 0x8C41C8D3), P256_LIMB_INIT(0x953A1E5A, 0x06BBE514) },
+		  { P256_LIMB_INIT(0xFFC6EFA1, 0x03BB64FF), P256_LIMB_INIT(0xE1D97392, 0x5CEEE092), P256_LIMB_INIT(0xD1DB6D45, 0xC3B16BEE), P256_LIMB_INIT(0xC8344D7E, 0x7B6F42E6) } },
+		{ { P256_LIMB_INIT(0x1B350D24, 0xDC2CD14D), P256_LIMB_INIT(0x1A51A48A, 0x65B633C9), P256_LIMB_INIT(0xCCA6F159, 0x442AC796), P256_LIMB_INIT(0x803F83A2, 0x0708293E) },
+		  { P256_LIMB_INIT(0x00295F3C, 0x82B315CE), P256_LIMB_INIT(0x00A94EF3, 0x34CE0251), P256_LIMB_INIT(0x3B869E2A, 0xC31FCDF7), P256_LIMB_INIT(0xBE055E33, 0xE7221131) } },
+		{ { P256_LIMB_INIT(0xB1D9E826, 0xC733A35C), P256_LIMB_INIT(0xA24BDF47, 0x83A7BE42), P256_LIMB_INIT(0x0D3322AE, 0xE8D2B82A), P256_LIMB_INIT(0x6EFA7B64, 0x67D9C448) },
+		  { P256_LIMB_INIT(0x3C4EFF45, 0x00EFC46E), P256_LIMB_INIT(0x3788749D, 0xB9061FBC), P256_LIMB_INIT(0x9ED87D4B, 0x0126AFA5), P256_LIMB_INIT(0x3B898AEB, 0x0CA8BD66) } },
+		{ { P256_LIMB_INIT(0x13156DEF, 0xBFA24949), P256_LIMB_INIT(0x941C3205, 0x86BAE096), P256_LIMB_INIT(0x516889CD, 0x92BADA35), P256_LIMB_INIT(0x555CE593, 0x3D1B0FCB) },
+		  { P256_LIMB_INIT(0x2B75678F, 0x37C5570F), P256_LIMB_INIT(0x843F8474, 0xDE352050), P256_LIMB_INIT(0xE10D9BC1, 0xD35256F6), P256_LIMB_INIT(0xC238D89B, 0xAE464342) } },
+		{ { P256_LIMB_INIT(0x8DCFF161, 0x10CEB0FE), P256_LIMB_INIT(0x5CCAD085, 0x2CC48C40), P256_LIMB_INIT(0x2EBB467D, 0xE9F95E02), P256_LIMB_INIT(0x35C99FC1, 0x2D501A5B) },
+		  { P256_LIMB_INIT(0x57FE8E92, 0x4030C417), P256_LIMB_INIT(0x6926A86E, 0x1AE688C5), P256_LIMB_INIT(0xB90248C1, 0xEF87BC0E), P256_LIMB_INIT(0xBB1D0449, 0x64FE5137) } },
+		{ { P256_LIMB_INIT(0xC20749BB, 0xDC54BCD8), P256_LIMB_INIT(0x72FC7617, 0xF673B107), P256_LIMB_INIT(0xF3AF132E, 0xA6559385), P256_LIMB_INIT(0xBE09A0ED, 0x18977790) },
+		  { P256_LIMB_INIT(0x773ABFE0, 0x62CEC5E4), P256_LIMB_INIT(0x9EEDCCB4, 0x455A952D), P256_LIMB_INIT(0x0E5031A0, 0x3617648B), P256_LIMB_INIT(0x025194F7, 0x695FCFFE) } },
+		{ { P256_LIMB_INIT(0x2EF431C4, 0x17DD478A), P256_LIMB_INIT(0x8C6BF408, 0xA0D4D4FD), P256_LIMB_INIT(0x11F42F67, 0x20A1DF00), P256_LIMB_INIT(0xA189E987, 0x5BF1DA53) },
+		  { P256_LIMB_INIT(0x167CC88C, 0xAD684C5B), P256_LIMB_INIT(0xEFCD078E, 0x0FA37770), P256_LIMB_INIT(0x8554AAE5, 0x7D5F6878), P256_LIMB_INIT(0x32DF5E5F, 0x7D409393) } },
+		{ { P256_LIMB_INIT(0x83432663, 0xE91F36C8), P256_LIMB_INIT(0x7DB1DAF6, 0xAD38F22E), P256_LIMB_INIT(0x48DB299C, 0x422932F1), P256_LIMB_INIT(0xDF61EE0E, 0x5C97A8D4) },
+		  { P256_LIMB_INIT(0x0866E960, 0x2F994CEE), P256_LIMB_INIT(0xCF9EF92E, 0xA0508D75), P256_LIMB_INIT(0xD6DB0FE2, 0xB6F57529), P256_LIMB_INIT(0xB03B39D7, 0xFBA0EFAA) } },
+		{ { P256_LIMB_INIT(0x214C8F4E, 0xF6AE2B01), P256_LIMB_INIT(0x69A1DF41, 0x165316B9), P256_LIMB_INIT(0xEBD1E3C3, 0xE69700DA), P256_LIMB_INIT(0x4255DBD2, 0xA939578A) },
+		  { P256_LIMB_INIT(0x3F95A46E, 0x571386B9), P256_LIMB_INIT(0x4D5C6D71, 0xBA6572A1), P256_LIMB_INIT(0xB0E259C0, 0x21AD1331), P256_LIMB_INIT(0xB0E70D66, 0x655028C1) } },
+		{ { P256_LIMB_INIT(0x2CD9D94E, 0x1269CA04), P256_LIMB_INIT(0x2BC0B7A8, 0x7FE95AAC), P256_LIMB_INIT(0xF83FA705, 0x0AF4E089), P256_LIMB_INIT(0x78E34AEB, 0xC47039CB) },
+		  { P256_LIMB_INIT(0x4776BA60, 0x0D656E03), P256_LIMB_INIT(0x8A9A1808, 0xD5A9D660), P256_LIMB_INIT(0x31BAFECC, 0xFBD38E0E), P256_LIMB_INIT(0x1B9AD407, 0x102B1637) } },
+		{ { P256_LIMB_INIT(0x2E1F8BBB, 0x62619DA5), P256_LIMB_INIT(0xFEA13701, 0x2B489A40), P256_LIMB_INIT(0x91F39C49, 0xFDD27B28), P256_LIMB_INIT(0x2601CBD6, 0x2523C303) },
+		  { P256_LIMB_INIT(0x4A120B8B, 0xE2AD5191), P256_LIMB_INIT(0xEC737EE9, 0x46DE6DE6), P256_LIMB_INIT(0x99ABEA54, 0xEF14DACD), P256_LIMB_INIT(0x6B15744D, 0x3AF66E40) } },
+		{ { P256_LIMB_INIT(0x49FCFD4A, 0x465A52E1), P256_LIMB_INIT(0x34FA5C01, 0x5C754624), P256_LIMB_INIT(0x549B4BDA, 0x7EE86CB2), P256_LIMB_INIT(0xA8DE1120, 0xFE7DE218) },
+		  { P256_LIMB_INIT(0xF4BD3F13, 0xBCB52996), P256_LIMB_INIT(0x9A5DD9A6, 0x5A9872A0), P256_LIMB_INIT(0xB1C71302, 0x816D5849), P256_LIMB_INIT(0x2DBAD396, 0x2DC28DAD) } },
+		{ { P256_LIMB_INIT(0xBAE3077A, 0x8063996E), P256_LIMB_INIT(0x8E9E32CE, 0x89396151), P256_LIMB_INIT(0x3005976A, 0x9F0CD2B4), P256_LIMB_INIT(0x43665053, 0x56EEC8AD) },
+		  { P256_LIMB_INIT(0xA93C3BD9, 0x5864A0B3), P256_LIMB_INIT(0x7C34EB90, 0x4848D956), P256_LIMB_INIT(0xC6497468, 0xBAB45A48), P256_LIMB_INIT(0xD0834368, 0x3D2C72B5) } },
+		{ { P256_LIMB_INIT(0x1BFB80CE, 0x9310023B), P256_LIMB_INIT(0x9545B43C, 0x64810858), P256_LIMB_INIT(0xACC2EFC3, 0xA04F5D88), P256_LIMB_INIT(0x8B8EF0BE, 0x7D84F3E0) },
+		  { P256_LIMB_INIT(0x5B43E802, 0x4A979E02), P256_LIMB_INIT(0x2310342E, 0x244D584D), P256_LIMB_INIT(0x9AF1AC24, 0x2DF9BBB6), P256_LIMB_INIT(0xFA9F4A46, 0x483248A1) } },
+		{ { P256_LIMB_INIT(0xA0D58BF2, 0x342D12E4), P256_LIMB_INIT(0x9EF15766, 0x87D66F0F), P256_LIMB_INIT(0x45338681, 0x2E75A41C), P256_LIMB_INIT(0xC4A0B75B, 0xD3E6D9A5) },
+		  { P256_LIMB_INIT(0x5AE5EB30, 0x1374D89D), P256_LIMB_INIT(0xFC1667C1, 0xDF72EF08), P256_LIMB_INIT(0xADC103E5, 0xB51B38EC), P256_LIMB_INIT(0x8B37FBCD, 0x9BE3F79F) } },
+		{ { P256_LIMB_INIT(0x63EA21CC, 0xD7A62AE1), P256_LIMB_INIT(0x4D0B7087, 0x53F238BF), P256_LIMB_INIT(0x21142AB8, 0x200323B1), P256_LIMB_INIT(0x87D74A59, 0xDF2AE87B) },
+		  { P256_LIMB_INIT(0xBA3EA000, 0x773BAC88), P256_LIMB_INIT(0x73B4DA93, 0xE8008CEC), P256_LIMB_INIT(0x6A96D5AC, 0x5434FAF6), P256_LIMB_INIT(0x8AF7BB5E, 0xBEEADBDF) } },
+		{ { P256_LIMB_INIT(0x27A98A5D, 0x9AD9E051), P256_LIMB_INIT(0xD616454F, 0x815724A1), P256_LIMB_INIT(0x58036646, 0x0DDE2C9E), P256_LIMB_INIT(0x7BB3FFE7, 0xD6CBEFFD) },
+		  { P256_LIMB_INIT(0x49213B9C, 0xB4EBCFC3), P256_LIMB_INIT(0x8CA09382, 0x1E6417F4), P256_LIMB_INIT(0x48922198, 0x81064B08), P256_LIMB_INIT(0xB76A343E, 0x4A8C9A53) } },
+		{ { P256_LIMB_INIT(0x238474E8, 0x8E63840E), P256_LIMB_INIT(0x5A2F7541, 0xE929FAEF), P256_LIMB_INIT(0xF9C69AD5, 0x1363EA89), P256_LIMB_INIT(0x9EF74279, 0xA486139E) },
+		  { P256_LIMB_INIT(0x86029558, 0x9696B4F2), P256_LIMB_INIT(0xB44BB4C9, 0x16DC8843), P256_LIMB_INIT(0xB3E95E48, 0xF6E59F33), P256_LIMB_INIT(0xF80CAB63, 0x24BD5F96) } },
+		{ { P256_LIMB_INIT(0x8CDA98FE, 0x81CF66A6), P256_LIMB_INIT(0x8880832C, 0xCEB355EA), P256_LIMB_INIT(0x261914A2, 0xC935B67D), P256_LIMB_INIT(0x344F0B03, 0xC20719B3) },
+		  { P256_LIMB_INIT(0x2C41EC2F, 0x56621692), P256_LIMB_INIT(0x4A51A810, 0xA812779C), P256_LIMB_INIT(0x4799E605, 0xED1C0A29), P256_LIMB_INIT(0x4B198570, 0xB26C9E3A) } },
+		{ { P256_LIMB_INIT(0xDCA8927A, 0x560A049E), P256_LIMB_INIT(0x5EB776C0, 0x80ED398C), P256_LIMB_INIT(0x08658091, 0xCA230965), P256_LIMB_INIT(0x4DB6855E, 0x60A60BC0) },
+		  { P256_LIMB_INIT(0xDC2F9A87, 0xBFB8B8BE), P256_LIMB_INIT(0xAF54E85B, 0x8CC76CAD), P256_LIMB_INIT(0x29F90388, 0x257D9077), P256_LIMB_INIT(0xB9FC236D, 0xDA51FB70) } },
+		{ { P256_LIMB_INIT(0x5D6330C4, 0xBC0A98EA), P256_LIMB_INIT(0x98B9339D, 0x9CBAFDAA), P256_LIMB_INIT(0x1383653D, 0x37FEAC75), P256_LIMB_INIT(0xEFC7931E, 0x7CA81907) },
+		  { P256_LIMB_INIT(0x7889E9B1, 0x532F6FCD), P256_LIMB_INIT(0x1E12EFD5, 0xBD8F0CDB), P256_LIMB_INIT(0x2EDC74E9, 0x4A8D675E), P256_LIMB_INIT(0xF76DE767, 0x0A338C6A) } },
+		{ { P256_LIMB_INIT(0xCC7F8D78, 0xDA0E31E3), P256_LIMB_INIT(0xAA6E8018, 0xF04096E6), P256_LIMB_INIT(0x3544D0FE, 0x7DB25D57), P256_LIMB_INIT(0xF7ECFEE3, 0x07A9E183) },
+		  { P256_LIMB_INIT(0x677053FF, 0x314F7552), P256_LIMB_INIT(0x77EF0C5A, 0x0E456851), P256_LIMB_INIT(0xE7A976CD, 0xD92F31E6), P256_LIMB_INIT(0x2A582D38, 0x535F5F67) } },
+		{ { P256_LIMB_INIT(0xCFBF9DD6, 0xEF72BD08), P256_LIMB_INIT(0xDE0949FB, 0xFED86F20), P256_LIMB_INIT(0xC1F3E103, 0xA8721CC5), P256_LIMB_INIT(0x0BAFF33B, 0x46BCD267) },
+		  { P256_LIMB_INIT(0xBF15EAA6, 0x746F104F), P256_LIMB_INIT(0x449D1EFD, 0x19B3C26E), P256_LIMB_INIT(0x53233652, 0x22EC96CE), P256_LIMB_INIT(0xE3B77D3D, 0x999CA7A0) } },
+		{ { P256_LIMB_INIT(0xA0377EFF, 0xFACF5219), P256_LIMB_INIT(0x8D585E72, 0x982C3077), P256_LIMB_INIT(0x068A1A75, 0x7A5F07ED), P256_LIMB_INIT(0x22571EFF, 0xFEAB8B8B) },
+		  { P256_LIMB_INIT(0x471C19A7, 0x9C8E949C), P256_LIMB_INIT(0xFB4B9640, 0xD72F0936), P256_LIMB_INIT(0x25DB031C, 0x9D9AAB0C), P256_LIMB_INIT(0x9AEEF90A, 0x9ADDA164) } },
+		{ { P256_LIMB_INIT(0x69E219CC, 0x8F2F4DAD), P256_LIMB_INIT(0xE18CCC4A, 0xFCAE9833), P256_LIMB_INIT(0x721136BC, 0x45C7C577), P256_LIMB_INIT(0x63D02BAA, 0xB0685683) },
+		  { P256_LIMB_INIT(0x93839CE5, 0x16517C5C), P256_LIMB_INIT(0xF861BF98, 0xDCFA8B39), P256_LIMB_INIT(0x2B9F6F7F, 0x9F1D8739), P256_LIMB_INIT(0xC07EF512, 0x96162CCD) } },
+		{ { P256_LIMB_INIT(0x4E676158, 0x94CA9040), P256_LIMB_INIT(0x24C7E551, 0xA478C329), P256_LIMB_INIT(0xFCB882D4, 0x045E2BCD), P256_LIMB_INIT(0x62712D8C, 0x139619D9) },
+		  { P256_LIMB_INIT(0x7ED5D5B7, 0xB3E07C5A), P256_LIMB_INIT(0x414C6A6E, 0x863911BF), P256_LIMB_INIT(0xD937E84B, 0x7CEF3967), P256_LIMB_INIT(0x41E1A266, 0x0B42AFEE) } },
+		{ { P256_LIMB_INIT(0x46CF7792, 0x25EB9DE4), P256_LIMB_INIT(0xD048EB8F, 0xEFECBBE7), P256_LIMB_INIT(0x7735741F, 0xF08F02D2), P256_LIMB_INIT(0xC96354AB, 0xC91C9EF6) },
+		  { P256_LIMB_INIT(0x79C41B18, 0x6E02A512), P256_LIMB_INIT(0x3A39B040, 0x68E304AB), P256_LIMB_INIT(0xEEE7703A, 0x90C3F939), P256_LIMB_INIT(0x9488AAD9, 0x85087712) } },
+		{ { P256_LIMB_INIT(0xAB6033D4, 0x0D106E55), P256_LIMB_INIT(0xE0C5847A, 0x8DA36D52), P256_LIMB_INIT(0x83F03626, 0x190730C9), P256_LIMB_INIT(0x69058DED, 0x60BC76E8) },
+		  { P256_LIMB_INIT(0x6793DA24, 0x1F74C46D), P256_LIMB_INIT(0x1DCA1EF4, 0x8CF74C87), P256_LIMB_INIT(0xD69E8215, 0x104CEDCC), P256_LIMB_INIT(0xDAAD4BCD, 0xDCB27AC6) } },
+		{ { P256_LIMB_INIT(0x41FF5BF9, 0x8857D5A1), P256_LIMB_INIT(0x671E977F, 0xAD101602), P256_LIMB_INIT(0xE01BE909, 0x87AF838F), P256_LIMB_INIT(0x56EE3E88, 0x9DF96799) },
+		  { P256_LIMB_INIT(0xB50C6D59, 0x5B6AF045), P256_LIMB_INIT(0xDE9C5BAF, 0xD4E2E46D), P256_LIMB_INIT(0x8918F5AC, 0xA1DB9038), P256_LIMB_INIT(0x77220E6F, 0x108C3F56) } },
+		{ { P256_LIMB_INIT(0x43073E04, 0xCF63CCA4), P256_LIMB_INIT(0xC60D42AC, 0x38B9DEA7), P256_LIMB_INIT(0x81AD8D07, 0xE304FAFE), P256_LIMB_INIT(0x9DB24890, 0x70BEC20F) },
+		  { P256_LIMB_INIT(0x4EEA5833, 0x35430EAD), P256_LIMB_INIT(0x71BCD881, 0x888A3C1A), P256_LIMB_INIT(0x7D467897, 0x8DB77F0B), P256_LIMB_INIT(0xA165730E, 0x7404BCEF) } },
+		{ { P256_LIMB_INIT(0x2B42825C, 0xAE407F50), P256_LIMB_INIT(0x6B47DC88, 0xEA800B16), P256_LIMB_INIT(0x51CF12E7, 0xE1495E9A), P256_LIMB_INIT(0xEAF41EE8, 0x4FF44241) },
+		  { P256_LIMB_INIT(0x139B8832, 0x418DCB71), P256_LIMB_INIT(0x5A3D5E8A, 0x5CCCCF77), P256_LIMB_INIT(0x9C374A51, 0xE3586421), P256_LIMB_INIT(0xACD26670, 0x2D6A7A52) } },
+		{ { P256_LIMB_INIT(0x48845FCF, 0x96A7E9D2), P256_LIMB_INIT(0xD4A8A98E, 0x9F6B1C62), P256_LIMB_INIT(0x4D2FB269, 0xF10C4E66), P256_LIMB_INIT(0x12D006E6, 0xBE908091) },
+		  { P256_LIMB_INIT(0xDDA1B2B5, 0x7B6ED97A), P256_LIMB_INIT(0xBF31B1C7, 0xF1EB2E86), P256_LIMB_INIT(0x9ECDB305, 0x5CEBD923), P256_LIMB_INIT(0xECAE282F, 0xF75F8872) } },
+		{ { P256_LIMB_INIT(0x28014D65, 0x300D2B54), P256_LIMB_INIT(0xDEBE1A22, 0x6CCDFA59), P256_LIMB_INIT(0x44F3BD34, 0x44E21B5E), P256_LIMB_INIT(0x9D95D671, 0xD4D806C6) },
+		  { P256_LIMB_INIT(0xA0539457, 0x321E5BD6), P256_LIMB_INIT(0xAA6E1AD9, 0x0E222A76), P256_LIMB_INIT(0xD34CD297, 0xFDA07675), P256_LIMB_INIT(0x37B0D997, 0x6364942D) } },
+		{ { P256_LIMB_INIT(0x4D1DD52C, 0x0C1E47D9), P256_LIMB_INIT(0x7D017079, 0xF716596B), P256_LIMB_INIT(0xE99ABAFB, 0xE90553DC), P256_LIMB_INIT(0xC1ABC905, 0x137A2CB1) },
+		  { P256_LIMB_INIT(0x242E1E9D, 0xB6E805AE), P256_LIMB_INIT(0xD48F53F6, 0x820ED44E), P256_LIMB_INIT(0x2FDC0355, 0x7F467EFE), P256_LIMB_INIT(0x304444D2, 0x0A1AC1A1) } },
+		{ { P256_LIMB_INIT(0xAAAF5D00, 0x08468253), P256_LIMB_INIT(0xEA63EDA3, 0x1D0B86F1), P256_LIMB_INIT(0xAF501F50, 0xDA7E170D), P256_LIMB_INIT(0x5F568B89, 0x26DD7C67) },
+		  { P256_LIMB_INIT(0xBBED8882, 0x67EFB110), P256_LIMB_INIT(0xB8C5767A, 0x00DB3AA3), P256_LIMB_INIT(0xFDD6B54D, 0x43E3602F), P256_LIMB_INIT(0x76DECD1A, 0xC96CC3F2) } },
+		{ { P256_LIMB_INIT(0x9BA88010, 0x73BD4AAE), P256_LIMB_INIT(0xFEA91976, 0x73D7190C), P256_LIMB_INIT(0x497EDE31, 0x61647E94), P256_LIMB_INIT(0x7A637A39, 0x3883FA2A) },
+		  { P256_LIMB_INIT(0x47C74AF1, 0x633FDD43), P256_LIMB_INIT(0x679BEB3F, 0x405AC4D9), P256_LIMB_INIT(0x47E8854D, 0x8C024322), P256_LIMB_INIT(0x1A01A25F, 0x930762B4) } },
+		{ { P256_LIMB_INIT(0x241106D7, 0xE4A46A7D), P256_LIMB_INIT(0x8D39F58E, 0x70D0278E), P256_LIMB_INIT(0xBCBEC0B5, 0x142CC567), P256_LIMB_INIT(0xA7D1BC8F, 0xC3F5C46D) },
+		  { P256_LIMB_INIT(0x496B070A, 0xC911C328), P256_LIMB_INIT(0xCE94308E, 0x4207E173), P256_LIMB_INIT(0xB430A710, 0xA8E448CD), P256_LIMB_INIT(0xD56ED851, 0x30D41360) } },
+		{ { P256_LIMB_INIT(0x53BFA017, 0x6486009C), P256_LIMB_INIT(0x0B5A4968, 0x64FC6A80), P256_LIMB_INIT(0xED26210D, 0x5EBC0EBC), P256_LIMB_INIT(0xECBE6240, 0xF5CB31A3) },
+		  { P256_LIMB_INIT(0x244C386A, 0x004CEF35), P256_LIMB_INIT(0x6DFCCB54, 0x89BDDDF0), P256_LIMB_INIT(0x3EF6B654, 0xAC7F4F0B), P256_LIMB_INIT(0x089DA06C, 0xED3C1094) } },
+		{ { P256_LIMB_INIT(0xA1019AD6, 0x847AA6CA), P256_LIMB_INIT(0x1A184D45, 0x69F359DD), P256_LIMB_INIT(0x4444D5BE, 0xE0C79EDD), P256_LIMB_INIT(0x5326F379, 0xB6501CCD) },
+		  { P256_LIMB_INIT(0xD1935E55, 0xF6A10232), P256_LIMB_INIT(0xAAC614C3, 0x2B70AD43), P256_LIMB_INIT(0xFF02F869, 0x54890F3A), P256_LIMB_INIT(0xA7CA8DC9, 0x00EA2337) } },
+		{ { P256_LIMB_INIT(0x6C10F028, 0xF30E71DC), P256_LIMB_INIT(0x98122E28, 0x016D461C), P256_LIMB_INIT(0x8284E200, 0x25700671), P256_LIMB_INIT(0xC422F665, 0x066AA980) },
+		  { P256_LIMB_INIT(0x853EFA75, 0x29E46689), P256_LIMB_INIT(0x5171C3B1, 0x6C57DABE), P256_LIMB_INIT(0xBF025328, 0x9A89272C), P256_LIMB_INIT(0x4D797133, 0xEA9D9815) } },
+		{ { P256_LIMB_INIT(0xDB7E03D7, 0xE5F1390B), P256_LIMB_INIT(0xC69AECC9, 0xAC893901), P256_LIMB_INIT(0xEB410180, 0xCBF52526), P256_LIMB_INIT(0x90C54B8A, 0x246D944C) },
+		  { P256_LIMB_INIT(0xD1DB35A3, 0x62DBB640), P256_LIMB_INIT(0xFAD05083, 0x8D8282A9), P256_LIMB_INIT(0xD63A8A32, 0xA2B5F413), P256_LIMB_INIT(0xF57C6F70, 0x54A90661) } },
+		{ { P256_LIMB_INIT(0x1472DB24, 0xFC8F9971), P256_LIMB_INIT(0x554A3419, 0xEF8A533B), P256_LIMB_INIT(0x8574AC0C, 0x56D26A56), P256_LIMB_INIT(0x95D306BA, 0xDD99AFFD) },
+		  { P256_LIMB_INIT(0x2FB3060C, 0x5B4A88C7), P256_LIMB_INIT(0xA722377B, 0xEAF1A341), P256_LIMB_INIT(0x17AD158C, 0xB956EB94), P256_LIMB_INIT(0xA796FE47, 0x5FCABAEB) } },
+		{ { P256_LIMB_INIT(0xECD9BED0, 0xD0DC26C8), P256_LIMB_INIT(0x61328C91, 0x9D27AC5F), P256_LIMB_INIT(0x3B45A687, 0x013ADE98), P256_LIMB_INIT(0x41330025, 0x0FE4494C) },
+		  { P256_LIMB_INIT(0x235EF7D4, 0x646C6580), P256_LIMB_INIT(0xF0F4EA9B, 0xDB29F7A2), P256_LIMB_INIT(0x5F8564F0, 0xEC3C041D), P256_LIMB_INIT(0x65903433, 0x0049BE21) } },
+		{ { P256_LIMB_INIT(0x2E62D23C, 0x917CD03D), P256_LIMB_INIT(0xA6EF7194, 0x76F4DCFE), P256_LIMB_INIT(0x6995C017, 0x04C3A279), P256_LIMB_INIT(0x91648BB5, 0xC726D5BD) },
+		  { P256_LIMB_INIT(0x25F49472, 0x3A59AE7A), P256_LIMB_INIT(0x623A39F0, 0x155D86C1), P256_LIMB_INIT(0x6C7C42F3, 0x66CCAFEB), P256_LIMB_INIT(0x3800F984, 0x8B4A335D) } },
+		{ { P256_LIMB_INIT(0x5B4EEE6A, 0xCB19DA21), P256_LIMB_INIT(0xFEA98A6D, 0xD18242BF), P256_LIMB_INIT(0xB7A881AE, 0xAF7604C2), P256_LIMB_INIT(0x45D7F321, 0x096D1EA1) },
+		  { P256_LIMB_INIT(0x60683C2F, 0x3A04618F), P256_LIMB_INIT(0x96361B0F, 0xB181F05E), P256_LIMB_INIT(0xEDFAE772, 0x3D7DB7DD), P256_LIMB_INIT(0xFC973322, 0xC8B90BDA) } }
+	}
+};
@@ -84,6 +84,12 @@ int main(void)
 	/* Initialize the console UART */
 	configure_console();
 
+	/* Configure systick for 1 ms, it times commands running in the background */
+	if (SysTick_Config(sysclk_get_cpu_hz() / 1000)) {
+		puts("-E- Systick configuration error\r");
+		while (1);
+	}
+
 	/* Output example information */
 	//puts(STRING_HEADER);
 	